@@ -27,10 +27,13 @@
 #include "PrettyDebug.hh"
 #include "NM_Classes.hh"
 #include "M_Classes.hh"
+#include "EventTrace.hh"
 
 #include "SocketHTTPProxy.hh"
 #include "SecureTCPSocket.hh"
+#include "SocketPollerSelect.hh"
 
+#include <algorithm>
 #include <cerrno>
 #include <fstream>
 #include <iostream>
@@ -48,6 +51,12 @@ namespace rtia {
 static PrettyDebug D("RTIA_COMM", "(RTIA Comm) ");
 static PrettyDebug G("GENDOC",__FILE__);
 
+// As the default output queue of the RTIG links.
+const size_t Communications::DATA_QUEUE_LIMIT = 4096 * 1024 ;
+
+// A busy RTIA may never find its links idle: a millisecond at most.
+const double Communications::COALESCING_DELAY = 1e6 ;
+
 // ----------------------------------------------------------------------------
 
 NetworkMessage* Communications::waitMessage(
@@ -65,14 +74,14 @@ NetworkMessage* Communications::waitMessage(
 
     // Otherwise, wait for a message with same type than expected and with
     // same federate number.
-    msg = NM_Factory::receive(socketTCP);
+    msg = NM_Factory::receive(socketTCP, NM_msgBufReceive);
 
     D.Out(pdProtocol, "TCP Message of Type %d has arrived.", type_msg);
 
     while ((msg->getMessageType() != type_msg) ||
            ((numeroFedere != 0) && (msg->getFederate() != numeroFedere))) {
         waitingList.push_back(msg);
-        msg = NM_Factory::receive(socketTCP);
+        msg = NM_Factory::receive(socketTCP, NM_msgBufReceive);
         D.Out(pdProtocol, "Message of Type %d has arrived.", type_msg);
     }
     
@@ -83,7 +92,9 @@ NetworkMessage* Communications::waitMessage(
 
 // ----------------------------------------------------------------------------
 //! Communications.
-Communications::Communications(int RTIA_port, int RTIA_fd)
+Communications::Communications(int RTIA_port, int RTIA_fd, int RTIA_shm, LocalLink *RTIA_link)
+    : batchCount(0), batching(false), dataServer(NULL), dataPort(0), dataPoller(NULL),
+      clock(libhla::clock::Clock::getBestClock()), rtigQueued(false), rtigQueuedSince(0)
 {
     char nom_serveur_RTIG[200] ;
     const char *default_host = "localhost" ;
@@ -111,6 +122,10 @@ Communications::Communications(int RTIA_port, int RTIA_fd)
     } else {
       exit(EXIT_FAILURE);
     }
+    if (0 <= RTIA_shm && !socketUN->setSHMLinkFD(RTIA_shm))
+      exit(EXIT_FAILURE);
+    if (RTIA_link != NULL)
+      socketUN->setLocalLink(RTIA_link);
 
     // RTIG TCP link creation.
     const char *certihost = NULL ;
@@ -135,6 +150,15 @@ Communications::Communications(int RTIA_port, int RTIA_fd)
 
     socketTCP->createConnection(certihost, atoi(tcp_port));
     socketUDP->createConnection(certihost, atoi(udp_port));
+#ifndef WITH_GSSAPI
+    // The messages for the RTIG go together, when nothing else is to be read
+    // (see readMessage).
+    if (getenv("CERTI_NO_COALESCING") == NULL)
+        socketTCP->setCoalescing(true);
+#endif
+
+    if (getenv("CERTI_DIRECT_LINKS") != NULL)
+        openDataServer();
 }
 
 // ----------------------------------------------------------------------------
@@ -148,6 +172,16 @@ Communications::~Communications()
     closeMsg.send(socketTCP, NM_msgBufSend);
     socketTCP->close();
 
+    for (uint32_t i = 0 ; i < localBatch.size(); ++i)
+        delete localBatch[i] ;
+    std::map<FederateHandle, DataPeer>::iterator peer ;
+    for (peer = dataPeers.begin(); peer != dataPeers.end(); ++peer)
+        closeDataLink(peer->second.link);
+    for (list<SocketTCP *>::iterator link = dataLinks.begin(); link != dataLinks.end(); ++link)
+        closeDataLink(*link);
+    delete dataServer ;
+    delete dataPoller ;
+    delete clock ;
     delete socketUN;
 #ifdef FEDERATION_USES_MULTICAST
     delete socketMC;
@@ -167,10 +201,82 @@ Communications::requestFederateService(Message *req)
     //               "type %d",req->type);
     assert(req != NULL);
     D.Out(pdRequest, "Sending Request to Federate, Name %s, Type %d.", req->getMessageName(),req->getMessageType());
-    req->send(socketUN, msgBufSend);
+    EventTrace::record(TRACE_RTIA_CALLBACK, req->getMessageType(), 0, 0, 0, 0);
+    if (!batching) {
+        req->send(socketUN, msgBufSend);
+        return ;
+    }
+    if (socketUN->usesLocalLink()) {
+        localBatch.push_back(req->clone());
+        ++batchCount ;
+        return ;
+    }
+
+    // Leave room for the M_Tick_Callbacks header, written at flush time.
+    if (batch.empty()) {
+        M_Tick_Callbacks header ;
+        header.setCount(0);
+        msgBufSend.reset();
+        header.serialize(msgBufSend);
+        msgBufSend.updateReservedBytes();
+        batch.resize(msgBufSend.size());
+    }
+    msgBufSend.reset();
+    req->serialize(msgBufSend);
+    msgBufSend.updateReservedBytes();
+    const unsigned char *bytes = static_cast<const unsigned char *>(msgBufSend(0));
+    batch.insert(batch.end(), bytes, bytes + msgBufSend.size());
+    ++batchCount ;
     // G.Out(pdGendoc,"exit  Communications::requestFederateService");
 }
 
+// ----------------------------------------------------------------------------
+void
+Communications::batchFederateServices()
+{
+    batching = true ;
+}
+
+// ----------------------------------------------------------------------------
+void
+Communications::flushFederateServices()
+{
+    batching = false ;
+    if (batchCount == 0)
+        return ;
+
+    M_Tick_Callbacks header ;
+    header.setCount(batchCount);
+    D.Out(pdRequest, "Sending a batch of %u Requests to Federate.", batchCount);
+    if (socketUN->usesLocalLink()) {
+        // The messages themselves: the batch only saves wake ups.
+        if (batchCount > 1)
+            socketUN->sendMessage(header.clone());
+        for (uint32_t i = 0 ; i < localBatch.size(); ++i)
+            socketUN->sendMessage(localBatch[i]);
+        localBatch.clear();
+        batchCount = 0 ;
+        return ;
+    }
+
+    msgBufSend.reset();
+    header.serialize(msgBufSend);
+    msgBufSend.updateReservedBytes();
+    size_t headerSize = msgBufSend.size();
+
+    if (batchCount == 1) {
+        socketUN->send(&batch[headerSize], batch.size() - headerSize);
+    }
+    else {
+        std::copy(static_cast<const unsigned char *>(msgBufSend(0)),
+                  static_cast<const unsigned char *>(msgBufSend(0)) + headerSize,
+                  batch.begin());
+        socketUN->send(&batch[0], batch.size());
+    }
+    batch.clear();
+    batchCount = 0 ;
+}
+
 // ----------------------------------------------------------------------------
 unsigned long
 Communications::getAddress()
@@ -185,6 +291,186 @@ Communications::getPort()
     return socketUDP->getPort();
 }
 
+// ----------------------------------------------------------------------------
+//! Listen on an ephemeral port for the direct links of the other RTIAs.
+void
+Communications::openDataServer()
+{
+    dataServer = new SocketTCP();
+    try {
+        dataServer->createServer(0);
+    }
+    catch (NetworkError &e) {
+        D.Out(pdError, "Cannot open the direct links server, only the RTIG is used.");
+        delete dataServer ;
+        dataServer = NULL ;
+        return ;
+    }
+
+    struct sockaddr_in address ;
+#ifdef _WIN32
+    int length = sizeof(address);
+#else
+    socklen_t length = sizeof(address);
+#endif
+    if (getsockname(dataServer->returnSocket(), (struct sockaddr *) &address, &length) != 0) {
+        D.Out(pdError, "Cannot get the port of the direct links server.");
+        delete dataServer ;
+        dataServer = NULL ;
+        return ;
+    }
+    dataPort = ntohs(address.sin_port);
+    dataPoller = new SocketPollerSelect();
+    D.Out(pdInit, "Direct links accepted on port %u.", dataPort);
+}
+
+// ----------------------------------------------------------------------------
+//! Switch a direct link to the non blocking mode, as the RTIG links: a
+//! slow peer does not stall this RTIA, nor does a half-sent message.
+void
+Communications::watchDataLink(SocketTCP *link)
+    throw (NetworkError)
+{
+    dataPoller->add(link->returnSocket());
+    link->setNonBlocking(dataPoller, DATA_QUEUE_LIMIT, SLOW_CONSUMER_BLOCK);
+}
+
+// ----------------------------------------------------------------------------
+//! Close a direct link, writing what the peer still takes of its queue.
+void
+Communications::closeDataLink(SocketTCP *link)
+{
+    if (link == NULL)
+        return ;
+    SOCKET fd = link->returnSocket();
+    delete link ;
+    dataPoller->remove(fd);
+}
+
+// ----------------------------------------------------------------------------
+void
+Communications::setDataPeer(FederateHandle federate, unsigned long address, unsigned int port)
+{
+    std::map<FederateHandle, DataPeer>::iterator i = dataPeers.find(federate);
+    if (i != dataPeers.end()) {
+        closeDataLink(i->second.link);
+        dataPeers.erase(i);
+    }
+    if (port == 0)
+        return ;
+
+    DataPeer &peer = dataPeers[federate] ;
+    peer.address = address ;
+    peer.port = port ;
+    peer.link = NULL ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+Communications::connectDataPeer(FederateHandle federate)
+{
+    std::map<FederateHandle, DataPeer>::iterator i = dataPeers.find(federate);
+    if (i == dataPeers.end())
+        return false ;
+    if (i->second.link != NULL)
+        return true ;
+
+    SocketTCP *link = new SocketTCP();
+    try {
+        link->createTCPClient(i->second.port, i->second.address);
+        watchDataLink(link);
+    }
+    catch (NetworkError &e) {
+        // Unreachable peer: its messages go through the RTIG from now on.
+        D.Out(pdError, "Cannot open the direct link to federate %u.", federate);
+        dataPoller->remove(link->returnSocket());
+        delete link ;
+        dataPeers.erase(i);
+        return false ;
+    }
+    i->second.link = link ;
+    return true ;
+}
+
+// ----------------------------------------------------------------------------
+void
+Communications::sendToDataPeer(FederateHandle federate, WireBuffer &wire)
+{
+    std::map<FederateHandle, DataPeer>::iterator i = dataPeers.find(federate);
+    if (i == dataPeers.end() || i->second.link == NULL)
+        return ;
+
+    try {
+        wire.send(i->second.link);
+    }
+    catch (NetworkError &e) {
+        D.Out(pdExcept, "Direct link to federate %u lost, closing it.", federate);
+        closeDataLink(i->second.link);
+        dataPeers.erase(i);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! Write the output queues of the direct links select reported writable.
+//! @return true if a link was written
+bool
+Communications::flushDataPeers(fd_set &writable)
+{
+    bool flushed = false ;
+    std::map<FederateHandle, DataPeer>::iterator i = dataPeers.begin();
+    while (i != dataPeers.end()) {
+        SocketTCP *link = i->second.link ;
+        if (link == NULL || !FD_ISSET(link->returnSocket(), &writable)) {
+            ++i ;
+            continue ;
+        }
+        flushed = true ;
+        try {
+            link->flush();
+            ++i ;
+        }
+        catch (NetworkError &e) {
+            D.Out(pdExcept, "Direct link to federate %u lost, closing it.", i->first);
+            closeDataLink(link);
+            dataPeers.erase(i++);
+        }
+    }
+    return flushed ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+Communications::selectedDataLink(fd_set &fdset, list<SocketTCP *>::iterator &link)
+{
+    for (link = dataLinks.begin(); link != dataLinks.end(); ++link) {
+        if (FD_ISSET((*link)->returnSocket(), &fdset))
+            return true ;
+    }
+    return false ;
+}
+
+// ----------------------------------------------------------------------------
+//! Read a message from a direct link, closing it when the peer is gone.
+NetworkMessage *
+Communications::receiveDataLink(list<SocketTCP *>::iterator link)
+{
+    try {
+        // Only a whole message is read, the rest waits for the next call.
+        if ((*link)->isNonBlocking() && !(*link)->isDataReady()) {
+            (*link)->readAvailable();
+            if (!(*link)->isDataReady())
+                return NULL ;
+        }
+        return NM_Factory::receive(*link, NM_msgBufReceive);
+    }
+    catch (NetworkError &e) {
+        D.Out(pdProtocol, "Direct link closed by the other RTIA.");
+        closeDataLink(*link);
+        dataLinks.erase(link);
+        return NULL ;
+    }
+}
+
 // ----------------------------------------------------------------------------
 //! read message.
 /*! Reads a message either from the network or from the federate
@@ -197,9 +483,30 @@ Communications::readMessage(int &n, NetworkMessage **msg_reseau, Message **msg,
     const int tcp_fd(socketTCP->returnSocket());
     const int udp_fd(socketUDP->returnSocket());
 
+    // The coalesced messages for the RTIG wait for a pass with nothing to
+    // read, COALESCING_DELAY at most.
+    if (socketTCP->getQueuedBytes() == 0)
+        rtigQueued = false ;
+    else if (!rtigQueued) {
+        rtigQueued = true ;
+        rtigQueuedSince = clock->getCurrentTicksValue();
+    }
+    else if (clock->getDeltaNanoSecond(rtigQueuedSince) >= COALESCING_DELAY) {
+        socketTCP->flush();
+        rtigQueued = false ;
+    }
+
     int max_fd = 0; // not used for _WIN32
     fd_set fdset ;
     FD_ZERO(&fdset);
+    // Direct links with messages their peer has not taken yet.
+    fd_set writable ;
+    FD_ZERO(&writable);
+    bool writing = false ;
+
+    // Direct link with buffered data, read after the RTIG links so that a
+    // discovery relayed by the RTIG comes before the reflections of a peer.
+    list<SocketTCP *>::iterator ready = dataLinks.end();
 
     if (msg_reseau) {
         FD_SET(tcp_fd, &fdset);
@@ -207,6 +514,30 @@ Communications::readMessage(int &n, NetworkMessage **msg_reseau, Message **msg,
 #ifndef _WIN32
 	max_fd = std::max(max_fd, std::max(tcp_fd, udp_fd));
 #endif
+        if (dataServer != NULL) {
+            FD_SET(dataServer->returnSocket(), &fdset);
+#ifndef _WIN32
+            max_fd = std::max(max_fd, dataServer->returnSocket());
+#endif
+        }
+        for (list<SocketTCP *>::iterator link = dataLinks.begin(); link != dataLinks.end(); ++link) {
+            if (ready == dataLinks.end() && (*link)->isDataReady())
+                ready = link ;
+            FD_SET((*link)->returnSocket(), &fdset);
+#ifndef _WIN32
+            max_fd = std::max(max_fd, (*link)->returnSocket());
+#endif
+        }
+        std::map<FederateHandle, DataPeer>::iterator peer ;
+        for (peer = dataPeers.begin(); peer != dataPeers.end(); ++peer) {
+            if (peer->second.link == NULL || peer->second.link->getQueuedBytes() == 0)
+                continue ;
+            FD_SET(peer->second.link->returnSocket(), &writable);
+            writing = true ;
+#ifndef _WIN32
+            max_fd = std::max(max_fd, peer->second.link->returnSocket());
+#endif
+        }
     }
     if (msg) {
         FD_SET(socketUN->returnSocket(), &fdset);
@@ -225,38 +556,64 @@ Communications::readMessage(int &n, NetworkMessage **msg_reseau, Message **msg,
    }
 #endif
 
+    // The size of the message read, unknown if it was already waiting.
+    bool queued = false ;
+
     if (msg_reseau && !waitingList.empty()) {
         // One message is in waiting buffer.        
         *msg_reseau = waitingList.front();
         waitingList.pop_front();                
         n = 1 ;
+        queued = true ;
     }
     else if (msg_reseau && socketTCP->isDataReady()) {
         // Datas are in TCP waiting buffer.
         // Read a message from RTIG TCP link.
-    	*msg_reseau = NM_Factory::receive(socketTCP);
+    	*msg_reseau = NM_Factory::receive(socketTCP, NM_msgBufReceive);
         n = 1 ;
     }
     else if (msg_reseau && socketUDP->isDataReady()) {
         // Datas are in UDP waiting buffer.
         // Read a message from RTIG UDP link.
-    	*msg_reseau = NM_Factory::receive(socketUDP);
+    	*msg_reseau = NM_Factory::receive(socketUDP, NM_msgBufReceive);
         n = 1 ;
     }
+    else if (msg_reseau && ready != dataLinks.end()) {
+        // Datas are in the buffer of a direct link with another RTIA.
+        *msg_reseau = receiveDataLink(ready);
+        n = (*msg_reseau != NULL) ? 1 : 0 ;
+    }
     else if (msg && socketUN->isDataReady()) {
         // Datas are in UNIX waiting buffer.
         // Read a message from federate UNIX link.
-    	*msg = M_Factory::receive(socketUN);
+    	*msg = M_Factory::receive(socketUN, msgBufReceive);
         n = 2 ;
     }
     else {
         // waitingList is empty and no data in TCP buffer.
         // Wait a message (coming from federate or network).
+#ifndef _WIN32
+        int ready_count = 0 ;
+        if (socketTCP->getQueuedBytes() > 0) {
+            // The coalesced messages for the RTIG are written before
+            // blocking, not while the federate or the network has more.
+            fd_set polled = fdset ;
+            struct timeval now = { 0, 0 };
+            ready_count = select(max_fd+1, &polled, NULL, NULL, &now);
+            if (ready_count > 0) {
+                fdset = polled ;
+                FD_ZERO(&writable);
+            }
+            else
+                socketTCP->flush();
+        }
+#endif
 #ifdef _WIN32
-        if (select(max_fd, &fdset, NULL, NULL, timeout) < 0) {
+        if (select(max_fd, &fdset, writing ? &writable : NULL, NULL, timeout) < 0) {
             if (WSAGetLastError() == WSAEINTR)
 #else
-        if (select(max_fd+1, &fdset, NULL, NULL, timeout) < 0) {
+        if (ready_count <= 0
+            && select(max_fd+1, &fdset, writing ? &writable : NULL, NULL, timeout) < 0) {
             if (errno == EINTR)
 #endif 
             {
@@ -267,6 +624,9 @@ Communications::readMessage(int &n, NetworkMessage **msg_reseau, Message **msg,
 				}
         }
 
+        // The peers which read meanwhile get the rest of their messages.
+        bool flushed = writing && flushDataPeers(writable);
+
         // At least one message has been received, read this message.
 
 #ifdef FEDERATION_USES_MULTICAST
@@ -282,25 +642,59 @@ Communications::readMessage(int &n, NetworkMessage **msg_reseau, Message **msg,
 
         if (FD_ISSET(socketTCP->returnSocket(), &fdset)) {
             // Read a message coming from the TCP link with RTIG.
-        	(*msg_reseau) = NM_Factory::receive(socketTCP);
+        	(*msg_reseau) = NM_Factory::receive(socketTCP, NM_msgBufReceive);
             n = 1 ;
         }
         else if (FD_ISSET(socketUDP->returnSocket(), &fdset)) {
             // Read a message coming from the UDP link with RTIG.
-        	(*msg_reseau) = NM_Factory::receive(socketUDP);
+        	(*msg_reseau) = NM_Factory::receive(socketUDP, NM_msgBufReceive);
             n = 1 ;
         }
+        else if (msg_reseau && dataServer != NULL
+                 && FD_ISSET(dataServer->returnSocket(), &fdset)) {
+            // Another RTIA opens a direct link, nothing to process yet.
+            SocketTCP *link = new SocketTCP();
+            try {
+                link->accept(dataServer);
+                dataLinks.push_back(link);
+            }
+            catch (NetworkError &e) {
+                D.Out(pdError, "Cannot accept a direct link.");
+                delete link ;
+            }
+            n = 0 ;
+        }
+        else if (msg_reseau && selectedDataLink(fdset, ready)) {
+            // Read a message coming from a direct link with another RTIA.
+            *msg_reseau = receiveDataLink(ready);
+            n = (*msg_reseau != NULL) ? 1 : 0 ;
+        }
         else if (FD_ISSET(socketUN->returnSocket(), &fdset)) {
             // Read a message coming from the federate.
-			*msg = M_Factory::receive(socketUN);
+			*msg = M_Factory::receive(socketUN, msgBufReceive);
             n = 2 ;
         }
+        else if (flushed)
+        {
+            // Only direct links written, nothing to process.
+            n = 0 ;
+        }
         else
         {
             // select() timeout occured
             n = 3;
         }
     }
+
+    if (EventTrace::isEnabled()) {
+        if (n == 1)
+            EventTrace::record(TRACE_RTIA_RECEIVE, (*msg_reseau)->getMessageType(),
+                               (*msg_reseau)->getFederation(), (*msg_reseau)->getFederate(),
+                               0, queued ? 0 : NM_msgBufReceive.size());
+        else if (n == 2)
+            EventTrace::record(TRACE_RTIA_REQUEST, (*msg)->getMessageType(), 0, 0, 0,
+                               socketUN->usesLocalLink() ? 0 : msgBufReceive.size());
+    }
 } /* end of readMessage */
 
 // ----------------------------------------------------------------------------
@@ -337,6 +731,10 @@ void
 Communications::sendMessage(NetworkMessage *Msg)
 {
     Msg->send(socketTCP, NM_msgBufSend);
+    // The time advance of the other federates waits for the null messages.
+    if (Msg->getMessageType() == NetworkMessage::MESSAGE_NULL
+        || Msg->getMessageType() == NetworkMessage::MESSAGE_NULL_PRIME)
+        socketTCP->flush();
 }
 
 // ----------------------------------------------------------------------------
@@ -350,7 +748,9 @@ Communications::sendUN(Message *Msg)
 Message*
 Communications::receiveUN()
 {
-	Message* msg = M_Factory::receive(socketUN);
+	// The federate may wait for the RTIG before answering.
+	socketTCP->flush();
+	Message* msg = M_Factory::receive(socketUN, msgBufReceive);
 	return msg;
 }
 
@@ -30,11 +30,15 @@
 #include "SocketUN.hh"
 #include "SocketTCP.hh"
 #include "SocketUDP.hh"
+#include "WireBuffer.hh"
+#include "Clock.hh"
 #ifdef FEDERATION_USES_MULTICAST
 #include "SocketMC.hh"
 #endif
 
 #include <list>
+#include <map>
+#include <vector>
 
 namespace certi {
 namespace rtia {
@@ -47,7 +51,7 @@ namespace rtia {
 class Communications
 {
 public:
-    Communications(int RTIA_port, int RTIA_fd);
+    Communications(int RTIA_port, int RTIA_fd, int RTIA_shm, LocalLink *RTIA_link);
     ~Communications();
 
     /**
@@ -82,9 +86,62 @@ public:
     void readMessage(int& n, NetworkMessage **nmsg, Message **msg, struct timeval *timeout);
 
     void requestFederateService(Message *req);
+
+    /**
+     * Keep the federate services requested from now on in a batch, sent
+     * to the federate in a single transfer by flushFederateServices.
+     */
+    void batchFederateServices();
+
+    /**
+     * Send the batched federate services, if any, and stop batching.
+     * A batch of one service is sent as is, a larger one is preceded by
+     * an M_Tick_Callbacks header.
+     */
+    void flushFederateServices();
+
+    /** Return the number of federate services in the current batch. */
+    uint32_t getBatchedFederateServices() const { return batchCount ; };
+
     unsigned long getAddress();
     unsigned int getPort();
 
+    /**
+     * Return the TCP port the other RTIAs open direct links to this one on,
+     * 0 if the RTIA does not use direct links (CERTI_DIRECT_LINKS not set).
+     * The messages coming on these links are read as those of the RTIG.
+     */
+    unsigned int getDataPort() const { return dataPort ; };
+
+    /**
+     * Record where the RTIA of another federate accepts direct links, or
+     * forget it, closing the link to it, when the port is 0.
+     */
+    void setDataPeer(FederateHandle federate, unsigned long address, unsigned int port);
+
+    /**
+     * Open the direct link to the RTIA of a federate, if not yet done.
+     * @return false if the federate has no direct link or cannot be reached
+     */
+    bool connectDataPeer(FederateHandle federate);
+
+    /**
+     * Send a message over the direct link to a federate opened by
+     * connectDataPeer. What the peer does not take at once waits in the
+     * output queue of the link, written by readMessage when the peer reads;
+     * the RTIA only waits for a peer whose queue is full (DATA_QUEUE_LIMIT).
+     * On a network error, the link is closed and the message dropped, as
+     * the RTIG does when broadcasting.
+     */
+    void sendToDataPeer(FederateHandle federate, WireBuffer &wire);
+
+    /** Bytes a direct link queues for a slow peer before waiting for it. */
+    static const size_t DATA_QUEUE_LIMIT ;
+
+    /** Nanoseconds the coalesced messages for the RTIG may wait for an
+     *  idle pass of readMessage before they are written anyway. */
+    static const double COALESCING_DELAY ;
+
     /**
      * Wait for a message coming from RTIG and return when received.
      * @param[in] type_msg, expected message type,
@@ -96,7 +153,9 @@ public:
     
 protected:
     MessageBuffer NM_msgBufSend;
+    MessageBuffer NM_msgBufReceive;
     MessageBuffer msgBufSend;
+    MessageBuffer msgBufReceive;
 
     SocketUN *socketUN;
 #ifdef FEDERATION_USES_MULTICAST
@@ -114,6 +173,39 @@ private:
 	 */
     std::list<NetworkMessage *> waitingList ;
 
+    /** Serialized federate services waiting for flushFederateServices. */
+    std::vector<unsigned char> batch ;
+    /** Federate services waiting for flushFederateServices, on an in-memory link. */
+    std::vector<Message *> localBatch ;
+    uint32_t batchCount ;
+    bool batching ;
+
+    /** Where the RTIA of another federate accepts direct links. */
+    struct DataPeer {
+        unsigned long address ;
+        unsigned int port ;
+        SocketTCP *link ; //!< NULL until connectDataPeer
+    };
+
+    SocketTCP *dataServer ; //!< NULL if the RTIA uses no direct link
+    unsigned int dataPort ;
+    std::map<FederateHandle, DataPeer> dataPeers ;
+    /** The direct links the other RTIAs opened to this one. */
+    std::list<SocketTCP *> dataLinks ;
+    /** Makes the direct links non blocking; readMessage selects them. */
+    SocketPoller *dataPoller ;
+
+    libhla::clock::Clock *clock ;
+    bool rtigQueued ;           //!< coalesced messages wait for the RTIG
+    uint64_t rtigQueuedSince ;  //!< when readMessage first saw them
+
+    void openDataServer();
+    void watchDataLink(SocketTCP *link) throw (NetworkError);
+    void closeDataLink(SocketTCP *link);
+    NetworkMessage *receiveDataLink(std::list<SocketTCP *>::iterator link);
+    bool selectedDataLink(fd_set &fdset, std::list<SocketTCP *>::iterator &link);
+    bool flushDataPeers(fd_set &writable);
+
     bool searchMessage(NetworkMessage::Type type_msg,
 		       FederateHandle numeroFedere,
 		       NetworkMessage **msg);
@@ -160,7 +160,7 @@ DataDistribution::modifyRegion(RegionHandle handle,
 	Debug(D, pdDebug) << "Modify region " << handle << "..." << endl ;
 
 	// check region
-	RTIRegion *region = rootObject->getRegion(handle);
+	rootObject->getRegion(handle);
 
 	// Request to RTIG
 	NM_DDM_Modify_Region req;
@@ -175,7 +175,7 @@ DataDistribution::modifyRegion(RegionHandle handle,
 	e = rep->getException() ;
 
 	if (e == e_NO_EXCEPTION) {
-		region->replaceExtents(extents);
+		rootObject->modifyRegion(handle, extents);
 		Debug(D, pdDebug) << "Modified region " << handle << endl ;
 	}
 } /* end of modifyRegion */
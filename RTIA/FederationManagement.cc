@@ -29,6 +29,7 @@
 #include "NM_Classes.hh"
 #include "M_Classes.hh"
 
+#include <cstdlib>
 #include <cstring>
 #include <cstdio>
 #include <cassert>
@@ -242,8 +243,11 @@ joinFederationExecution(const std::string& Federate,
         requete.setFederationName(Federation);
         requete.setFederateName(Federate);
 
+        // A zero port has the RTIG send the best effort messages on TCP. The
+        // RTIG takes the address of the TCP link, only the port is used.
         requete.setBestEffortAddress(comm->getAddress());
-        requete.setBestEffortPeer(comm->getPort());
+        requete.setBestEffortPeer(getenv("CERTI_NO_UDP") ? 0 : comm->getPort());
+        requete.setDataPeer(comm->getDataPort());
 
         G.Out(pdGendoc,"joinFederationExecution====>send Message to RTIG");
 
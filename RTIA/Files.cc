@@ -23,27 +23,54 @@
 
 #include <config.h>
 #include "Files.hh"
+#include "MessagePool.hh"
+#include "ObjectSet.hh"
+#include "ObjectClassSet.hh"
+#include "PrettyDebug.hh"
 
-using std::list ;
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
 
 namespace certi {
 namespace rtia {
 
+static PrettyDebug D("RTIA_QUEUES", __FILE__);
+
+// ----------------------------------------------------------------------------
+/*! CERTI_CONFLATE lists, separated by commas or spaces, the object classes
+  whose every attribute is conflated and the Class.Attribute names of the
+  other conflated attributes.
+*/
+Queues::Queues()
+    : rootObject(NULL), tsoRank(0), conflationResolved(false)
+{
+    const char *conflate = getenv("CERTI_CONFLATE");
+    std::string names = conflate != NULL ? conflate : "" ;
+    std::string::size_type begin = names.find_first_not_of(", ");
+    while (begin != std::string::npos) {
+        std::string::size_type end = names.find_first_of(", ", begin);
+        conflationNames.push_back(names.substr(begin, end - begin));
+        begin = names.find_first_not_of(", ", end);
+    }
+}
+
 // ----------------------------------------------------------------------------
 //! Returns logical time from first message in TSO list.
 void
 Queues::nextTsoDate(bool &found, FederationTime &time)
 {
-    NetworkMessage *msg_buffer ;
-
-    if (tsos.empty()) {
-        found = false ;
-        time = -1.0 ;
+    if (!releasedTsos.empty()) {
+        found = true ;
+        time = releasedTsos.front()->getDate();
     }
-    else {
-        msg_buffer = tsos.front();
+    else if (!tsos.empty()) {
         found = true ;
-        time = msg_buffer->getDate();
+        time = tsos.front().date ;
+    }
+    else {
+        found = false ;
+        time = -1.0 ;
     }
 }
 
@@ -89,6 +116,18 @@ Queues::giveFifoMessage(bool &msg_donne, bool &msg_restant)
         fifos.pop_front();
         msg_donne = true ;
 
+        // Its values are not pending anymore.
+        if (!latestValues.empty()
+            && msg_tampon->getMessageType() == NetworkMessage::REFLECT_ATTRIBUTE_VALUES) {
+            NM_Reflect_Attribute_Values *reflection = static_cast<NM_Reflect_Attribute_Values *>(msg_tampon);
+            for (uint32_t i = 0 ; i < reflection->getAttributesSize() ; ++i) {
+                std::map<ObjectAttribute, NM_Reflect_Attribute_Values *>::iterator latest =
+                    latestValues.find(ObjectAttribute(reflection->getObject(), reflection->getAttributes(i)));
+                if (latest != latestValues.end() && latest->second == reflection)
+                    latestValues.erase(latest);
+            }
+        }
+
         if (!fifos.empty())
             msg_restant = true ;
 
@@ -111,22 +150,23 @@ Queues::giveTsoMessage(FederationTime heure_logique,
     msg_donne = false ;
     msg_restant = false ;
 
-    if (!tsos.empty()) {
-        buffer_msg = tsos.front();
+    if (releasedTsos.empty())
+        releaseTsoMessages(heure_logique);
+
+    if (!releasedTsos.empty()) {
+        buffer_msg = releasedTsos.front();
         if (buffer_msg->getDate() <= heure_logique) {
             // remove from list but keep pointer to execute
             // ExecuterServiceFedere.
-            tsos.pop_front();
+            releasedTsos.pop_front();
             msg_donne = true ;
 
             // Test if next TSO message can be sent.
-            if (!tsos.empty()) {
-                NetworkMessage *buffer_msg2 ;
-                buffer_msg2 = tsos.front();
+            if (!releasedTsos.empty())
+                msg_restant = releasedTsos.front()->getDate() <= heure_logique ;
+            else
+                msg_restant = !tsos.empty() && FederationTime(tsos.front().date) <= heure_logique ;
 
-                if (buffer_msg2->getDate() <= heure_logique)
-                    msg_restant = true ;
-            }
             return buffer_msg ;
         }
         else return NULL;
@@ -134,6 +174,22 @@ Queues::giveTsoMessage(FederationTime heure_logique,
     else return NULL;
 }
 
+// ----------------------------------------------------------------------------
+/*! Take every TSO message dated up to 'heure_logique' off the heap at once,
+  in delivery order. giveTsoMessage then hands them out one by one without
+  touching the heap. Returns the number of messages waiting to be given.
+*/
+unsigned int
+Queues::releaseTsoMessages(FederationTime heure_logique)
+{
+    while (!tsos.empty() && FederationTime(tsos.front().date) <= heure_logique) {
+        releasedTsos.push_back(tsos.front().msg);
+        std::pop_heap(tsos.begin(), tsos.end(), TsoAfter());
+        tsos.pop_back();
+    }
+    return releasedTsos.size();
+}
+
 // ----------------------------------------------------------------------------
 /*! Insert a message with a command (ex: requestPause) to the beginning of
   command list.
@@ -161,27 +217,154 @@ Queues::insertFifoMessage(NetworkMessage *msg)
 }
 
 // ----------------------------------------------------------------------------
-//! TSO list is sorted by message logical time.
+/*! The queued reflection keeps its place and its tag, with the newer values.
+  A reflection with a time stamp is queued as is, its values going with it,
+  and the later values of its attributes are queued after it.
+*/
+uint32_t
+Queues::insertFifoReflection(NM_Reflect_Attribute_Values *msg)
+{
+    if (msg->isDated()) {
+        forgetLatestValues(msg);
+        fifos.push_back(msg);
+        return 0 ;
+    }
+
+    if (!conflationResolved)
+        resolveConflation();
+
+    ObjectClassHandle the_class ;
+    try {
+        the_class = rootObject->objects->getObjectClass(msg->getObject());
+    }
+    catch (Exception &e) {
+        forgetLatestValues(msg);
+        fifos.push_back(msg);
+        return 0 ;
+    }
+    const Conflation &conflation = getConflation(the_class);
+
+    uint32_t replaced = 0 ;
+    uint32_t i = 0 ;
+    while (i < msg->getAttributesSize()) {
+        AttributeHandle attribute = msg->getAttributes(i);
+        if (!conflation.all && conflation.attributes.count(attribute) == 0) {
+            ++i ;
+            continue ;
+        }
+
+        ObjectAttribute key(msg->getObject(), attribute);
+        std::map<ObjectAttribute, NM_Reflect_Attribute_Values *>::iterator latest = latestValues.find(key);
+        if (latest == latestValues.end() || latest->second == msg) {
+            latestValues[key] = msg ;
+            ++i ;
+            continue ;
+        }
+
+        NM_Reflect_Attribute_Values *queued = latest->second ;
+        const std::vector<AttributeHandle> &attributes = queued->getAttributes();
+        uint32_t rank = std::find(attributes.begin(), attributes.end(), attribute) - attributes.begin();
+        queued->getValues().overwrite(rank, msg->getValues().data(i), msg->getValues().length(i));
+        msg->removeAttributes(i);
+        msg->removeValues(i);
+        ++replaced ;
+    }
+
+    if (msg->getAttributesSize() == 0) {
+        D.Out(pdDebug, "Reflection of object %d conflated.", msg->getObject());
+        MessagePool::release(msg);
+    }
+    else
+        fifos.push_back(msg);
+    return replaced ;
+}
+
+// ----------------------------------------------------------------------------
+/*! A reflection queued as is stands between the values queued before it and
+  the later ones, which must not replace them anymore.
+*/
+void
+Queues::forgetLatestValues(const NM_Reflect_Attribute_Values *msg)
+{
+    for (uint32_t i = 0 ; !latestValues.empty() && i < msg->getAttributesSize() ; ++i)
+        latestValues.erase(ObjectAttribute(msg->getObject(), msg->getAttributes(i)));
+}
+
+// ----------------------------------------------------------------------------
+//! Find the handles of the CERTI_CONFLATE names, once the FOM is known.
+void
+Queues::resolveConflation()
+{
+    conflationResolved = true ;
+    for (uint32_t i = 0 ; i < conflationNames.size() ; ++i) {
+        const std::string &name = conflationNames[i] ;
+        try {
+            conflatedClasses.insert(rootObject->ObjectClasses->getObjectClassHandle(name));
+            continue ;
+        }
+        catch (NameNotFound &e) {
+        }
+
+        // A class name may have dots as well: the attribute is the last part.
+        std::string::size_type dot = name.rfind('.');
+        try {
+            if (dot == std::string::npos)
+                throw NameNotFound(name);
+            ObjectClassHandle the_class = rootObject->ObjectClasses->getObjectClassHandle(name.substr(0, dot));
+            AttributeHandle attribute = rootObject->ObjectClasses->getAttributeHandle(name.substr(dot + 1), the_class);
+            conflatedAttributes.insert(std::make_pair(the_class, attribute));
+        }
+        catch (Exception &e) {
+            std::cerr << "RTIA: CERTI_CONFLATE names no object class or attribute <"
+                      << name << ">, ignored." << std::endl ;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! What is conflated for the objects of a class, from it and its superclasses.
+const Queues::Conflation &
+Queues::getConflation(ObjectClassHandle the_class)
+{
+    std::map<ObjectClassHandle, Conflation>::iterator found = conflations.find(the_class);
+    if (found != conflations.end())
+        return found->second ;
+
+    Conflation &conflation = conflations[the_class] ;
+    for (ObjectClassHandle c = the_class ; c != 0 ;
+         c = rootObject->ObjectClasses->getObjectFromHandle(c)->getSuperclass()) {
+        if (conflatedClasses.count(c) > 0)
+            conflation.all = true ;
+        std::set<std::pair<ObjectClassHandle, AttributeHandle> >::const_iterator a =
+            conflatedAttributes.lower_bound(std::make_pair(c, AttributeHandle(0)));
+        for ( ; a != conflatedAttributes.end() && a->first == c ; ++a)
+            conflation.attributes.insert(a->second);
+    }
+    return conflation ;
+}
+
+// ----------------------------------------------------------------------------
+//! TSO messages are ordered by logical time, then by reception.
 void
 Queues::insertTsoMessage(NetworkMessage *msg)
 {
-    if (tsos.empty()) {
-        tsos.push_front(msg);
+    TsoEntry entry ;
+    entry.date = msg->getDate().getTime();
+    entry.rank = tsoRank++ ;
+    entry.msg = msg ;
+
+    // A message dated before already released ones (which should not
+    // happen if the sender respects its lookahead) still goes in order.
+    if (!releasedTsos.empty() && entry.date < releasedTsos.back()->getDate().getTime()) {
+        std::deque<NetworkMessage *>::iterator i = releasedTsos.begin();
+        while (i != releasedTsos.end() && (*i)->getDate().getTime() <= entry.date)
+            ++i ;
+        releasedTsos.insert(i, msg);
         return ;
     }
-    else {
-        list<NetworkMessage *>::iterator i ;
-        for (i = tsos.begin(); i != tsos.end(); i++) {
-            // stricly greater because we want to place new message behind
-            // older ones with same logical time and thus keep receive order
-            // in list.
-            if ((*i)->getDate() > msg->getDate()) {
-                tsos.insert(i, msg);
-                return ;
-            }
-        }
-    }
-    tsos.push_back(msg);
+
+    tsos.push_back(entry);
+    std::push_heap(tsos.begin(), tsos.end(), TsoAfter());
 }
 
 }} // namespaces
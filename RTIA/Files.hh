@@ -28,8 +28,14 @@
 #include "DeclarationManagement.hh"
 #include "ObjectManagement.hh"
 #include "NetworkMessage.hh"
+#include "NM_Classes.hh"
 
+#include <deque>
 #include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
 #include <stdlib.h>
 
 namespace certi {
@@ -42,15 +48,28 @@ class ObjectManagement ;
 class Queues
 {
 public:
+    Queues();
+
     // File FIFO(First In First Out, or Receive Order)
     void insertFifoMessage(NetworkMessage *msg);
     NetworkMessage *giveFifoMessage(bool &, bool &);
 
+    /** True if CERTI_CONFLATE names object classes or attributes whose
+        receive order reflections go through insertFifoReflection. */
+    bool conflates() const { return !conflationNames.empty(); }
+    /** Insert a receive order reflection in the FIFO list, its values of
+        conflated attributes replacing the ones of the same object waiting
+        in the list instead of being queued again. Returns the number of
+        values replaced, the reflection being released if it has no value
+        left. */
+    uint32_t insertFifoReflection(NM_Reflect_Attribute_Values *msg);
+
     // File TSO(Time Stamp Order)
     void insertTsoMessage(NetworkMessage *msg);
     NetworkMessage *giveTsoMessage(FederationTime heure_logique,
                                    bool &msg_donne,
                                    bool &msg_restant);
+    unsigned int releaseTsoMessages(FederationTime heure_logique);
     void nextTsoDate(bool &trouve, FederationTime &heure_logique);
 
     // File Commandes(ex: requestPause)
@@ -61,13 +80,56 @@ public:
     FederationManagement *fm ;
     DeclarationManagement *dm ;
     ObjectManagement *om ;
+    RootObject *rootObject ;
 
 private:
+    /**
+     * A TSO message with its date and its reception rank, which keeps
+     * messages with the same date in receive order.
+     */
+    struct TsoEntry {
+        double date ;
+        unsigned long rank ;
+        NetworkMessage *msg ;
+    };
+
+    //! Heap ordering: true if a has to be delivered after b. The raw
+    //! dates are compared: the FederationTime tolerance is not transitive,
+    //! hence no strict weak ordering for the heap. It only applies against
+    //! the logical time, in releaseTsoMessages and giveTsoMessage.
+    struct TsoAfter {
+        bool operator()(const TsoEntry &a, const TsoEntry &b) const {
+            return a.date > b.date || (a.date == b.date && a.rank > b.rank);
+        }
+    };
+
     // Attributes
     std::list<NetworkMessage *> fifos ; //!< FIFO list.
-    std::list<NetworkMessage *> tsos ; //!< TSO list.
+    std::vector<TsoEntry> tsos ; //!< TSO heap, next message to deliver on top.
+    std::deque<NetworkMessage *> releasedTsos ; //!< TSO messages taken off the heap, in order.
+    unsigned long tsoRank ; //!< Reception rank of the next TSO message.
     std::list<NetworkMessage *> commands ; //!< commands list.
 
+    /** Conflated attributes of an object class, its superclasses included. */
+    struct Conflation {
+        Conflation() : all(false) {}
+        bool all ;
+        std::set<AttributeHandle> attributes ;
+    };
+    typedef std::pair<ObjectHandle, AttributeHandle> ObjectAttribute ;
+
+    std::vector<std::string> conflationNames ; //!< CERTI_CONFLATE entries.
+    bool conflationResolved ; //!< Names resolved with the FOM.
+    std::set<ObjectClassHandle> conflatedClasses ;
+    std::set<std::pair<ObjectClassHandle, AttributeHandle> > conflatedAttributes ;
+    std::map<ObjectClassHandle, Conflation> conflations ; //!< Cache by object class.
+    //! Reflection of the FIFO list holding the latest value of an attribute.
+    std::map<ObjectAttribute, NM_Reflect_Attribute_Values *> latestValues ;
+
+    void resolveConflation();
+    void forgetLatestValues(const NM_Reflect_Attribute_Values *msg);
+    const Conflation &getConflation(ObjectClassHandle the_class);
+
     // Call a service on the federate.
     void executeFederateService(NetworkMessage *);
 };
@@ -21,11 +21,16 @@
 // ----------------------------------------------------------------------------
 
 #include <config.h>
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <memory>
 #include <iostream>
 
+#include "Communications.hh"
 #include "InteractionSet.hh"
+#include "Object.hh"
+#include "ObjectAttribute.hh"
 #include "ObjectSet.hh"
 #include "ObjectClassSet.hh"
 #include "ObjectManagement.hh"
@@ -34,6 +39,7 @@
 #include "TimeManagement.hh"
 #include "NM_Classes.hh"
 #include "M_Classes.hh"
+#include "MessagePool.hh"
 
 using std::cout ;
 using std::endl ;
@@ -56,14 +62,36 @@ ObjectManagement::orderTypeList[] = {
 		{ "Timestamp", TIMESTAMP }
 };
 
+const size_t ObjectManagement::HELD_REFLECTIONS_LIMIT = 1024 ;
+const size_t ObjectManagement::REMOVED_OBJECTS_KEPT = 4096 ;
+
 ObjectManagement::ObjectManagement(Communications *GC,
 		FederationManagement *GF,
 		RootObject *theRootObj)
 : comm(GC),
   fm(GF),
-  rootObject(theRootObj) { }
+  rootObject(theRootObj),
+  asyncWindow(0),
+  pendingUpdates(0),
+  pendingInteractions(0),
+  asyncException(e_NO_EXCEPTION),
+  routesKnown(false)
+{
+	const char *window = getenv("CERTI_ASYNC_UPDATES");
+	if (window != NULL && atoi(window) > 0) {
+		asyncWindow = atoi(window);
+		D.Out(pdInit, "Asynchronous updates and interactions, window = %u.", asyncWindow);
+	}
+}
 
-ObjectManagement::~ObjectManagement() { }
+ObjectManagement::~ObjectManagement()
+{
+	std::map<ObjectHandle, std::vector<NetworkMessage *> >::iterator o ;
+	for (o = heldReflections.begin(); o != heldReflections.end(); ++o) {
+		for (uint32_t i = 0 ; i < o->second.size() ; ++i)
+			MessagePool::release(o->second[i]);
+	}
+}
 
 // ----------------------------------------------------------------------------
 void
@@ -114,6 +142,8 @@ ObjectManagement::registerObject(ObjectClassHandle the_class,
 	if (e == e_NO_EXCEPTION) {
 		rootObject->registerObjectInstance(fm->federate, the_class, rep->getObject(),
 				rep->getLabel());
+		if (comm->getDataPort() != 0)
+			directObjects.insert(rep->getObject());
 		return rep->getObject() ;
 	}
 	else {
@@ -164,10 +194,15 @@ ObjectManagement::updateAttributeValues(ObjectHandle theObjectHandle,
 
 		req.setLabel(theTag);
 
-		comm->sendMessage(&req);
-		std::auto_ptr<NM_Update_Attribute_Values> rep(static_cast<NM_Update_Attribute_Values*>(comm->waitMessage(req.getMessageType(), req.getFederate())));
-		e = rep->getException() ;
-		evtrHandle = rep->getEvent();
+		if (asyncWindow > 0) {
+			e = sendAsynchronously(&req, pendingUpdates);
+		}
+		else {
+			comm->sendMessage(&req);
+			std::auto_ptr<NM_Update_Attribute_Values> rep(static_cast<NM_Update_Attribute_Values*>(comm->waitMessage(req.getMessageType(), req.getFederate())));
+			e = rep->getException() ;
+			evtrHandle = rep->getEvent();
+		}
 	}
 	else {
 		std::stringstream errorMsg;
@@ -221,10 +256,17 @@ ObjectManagement::updateAttributeValues(ObjectHandle theObjectHandle,
 
 	req.setLabel(theTag);
 
-	comm->sendMessage(&req);
-	std::auto_ptr<NetworkMessage> rep(comm->waitMessage(req.getMessageType(), req.getFederate()));
-
-	e = rep->getException() ;
+	if (updateDirectly(req)) {
+		e = e_NO_EXCEPTION ;
+	}
+	else if (asyncWindow > 0) {
+		e = sendAsynchronously(&req, pendingUpdates);
+	}
+	else {
+		comm->sendMessage(&req);
+		std::auto_ptr<NetworkMessage> rep(comm->waitMessage(req.getMessageType(), req.getFederate()));
+		e = rep->getException() ;
+	}
 	G.Out(pdGendoc,"exit  ObjectManagement::updateAttributeValues without time");
 }
 
@@ -261,7 +303,7 @@ ObjectManagement::discoverObject(ObjectHandle the_object,
 void
 ObjectManagement::reflectAttributeValues(ObjectHandle the_object,
 		const std::vector <AttributeHandle> &the_attributes,
-		const std::vector <AttributeValue_t> &the_values,
+		const ValueArena &the_values,
 		uint16_t the_size,
 		FederationTime the_time,
 		const std::string& the_tag,
@@ -281,7 +323,7 @@ ObjectManagement::reflectAttributeValues(ObjectHandle the_object,
 	req.setValuesSize(the_size);
 	req.setAttributesSize(the_size);
 	for (int i=0; i<the_size;++i) {
-		req.setValues(the_values[i],i);
+		the_values.copy(i, req.getValues(i));
 		req.setAttributes(the_attributes[i],i);
 	}
 
@@ -294,7 +336,7 @@ ObjectManagement::reflectAttributeValues(ObjectHandle the_object,
 void
 ObjectManagement::reflectAttributeValues(ObjectHandle the_object,
 		const std::vector <AttributeHandle> &the_attributes,
-		const std::vector <AttributeValue_t> &the_values,
+		const ValueArena &the_values,
 		uint16_t the_size,
 		const std::string& the_tag,
 		TypeException &)
@@ -308,7 +350,7 @@ ObjectManagement::reflectAttributeValues(ObjectHandle the_object,
 	req.setValuesSize(the_size);
 	req.setAttributesSize(the_size);
 	for (int i=0; i<the_size;++i) {
-		req.setValues(the_values[i],i);
+		the_values.copy(i, req.getValues(i));
 		req.setAttributes(the_attributes[i],i);
 	}
 
@@ -360,11 +402,16 @@ ObjectManagement::sendInteraction(InteractionClassHandle theInteraction,
 
 		req.setLabel(theTag);
 
-		// Send network message and then wait for answer.
-		comm->sendMessage(&req);
-		std::auto_ptr<NetworkMessage> rep(comm->waitMessage(NetworkMessage::SEND_INTERACTION, req.getFederate()));
-		e = rep->getException() ;
-		evtrHandle = rep->eventRetraction;
+		if (asyncWindow > 0) {
+			e = sendAsynchronously(&req, pendingInteractions);
+		}
+		else {
+			// Send network message and then wait for answer.
+			comm->sendMessage(&req);
+			std::auto_ptr<NetworkMessage> rep(comm->waitMessage(NetworkMessage::SEND_INTERACTION, req.getFederate()));
+			e = rep->getException() ;
+			evtrHandle = rep->eventRetraction;
+		}
 	}
 	else {
 		e = e_InvalidFederationTime ;
@@ -408,20 +455,395 @@ ObjectManagement::sendInteraction(InteractionClassHandle theInteraction,
 
 	req.setLabel(theTag);
 
-	// Send network message and then wait for answer.
-	comm->sendMessage(&req);
-	std::auto_ptr<NetworkMessage> rep(comm->waitMessage(NetworkMessage::SEND_INTERACTION, req.getFederate()));
-
-	e = rep->getException() ;
+	if (region == 0 && sendDirectly(req)) {
+		e = e_NO_EXCEPTION ;
+	}
+	else if (asyncWindow > 0) {
+		e = sendAsynchronously(&req, pendingInteractions);
+	}
+	else {
+		// Send network message and then wait for answer.
+		comm->sendMessage(&req);
+		std::auto_ptr<NetworkMessage> rep(comm->waitMessage(NetworkMessage::SEND_INTERACTION, req.getFederate()));
+		e = rep->getException() ;
+	}
 
 } /* end of sendInteraction */
 
+// ----------------------------------------------------------------------------
+//! sendAsynchronously
+/** Send an update or interaction without waiting for the RTIG answer.
+    The call only blocks when more than asyncWindow messages of the same
+    kind are unacknowledged. An error reported by the RTIG on a previous
+    asynchronous message is returned instead of sending the new one.
+    @param req update or interaction to send to the RTIG
+    @param pending unacknowledged message counter for this kind of message
+    @return e_NO_EXCEPTION or the pending asynchronous error
+ */
+TypeException
+ObjectManagement::sendAsynchronously(NetworkMessage *req, unsigned int &pending)
+{
+	if (asyncException != e_NO_EXCEPTION) {
+		TypeException e = asyncException ;
+		asyncException = e_NO_EXCEPTION ;
+		return e ;
+	}
+
+	comm->sendMessage(req);
+	++pending ;
+
+	while (pending > asyncWindow) {
+		acknowledgeUpdate(comm->waitMessage(req->getMessageType(), req->getFederate()));
+	}
+	return e_NO_EXCEPTION ;
+}
+
+// ----------------------------------------------------------------------------
+//! acknowledgeUpdate
+/** Consume the RTIG answer to an asynchronous update or interaction.
+    The first error found is kept until the next update or interaction
+    call reports it to the federate.
+    @param ack NM_Update_Attribute_Values or NM_Send_Interaction answer
+    (deleted)
+ */
+void
+ObjectManagement::acknowledgeUpdate(NetworkMessage *ack)
+{
+	unsigned int &pending = (ack->getMessageType() == NetworkMessage::SEND_INTERACTION)
+			? pendingInteractions : pendingUpdates ;
+	if (pending > 0)
+		--pending ;
+
+	if (ack->getException() != e_NO_EXCEPTION) {
+		D.Out(pdExcept, "Asynchronous %s failed with exception %d (%s).",
+				ack->getMessageName(), ack->getException(),
+				ack->getExceptionReason().c_str());
+		if (asyncException == e_NO_EXCEPTION)
+			asyncException = ack->getException();
+	}
+	MessagePool::release(ack);
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectManagement::setObjectClassRoutes(const NM_Object_Class_Routes &routes)
+{
+	ObjectRoute &route = objectRoutes[routes.getObjectClass()] ;
+	route.federates.clear();
+	route.regional.clear();
+
+	uint32_t first = 0 ;
+	for (uint32_t i = 0 ; i < routes.getAttributesSize() ; ++i) {
+		const std::vector<FederateHandle> &federates = routes.getFederates();
+		uint32_t last = first + routes.getRouteSizes(i);
+		route.federates[routes.getAttributes(i)].assign(federates.begin() + first,
+				federates.begin() + last);
+		first = last ;
+	}
+	route.regional.insert(routes.getRegionalAttributes().begin(),
+			routes.getRegionalAttributes().end());
+	D.Out(pdDebug, "Routes of object class %u: %u attributes, %u regional.",
+			routes.getObjectClass(), routes.getAttributesSize(),
+			routes.getRegionalAttributesSize());
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectManagement::setInteractionClassRoutes(const NM_Interaction_Class_Routes &routes)
+{
+	InteractionRoute &route = interactionRoutes[routes.getInteractionClass()] ;
+	route.federates = routes.getFederates();
+	route.regional = routes.getRegional();
+	D.Out(pdDebug, "Routes of interaction class %u: %u federates%s.",
+			routes.getInteractionClass(), routes.getFederatesSize(),
+			route.regional ? ", regional" : "");
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectManagement::removeDataPeer(FederateHandle federate)
+{
+	std::map<ObjectClassHandle, ObjectRoute>::iterator c ;
+	for (c = objectRoutes.begin(); c != objectRoutes.end(); ++c) {
+		std::map<AttributeHandle, std::vector<FederateHandle> >::iterator a ;
+		for (a = c->second.federates.begin(); a != c->second.federates.end(); ++a) {
+			a->second.erase(std::remove(a->second.begin(), a->second.end(), federate),
+					a->second.end());
+		}
+	}
+	std::map<InteractionClassHandle, InteractionRoute>::iterator i ;
+	for (i = interactionRoutes.begin(); i != interactionRoutes.end(); ++i) {
+		i->second.federates.erase(std::remove(i->second.federates.begin(),
+				i->second.federates.end(), federate), i->second.federates.end());
+	}
+
+	// Nothing more comes from it: what it sent for an object this federate
+	// did not discover would be held forever.
+	std::map<ObjectHandle, std::vector<NetworkMessage *> >::iterator o = heldReflections.begin();
+	while (o != heldReflections.end()) {
+		std::vector<NetworkMessage *> &held = o->second ;
+		for (uint32_t r = 0 ; r < held.size() ;) {
+			if (held[r]->getFederate() == federate) {
+				MessagePool::release(held[r]);
+				held.erase(held.begin() + r);
+			}
+			else
+				++r ;
+		}
+		if (held.empty())
+			heldReflections.erase(o++);
+		else
+			++o ;
+	}
+}
+
+// ----------------------------------------------------------------------------
+bool
+ObjectManagement::holdReflection(NM_Reflect_Attribute_Values *msg)
+{
+	if (comm->getDataPort() == 0 || msg->isDated())
+		return false ;
+	// Sent before the deletion, it would come after the removal.
+	if (removedObjects.find(msg->getObject()) != removedObjects.end()) {
+		D.Out(pdDebug, "Reflection of removed object %u dropped.", msg->getObject());
+		MessagePool::release(msg);
+		return true ;
+	}
+	try {
+		rootObject->objects->getObject(msg->getObject());
+		return false ;
+	}
+	catch (ObjectNotKnown &) {
+	}
+	D.Out(pdDebug, "Reflection of object %u held until its discovery.", msg->getObject());
+	std::vector<NetworkMessage *> &held = heldReflections[msg->getObject()];
+	if (held.size() >= HELD_REFLECTIONS_LIMIT) {
+		MessagePool::release(held.front());
+		held.erase(held.begin());
+	}
+	held.push_back(msg);
+	return true ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectManagement::releaseReflections(ObjectHandle object, std::vector<NetworkMessage *> &reflections)
+{
+	// The RTIG may give the handle of a removed object to a new one.
+	removedObjects.erase(object);
+
+	std::map<ObjectHandle, std::vector<NetworkMessage *> >::iterator o = heldReflections.find(object);
+	if (o == heldReflections.end())
+		return ;
+	reflections.swap(o->second);
+	heldReflections.erase(o);
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectManagement::forgetReflections(ObjectHandle object)
+{
+	if (comm->getDataPort() == 0)
+		return ;
+
+	std::map<ObjectHandle, std::vector<NetworkMessage *> >::iterator o = heldReflections.find(object);
+	if (o != heldReflections.end()) {
+		for (uint32_t i = 0 ; i < o->second.size() ; ++i)
+			MessagePool::release(o->second[i]);
+		heldReflections.erase(o);
+	}
+
+	if (!removedObjects.insert(object).second)
+		return ;
+	removedOrder.push_back(object);
+	if (removedOrder.size() > REMOVED_OBJECTS_KEPT) {
+		removedObjects.erase(removedOrder.front());
+		removedOrder.pop_front();
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectManagement::stopDirectUpdates(ObjectHandle object)
+{
+	directObjects.erase(object);
+}
+
+// ----------------------------------------------------------------------------
+//! updateDirectly
+/** Send a receive order update to its subscribers over the direct links,
+    each one getting the attributes it subscribed to, as the RTIG would.
+    The update goes through the RTIG instead (false returned) when the RTIA
+    cannot check it or route it alone: routes not all received yet, object
+    not registered by this federate or whose ownership may have changed,
+    attribute not owned or subscribed with a region, subscriber without a
+    direct link, or asynchronous updates not yet acknowledged, which it must
+    not overtake.
+    @param req update built for the RTIG
+    @return true if the update has been sent over the direct links
+ */
+bool
+ObjectManagement::updateDirectly(NM_Update_Attribute_Values &req)
+{
+	if (!routesKnown || pendingUpdates > 0
+			|| directObjects.find(req.getObject()) == directObjects.end())
+		return false ;
+
+	Object *object = rootObject->objects->getObject(req.getObject());
+	std::map<ObjectClassHandle, ObjectRoute>::const_iterator route =
+			objectRoutes.find(object->getClass());
+
+	// Attribute ranks to reflect, by subscriber.
+	std::map<FederateHandle, std::vector<uint32_t> > ranks ;
+	for (uint32_t i = 0 ; i < req.getAttributesSize() ; ++i) {
+		AttributeHandle attribute = req.getAttributes(i);
+		try {
+			if (object->getAttribute(attribute)->getOwner() != fm->federate)
+				return false ;
+		}
+		catch (AttributeNotDefined &) {
+			return false ;
+		}
+		if (route == objectRoutes.end())
+			continue ;
+		if (route->second.regional.count(attribute))
+			return false ;
+
+		std::map<AttributeHandle, std::vector<FederateHandle> >::const_iterator r =
+				route->second.federates.find(attribute);
+		if (r == route->second.federates.end())
+			continue ;
+		for (uint32_t f = 0 ; f < r->second.size() ; ++f) {
+			if (r->second[f] != fm->federate)
+				ranks[r->second[f]].push_back(i);
+		}
+	}
+
+	std::map<FederateHandle, std::vector<uint32_t> >::const_iterator f ;
+	for (f = ranks.begin(); f != ranks.end(); ++f) {
+		if (!comm->connectDataPeer(f->first))
+			return false ;
+	}
+
+	// Federates reflecting the same attributes share the encoded message.
+	std::map<std::vector<uint32_t>, WireBuffer> wires ;
+	for (f = ranks.begin(); f != ranks.end(); ++f) {
+		std::map<std::vector<uint32_t>, WireBuffer>::iterator wire = wires.find(f->second);
+		if (wire == wires.end()) {
+			NM_Reflect_Attribute_Values reflect ;
+			reflect.setFederation(fm->_numero_federation);
+			reflect.setFederate(fm->federate);
+			reflect.setObject(req.getObject());
+			reflect.setLabel(req.getLabel());
+			reflect.setAttributesSize(f->second.size());
+			for (uint32_t i = 0 ; i < f->second.size() ; ++i)
+				reflect.setAttributes(req.getAttributes(f->second[i]), i);
+			reflect.setValues(ValueArena(req.getValues(), f->second));
+			wire = wires.insert(std::make_pair(f->second, WireBuffer(reflect))).first ;
+		}
+		comm->sendToDataPeer(f->first, wire->second);
+	}
+	D.Out(pdDebug, "Object %u updated over %u direct links.", req.getObject(),
+			static_cast<unsigned int>(ranks.size()));
+	return true ;
+}
+
+// ----------------------------------------------------------------------------
+namespace {
+
+//! Subscribers reached by an interaction at one level of its class tree.
+struct InteractionLevel {
+	InteractionClassHandle handle ;
+	std::vector<uint32_t> ranks ;
+	std::vector<FederateHandle> federates ;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+//! sendDirectly
+/** Send a receive order interaction without region to its subscribers over
+    the direct links. The subscribers of each superclass receive it as an
+    interaction of their class, with the parameters of this class only, as
+    the RTIG would. The interaction goes through the RTIG instead (false
+    returned) when the routes are not all received yet, a class is
+    subscribed with a region, a subscriber has no direct link or
+    asynchronous interactions are not yet acknowledged.
+    @param req interaction built for the RTIG
+    @return true if the interaction has been sent over the direct links
+ */
+bool
+ObjectManagement::sendDirectly(NM_Send_Interaction &req)
+{
+	if (comm->getDataPort() == 0 || !routesKnown || pendingInteractions > 0)
+		return false ;
+
+	std::vector<InteractionLevel> levels ;
+	std::set<FederateHandle> reached ;
+	reached.insert(fm->federate);
+
+	std::vector<uint32_t> ranks ;
+	for (uint32_t i = 0 ; i < req.getParametersSize() ; ++i)
+		ranks.push_back(i);
+
+	InteractionClassHandle handle = req.getInteractionClass();
+	while (handle != 0) {
+		Interaction *interaction = rootObject->Interactions->getObjectFromHandle(handle);
+		for (uint32_t i = 0 ; i < ranks.size() ;) {
+			if (interaction->hasParameter(req.getParameters(ranks[i])))
+				++i ;
+			else
+				ranks.erase(ranks.begin() + i);
+		}
+
+		std::map<InteractionClassHandle, InteractionRoute>::const_iterator route =
+				interactionRoutes.find(handle);
+		if (route != interactionRoutes.end()) {
+			if (route->second.regional)
+				return false ;
+			InteractionLevel level ;
+			for (uint32_t f = 0 ; f < route->second.federates.size() ; ++f) {
+				FederateHandle federate = route->second.federates[f] ;
+				if (!reached.insert(federate).second)
+					continue ;
+				if (!comm->connectDataPeer(federate))
+					return false ;
+				level.federates.push_back(federate);
+			}
+			if (!level.federates.empty()) {
+				level.handle = handle ;
+				level.ranks = ranks ;
+				levels.push_back(level);
+			}
+		}
+		handle = interaction->getSuperclass();
+	}
+
+	for (uint32_t l = 0 ; l < levels.size() ; ++l) {
+		NM_Receive_Interaction receive ;
+		receive.setFederation(fm->_numero_federation);
+		receive.setFederate(fm->federate);
+		receive.setInteractionClass(levels[l].handle);
+		receive.setLabel(req.getLabel());
+		receive.setParametersSize(levels[l].ranks.size());
+		for (uint32_t i = 0 ; i < levels[l].ranks.size() ; ++i)
+			receive.setParameters(req.getParameters(levels[l].ranks[i]), i);
+		receive.setValues(ValueArena(req.getValues(), levels[l].ranks));
+
+		WireBuffer wire(receive);
+		for (uint32_t f = 0 ; f < levels[l].federates.size() ; ++f)
+			comm->sendToDataPeer(levels[l].federates[f], wire);
+	}
+	D.Out(pdDebug, "Interaction %u sent over direct links.", req.getInteractionClass());
+	return true ;
+}
+
 // ----------------------------------------------------------------------------
 //! receiveInteraction with time
 void
 ObjectManagement::receiveInteraction(InteractionClassHandle the_interaction,
 		const std::vector <ParameterHandle> &the_parameters,
-		const std::vector <ParameterValue_t> &the_values,
+		const ValueArena &the_values,
 		uint16_t the_size,
 		FederationTime the_time,
 		const std::string& the_tag,
@@ -440,7 +862,7 @@ ObjectManagement::receiveInteraction(InteractionClassHandle the_interaction,
 	req.setValuesSize(the_size);
 	for (uint32_t i=0;i<the_size;++i) {
 		req.setParameters(the_parameters[i],i);
-		req.setValues(the_values[i],i);
+		the_values.copy(i, req.getValues(i));
 	}
 	comm->requestFederateService(&req);
 }
@@ -450,7 +872,7 @@ ObjectManagement::receiveInteraction(InteractionClassHandle the_interaction,
 void
 ObjectManagement::receiveInteraction(InteractionClassHandle the_interaction,
 		const std::vector <ParameterHandle> &the_parameters,
-		const std::vector <ParameterValue_t> &the_values,
+		const ValueArena &the_values,
 		uint16_t the_size,
 		const std::string& the_tag,
 		TypeException &)
@@ -463,7 +885,7 @@ ObjectManagement::receiveInteraction(InteractionClassHandle the_interaction,
 	req.setValuesSize(the_size);
 	for (uint32_t i=0;i<the_size;++i) {
 		req.setParameters(the_parameters[i],i);
-		req.setValues(the_values[i],i);
+		the_values.copy(i, req.getValues(i));
 	}
 	comm->requestFederateService(&req);
 }
@@ -491,6 +913,7 @@ ObjectManagement::deleteObject(ObjectHandle theObjectHandle,
 
 	if (e == e_NO_EXCEPTION) {
 		rootObject->deleteObjectInstance(fm->federate, theObjectHandle, theTag);
+		directObjects.erase(theObjectHandle);
 	}
 
 	return rep->eventRetraction ;
@@ -517,6 +940,7 @@ ObjectManagement::deleteObject(ObjectHandle theObjectHandle,
 
 	if (e == e_NO_EXCEPTION) {
 		rootObject->deleteObjectInstance(fm->federate, theObjectHandle, theTag);
+		directObjects.erase(theObjectHandle);
 	}
 } /* end of deleteObject */
 
@@ -25,8 +25,20 @@
 #define _CERTI_RTIA_OM
 
 #include "RootObject.hh"
+#include "ValueArena.hh"
+
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
 
 namespace certi {
+
+class NM_Update_Attribute_Values ;
+class NM_Reflect_Attribute_Values ;
+class NM_Send_Interaction ;
+class NM_Object_Class_Routes ;
+class NM_Interaction_Class_Routes ;
 namespace rtia {
 
 class Communications ;
@@ -75,7 +87,7 @@ public:
 
     void reflectAttributeValues(ObjectHandle theObjectHandle,
                                 const std::vector <AttributeHandle> &attribArray,
-                                const std::vector <AttributeValue_t> &valueArray,
+                                const ValueArena &valueArray,
                                 uint16_t attribArraySize,
                                 FederationTime theTime,
                                 const std::string& theTag,
@@ -84,7 +96,7 @@ public:
 
    void reflectAttributeValues(ObjectHandle theObjectHandle,
                                 const std::vector <AttributeHandle> &attribArray,
-                                const std::vector <AttributeValue_t> &valueArray,
+                                const ValueArena &valueArray,
                                 uint16_t attribArraySize,
                                 const std::string& theTag,
                                 TypeException &e);
@@ -108,9 +120,77 @@ public:
 		    RegionHandle,
                     TypeException &e);
 
+    /**
+     * Handle the RTIG answer to an update or an interaction sent in
+     * asynchronous mode (CERTI_ASYNC_UPDATES set to the number of
+     * unacknowledged messages allowed).
+     * @param[in] ack the answer, deleted by this call
+     */
+    void acknowledgeUpdate(NetworkMessage *ack);
+
+    /**
+     * Replace the routes of an object class, which the RTIG sends to the
+     * RTIAs using direct links (CERTI_DIRECT_LINKS). The receive order
+     * updates whose recipients all have a direct link are sent to them
+     * without going through the RTIG.
+     */
+    void setObjectClassRoutes(const NM_Object_Class_Routes &routes);
+
+    /** Replace the routes of an interaction class, see setObjectClassRoutes. */
+    void setInteractionClassRoutes(const NM_Interaction_Class_Routes &routes);
+
+    /**
+     * Use the direct links from now on: the RTIG has sent every route, which
+     * it ends with the direct link of this federate. Until then the updates
+     * and interactions go through the RTIG.
+     */
+    void setRoutesKnown() { routesKnown = true ; }
+
+    /**
+     * Remove a federate which left the federation from the routes, and drop
+     * its reflections held for an object not discovered.
+     */
+    void removeDataPeer(FederateHandle federate);
+
+    /**
+     * Keep a receive order reflection of an object not yet discovered: a
+     * peer sends it over its direct link, which may overtake the discovery
+     * the RTIG relays. Only done when the RTIA uses direct links. The
+     * reflection of an object just removed is dropped instead, as are the
+     * oldest ones beyond HELD_REFLECTIONS_LIMIT for an object.
+     * @return true if the reflection is held, until releaseReflections, or
+     *         dropped: the caller is done with it either way
+     */
+    bool holdReflection(NM_Reflect_Attribute_Values *msg);
+
+    /**
+     * Give back the reflections held for an object just discovered, in
+     * their order of arrival.
+     */
+    void releaseReflections(ObjectHandle object, std::vector<NetworkMessage *> &reflections);
+
+    /**
+     * The RTIG removes an object: drop its held reflections and those its
+     * owner sent over a direct link before deleting it, which may still
+     * come after the removal. The last REMOVED_OBJECTS_KEPT objects
+     * removed are remembered.
+     */
+    void forgetReflections(ObjectHandle object);
+
+    /** Reflections held at most for an object not discovered. */
+    static const size_t HELD_REFLECTIONS_LIMIT ;
+    /** Objects removed whose late reflections are dropped. */
+    static const size_t REMOVED_OBJECTS_KEPT ;
+
+    /**
+     * Send the updates of an object through the RTIG from now on: its
+     * attributes may change owner, which the RTIA does not follow.
+     */
+    void stopDirectUpdates(ObjectHandle object);
+
     void receiveInteraction(InteractionClassHandle theInteraction,
                             const std::vector <ParameterHandle> &paramArray,
-                            const std::vector <ParameterValue_t> &valueArray,
+                            const ValueArena &valueArray,
                             uint16_t paramArraySize,
                             FederationTime theTime,
                             const std::string& theTag,
@@ -119,7 +199,7 @@ public:
 
     void receiveInteraction(InteractionClassHandle theInteraction,
                             const std::vector <ParameterHandle> &paramArray,
-                            const std::vector <ParameterValue_t> &valueArray,
+                            const ValueArena &valueArray,
                             uint16_t paramArraySize,
                             const std::string& theTag,
                             TypeException &e);
@@ -298,6 +378,44 @@ protected:
     RootObject *rootObject ;
 
 private:
+    TypeException sendAsynchronously(NetworkMessage *req, unsigned int &pending);
+
+    bool updateDirectly(NM_Update_Attribute_Values &req);
+    bool sendDirectly(NM_Send_Interaction &req);
+
+    //! Unacknowledged messages allowed, 0 means synchronous updates.
+    unsigned int asyncWindow ;
+    unsigned int pendingUpdates ;
+    unsigned int pendingInteractions ;
+    //! First error reported on an asynchronous message, not yet returned.
+    TypeException asyncException ;
+
+    /** Route of an object class: the federates subscribed to each attribute. */
+    struct ObjectRoute {
+        std::map<AttributeHandle, std::vector<FederateHandle> > federates ;
+        //! Attributes also subscribed with a region, relayed by the RTIG.
+        std::set<AttributeHandle> regional ;
+    };
+
+    /** Route of an interaction class, its superclasses not included. */
+    struct InteractionRoute {
+        InteractionRoute() : regional(false) {}
+        std::vector<FederateHandle> federates ;
+        bool regional ;
+    };
+
+    std::map<ObjectClassHandle, ObjectRoute> objectRoutes ;
+    std::map<InteractionClassHandle, InteractionRoute> interactionRoutes ;
+    //! Every route has been received, see setRoutesKnown.
+    bool routesKnown ;
+    //! Objects registered by this federate whose owners are known locally.
+    std::set<ObjectHandle> directObjects ;
+    //! Reflections received before the discovery of their object.
+    std::map<ObjectHandle, std::vector<NetworkMessage *> > heldReflections ;
+    //! Objects removed lately, oldest first, and the same as a set.
+    std::deque<ObjectHandle> removedOrder ;
+    std::set<ObjectHandle> removedObjects ;
+
     struct TransportTypeList {
         std::string name;
         TransportType type;
@@ -23,6 +23,7 @@
 
 #include <config.h>
 #include "RTIA.hh"
+#include "EventTrace.hh"
 #include <assert.h>
 #include <math.h>
 #include <limits.h>
@@ -32,15 +33,17 @@ namespace rtia {
 
 static PrettyDebug D("RTIA", "(RTIA) ");
 
-RTIA::RTIA(int RTIA_port, int RTIA_fd) {
+RTIA::RTIA(int RTIA_port, int RTIA_fd, int RTIA_shm, LocalLink *RTIA_link) {
 
+    // On a thread of its federate, the RTIA joins the trace of the federate.
+    EventTrace::configure("rtia");
     clock = libhla::clock::Clock::getBestClock();
 
     // No SocketServer is passed to the RootObject (RTIA use case)
 	// socket server are passed to RootObject iff we are in RTIG.
     rootObject = new RootObject(NULL);
 
-    comm   = new Communications(RTIA_port, RTIA_fd);
+    comm   = new Communications(RTIA_port, RTIA_fd, RTIA_shm, RTIA_link);
     queues = new Queues ;
     fm     = new FederationManagement(comm,&stat);
     om     = new ObjectManagement(comm, fm, rootObject);
@@ -52,8 +55,9 @@ RTIA::RTIA(int RTIA_port, int RTIA_fd) {
     fm->tm     = tm ;
     queues->fm = fm ;
     queues->dm = dm ;
+    queues->rootObject = rootObject ;
     om->tm     = tm ;
-} /* end of RTIA(int RTIA_port, int RTIA_fd) */
+} /* end of RTIA(int RTIA_port, int RTIA_fd, int RTIA_shm, LocalLink *RTIA_link) */
 
 
 RTIA::~RTIA() {
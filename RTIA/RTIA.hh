@@ -45,7 +45,8 @@ namespace rtia {
  * to communication to/from the RTI.
  * In current CERTI implementation RTIA is a seperate process
  * which is created (forked) when the RTIambassador's federate
- * constructor is called.
+ * constructor is called, or a thread of the federate process
+ * when CERTI_RTIA_THREAD is set (see RTIAThread).
  * RTIA is a reactive process which process Message from federate
  * and NetworkMessage from RTIG.
  */
@@ -56,8 +57,11 @@ public:
 	 * RTIA constructor.
 	 * @param[in] RTIA_port the TCP port used
 	 * @param[in] RTIA_fd the file descriptor
+	 * @param[in] RTIA_shm the shared memory segment of the link, or -1
+	 * @param[in] RTIA_link the in-memory link of an RTIA running in the
+	 *            federate process (see RTIAThread), or NULL
 	 */
-    RTIA(int RTIA_port, int RTIA_fd);
+    RTIA(int RTIA_port, int RTIA_fd, int RTIA_shm, LocalLink *RTIA_link = NULL);
 
     /**
      * RTIA destructor.
@@ -123,8 +127,16 @@ private:
 
     /**
      * RTIA processes the TICK_REQUEST.
+     * With CERTI_TICK_BATCH, the callbacks evoked by one call are sent
+     * to the federate in a single transfer.
      */
     void processOngoingTick();
+
+    /**
+     * Evoke the callbacks of the ongoing tick until the federate has to
+     * answer, at most tm->_tick_batch of them.
+     */
+    void evokeCallbacks();
 };
 
 }} // namespace certi
@@ -0,0 +1,135 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include <config.h>
+#include "RTIAThread.hh"
+#include "RTIA.hh"
+#include "LocalLink.hh"
+#include "PrettyDebug.hh"
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+
+namespace certi {
+namespace rtia {
+
+static PrettyDebug D("RTIA_THREAD", "(RTIA thread) ");
+
+// ----------------------------------------------------------------------------
+bool
+RTIAThread::isRequested()
+{
+    const char *env = getenv("CERTI_RTIA_THREAD");
+    return env != NULL && atoi(env) > 0 ;
+}
+
+// ----------------------------------------------------------------------------
+RTIAThread *
+RTIAThread::start(SocketUN &federate, int fd)
+{
+    LocalLink *link = federate.createLocalLink();
+    if (link == NULL) {
+        close(fd);
+        return NULL ;
+    }
+    RTIAThread *rtia = new RTIAThread(fd, link);
+
+    // Signals are for the federate: an RTIA writing to a closed RTIG link
+    // gets EPIPE instead of SIGPIPE, as the rtia executable does.
+    sigset_t blocked, previous ;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+    int error = pthread_create(&rtia->thread, NULL, run, rtia);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (error != 0) {
+        D.Out(pdError, "Cannot start the RTIA thread.");
+        delete link ;
+        close(fd);
+        rtia->fd = -1 ;
+        delete rtia ;
+        return NULL ;
+    }
+    D.Out(pdInit, "RTIA started in the federate process.");
+    return rtia ;
+}
+
+// ----------------------------------------------------------------------------
+RTIAThread::RTIAThread(int socket, LocalLink *side)
+    : fd(socket), link(side)
+{
+}
+
+// ----------------------------------------------------------------------------
+RTIAThread::~RTIAThread()
+{
+    if (fd != -1)
+        pthread_join(thread, NULL);
+}
+
+// ----------------------------------------------------------------------------
+void *
+RTIAThread::run(void *arg)
+{
+    static_cast<RTIAThread *>(arg)->execute();
+    return NULL ;
+}
+
+// ----------------------------------------------------------------------------
+//! Same life cycle as the rtia executable, the socket of the federate
+//! being closed if the RTIA cannot be created.
+void
+RTIAThread::execute()
+{
+    RTIA *rtia ;
+    try {
+        rtia = new RTIA(-1, fd, -1, link);
+    }
+    catch (Exception &e) {
+        std::cerr << "RTIA:: RTIA has thrown " << e._name << " exception." << std::endl ;
+        if (!e._reason.empty())
+            std::cerr << "RTIA:: Reason: " << e._reason << std::endl ;
+        close(fd);
+        return ;
+    }
+
+    try {
+        rtia->execute();
+    }
+    catch (Exception &e) {
+        std::cerr << "RTIA:: RTIA has thrown " << e._name << " exception." << std::endl ;
+        if (!e._reason.empty())
+            std::cerr << "RTIA:: Reason: " << e._reason << std::endl ;
+    }
+    rtia->displayStatistics();
+
+    try {
+        delete rtia ;
+    }
+    catch (Exception &e) {
+        D.Out(pdExcept, "RTIA termination has thrown %s.", e._name);
+    }
+    D.Out(pdTerm, "RTIA thread ends.");
+}
+
+}} // namespace certi/rtia
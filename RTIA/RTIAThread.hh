@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef _CERTI_RTIA_THREAD_HH
+#define _CERTI_RTIA_THREAD_HH
+
+#include "SocketUN.hh"
+
+#include <pthread.h>
+
+namespace certi {
+namespace rtia {
+
+/**
+ * An RTIA running on a thread of the federate process.
+ *
+ * The libRTI starts it instead of forking the rtia executable when the
+ * federate asks for it at the creation of its ambassador, or else when
+ * CERTI_RTIA_THREAD is set. The federate and the RTIA then exchange the
+ * message objects through an in-memory link (see LocalLink) instead of
+ * serializing them; the socketpair of the link only carries the wake ups,
+ * and tells each side when the other is gone.
+ */
+class RTIAThread
+{
+public:
+    /** Return true if CERTI_RTIA_THREAD asks for the RTIA to run in the
+     *  federate process. */
+    static bool isRequested();
+
+    /**
+     * Start an RTIA on the given end of the socketpair of the federate.
+     * The in-memory link is created on the socket of the federate.
+     * @return the started RTIA, NULL on error (the end is then closed)
+     */
+    static RTIAThread *start(SocketUN &federate, int fd);
+
+    /**
+     * Wait for the end of the RTIA, which the CLOSE_CONNEXION of the
+     * federate or the closing of its socket triggers.
+     */
+    ~RTIAThread();
+
+private:
+    RTIAThread(int socket, LocalLink *side);
+
+    static void *run(void *arg);
+    void execute();
+
+    pthread_t thread ;
+    int fd ;
+    LocalLink *link ;
+};
+
+}} // namespace certi/rtia
+
+#endif // _CERTI_RTIA_THREAD_HH
@@ -30,6 +30,7 @@ const char *gengetopt_args_info_help[] = {
   "  -h, --help           Print help and exit",
   "  -V, --version        Print version and exit",
   "  -f, --fd=INT         file descriptor number to be used to communicate with \n                         FederateAmbassador",
+  "  -s, --shm=INT        file descriptor of the shared memory segment carrying \n                         the FederateAmbassador link",
   "  -p, --port=INT       tcp port to be used to communicate with \n                         FederateAmbassador",
   "  -v, --verbose=SHORT  verbose mode",
     0
@@ -59,6 +60,7 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->help_given = 0 ;
   args_info->version_given = 0 ;
   args_info->fd_given = 0 ;
+  args_info->shm_given = 0 ;
   args_info->port_given = 0 ;
   args_info->verbose_given = 0 ;
 }
@@ -67,6 +69,7 @@ static
 void clear_args (struct gengetopt_args_info *args_info)
 {
   args_info->fd_orig = NULL;
+  args_info->shm_orig = NULL;
   args_info->port_orig = NULL;
   args_info->verbose_orig = NULL;
   
@@ -80,8 +83,9 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->help_help = gengetopt_args_info_help[0] ;
   args_info->version_help = gengetopt_args_info_help[1] ;
   args_info->fd_help = gengetopt_args_info_help[2] ;
-  args_info->port_help = gengetopt_args_info_help[3] ;
-  args_info->verbose_help = gengetopt_args_info_help[4] ;
+  args_info->shm_help = gengetopt_args_info_help[3] ;
+  args_info->port_help = gengetopt_args_info_help[4] ;
+  args_info->verbose_help = gengetopt_args_info_help[5] ;
   
 }
 
@@ -161,6 +165,7 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
 {
 
   free_string_field (&(args_info->fd_orig));
+  free_string_field (&(args_info->shm_orig));
   free_string_field (&(args_info->port_orig));
   free_string_field (&(args_info->verbose_orig));
   
@@ -198,6 +203,8 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "version", 0, 0 );
   if (args_info->fd_given)
     write_into_file(outfile, "fd", args_info->fd_orig, 0);
+  if (args_info->shm_given)
+    write_into_file(outfile, "shm", args_info->shm_orig, 0);
   if (args_info->port_given)
     write_into_file(outfile, "port", args_info->port_orig, 0);
   if (args_info->verbose_given)
@@ -1067,6 +1074,7 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
         { "help",	0, NULL, 'h' },
         { "version",	0, NULL, 'V' },
         { "fd",	1, NULL, 'f' },
+        { "shm",	1, NULL, 's' },
         { "port",	1, NULL, 'p' },
         { "verbose",	1, NULL, 'v' },
         { NULL,	0, NULL, 0 }
@@ -1077,7 +1085,7 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
       custom_opterr = opterr;
       custom_optopt = optopt;
 
-      c = custom_getopt_long (argc, argv, "hVf:p:v:", long_options, &option_index);
+      c = custom_getopt_long (argc, argv, "hVf:s:p:v:", long_options, &option_index);
 
       optarg = custom_optarg;
       optind = custom_optind;
@@ -1109,6 +1117,18 @@ cmdline_parser_internal (int argc, char * const *argv, struct gengetopt_args_inf
               additional_error))
             goto failure;
         
+          break;
+        case 's':	/* file descriptor of the shared memory segment carrying the FederateAmbassador link.  */
+        
+        
+          if (update_arg( (void *)&(args_info->shm_arg), 
+               &(args_info->shm_orig), &(args_info->shm_given),
+              &(local_args_info.shm_given), optarg, 0, 0, ARG_INT,
+              check_ambiguity, override, 0, 0,
+              "shm", 's',
+              additional_error))
+            goto failure;
+        
           break;
         case 'p':	/* tcp port to be used to communicate with FederateAmbassador.  */
         
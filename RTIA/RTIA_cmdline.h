@@ -37,6 +37,9 @@ struct gengetopt_args_info
   int fd_arg;	/**< @brief file descriptor number to be used to communicate with FederateAmbassador.  */
   char * fd_orig;	/**< @brief file descriptor number to be used to communicate with FederateAmbassador original value given at command line.  */
   const char *fd_help; /**< @brief file descriptor number to be used to communicate with FederateAmbassador help description.  */
+  int shm_arg;	/**< @brief file descriptor of the shared memory segment carrying the FederateAmbassador link.  */
+  char * shm_orig;	/**< @brief file descriptor of the shared memory segment carrying the FederateAmbassador link original value given at command line.  */
+  const char *shm_help; /**< @brief file descriptor of the shared memory segment carrying the FederateAmbassador link help description.  */
   int port_arg;	/**< @brief tcp port to be used to communicate with FederateAmbassador.  */
   char * port_orig;	/**< @brief tcp port to be used to communicate with FederateAmbassador original value given at command line.  */
   const char *port_help; /**< @brief tcp port to be used to communicate with FederateAmbassador help description.  */
@@ -47,6 +50,7 @@ struct gengetopt_args_info
   unsigned int help_given ;	/**< @brief Whether help was given.  */
   unsigned int version_given ;	/**< @brief Whether version was given.  */
   unsigned int fd_given ;	/**< @brief Whether fd was given.  */
+  unsigned int shm_given ;	/**< @brief Whether shm was given.  */
   unsigned int port_given ;	/**< @brief Whether port was given.  */
   unsigned int verbose_given ;	/**< @brief Whether verbose was given.  */
 
@@ -28,6 +28,7 @@
 #include "RoutingSpace.hh"
 #include "XmlParser.hh"
 #include "M_Classes.hh"
+#include "MessagePool.hh"
 
 #include <assert.h>
 #include <memory>
@@ -615,6 +616,7 @@ RTIA::chooseFederateProcessing(Message *req, Message* rep, TypeException &e)
 				"type unconditionalAttributeOwnershipDivestiture.");
 		D.Out(pdTrace, "Object %u number of attributes %u ",
 				UAODq->getObject(), UAODq->getAttributesSize());
+		om->stopDirectUpdates(UAODq->getObject());
 		owm->unconditionalAttributeOwnershipDivestiture(UAODq->getObject(),
 				UAODq->getAttributes(),
 				UAODq->getAttributesSize(),
@@ -629,6 +631,7 @@ RTIA::chooseFederateProcessing(Message *req, Message* rep, TypeException &e)
 				"type negotiatedAttributeOwnershipDivestiture.");
 		D.Out(pdTrace, "Object %u ; %u nb Attribute ", NAODq->getObject(),
 				NAODq->getAttributesSize());
+		om->stopDirectUpdates(NAODq->getObject());
 		owm->negotiatedAttributeOwnershipDivestiture(NAODq->getObject(),
 				NAODq->getAttributes(),
 				NAODq->getAttributesSize(),
@@ -662,6 +665,7 @@ RTIA::chooseFederateProcessing(Message *req, Message* rep, TypeException &e)
 		D.Out(pdTrace, "Object %u nb Attribute %u ",
 				AORRq->getObject(), AORRq->getAttributesSize());
 
+		om->stopDirectUpdates(AORRq->getObject());
 		AttributeHandleSet* theAttributes =
 				owm->attributeOwnershipRealeaseResponse(AORRq->getObject(),
 						AORRq->getAttributes(),
@@ -1307,6 +1311,22 @@ RTIA::chooseFederateProcessing(Message *req, Message* rep, TypeException &e)
 
 void
 RTIA::processOngoingTick() {
+	if (tm->_tick_batch > 1)
+		comm->batchFederateServices();
+
+	try {
+		evokeCallbacks();
+	}
+	catch (...) {
+		/* the batched callbacks are no longer in the queues */
+		comm->flushFederateServices();
+		throw;
+	}
+	comm->flushFederateServices();
+} /* RTIA::processOngoingTick() */
+
+void
+RTIA::evokeCallbacks() {
 	TypeException exc = e_NO_EXCEPTION;
 
 	while (1) {
@@ -1332,11 +1352,18 @@ RTIA::processOngoingTick() {
 
 
 			    tm->_tick_state = TimeManagement::TICK_CALLBACK;
+			    /* keep filling the batch */
+			    if (tm->_tick_batch > 1 &&
+			        comm->getBatchedFederateServices() < tm->_tick_batch)
+			        break;
 			}
 			else {
 				tm->_tick_state = TimeManagement::TICK_RETURN;
+				/* end the batch with the TICK_REQUEST response */
+				if (tm->_tick_batch > 1)
+				    break;
 			}
-            /* Unconditional return */
+            /* wait for TICK_REQUEST_NEXT */
 			return;
 
 		case TimeManagement::TICK_CALLBACK:
@@ -1372,7 +1399,7 @@ RTIA::processOngoingTick() {
 			break;
 		}
 	}
-} /* RTIA::processOngoingTick() */
+} /* RTIA::evokeCallbacks() */
 
 void
 RTIA::initFederateProcessing(Message *req, Message* rep)
@@ -1387,6 +1414,9 @@ RTIA::initFederateProcessing(Message *req, Message* rep)
                     ? OCq->getVersionMinor() : CERTI_Message::versionMinor;
             OCr->setVersionMajor(CERTI_Message::versionMajor);
             OCr->setVersionMinor(minorEffective);
+            // Callback batches came with protocol 1.1
+            if (minorEffective < 1)
+                tm->_tick_batch = 1;
 
             fm->_connection_state = FederationManagement::CONNECTION_READY;
         }
@@ -1770,7 +1800,7 @@ RTIA::processFederateRequest(Message *req)
 		rep->setException(e_RTIinternalError);
 	}
 
-	delete req;
+	MessagePool::release(req);
 
 	if (rep->getMessageType() != Message::TICK_REQUEST &&
 		rep->getMessageType() != Message::TICK_REQUEST_NEXT &&
@@ -23,6 +23,7 @@
 
 #include <config.h>
 #include "NM_Classes.hh"
+#include "MessagePool.hh"
 #include "RTIA.hh"
 #include "ObjectClassAttribute.hh"
 #include "Interaction.hh"
@@ -60,7 +61,7 @@ NetworkMessage::Type msgType = msg->getMessageType();
           DNULL.Out(pdDebug, "NULL message received (Federate=%d, Time = %f)",
                             msg->getFederate(), msg->getDate().getTime()) ;
           tm->update(msg->getFederate(), msg->getDate());
-          delete msg ;
+          MessagePool::release(msg);
           break ;
       }
 
@@ -74,7 +75,7 @@ NetworkMessage::Type msgType = msg->getMessageType();
               tm->insert(msg->getFederate(), msg->getDate());
           else
               tm->remove(msg->getFederate());
-          delete msg ;
+          MessagePool::release(msg);
           break ;
       }
 
@@ -119,6 +120,11 @@ NetworkMessage::Type msgType = msg->getMessageType();
           	catch (ObjectAlreadyRegistered&) {
           	}
 
+          	// The reflections of a peer which overtook the discovery.
+          	std::vector<NetworkMessage *> held ;
+          	om->releaseReflections(DO->getObject(), held);
+          	for (uint32_t i = 0 ; i < held.size() ; ++i)
+          		processNetworkMessage(held[i]);
       }
       break;
 
@@ -132,6 +138,10 @@ NetworkMessage::Type msgType = msg->getMessageType();
                 "Receiving Message from RTIG, "
                 "type NetworkMessage::REFLECT_ATTRIBUTE_VALUES.");
 
+          // From a direct link, before the discovery of its object.
+          if (om->holdReflection(RAV))
+              break ;
+
          // It is important to note that several attributes may be updated at
          // the same time. Each attribute has its own order type, region, etc.
          // So attributes which are meeting similar criteria should be sent
@@ -174,6 +184,14 @@ NetworkMessage::Type msgType = msg->getMessageType();
             // Update is TSO
             queues->insertTsoMessage(msg);
          }
+         else if (queues->conflates())
+         {
+            // Update is RO, its values may replace queued ones
+            uint32_t values = RAV->getAttributesSize();
+            uint32_t replaced = queues->insertFifoReflection(RAV);
+            if (replaced > 0)
+                stat.conflatedReflection(replaced, replaced == values);
+         }
          else
          {
             // Update is RO
@@ -225,6 +243,9 @@ NetworkMessage::Type msgType = msg->getMessageType();
           D.Out(pdTrace, "Receving Message from RTIG, \
 	  		  type NetworkMessage::REMOVE_OBJECT.");
 
+          // What its owner sent over a direct link is of no use any more.
+          om->forgetReflections(static_cast<NM_Remove_Object *>(msg)->getObject());
+
           if (tm->requestContraintState() && msg->isDated()) {
               // Verify that received TSO timestamp is >= current
               // time + lookahead
@@ -398,12 +419,49 @@ NetworkMessage::Type msgType = msg->getMessageType();
     			  " type reserveObjectInstanceNameFaild.");
     	  queues->insertLastCommand(msg);
 	  break;
+
+      case NetworkMessage::UPDATE_ATTRIBUTE_VALUES:
+      case NetworkMessage::SEND_INTERACTION:
+          D.Out(pdTrace, "Receiving Message from RTIG, "
+                "answer to an asynchronous %s.", msg->getMessageName());
+          om->acknowledgeUpdate(msg);
+          break;
+
+      case NetworkMessage::DATA_PEER:
+      {
+          NM_Data_Peer *peer = static_cast<NM_Data_Peer *>(msg);
+          D.Out(pdTrace, "Receiving Message from RTIG, type DataPeer "
+                "(federate %u, port %u).", peer->getFederate(), peer->getPort());
+          if (peer->getFederate() == fm->federate) {
+              // The link of this federate ends the routes sent on join.
+              om->setRoutesKnown();
+              MessagePool::release(msg);
+              break;
+          }
+          comm->setDataPeer(peer->getFederate(), peer->getAddress(), peer->getPort());
+          if (peer->getPort() == 0)
+              om->removeDataPeer(peer->getFederate());
+          MessagePool::release(msg);
+          break;
+      }
+
+      case NetworkMessage::OBJECT_CLASS_ROUTES:
+          D.Out(pdTrace, "Receiving Message from RTIG, type ObjectClassRoutes.");
+          om->setObjectClassRoutes(*static_cast<NM_Object_Class_Routes *>(msg));
+          MessagePool::release(msg);
+          break;
+
+      case NetworkMessage::INTERACTION_CLASS_ROUTES:
+          D.Out(pdTrace, "Receiving Message from RTIG, type InteractionClassRoutes.");
+          om->setInteractionClassRoutes(*static_cast<NM_Interaction_Class_Routes *>(msg));
+          MessagePool::release(msg);
+          break;
       	
       default:
       {
           D.Out(pdTrace,
                 "Receving Message from RTIG, unknown type %d.", msgType);
-          delete msg ;
+          MessagePool::release(msg);
           throw RTIinternalError(stringize() << "Unknown Message type <" << msgType << "> received from RTIG.");
       }
     }
@@ -50,6 +50,7 @@ vector<string> Statistics::rtiMessageName(NetworkMessage::LAST);
 Statistics::Statistics()
     : federateServiceSet(Message::LAST, 0),
       rtiServiceSet(NetworkMessage::LAST, 0),
+      conflatedValues(0), conflatedReflections(0),
       myDisplay(true), myDisplayZero(false)
 {
     if (getenv("CERTI_NO_STATISTICS"))
@@ -214,6 +215,7 @@ Statistics::Statistics()
 	FED_MSG_NAME(Message::TICK_REQUEST);
 	FED_MSG_NAME(Message::TICK_REQUEST_NEXT);
 	FED_MSG_NAME(Message::TICK_REQUEST_STOP);
+	FED_MSG_NAME(Message::TICK_CALLBACKS);
 
 	FED_MSG_NAME(Message::RESERVE_OBJECT_INSTANCE_NAME);
 	FED_MSG_NAME(Message::RESERVE_OBJECT_INSTANCE_NAME_SUCCEEDED);
@@ -333,6 +335,15 @@ Statistics::federateService(Message::Type service)
     federateServiceSet[service]++ ;
 }
 
+// ----------------------------------------------------------------------------
+void
+Statistics::conflatedReflection(uint32_t values, bool dropped)
+{
+    conflatedValues += values ;
+    if (dropped)
+        ++conflatedReflections ;
+}
+
 // ----------------------------------------------------------------------------
 //! Display collected data.
 ostream &
@@ -374,6 +385,10 @@ operator<<(ostream &s, Statistics &stat)
       << " Number of Federate messages : " << sentFederateMessages << endl
       << " Number of RTIG messages : " << sentRtiMessages << endl ;
 
+    if (stat.conflatedValues > 0 || stat.displayZero())
+        s << " Conflated attribute values : " << stat.conflatedValues << endl
+          << " Conflated reflections : " << stat.conflatedReflections << endl ;
+
     return s ;
 }
 
@@ -45,6 +45,11 @@ public:
 
     void rtiService(NetworkMessage::Type);
     void federateService(Message::Type);
+    /** Count the values a receive order reflection replaced in a queued
+        one, dropped if it had no other value. */
+    void conflatedReflection(uint32_t values, bool dropped);
+    unsigned long getConflatedValues() const { return conflatedValues ; }
+    unsigned long getConflatedReflections() const { return conflatedReflections ; }
     bool display() { return myDisplay ; };
     bool displayZero() { return myDisplayZero ; };
     
@@ -55,6 +60,10 @@ protected:
     std::vector<int> federateServiceSet ;
     //! Collects number of messages exchanged between RTIG and RTIA.
     std::vector<int> rtiServiceSet ;
+    //! Attribute values which replaced queued ones (CERTI_CONFLATE).
+    unsigned long conflatedValues ;
+    //! Reflections dropped, all of their values having replaced queued ones.
+    unsigned long conflatedReflections ;
     //! Names of Message messages
     static std::vector<std::string> fedMessageName ;
     //! Names of NetworkMessage-class messages
@@ -25,8 +25,10 @@
 #include "TimeManagement.hh"
 #include "NM_Classes.hh"
 #include "M_Classes.hh"
+#include "MessagePool.hh"
 
 #include <float.h>
+#include <cstdlib>
 
 namespace certi {
 namespace rtia {
@@ -87,8 +89,15 @@ TimeManagement::TimeManagement(Communications *GC,
 
     _avancee_en_cours = PAS_D_AVANCEE ;
     _tick_state = NO_TICK;
+    _tick_batch = 1 ;
     _asynchronous_delivery = false ;
 
+    const char *batch = getenv("CERTI_TICK_BATCH");
+    if (batch != NULL && atoi(batch) > 1) {
+        _tick_batch = atoi(batch);
+        D.Out(pdInit, "Callbacks sent by batches of at most %u.", _tick_batch);
+    }
+
     _heure_courante = 0.0 ;
     _lookahead_courant = 0.0 ;
     _is_regulating = false ;
@@ -502,7 +511,7 @@ TimeManagement::nextEventAdvance(bool &msg_restant, TypeException &e)
             	Debug(D,pdDebug) << "TM::nextEventAdvance - MSG :" << msg->getMessageName() << std::endl;
                 // Send message back to federate.
                 executeFederateService(*msg);
-                delete msg ;
+                MessagePool::release(msg);
             }
             else {
                 // Advance current time up to 'date_min'.
@@ -881,7 +890,7 @@ TimeManagement::tick(TypeException &e)
         }
     }
 
-    delete msg ;
+    MessagePool::release(msg);
 
     G.Out(pdGendoc," exit  TimeManagement::tick");
     return moreMsgToHandle;
@@ -930,7 +939,7 @@ TimeManagement::timeAdvance(bool &msg_restant, TypeException &e)
         }
         else {
             executeFederateService(*msg);
-            delete msg ;
+            MessagePool::release(msg);
         }
     }
     else {
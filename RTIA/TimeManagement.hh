@@ -145,6 +145,12 @@ public:
     TickTime _tick_timeout;
     TickTime _tick_max_tick;
     uint64_t _tick_clock_start;
+    /**
+     * Maximum number of callbacks sent to the federate in a single
+     * transfer (CERTI_TICK_BATCH), 1 meaning one callback per
+     * TICK_REQUEST_NEXT.
+     */
+    uint32_t _tick_batch;
     /**
      * Is asynchronous delivery enabled/disabled.
      */
@@ -53,13 +53,16 @@ void NewHandler() {
  *
  * The CERTI RunTime Infrastructure Ambassador (RTIA) is a process
  * which is automatically launched by the federate as soon as its
- * RTIambassador is created.
+ * RTIambassador is created, unless it runs on a thread of the federate
+ * (see CERTI_RTIA_THREAD in \ref certi_user_env).
  * The command line usage of the RTIA is following:
  * \par rtia [-v] [-p \<port\>]
  * \par
  * <ul>
  *   <li> \b -v  (optional) verbose, display more information </li>
  *   <li> \b -p  (optional) tcp port to be used to communicate with FederateAmbassador</li>
+ *   <li> \b -s  (optional) shared memory segment carrying the FederateAmbassador link
+ *        (see CERTI_SHM_LINK in \ref certi_user_env)</li>
  * </ul>
  * RTIA will try to connect to RTIG process on the machine specified in CERTI_HOME
  * (see \ref certi_user_env) environment variable. If it is void or not set then he will
@@ -92,8 +95,12 @@ main(int argc, char **argv) {
 		if (args.fd_given) {
 			rtia_fd = args.fd_arg;
 		}
+		int rtia_shm = -1;
+		if (args.shm_given) {
+			rtia_shm = args.shm_arg;
+		}
 
-		RTIA rtia(rtia_port, rtia_fd);
+		RTIA rtia(rtia_port, rtia_fd, rtia_shm);
 
 		PrettyDebug::setFederateName("RTIA::UnknownFederate");
 
@@ -37,7 +37,7 @@ Federate::Federate(const std::string& the_name, FederateHandle the_handle)
     throw (RTIinternalError)
     : handle(the_handle), name(the_name), regulator(false), constrained(false), usingNERx(false),
       cras(true), iras(true), aras(false), asas(false), 
-      saving(false), restoring(false)
+      dataAddress(0), dataPort(0), saving(false), restoring(false)
 {
     if (handle == 0)
         throw RTIinternalError("Bad initialization parameter for Federate.");
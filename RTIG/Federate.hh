@@ -112,6 +112,16 @@ public:
      */
     bool isAttributeScopeAdvisorySwitch() const { return asas ; };
 
+    /**
+     * Set the address the RTIA of the federate accepts direct links on,
+     * see Federation::setDataPeer.
+     * @param[in] address IPv4 address of the RTIA
+     * @param[in] port TCP port of the RTIA, 0 if it uses no direct link
+     */
+    void setDataPeer(unsigned long address, unsigned int port) { dataAddress = address ; dataPort = port ; };
+    unsigned long getDataAddress() const { return dataAddress ; };
+    unsigned int getDataPort() const { return dataPort ; };
+
     bool isSaving() const { return saving ; };
     bool isRestoring() const { return restoring ; };
     void setSaving(bool s) { saving = s ; };
@@ -156,6 +166,9 @@ private:
     typedef std::vector<std::string> SyncList ;
     SyncList syncLabels ; // List of labels to synchronize.
 
+    unsigned long dataAddress ; //!< Address of the direct links of the RTIA.
+    unsigned int dataPort ; //!< Port of the direct links of the RTIA, 0 if none.
+
     bool saving ; //!< True when saving has been initiated on federate.
     bool restoring ; //!< True when restoring has been initiated on federate.
 };
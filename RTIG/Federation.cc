@@ -40,6 +40,8 @@
 #include "ObjectClassAttribute.hh"
 #include "PrettyDebug.hh"
 #include "LBTS.hh"
+#include "WireBuffer.hh"
+#include "Snapshot.hh"
 #include "NM_Classes.hh"
 
 using std::pair ;
@@ -53,14 +55,9 @@ using std::cerr ;
 using std::vector ;
 
 // Definitions
-#ifdef HAVE_XML
-#include <libxml/xmlmemory.h>
-#include <libxml/parser.h>
-#include <libxml/tree.h>
-#define ROOT_NODE (const xmlChar*) "rtigSaveData"
-#define NODE_FEDERATION (const xmlChar*) "federation"
-#define NODE_FEDERATE (const xmlChar*) "federate"
-#endif // HAVE_XML
+namespace {
+const uint32_t FEDERATION_SECTION = 0x4644534e ; // "FDSN"
+}
 
 // Path splitting functions
 std::vector<std::string> &split(const std::string &s, char delim, std::vector<std::string> &elems) {
@@ -128,7 +125,7 @@ throw (CouldNotOpenFED, ErrorReadingFED, MemoryExhausted, SecurityError,
         RTIinternalError)
         : federateHandles(1), objectHandles(1), saveInProgress(false),
           restoreInProgress(false), saveStatus(true), restoreStatus(true),
-          verboseLevel(theVerboseLevel)
+          verboseLevel(theVerboseLevel), nbNERing(0)
 
 {
     STAT_STRUCT file_stat;
@@ -720,6 +717,12 @@ throw (FederateNotExecutionMember,
 
 	// It may throw RTIinternalError if Federate was not regulators.
 	regulators.insert(federate_handle, time);
+	if (federate.isUsingNERx()) {
+		NERxClocks.insert(federate_handle, federate.getLastNERxValue());
+		nbNERing++;
+	} else {
+		NERxClocks.insert(federate_handle, time);
+	}
 	federate.setRegulator(true);
 
 	D.Out(pdTerm, "Federation %d: Federate %d is now a regulator(Time=%f).",
@@ -748,6 +751,11 @@ throw (FederateNotExecutionMember) {
 	FederationTime newMin;
 	Federate& f = getFederate(federate);
 
+	if (f.isRegulator()) {
+		if (!f.isUsingNERx())
+			nbNERing++;
+		NERxClocks.set(federate, date);
+	}
 	f.setLastNERxValue(date);
 	Debug(D,pdDebug) << "Federate <"<<f.getName()<<"> has new NERx value="<<date.getTime() << std::endl;
 	newMin = computeMinNERx();
@@ -764,9 +772,12 @@ throw (FederateNotExecutionMember) {
 			if (i->second.isUsingNERx()) {
 				//i->second.setLastNERxValue(FedTime(0.0)); // not needed
 				i->second.setIsUsingNERx(false);
+				if (i->second.isRegulator())
+					NERxClocks.set(i->first, regulators.getClock(i->first));
 				Debug(D,pdDebug) << "Federate <" << i->second.getName() <<"> not NERing anymore." <<  std::endl;
 			}
 		}
+		nbNERing = 0;
 	}
 	return retval;
 } /* end of updateLastNERxForFederate */
@@ -774,32 +785,13 @@ throw (FederateNotExecutionMember) {
 FederationTime
 Federation::computeMinNERx() {
 	FederationTime retval;
-	uint32_t       nbFed;
-	LBTS           NER_regulators;
-	std::vector<LBTS::FederateClock> clocks;
-	retval.setZero();
-	nbFed = 0;
-	regulators.get(clocks);
-
-	/* Build a set of clocks */
-	for (std::vector<LBTS::FederateClock>::iterator it = clocks.begin(); it!=clocks.end(); ++it) {
-		FederateHandle h=it->first;
-		HandleFederateMap::iterator f = _handleFederateMap.find(h);
-		if (f->second.isUsingNERx()) {
-			nbFed++;
-			NER_regulators.insert(h,f->second.getLastNERxValue());
-		} else {
-			NER_regulators.insert(h,it->second);
-		}
-	}
 
-	/* compute the new NERx LBTS (minimum) */
-	NER_regulators.compute();
-	retval = NER_regulators.getLBTSValue();
+	/* NERxClocks is kept up to date by the regulators and NERx updates */
+	retval = NERxClocks.getLBTSValue();
 	Debug(D,pdDebug) << "MinNERx =" << retval.getTime() << std::endl;
 
 	/* the minimum is different from 0 iff more than 2 federate use NERx */
-	if (nbFed<2) {
+	if (nbNERing<2) {
 		retval.setZero();
 	}
 
@@ -812,18 +804,18 @@ Federation::broadcastAnyMessage(NetworkMessage *msg,
 		FederateHandle except_federate, bool anonymous)
 {
 	Socket *socket = NULL ;
+	WireBuffer wire ;
 
 	// Broadcast the message 'msg' to all Federates in the Federation
 	// except to Federate whose Handle is 'Except_Federate'.
+	// The message is encoded once, on the first recipient.
 	for (HandleFederateMap::iterator i = _handleFederateMap.begin(); i != _handleFederateMap.end(); ++i) {
 		if (anonymous || (i->first != except_federate)) {
 			try {
-#ifdef HLA_USES_UDP
-				socket = server->getSocketLink(i->second.getHandle(), BEST_EFFORT);
-#else
 				socket = server->getSocketLink(i->second.getHandle());
-#endif
-				msg->send(socket,NM_msgBufSend);
+				if (wire.empty())
+					wire = WireBuffer(*msg);
+				wire.send(socket);
 			}
 			catch (RTIinternalError &e) {
 				Debug(D, pdExcept) << "Reference to a killed Federate while "
@@ -848,6 +840,7 @@ Federation::broadcastSomeMessage(NetworkMessage *msg,
 {
 	uint32_t ifed ;
 	Socket *socket = NULL ;
+	WireBuffer wire ;
 
 	if ( fede_array.size() != 0 || nbfed == 0)
 	{
@@ -866,12 +859,10 @@ Federation::broadcastSomeMessage(NetworkMessage *msg,
 						{
 						try
 						{
-#ifdef HLA_USES_UDP
-							socket = server->getSocketLink(i->second.getHandle(), BEST_EFFORT);
-#else
 							socket = server->getSocketLink(i->second.getHandle());
-#endif
-							msg->send(socket,NM_msgBufSend);
+							if (wire.empty())
+								wire = WireBuffer(*msg);
+							wire.send(socket);
 						}
 						catch (RTIinternalError &e)
 						{
@@ -898,7 +889,7 @@ void
 Federation::broadcastInteraction(FederateHandle federate_handle,
         InteractionClassHandle interaction,
         const std::vector <ParameterHandle> &parameter_handles,
-        const std::vector <ParameterValue_t> &parameter_values,
+        const ValueArena &parameter_values,
         uint16_t list_size,
         FederationTime time,
         RegionHandle region_handle,
@@ -942,7 +933,7 @@ void
 Federation::broadcastInteraction(FederateHandle federate_handle,
         InteractionClassHandle interaction,
         const std::vector <ParameterHandle> &parameter_handles,
-        const std::vector <ParameterValue_t> &parameter_values,
+        const ValueArena &parameter_values,
         uint16_t list_size,
         RegionHandle region_handle,
         const std::string& tag)
@@ -977,7 +968,7 @@ throw (FederateNotExecutionMember,
         D.Out(pdRequest,
                 " Param %d Value %s",
                 parameter_handles[i],
-                string(&(parameter_values[i][0]), parameter_values[i].size()).c_str());
+                string(parameter_values.data(i), parameter_values.length(i)).c_str());
 
     G.Out(pdGendoc,"exit Federation::broadcastInteraction without time");
 
@@ -1312,7 +1303,7 @@ throw (FederateNotExecutionMember)
 
 	// Save RTIG Data for future restoration.
 	if (saveStatus) {
-		saveStatus = saveXmlData();
+		saveStatus = saveSnapshot();
 	}
 
 	// Send end save message.
@@ -1353,17 +1344,7 @@ throw (FederateNotExecutionMember)
 
 
 	// Informs sending federate of success/failure in restoring.
-	// At this point, only verify that file is present.
-	bool success = true ;
-#ifdef HAVE_XML
-	string filename = name + "_" + the_label + ".xcs" ;
-	success = restoreXmlData(filename);
-#else
-	success = false ;
-#endif // HAVE_XML
-
-	// JYR Note : forcing success to true to skip xmlParseFile (not compliant ?)
-	success = true ;
+	bool success = restoreSnapshot(the_label);
 
 	if (success) {
 		msg = NM_Factory::create(NetworkMessage::REQUEST_FEDERATION_RESTORE_SUCCEEDED);
@@ -1590,6 +1571,55 @@ throw (InteractionClassNotDefined,
 			handle, federate, interaction);
 		}
 
+// ----------------------------------------------------------------------------
+// changeAttributeTransportationType
+
+void
+Federation::changeAttributeTransportationType(FederateHandle federate,
+		ObjectHandle objectHandle,
+		const std::vector <AttributeHandle> &attribs,
+		TransportType type)
+throw (FederateNotExecutionMember,
+		ObjectNotKnown,
+		AttributeNotDefined,
+		AttributeNotOwned,
+		InvalidTransportationHandle,
+		SaveInProgress,
+		RestoreInProgress,
+		RTIinternalError)
+		{
+	// It may throw FederateNotExecutionMember.
+	this->check(federate);
+
+	// It may throw ObjectNotKnown, AttributeNotDefined, AttributeNotOwned.
+	root->objects->changeAttributeTransportationType(federate, objectHandle, attribs, type);
+		}
+
+// ----------------------------------------------------------------------------
+// changeInteractionTransportationType
+
+void
+Federation::changeInteractionTransportationType(FederateHandle federate,
+		InteractionClassHandle interaction,
+		TransportType type)
+throw (FederateNotExecutionMember,
+		InteractionClassNotDefined,
+		FederateNotPublishing,
+		InvalidTransportationHandle,
+		SaveInProgress,
+		RestoreInProgress,
+		RTIinternalError)
+		{
+	// It may throw FederateNotExecutionMember.
+	this->check(federate);
+
+	// It may throw InteractionClassNotDefined
+	root->Interactions->getObjectFromHandle(interaction)->changeTransportationType(type, federate);
+	D.Out(pdRequest,
+			"Federation %d: Federate %d changed the transport of Interaction %d to %d.",
+			handle, federate, interaction, type);
+		}
+
 // ----------------------------------------------------------------------------
 // publishObject
 
@@ -1789,6 +1819,14 @@ throw (FederateOwnsAttributes, FederateNotExecutionMember)
 		federateHandles.free(federate_handle);
 		_handleFederateMap.erase(i);
 
+		// The direct links stop routing to the federate.
+		NM_Data_Peer peer ;
+		peer.setFederation(handle);
+		peer.setFederate(federate_handle);
+		peer.setAddress(0);
+		peer.setPort(0);
+		sendToDataPeers(&peer, 0);
+
 		D.Out(pdInit, "Federation %d: Removed Federate %d.", handle,
 				federate_handle);
 		return;
@@ -1799,6 +1837,134 @@ throw (FederateOwnsAttributes, FederateNotExecutionMember)
 	throw FederateNotExecutionMember(certi::stringize() << "Federate Handle=<"<<federate_handle <<">");
 }
 
+// ----------------------------------------------------------------------------
+void
+Federation::setDataPeer(FederateHandle federate_handle, unsigned long address,
+		unsigned int port)
+throw (FederateNotExecutionMember)
+{
+	Federate &federate = getFederate(federate_handle);
+	federate.setDataPeer(address, port);
+	if (port == 0)
+		return ;
+
+	D.Out(pdInit, "Federate %d accepts direct links on port %u.", federate_handle, port);
+
+	NM_Data_Peer peer ;
+	peer.setFederation(handle);
+	peer.setFederate(federate_handle);
+	peer.setAddress(address);
+	peer.setPort(port);
+	sendToDataPeers(&peer, federate_handle);
+
+	// The newcomer gets the other RTIAs and the current routes.
+	Socket *socket = server->getSocketLink(federate_handle);
+	for (HandleFederateMap::iterator i = _handleFederateMap.begin(); i != _handleFederateMap.end(); ++i) {
+		if (i->first == federate_handle || i->second.getDataPort() == 0)
+			continue ;
+		peer.setFederate(i->first);
+		peer.setAddress(i->second.getDataAddress());
+		peer.setPort(i->second.getDataPort());
+		peer.send(socket, NM_msgBufSend);
+	}
+
+	NM_Object_Class_Routes objectRoutes ;
+	objectRoutes.setFederation(handle);
+	ObjectClassSet::handled_const_iterator c ;
+	for (c = root->ObjectClasses->handled_begin(); c != root->ObjectClasses->handled_end(); ++c) {
+		c->second->getRoutes(objectRoutes);
+		if (objectRoutes.getAttributesSize() > 0)
+			objectRoutes.send(socket, NM_msgBufSend);
+	}
+
+	NM_Interaction_Class_Routes interactionRoutes ;
+	interactionRoutes.setFederation(handle);
+	InteractionSet::handled_const_iterator i ;
+	for (i = root->Interactions->handled_begin(); i != root->Interactions->handled_end(); ++i) {
+		if (i->second->getSubscribers().empty())
+			continue ;
+		i->second->getRoutes(interactionRoutes);
+		interactionRoutes.send(socket, NM_msgBufSend);
+	}
+
+	// Its own direct link tells the newcomer it has every route, and may
+	// stop sending through the RTIG.
+	peer.setFederate(federate_handle);
+	peer.setAddress(address);
+	peer.setPort(port);
+	peer.send(socket, NM_msgBufSend);
+}
+
+// ----------------------------------------------------------------------------
+bool
+Federation::hasDataPeers() const
+{
+	for (HandleFederateMap::const_iterator i = _handleFederateMap.begin(); i != _handleFederateMap.end(); ++i) {
+		if (i->second.getDataPort() != 0)
+			return true ;
+	}
+	return false ;
+}
+
+// ----------------------------------------------------------------------------
+void
+Federation::sendToDataPeers(NetworkMessage *msg, FederateHandle except)
+{
+	WireBuffer wire ;
+	for (HandleFederateMap::iterator i = _handleFederateMap.begin(); i != _handleFederateMap.end(); ++i) {
+		if (i->first == except || i->second.getDataPort() == 0)
+			continue ;
+		try {
+			Socket *socket = server->getSocketLink(i->first);
+			if (wire.empty())
+				wire = WireBuffer(*msg);
+			wire.send(socket);
+		}
+		catch (RTIinternalError &e) {
+			Debug(D, pdExcept) << "Reference to a killed Federate while "
+					<< "sending to the direct links." << endl ;
+		}
+		catch (NetworkError &e) {
+			D.Out(pdExcept, "Network error while sending to the direct links, ignoring.");
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+Federation::sendObjectClassRoutes(ObjectClassHandle class_handle)
+{
+	if (!hasDataPeers())
+		return ;
+
+	std::vector<ObjectClass *> classes(1, root->ObjectClasses->getObjectFromHandle(class_handle));
+	NM_Object_Class_Routes msg ;
+	msg.setFederation(handle);
+	while (!classes.empty()) {
+		ObjectClass *objectClass = classes.back();
+		classes.pop_back();
+		objectClass->getRoutes(msg);
+		sendToDataPeers(&msg, 0);
+
+		ObjectClassSet *subClasses = objectClass->getSubClasses();
+		for (ObjectClassSet::const_iterator i = subClasses->begin(); i != subClasses->end(); ++i)
+			classes.push_back(i->second);
+	}
+}
+
+// ----------------------------------------------------------------------------
+void
+Federation::sendInteractionClassRoutes(InteractionClassHandle class_handle)
+{
+	if (!hasDataPeers())
+		return ;
+
+	NM_Interaction_Class_Routes msg ;
+	msg.setFederation(handle);
+	root->Interactions->getObjectFromHandle(class_handle)->getRoutes(msg);
+	sendToDataPeers(&msg, 0);
+}
+
 // ----------------------------------------------------------------------------
 //! Set Federate's IsConstrained to false.
 void
@@ -1835,6 +2001,9 @@ throw (FederateNotExecutionMember,
 
 	// It may throw RTIinternalError if Federate was not regulators.
 	regulators.remove(federate_handle);
+	NERxClocks.remove(federate_handle);
+	if (federate.isUsingNERx())
+		nbNERing--;
 
 	federate.setRegulator(false);
 
@@ -1920,6 +2089,7 @@ throw (InteractionClassNotDefined,
 
 	// It may throw *NotDefined
 	root->Interactions->subscribe(federate, interaction, 0, sub);
+	sendInteractionClassRoutes(interaction);
 	D.Out(pdRegister,
 			"Federation %d: Federate %d(un)subscribes to Interaction %d.",
 			handle, federate, interaction);
@@ -1954,6 +2124,7 @@ throw (ObjectClassNotDefined,
 
     // It may throw AttributeNotDefined
     root->ObjectClasses->subscribe(federate, object, attributes);
+    sendObjectClassRoutes(object);
 
     /*
      * The above code line (root->ObjectClasses->subscribe(...) calls the
@@ -2048,7 +2219,7 @@ void
 Federation::updateAttributeValues(FederateHandle federate,
 		ObjectHandle objectHandle,
 		const std::vector <AttributeHandle>  &attributes,
-		const std::vector <AttributeValue_t> &values,
+		const ValueArena &values,
 		uint16_t list_size,
 		FederationTime time,
 		const std::string& tag)
@@ -2083,7 +2254,7 @@ void
 Federation::updateAttributeValues(FederateHandle federate,
 		ObjectHandle objectHandle,
 		const std::vector <AttributeHandle> &attributes,
-		const std::vector <AttributeValue_t> &values,
+		const ValueArena &values,
 		uint16_t list_size,
 		const std::string& tag)
 throw (FederateNotExecutionMember,
@@ -2133,6 +2304,8 @@ throw (FederateNotExecutionMember,
 		D.Out(pdDebug, "Federation %d: Federate %d's new time is %f.",
 				handle, federate_handle, time.getTime());
 		regulators.update(federate_handle, time);
+		if (!federate.isUsingNERx())
+			NERxClocks.update(federate_handle, time);
 	}
 
 	NM_Message_Null msg ;
@@ -2490,6 +2663,7 @@ throw (RegionNotKnown,
 		{
 	check(federate);
 	root->ObjectClasses->subscribe(federate, c, attributes, root->getRegion(region_handle));
+	sendObjectClassRoutes(c);
 		}
 
 // ----------------------------------------------------------------------------
@@ -2508,6 +2682,7 @@ throw (RegionNotKnown,
 	RTIRegion *region = root->getRegion(region_handle);
 
 	root->getObjectClass(object_class)->unsubscribe(federate, region);
+	sendObjectClassRoutes(object_class);
 		}
 
 // ----------------------------------------------------------------------------
@@ -2525,6 +2700,7 @@ throw (RegionNotKnown,
 	RTIRegion *region = root->getRegion(region_handle);
 
 	root->getInteractionClass(interaction)->subscribe(federate, region);
+	sendInteractionClassRoutes(interaction);
 		}
 
 // ----------------------------------------------------------------------------
@@ -2542,6 +2718,7 @@ throw (RegionNotKnown,
 	RTIRegion *region = root->getRegion(region_handle);
 
 	root->getInteractionClass(interaction)->unsubscribe(federate, region);
+	sendInteractionClassRoutes(interaction);
 		}
 
 // ----------------------------------------------------------------------------
@@ -2594,128 +2771,160 @@ throw (ObjectClassNotDefined, ObjectClassNotPublished,
 		}
 
 // ----------------------------------------------------------------------------
-bool
-Federation::restoreXmlData(std::string docFilename)
+string
+Federation::getSnapshotName(const string &label) const
 {
-#ifndef HAVE_XML
-	return false ;
-#else
+	return name + "_" + label + ".snp" ;
+}
 
-    xmlDocPtr doc = xmlParseFile(docFilename.c_str());
+// ----------------------------------------------------------------------------
+bool
+Federation::restoreSnapshot(const string &label)
+{
+	// The whole snapshot is read and checked first: the federation is
+	// left as it is when it cannot be restored.
+	SnapshotReader snapshot ;
+	std::vector<Federate *> federates ;
+	std::vector<bool> flags ;
+	std::vector<FederationTime> nerx ;
+	vector<LBTS::FederateClock> clocks[2] ;
+	FederateHandle nextObject = 0 ;
+	FederationTime savedMinNERx ;
+	uint32_t savedNbNERing = 0 ;
+	RootObject::SnapshotState state ;
+	try {
+		snapshot.open(getSnapshotName(label));
+		snapshot.readSection(FEDERATION_SECTION);
+		if (snapshot.readString() != name) {
+			cerr << "Snapshot of another federation" << endl ;
+			return false ;
+		}
+		snapshot.readUInt32(); // Federation handle, which may have changed.
+		nextObject = snapshot.readUInt32();
+
+		// Every saved federate must have joined again, maybe with
+		// another handle.
+		uint32_t nbFederates = snapshot.readUInt32();
+		for (uint32_t i = 0 ; i < nbFederates ; ++i) {
+			FederateHandle saved = snapshot.readUInt32();
+			string federateName = snapshot.readString();
+			try {
+				Federate &federate = getFederate(federateName);
+				snapshot.mapFederate(saved, federate.getHandle());
+				federates.push_back(&federate);
+			}
+			catch (FederateNotExecutionMember &) {
+				cerr << "Saved federate " << federateName << " has not joined" << endl ;
+				return false ;
+			}
+			flags.push_back(snapshot.readBool());
+			flags.push_back(snapshot.readBool());
+			flags.push_back(snapshot.readBool());
+			nerx.push_back(snapshot.readDouble());
+		}
 
-    // Did libXML manage to parse the file ?
-    if (doc == 0) {
-        cerr << "XML restore file not parsed successfully" << endl ;
-        xmlFreeDoc(doc);
-        return false ;
-    }
-	xmlNodePtr cur ;
+		for (int c = 0 ; c < 2 ; ++c) {
+			std::set<FederateHandle> known ;
+			for (uint32_t n = snapshot.readUInt32(); n > 0 ; --n) {
+				FederateHandle federate = snapshot.readFederate();
+				if (!known.insert(federate).second)
+					throw RTIinternalError(stringize() << "Snapshot has two clocks for federate " << federate);
+				clocks[c].push_back(LBTS::FederateClock(federate, snapshot.readDouble()));
+			}
+		}
+		savedMinNERx = snapshot.readDouble();
+		savedNbNERing = snapshot.readUInt32();
 
-	cur = xmlDocGetRootElement(doc);
-	if (cur == 0) {
-		cerr << "XML file is empty" << endl ;
-		xmlFreeDoc(doc);
-		return false ;
+		root->readSnapshot(snapshot, state);
 	}
-
-	// Is this root element an ROOT_NODE ?
-	if (xmlStrcmp(cur->name, ROOT_NODE)) {
-		cerr << "Wrong XML file: not the expected root node" << endl ;
+	catch (Exception &e) {
+		cerr << "Snapshot not restored: " << e._reason << endl ;
 		return false ;
 	}
 
-	cur = cur->xmlChildrenNode ;
-	if (xmlStrcmp(cur->name, NODE_FEDERATION)) {
-		cerr << "Wrong XML file structure" << endl ;
-		return false ;
+	for (uint32_t i = 0 ; i < federates.size() ; ++i) {
+		federates[i]->setConstrained(flags[3 * i]);
+		federates[i]->setRegulator(flags[3 * i + 1]);
+		federates[i]->setIsUsingNERx(flags[3 * i + 2]);
+		if (flags[3 * i + 2])
+			federates[i]->setLastNERxValue(nerx[i]);
 	}
 
-	if (strcmp(name.c_str(), XmlParser::CleanXmlGetProp(cur,(const xmlChar*)"name")) != 0) {
-		cerr << "Wrong federation name" << endl ;
+	LBTS *lbts[] = { &regulators, &NERxClocks };
+	for (int c = 0 ; c < 2 ; ++c) {
+		vector<LBTS::FederateClock> current ;
+		lbts[c]->get(current);
+		for (vector<LBTS::FederateClock>::const_iterator i = current.begin(); i != current.end(); ++i)
+			lbts[c]->remove(i->first);
+		for (vector<LBTS::FederateClock>::const_iterator i = clocks[c].begin(); i != clocks[c].end(); ++i)
+			lbts[c]->insert(i->first, i->second);
 	}
+	minNERx = savedMinNERx ;
+	nbNERing = savedNbNERing ;
 
+	// Handles given after the save may still be known to the RTIAs.
+	if (nextObject > objectHandles.getNext())
+		objectHandles.setNext(nextObject);
 
-	cur = cur->xmlChildrenNode ;
-
-	bool status = false;
-	while (cur != NULL) {
-		if ((!xmlStrcmp(cur->name, NODE_FEDERATE))) {
-			for (HandleFederateMap::iterator i = _handleFederateMap.begin(); i != _handleFederateMap.end(); ++i) {
-				if (!strcmp(i->second.getName().c_str(),XmlParser::CleanXmlGetProp(cur, (const xmlChar*) "name"))) {
-					// Set federate constrained status
-					if (!strcmp("true", XmlParser::CleanXmlGetProp(cur, (const xmlChar*) "constrained"))) {
-						status = true ;
-					}
-					else {
-						status = false ;
-					}
+	root->applySnapshot(state);
 
-					i->second.setConstrained(status);
-
-					// Set federate regulating status
-					status = !strcmp("true", XmlParser::CleanXmlGetProp(cur, (const xmlChar *) "regulator"));
-
-					i->second.setRegulator(status);
-
-					i->second.setHandle(strtol(XmlParser::CleanXmlGetProp(cur, (const xmlChar *) "handle"), 0, 10));
-					break ;
-				}
-			}
-		}
-		cur = cur->next ;
+	// The RTIAs using direct links route with the restored declarations.
+	ObjectClassSet::handled_const_iterator c ;
+	for (c = root->ObjectClasses->handled_begin(); c != root->ObjectClasses->handled_end(); ++c) {
+		if (c->second->getSuperclass() == 0)
+			sendObjectClassRoutes(c->first);
 	}
-
-	return status ;
-#endif // HAVE_XML
+	InteractionSet::handled_const_iterator i ;
+	for (i = root->Interactions->handled_begin(); i != root->Interactions->handled_end(); ++i)
+		sendInteractionClassRoutes(i->first);
+	return true ;
 }
 
 // ----------------------------------------------------------------------------
 bool
-Federation::saveXmlData()
+Federation::saveSnapshot()
 {
-#ifndef HAVE_XML
-	return false ;
-#else
-	xmlDocPtr doc = xmlNewDoc((const xmlChar *) "1.0");
-	doc->children = xmlNewDocNode(doc, NULL, ROOT_NODE, NULL);
-
-	xmlNodePtr federation ;
-	federation = xmlNewChild(doc->children, NULL, NODE_FEDERATION, NULL);
-
-	xmlSetProp(federation, (const xmlChar *) "name", (const xmlChar *) name.c_str());
-
-	char t[10] ;
-	sprintf(t, "%u", handle);
-	xmlSetProp(federation, (const xmlChar *) "handle", (const xmlChar *) t);
-
-	xmlNodePtr federate ;
-
-	for (HandleFederateMap::iterator i = _handleFederateMap.begin(); i != _handleFederateMap.end(); ++i) {
-		federate = xmlNewChild(federation, NULL, NODE_FEDERATE, NULL);
-
-		xmlSetProp(federate,
-				(const xmlChar *) "name",
-				(const xmlChar *) i->second.getName().c_str());
+	SnapshotWriter snapshot ;
+	try {
+		snapshot.open(getSnapshotName(saveLabel));
+		snapshot.writeSection(FEDERATION_SECTION);
+		snapshot.writeString(name);
+		snapshot.writeUInt32(handle);
+		snapshot.writeUInt32(objectHandles.getNext());
+
+		snapshot.writeUInt32(_handleFederateMap.size());
+		for (HandleFederateMap::const_iterator i = _handleFederateMap.begin(); i != _handleFederateMap.end(); ++i) {
+			snapshot.writeUInt32(i->first);
+			snapshot.writeString(i->second.getName());
+			snapshot.writeBool(i->second.isConstrained());
+			snapshot.writeBool(i->second.isRegulator());
+			snapshot.writeBool(i->second.isUsingNERx());
+			snapshot.writeDouble(i->second.getLastNERxValue().getTime());
+		}
 
-		sprintf(t, "%u", i->second.getHandle());
-		xmlSetProp(federate, (const xmlChar *) "handle", (const xmlChar *) t);
+		const LBTS *clocks[] = { &regulators, &NERxClocks };
+		for (int c = 0 ; c < 2 ; ++c) {
+			vector<LBTS::FederateClock> current ;
+			clocks[c]->get(current);
+			snapshot.writeUInt32(current.size());
+			for (vector<LBTS::FederateClock>::const_iterator i = current.begin(); i != current.end(); ++i) {
+				snapshot.writeUInt32(i->first);
+				snapshot.writeDouble(i->second.getTime());
+			}
+		}
+		snapshot.writeDouble(minNERx.getTime());
+		snapshot.writeUInt32(nbNERing);
 
-		xmlSetProp(federate,
-				(const xmlChar *)"constrained", (const xmlChar *)
-				((i->second.isConstrained()) ? "true" : "false"));
-		xmlSetProp(federate, (const xmlChar *) "regulator",
-				(const xmlChar *)((i->second.isRegulator()) ? "true" : "false"));
+		root->saveSnapshot(snapshot);
+		snapshot.close();
 	}
-
-	xmlSetDocCompressMode(doc, 9);
-
-	string filename = name + "_" + saveLabel + ".xcs" ;
-	xmlSaveFile(filename.c_str(), doc);
-
-	// TODO: tests
-
+	catch (Exception &e) {
+		cerr << "Snapshot not saved: " << e._reason << endl ;
+		return false ;
+	}
+	D.Out(pdRegister, "Federation %d: snapshot %s, %lu bytes.", handle,
+	      getSnapshotName(saveLabel).c_str(), static_cast<unsigned long>(snapshot.getSize()));
 	return true ;
-#endif // HAVE_XML
 }
 
 // ----------------------------------------------------------------------------
@@ -29,6 +29,7 @@
 #include "GAV.hh"
 #include "SecurityServer.hh"
 #include "HandleManager.hh"
+#include "ValueArena.hh"
 #include "certi.hh"
 #include <cstdlib>
 
@@ -65,8 +66,12 @@ private:
     SocketMC *MCLink ;
 #endif
 
-    bool saveXmlData();
-    bool restoreXmlData(std::string docFilename);
+    /** Name of the file of the snapshot saved with the given label. */
+    std::string getSnapshotName(const std::string &label) const ;
+    /** Write the state of the federation in a snapshot, after a save. */
+    bool saveSnapshot();
+    /** Restore the state of the federation from a snapshot, if possible. */
+    bool restoreSnapshot(const std::string &label);
 
     // METHODS -----------------------------------------------------------------
 public:
@@ -139,6 +144,19 @@ public:
         throw (FederateOwnsAttributes,
                FederateNotExecutionMember);
 
+    /**
+     * Record where the RTIA of a federate accepts direct links, on which
+     * the RTIAs send each other the receive order updates and interactions
+     * instead of sending them through the RTIG. The RTIAs using direct
+     * links are told the addresses of each other, and get the routing
+     * tables of the federation each time a subscription changes.
+     * @param[in] theHandle the federate
+     * @param[in] address IPv4 address of its RTIA
+     * @param[in] port TCP port of its RTIA, 0 if it uses no direct link
+     */
+    void setDataPeer(FederateHandle theHandle, unsigned long address, unsigned int port)
+        throw (FederateNotExecutionMember);
+
     // ---------------------
     // -- Time Management --
     // ---------------------
@@ -325,7 +343,7 @@ public:
     void updateAttributeValues(FederateHandle theFederateHandle,
                                ObjectHandle theObjectHandle,
                                const std::vector <AttributeHandle> &theAttributeList,
-                               const std::vector <AttributeValue_t> &theValueList,
+                               const ValueArena &theValueList,
                                uint16_t theListSize,
                                FederationTime theTime,
                                const std::string& theTag)
@@ -340,7 +358,7 @@ public:
     void updateAttributeValues(FederateHandle theFederateHandle,
                                ObjectHandle theObjectHandle,
                                const std::vector <AttributeHandle> &theAttributeList,
-                               const std::vector <AttributeValue_t> &theValueList,
+                               const ValueArena &theValueList,
                                uint16_t theListSize,
                                const std::string& theTag)
         throw (FederateNotExecutionMember,
@@ -358,7 +376,7 @@ public:
     void broadcastInteraction(FederateHandle theFederateHandle,
                               InteractionClassHandle theInteractionHandle,
                               const std::vector <ParameterHandle> &theParameterList,
-                              const std::vector <ParameterValue_t> &theValueList,
+                              const ValueArena &theValueList,
                               uint16_t theListSize,
                               FederationTime theTime,
                               RegionHandle region,
@@ -374,7 +392,7 @@ public:
    void broadcastInteraction(FederateHandle theFederateHandle,
                               InteractionClassHandle theInteractionHandle,
                               const std::vector <ParameterHandle> &theParameterList,
-                              const std::vector <ParameterValue_t> &theValueList,
+                              const ValueArena &theValueList,
                               uint16_t theListSize,
                               RegionHandle region,
                               const std::string& theTag)
@@ -396,6 +414,32 @@ public:
                RestoreInProgress,
                RTIinternalError);
 
+    /** Change the transportation of the updates of owned attributes. */
+    void changeAttributeTransportationType(FederateHandle theFederateHandle,
+                                           ObjectHandle theObjectHandle,
+                                           const std::vector <AttributeHandle> &theAttributeList,
+                                           TransportType theType)
+        throw (FederateNotExecutionMember,
+               ObjectNotKnown,
+               AttributeNotDefined,
+               AttributeNotOwned,
+               InvalidTransportationHandle,
+               SaveInProgress,
+               RestoreInProgress,
+               RTIinternalError);
+
+    /** Change the transportation of a published interaction class. */
+    void changeInteractionTransportationType(FederateHandle theFederateHandle,
+                                             InteractionClassHandle theInteractionHandle,
+                                             TransportType theType)
+        throw (FederateNotExecutionMember,
+               InteractionClassNotDefined,
+               FederateNotPublishing,
+               InvalidTransportationHandle,
+               SaveInProgress,
+               RestoreInProgress,
+               RTIinternalError);
+
     void subscribeInteraction(FederateHandle theFederateHandle,
                               InteractionClassHandle theInteractionHandle,
                               bool SubOrUnsub)
@@ -680,6 +724,25 @@ private:
     void broadcastSomeMessage(NetworkMessage *msg, FederateHandle Except,
                        const std::vector <FederateHandle> &fede_array, uint32_t nbfed);
 
+    /** Return true if a federate of the federation uses direct links. */
+    bool hasDataPeers() const ;
+
+    /**
+     * Send a message to the RTIAs using direct links.
+     * @param[in] msg the message
+     * @param[in] except federate not to send it to, 0 for none
+     */
+    void sendToDataPeers(NetworkMessage *msg, FederateHandle except);
+
+    /**
+     * Send the routes of an object class and of its subclasses, whose
+     * routes include the subscriptions made to the class, to the RTIAs
+     * using direct links.
+     */
+    void sendObjectClassRoutes(ObjectClassHandle theClass);
+
+    void sendInteractionClassRoutes(InteractionClassHandle theClass);
+
     Federate &getFederate(const std::string& theName)
         throw (FederateNotExecutionMember);
 
@@ -700,6 +763,13 @@ private:
      * The minimum NERx timestamp for this federation
      */
     FederationTime minNERx;
+    /**
+     * The regulators clocks as seen by the NERx computation: the last NERx
+     * value of a NERing regulator, its logical time otherwise.
+     */
+    LBTS NERxClocks;
+    /** The number of regulators currently using NERx. */
+    uint32_t nbNERing;
     /* The message buffer used to send Network messages */
     MessageBuffer NM_msgBufSend;
 };
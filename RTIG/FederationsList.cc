@@ -498,7 +498,7 @@ FederationsList::updateAttribute(Handle federationHandle,
                                  FederateHandle federate,
                                  ObjectHandle id,
                                  const std::vector <AttributeHandle> &attributes,
-                                 const std::vector <AttributeValue_t> &values,
+                                 const ValueArena &values,
                                  uint16_t list_size,
                                  FederationTime time,
                                  const std::string& tag)
@@ -525,7 +525,7 @@ FederationsList::updateAttribute(Handle federationHandle,
                                  FederateHandle federate,
                                  ObjectHandle id,
                                  const std::vector <AttributeHandle> &attributes,
-                                 const std::vector <AttributeValue_t> &values,
+                                 const ValueArena &values,
                                  uint16_t list_size,
                                  const std::string& tag)
     throw (FederateNotExecutionMember,
@@ -550,7 +550,7 @@ FederationsList::updateParameter(Handle federationHandle,
                                  FederateHandle federate,
                                  InteractionClassHandle interaction,
                                  const std::vector <ParameterHandle> &parameters,
-                                 const std::vector <ParameterValue_t> &values,
+                                 const ValueArena &values,
                                  uint16_t list_size,
                                  FederationTime time,
                                  RegionHandle region,
@@ -583,7 +583,7 @@ FederationsList::updateParameter(Handle federationHandle,
                                  FederateHandle federate,
                                  InteractionClassHandle interaction,
                                  const std::vector <ParameterHandle> &parameters,
-                                 const std::vector <ParameterValue_t> &values,
+                                 const ValueArena &values,
                                  uint16_t list_size,
                                  RegionHandle region,
                                  const std::string& tag)
@@ -735,6 +735,52 @@ FederationsList::publishInteraction(Handle federationHandle,
     federation->publishInteraction(federate, interaction, pub);
 }
 
+// ----------------------------------------------------------------------------
+// changeAttributeTransportationType
+void
+FederationsList::changeAttributeTransportationType(Handle federationHandle,
+                                                   FederateHandle federate,
+                                                   ObjectHandle id,
+                                                   const std::vector <AttributeHandle> &attributes,
+                                                   TransportType type)
+    throw (FederationExecutionDoesNotExist,
+           FederateNotExecutionMember,
+           ObjectNotKnown,
+           AttributeNotDefined,
+           AttributeNotOwned,
+           InvalidTransportationHandle,
+           SaveInProgress,
+           RestoreInProgress,
+           RTIinternalError)
+{
+    // It may throw FederationExecutionDoesNotExist.
+    Federation *federation = searchFederation(federationHandle);
+
+    federation->changeAttributeTransportationType(federate, id, attributes, type);
+}
+
+// ----------------------------------------------------------------------------
+// changeInteractionTransportationType
+void
+FederationsList::changeInteractionTransportationType(Handle federationHandle,
+                                                     FederateHandle federate,
+                                                     InteractionClassHandle interaction,
+                                                     TransportType type)
+    throw (FederationExecutionDoesNotExist,
+           FederateNotExecutionMember,
+           InteractionClassNotDefined,
+           FederateNotPublishing,
+           InvalidTransportationHandle,
+           SaveInProgress,
+           RestoreInProgress,
+           RTIinternalError)
+{
+    // It may throw FederationExecutionDoesNotExist.
+    Federation *federation = searchFederation(federationHandle);
+
+    federation->changeInteractionTransportationType(federate, interaction, type);
+}
+
 // ----------------------------------------------------------------------------
 // publishObject
 void
@@ -861,6 +907,21 @@ FederationsList::remove(Handle federationHandle, FederateHandle federate)
     G.Out(pdGendoc,"exit FederationsList::remove");
 }
 
+// ----------------------------------------------------------------------------
+void
+FederationsList::setDataPeer(Handle federationHandle, FederateHandle federate,
+                             unsigned long address, unsigned int port)
+    throw (FederationExecutionDoesNotExist,
+           FederateNotExecutionMember,
+           RTIinternalError)
+{
+    // It may throw FederationExecutionDoesNotExist
+    Federation *federation = searchFederation(federationHandle);
+
+    // It may throw FederateNotExecutionMember
+    federation->setDataPeer(federate, address, port);
+}
+
 // ----------------------------------------------------------------------------
 // removeRegulator
 void
@@ -171,6 +171,12 @@ public:
                FederateNotExecutionMember,
                RTIinternalError);
 
+    /** See Federation::setDataPeer. */
+    void setDataPeer(Handle, FederateHandle, unsigned long address, unsigned int port)
+        throw (FederationExecutionDoesNotExist,
+               FederateNotExecutionMember,
+               RTIinternalError);
+
     void setClassRelevanceAdvisorySwitch(Handle theHandle,
                         FederateHandle theFederateHandle)
         throw (FederationExecutionDoesNotExist,
@@ -388,7 +394,7 @@ public:
                          FederateHandle theFederateHandle,
                          ObjectHandle theObjectHandle,
                          const std::vector <AttributeHandle> &theAttributeList,
-                         const std::vector <AttributeValue_t> &theValueList,
+                         const ValueArena &theValueList,
                          uint16_t theListSize,
                          FederationTime theTime,
                          const std::string& theTag)
@@ -405,7 +411,7 @@ public:
                          FederateHandle theFederateHandle,
                          ObjectHandle theObjectHandle,
                          const std::vector <AttributeHandle> &theAttributeList,
-                         const std::vector <AttributeValue_t> &theValueList,
+                         const ValueArena &theValueList,
                          uint16_t theListSize,
                          const std::string& theTag)
         throw (FederateNotExecutionMember,
@@ -433,6 +439,34 @@ public:
                RestoreInProgress,
                RTIinternalError);
 
+    void changeAttributeTransportationType(Handle theHandle,
+                                           FederateHandle theFederateHandle,
+                                           ObjectHandle theObjectHandle,
+                                           const std::vector <AttributeHandle> &theAttributeList,
+                                           TransportType theType)
+        throw (FederationExecutionDoesNotExist,
+               FederateNotExecutionMember,
+               ObjectNotKnown,
+               AttributeNotDefined,
+               AttributeNotOwned,
+               InvalidTransportationHandle,
+               SaveInProgress,
+               RestoreInProgress,
+               RTIinternalError);
+
+    void changeInteractionTransportationType(Handle theHandle,
+                                             FederateHandle theFederateHandle,
+                                             InteractionClassHandle theInteractionHandle,
+                                             TransportType theType)
+        throw (FederationExecutionDoesNotExist,
+               FederateNotExecutionMember,
+               InteractionClassNotDefined,
+               FederateNotPublishing,
+               InvalidTransportationHandle,
+               SaveInProgress,
+               RestoreInProgress,
+               RTIinternalError);
+
     void subscribeInteraction(Handle theHandle,
                               FederateHandle theFederateHandle,
                               InteractionClassHandle theInteractionHandle,
@@ -449,7 +483,7 @@ public:
                          FederateHandle theFederateHandle,
                          InteractionClassHandle theInteractionHandle,
                          const std::vector <ParameterHandle> &theParameterList,
-                         const std::vector <ParameterValue_t> &theValueList,
+                         const ValueArena &theValueList,
                          uint16_t theListSize,
                          FederationTime theTime,
                          RegionHandle,
@@ -467,7 +501,7 @@ public:
                          FederateHandle theFederateHandle,
                          InteractionClassHandle theInteractionHandle,
                          const std::vector <ParameterHandle> &theParameterList,
-                         const std::vector <ParameterValue_t> &theValueList,
+                         const ValueArena &theValueList,
                          uint16_t theListSize,
                          RegionHandle,
                          const std::string& theTag)
@@ -25,11 +25,14 @@
 
 #include "PrettyDebug.hh"
 #include "NM_Classes.hh"
+#include "MessagePool.hh"
+#include "EventTrace.hh"
 
 #ifdef _WIN32
 #include <signal.h>
 #else
 #include <unistd.h>
+#include <fcntl.h>
 #endif
 #include <iostream>
 #include <cerrno>
@@ -55,7 +58,8 @@ RTIG::RTIG()
     :  federationHandles(1),
       socketServer(&tcpSocketServer, &udpSocketServer),
       auditServer(RTIG_AUDIT_FILENAME),
-      federations(socketServer, auditServer)
+      federations(socketServer, auditServer),
+      acceptor(this)
 {
     this->verboseLevel = 0;
     // the default is to listen on all network interface
@@ -72,6 +76,42 @@ RTIG::RTIG()
     this->federations.setVerboseLevel(verboseLevel);
     NM_msgBufSend.reset();
     NM_msgBufReceive.reset();
+#ifndef _WIN32
+    pthread_mutex_init(&handoffLock, NULL);
+    pthread_mutex_init(&creationLock, NULL);
+    wakeup[0] = wakeup[1] = -1 ;
+    stopping = false ;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Shard constructor: the links are accepted by the acceptor, the shard only
+// gets them once they name one of its federations.
+RTIG::RTIG(RTIG &the_acceptor, unsigned int index)
+    : tcpPort(the_acceptor.tcpPort),
+      udpPort(the_acceptor.udpPort),
+      verboseLevel(the_acceptor.verboseLevel),
+      listeningIPAddress(the_acceptor.listeningIPAddress),
+      federationHandles(1),
+      socketServer(&the_acceptor.tcpSocketServer, &the_acceptor.udpSocketServer),
+      auditServer(stringize() << RTIG_AUDIT_FILENAME << "." << index),
+      federations(socketServer, auditServer),
+      acceptor(&the_acceptor)
+{
+    federations.setVerboseLevel(verboseLevel);
+    NM_msgBufSend.reset();
+    NM_msgBufReceive.reset();
+#ifndef _WIN32
+    pthread_mutex_init(&handoffLock, NULL);
+    pthread_mutex_init(&creationLock, NULL);
+    stopping = false ;
+    if (pipe(wakeup) < 0)
+        throw NetworkError(stringize() << "Cannot create the shard wakeup pipe: "
+                           << strerror(errno));
+    fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakeup[1], F_SETFL, O_NONBLOCK);
+    socketServer.getPoller().add(wakeup[0]);
+#endif
 }
 
 // ----------------------------------------------------------------------------
@@ -79,12 +119,108 @@ RTIG::RTIG()
 
 RTIG::~RTIG()
 {
+    dropHandoffs();
+#ifndef _WIN32
+    if (wakeup[0] != -1) {
+        ::close(wakeup[0]);
+        ::close(wakeup[1]);
+    }
+    pthread_mutex_destroy(&handoffLock);
+    pthread_mutex_destroy(&creationLock);
+#endif
+    if (acceptor != this)
+        return ;
+
     tcpSocketServer.close();
     udpSocketServer.close();
 
     cout << endl << "Stopping RTIG" << endl ;
 }
 
+// ----------------------------------------------------------------------------
+RTIG::CreationLock::CreationLock(RTIG &rtig)
+    : acceptor(*rtig.acceptor)
+{
+#ifndef _WIN32
+    pthread_mutex_lock(&acceptor.creationLock);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+RTIG::CreationLock::~CreationLock()
+{
+#ifndef _WIN32
+    pthread_mutex_unlock(&acceptor.creationLock);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+/*! Return the shard hosting the federation named by a create, join or destroy
+  request, or this RTIG if the federations are not sharded or if msg names no
+  federation.
+*/
+RTIG *
+RTIG::hostOf(NetworkMessage *msg)
+{
+    if (acceptor->shards.empty())
+        return this ;
+
+    const std::string *name ;
+    switch (msg->getMessageType()) {
+      case NetworkMessage::CREATE_FEDERATION_EXECUTION:
+        name = &static_cast<NM_Create_Federation_Execution*>(msg)->getFederationName();
+        break ;
+      case NetworkMessage::DESTROY_FEDERATION_EXECUTION:
+        name = &static_cast<NM_Destroy_Federation_Execution*>(msg)->getFederationName();
+        break ;
+      case NetworkMessage::JOIN_FEDERATION_EXECUTION:
+        name = &static_cast<NM_Join_Federation_Execution*>(msg)->getFederationName();
+        break ;
+      default:
+        return this ;
+    }
+
+    unsigned long hash = 5381 ;
+    for (std::string::const_iterator c = name->begin(); c != name->end(); ++c)
+        hash = hash * 33 + static_cast<unsigned char>(*c);
+    return acceptor->shards[hash % acceptor->shards.size()];
+}
+
+// ----------------------------------------------------------------------------
+/*! Give a link released by another RTIG, and the request it has just
+  received, to the event loop of this shard. Called from the thread of the
+  former RTIG of the link.
+*/
+void
+RTIG::handOver(SocketTuple *tuple, NetworkMessage *msg)
+{
+#ifndef _WIN32
+    Handoff handoff = { tuple, msg };
+    pthread_mutex_lock(&handoffLock);
+    handoffs.push_back(handoff);
+    pthread_mutex_unlock(&handoffLock);
+
+    // A full pipe already wakes the shard up.
+    char wake = 0 ;
+    if (write(wakeup[1], &wake, 1) < 0 && errno != EAGAIN)
+        D.Out(pdError, "Cannot wake up RTIG shard: %s.", strerror(errno));
+#endif
+}
+
+// ----------------------------------------------------------------------------
+//! Close the links handed over to this shard which it has not adopted.
+void
+RTIG::dropHandoffs()
+{
+    for (std::vector<Handoff>::iterator i = handoffs.begin(); i != handoffs.end(); ++i) {
+        D.Out(pdCom, "Closing socket %ld, handed over to a stopped shard.",
+              i->tuple->ReliableLink->returnSocket());
+        delete i->tuple ;
+        MessagePool::release(i->msg);
+    }
+    handoffs.clear();
+}
+
 // ----------------------------------------------------------------------------
 //! Choose the right processing module to call.
 /*! This module chooses the right processing module to call. This process is
@@ -98,6 +234,10 @@ RTIG::chooseProcessingMethod(Socket *link, NetworkMessage *msg)
     if ( msg->getMessageType() != NetworkMessage::DESTROY_FEDERATION_EXECUTION)
        socketServer.checkMessage(link->returnSocket(), msg);
 
+    // A joined link stays in the shard of its federation until it resigns.
+    if (hostOf(msg) != this)
+        throw RTIinternalError("Federation hosted by another RTIG shard.");
+
     switch(msg->getMessageType()) {
     case NetworkMessage::MESSAGE_NULL:
     	D.Out(pdDebug, "Message Null.");
@@ -245,6 +385,18 @@ RTIG::chooseProcessingMethod(Socket *link, NetworkMessage *msg)
         processPublishInteractionClass(link, static_cast<NM_Publish_Interaction_Class*>(msg));
         break ;
 
+      case NetworkMessage::CHANGE_ATTRIBUTE_TRANSPORT_TYPE:
+        D.Out(pdTrace, "changeAttributeTransportationType.");
+        auditServer.setLevel(6);
+        processChangeAttributeTransportType(link, static_cast<NM_Change_Attribute_Transport_Type*>(msg));
+        break ;
+
+      case NetworkMessage::CHANGE_INTERACTION_TRANSPORT_TYPE:
+        D.Out(pdTrace, "changeInteractionTransportationType.");
+        auditServer.setLevel(6);
+        processChangeInteractionTransportType(link, static_cast<NM_Change_Interaction_Transport_Type*>(msg));
+        break ;
+
       case NetworkMessage::SUBSCRIBE_OBJECT_CLASS:
       case NetworkMessage::UNSUBSCRIBE_OBJECT_CLASS:
         D.Out(pdTrace, "un/subscribeObjectClass.");
@@ -420,7 +572,7 @@ RTIG::chooseProcessingMethod(Socket *link, NetworkMessage *msg)
         break ;
 
       default:
-        // FIXME: Should treat other cases CHANGE_*_ORDER/TRANSPORT_TYPE
+        // FIXME: Should treat other cases CHANGE_*_ORDER_TYPE
         D.Out(pdError, "processMessageRecu: unknown type %u.", msg->getMessageType());
         throw RTIinternalError("Unknown Message Type");
     }
@@ -467,9 +619,8 @@ RTIG::setListeningIPAddress(const std::string& hostName) throw (NetworkError) {
 // Called only by RTIG main
 void
 RTIG::execute() throw (NetworkError) {
-    int result ;
-    fd_set fd ;
-    Socket *link ;
+    SocketTCP *link ;
+    std::vector<SOCKET> activeSockets ;
 
     // create TCP and UDP connections for the RTIG server
 
@@ -485,83 +636,221 @@ RTIG::execute() throw (NetworkError) {
         tcpSocketServer.createServer(tcpPort);
     }
 
+    SocketPoller &poller = socketServer.getPoller();
+    const SOCKET server_socket = tcpSocketServer.returnSocket();
+    poller.add(server_socket);
+
+#ifndef _WIN32
+    const char *shards_s = getenv("CERTI_RTIG_SHARDS");
+    if (shards_s != NULL && atoi(shards_s) > 1)
+        startShards(atoi(shards_s));
+#endif
+
     if (verboseLevel>0) {
-        cout << "CERTI RTIG up and running ..." << endl ;
+        cout << "CERTI RTIG up and running (" << poller.getName();
+        if (!shards.empty())
+            cout << ", " << shards.size() << " shards" ;
+        cout << ") ..." << endl ;
     }
     terminate = false ;
 
     while (!terminate) {
-        // Initialize fd_set structure with all opened sockets.
-    #if _WIN32
-
-        result = 0;	// Wait for an incoming message.
-        while (!result)
-        {
-            int test;
+        // Wait for incoming messages on any opened socket.
+        try {
+#if _WIN32
+            // Wake up regularly to check the terminate flag.
+            if (poller.wait(activeSockets, 50) == 0)
+                continue ;
+#else
+            poller.wait(activeSockets, -1);
+#endif
+        }
+        catch (NetworkSignal &e) {
+            // Interrupted by a signal, terminate is checked by the loop.
+            continue ;
+        }
 
-            FD_ZERO(&fd);
-            FD_SET(tcpSocketServer.returnSocket(), &fd);
+        // Service every link reported ready during this wakeup, new
+        // connections are accepted once established links are drained.
+        bool connection_request = false ;
+        for (std::vector<SOCKET>::const_iterator i = activeSockets.begin();
+             i != activeSockets.end(); ++i) {
+            if (*i == server_socket) {
+                connection_request = true ;
+                continue ;
+            }
 
-            int highest_fd = socketServer.addToFDSet(&fd);
-            int server_socket = tcpSocketServer.returnSocket();
+            // The link may have been closed while servicing a previous one.
+            link = socketServer.getActiveSocket(*i);
+            if (link != NULL)
+                processLink(link, NULL);
+        }
+        socketServer.flushDatagrams();
+        socketServer.flushLinks();
 
-            //typedef struct timeval {  long tv_sec;  long tv_usec; }
-            timeval		watchDog;
-            watchDog.tv_sec= 0;
-            watchDog.tv_usec= 50000L;
+        // Or on the server socket ?
+        if (connection_request) {
+            D.Out(pdCom, "Demande de connexion.");
+            openConnection();
+        }
+    }
+#ifndef _WIN32
+    stopShards();
+#endif
+}
 
-            highest_fd = server_socket>highest_fd ? server_socket : highest_fd;
+// ----------------------------------------------------------------------------
+//! Process msg if not NULL, then the messages already received on link.
+/*! A non blocking link reported ready writes its output queue and reads
+  what has arrived: only the whole messages read are processed.
+*/
+void
+RTIG::processLink(SocketTCP *tcp_link, NetworkMessage *msg)
+{
+    Socket *link = tcp_link ;
+    D.Out(pdCom, "Incoming message on socket %ld.", link->returnSocket());
+    try {
+        if (msg != NULL)
+            link = processMessage(link, msg);
+        else if (tcp_link->isNonBlocking()) {
+            tcp_link->flush();
+            tcp_link->readAvailable();
+        }
+        else
+            link = processIncomingMessage(link);
+        while (link != NULL && link->isDataReady())
+            link = processIncomingMessage(link);
+    }
+    catch (NetworkError &e) {
+        if (!e._reason.empty())
+            D.Out(pdExcept, "Catching Network Error, reason : %s", e._reason.c_str());
+        else
+            D.Out(pdExcept, "Catching Network Error, no reason string.");
+        cout << "RTIG dropping client connection " << link->returnSocket()
+             << '.' << endl ;
+        closeConnection(link, true);
+    }
+}
 
-            result = select(highest_fd+1, &fd, NULL, NULL, &watchDog);
-            if (result < 0) test= WSAGetLastError();
-            if (terminate) break;
+#ifndef _WIN32
+// ----------------------------------------------------------------------------
+//! Start count shards, each one running its event loop in a thread.
+void
+RTIG::startShards(unsigned int count)
+{
+    // The threads inherit this mask: SIGINT has to interrupt the acceptor.
+    sigset_t blocked, previous ;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+
+    for (unsigned int i = 0 ; i < count ; ++i) {
+        RTIG *shard = new RTIG(*this, i + 1);
+        if (pthread_create(&shard->thread, NULL, runShard, shard) != 0) {
+            delete shard ;
+            pthread_sigmask(SIG_SETMASK, &previous, NULL);
+            stopShards();
+            throw NetworkError("Cannot start the RTIG shard threads.");
         }
-        if (terminate) break;
+        shards.push_back(shard);
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
 
-        if((result == -1)&&(WSAGetLastError() == WSAEINTR)) break;
-#else
-        FD_ZERO(&fd);
-        FD_SET(tcpSocketServer.returnSocket(), &fd);
+// ----------------------------------------------------------------------------
+//! Stop and delete the shards.
+void
+RTIG::stopShards()
+{
+    // A shard may still hand a link over to another one until every shard
+    // has stopped: none is deleted before.
+    for (std::vector<RTIG *>::iterator i = shards.begin(); i != shards.end(); ++i) {
+        pthread_mutex_lock(&(*i)->handoffLock);
+        (*i)->stopping = true ;
+        pthread_mutex_unlock(&(*i)->handoffLock);
+        char wake = 0 ;
+        if (write((*i)->wakeup[1], &wake, 1) < 0 && errno != EAGAIN)
+            D.Out(pdError, "Cannot wake up RTIG shard: %s.", strerror(errno));
+    }
+    for (std::vector<RTIG *>::iterator i = shards.begin(); i != shards.end(); ++i)
+        pthread_join((*i)->thread, NULL);
+    // Links handed over to a shard which stopped before adopting them.
+    for (std::vector<RTIG *>::iterator i = shards.begin(); i != shards.end(); ++i) {
+        (*i)->dropHandoffs();
+        delete *i ;
+    }
+    shards.clear();
+}
 
-        int fd_max = socketServer.addToFDSet(&fd);
-        fd_max = std::max(tcpSocketServer.returnSocket(), fd_max);
+// ----------------------------------------------------------------------------
+void *
+RTIG::runShard(void *shard)
+{
+    static_cast<RTIG *>(shard)->executeShard();
+    return NULL ;
+}
 
-        result = 0 ;	// Wait for an incoming message.
-        result = select(fd_max + 1, &fd, NULL, NULL, NULL);
+// ----------------------------------------------------------------------------
+//! Event loop of a shard, until stopShards.
+void
+RTIG::executeShard()
+{
+    SocketPoller &poller = socketServer.getPoller();
+    std::vector<SOCKET> activeSockets ;
+    std::vector<Handoff> adopted ;
 
-        if((result == -1)&&(errno == EINTR)) break;
-#endif
+    for (;;) {
+        try {
+            poller.wait(activeSockets, -1);
+        }
+        catch (NetworkSignal &e) {
+            continue ;
+        }
+        catch (NetworkError &e) {
+            cerr << "RTIG shard aborted with a Network Error: [" << e._reason << "]." << endl ;
+            return ;
+        }
 
-        // Is it a message from an already opened connection?
-        link = socketServer.getActiveSocket(&fd);
-        if (link != NULL) {
-            D.Out(pdCom, "Incoming message on socket %ld.",
-                    link->returnSocket());
-            try {
-                do {
-                    link = processIncomingMessage(link);
-                    if (link == NULL)break ;
-                } while (link->isDataReady());
+        for (std::vector<SOCKET>::const_iterator i = activeSockets.begin();
+             i != activeSockets.end(); ++i) {
+            if (*i != wakeup[0]) {
+                SocketTCP *link = socketServer.getActiveSocket(*i);
+                if (link != NULL)
+                    processLink(link, NULL);
+                continue ;
             }
-            catch (NetworkError &e) {
-                if (!e._reason.empty())
-                    D.Out(pdExcept, "Catching Network Error, reason : %s", e._reason.c_str());
-                else
-                    D.Out(pdExcept, "Catching Network Error, no reason string.");
-                cout << "RTIG dropping client connection " << link->returnSocket()
-                     << '.' << endl ;
-                closeConnection(link, true);
-                link = NULL ;
-            }
-        }
 
-        // Or on the server socket ?
-        if (FD_ISSET(tcpSocketServer.returnSocket(), &fd)) {
-            D.Out(pdCom, "Demande de connexion.");
-            openConnection();
+            char drain[64] ;
+            while (read(wakeup[0], drain, sizeof(drain)) > 0)
+                ;
+            pthread_mutex_lock(&handoffLock);
+            bool stop = stopping ;
+            if (!stop)
+                adopted.swap(handoffs);
+            pthread_mutex_unlock(&handoffLock);
+            if (stop)
+                return ;
+
+            for (std::vector<Handoff>::iterator h = adopted.begin(); h != adopted.end(); ++h) {
+                SocketTCP *link = h->tuple->ReliableLink ;
+                try {
+                    // It deletes the tuple if it fails.
+                    socketServer.adopt(h->tuple);
+                }
+                catch (RTIinternalError &e) {
+                    D.Out(pdExcept, "Cannot adopt a link: %s.", e._reason.c_str());
+                    MessagePool::release(h->msg);
+                    continue ;
+                }
+                processLink(link, h->msg);
+            }
+            adopted.clear();
         }
+        socketServer.flushDatagrams();
+        socketServer.flushLinks();
     }
 }
+#endif
 
 // ----------------------------------------------------------------------------
 // openConnection
@@ -581,20 +870,12 @@ RTIG::openConnection()
 
 // ----------------------------------------------------------------------------
 //! process incoming messages.
-/*! This module works as follows:
-
-Each processXXX module processes its own answer and any broadcast needed.
-processXXX module calling is decided by the ChooseProcessingMethod module.
-But if an exception occurs while processing a message, the exception is
-caught by this module. Then a message, similar to the received one is sent
-on the link. This message only holds the exception.
+/*! Receive a message on link and process it, unless the link is handed over
+  to another shard with the message: NULL is then returned.
 */
 Socket*
 RTIG::processIncomingMessage(Socket *link) throw (NetworkError)
 {
-    NetworkMessage* msg ;
-
-    char buffer[BUFFER_EXCEPTION_REASON_SIZE] ; // To store the exception reason
     G.Out(pdGendoc,"enter RTIG::processIncomingMessage");
     if (link == NULL) {
         D.Out(pdError, "NULL socket in processMessageRecu.");
@@ -602,11 +883,52 @@ RTIG::processIncomingMessage(Socket *link) throw (NetworkError)
     }
 
     /* virtual constructor call */
-    msg = NM_Factory::receive(link);
+    NetworkMessage *msg = NM_Factory::receive(link, NM_msgBufReceive);
+    EventTrace::record(TRACE_RTIG_RECEIVE, msg->getMessageType(), msg->getFederation(),
+                       msg->getFederate(), 0, NM_msgBufReceive.size());
+
+    // A link which has not joined yet goes to the shard of the federation
+    // it names, which processes the message.
+    RTIG *host = hostOf(msg);
+    if (host != this) {
+        SocketTuple *tuple = NULL ;
+        try {
+            tuple = socketServer.release(link->returnSocket());
+        }
+        catch (RTIinternalError &e) {
+            // Still joined: chooseProcessingMethod rejects the request.
+        }
+        if (tuple != NULL) {
+            D.Out(pdCom, "Socket %ld handed over to another shard.", link->returnSocket());
+            host->handOver(tuple, msg);
+            G.Out(pdGendoc,"exit  RTIG::processIncomingMessage");
+            return NULL ;
+        }
+    }
+    G.Out(pdGendoc,"exit  RTIG::processIncomingMessage");
+    return processMessage(link, msg);
+}
+
+// ----------------------------------------------------------------------------
+//! process a received message.
+/*! This module works as follows:
+
+Each processXXX module processes its own answer and any broadcast needed.
+processXXX module calling is decided by the ChooseProcessingMethod module.
+But if an exception occurs while processing a message, the exception is
+caught by this module. Then a message, similar to the received one is sent
+on the link. This message only holds the exception. The message is released
+to the MessagePool.
+*/
+Socket*
+RTIG::processMessage(Socket *link, NetworkMessage *msg) throw (NetworkError)
+{
+    char buffer[BUFFER_EXCEPTION_REASON_SIZE] ; // To store the exception reason
+    G.Out(pdGendoc,"enter RTIG::processMessage");
 
-    // Server Answer(only if an exception is raised)
-    std::auto_ptr<NetworkMessage> rep(NM_Factory::create(msg->getMessageType()));
-    rep->setFederate(msg->getFederate());
+    // Exception of the server answer, which is only built if one is raised
+    TypeException exception = e_NO_EXCEPTION ;
+    FederateHandle federate = msg->getFederate();
 
     auditServer.startLine(msg->getFederation(), msg->getFederate(), msg->getMessageType());
 
@@ -623,327 +945,327 @@ RTIG::processIncomingMessage(Socket *link) throw (NetworkError)
     catch (ArrayIndexOutOfBounds &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ArrayIndexOutOfBounds);
+        exception = e_ArrayIndexOutOfBounds ;
     }
     catch (AttributeAlreadyOwned &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeAlreadyOwned);
+        exception = e_AttributeAlreadyOwned ;
     }
     catch (AttributeAlreadyBeingAcquired &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeAlreadyBeingAcquired);
+        exception = e_AttributeAlreadyBeingAcquired ;
     }
     catch (AttributeAlreadyBeingDivested &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeAlreadyBeingDivested);
+        exception = e_AttributeAlreadyBeingDivested ;
     }
     catch (AttributeDivestitureWasNotRequested &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeDivestitureWasNotRequested);
+        exception = e_AttributeDivestitureWasNotRequested ;
     }
     catch (AttributeAcquisitionWasNotRequested &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeAcquisitionWasNotRequested);
+        exception = e_AttributeAcquisitionWasNotRequested ;
     }
     catch (AttributeNotDefined &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeNotDefined);
+        exception = e_AttributeNotDefined ;
     }
     catch (AttributeNotKnown &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeNotKnown);
+        exception = e_AttributeNotKnown ;
     }
     catch (AttributeNotOwned &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeNotOwned);
+        exception = e_AttributeNotOwned ;
     }
     catch (AttributeNotPublished &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeNotPublished);
+        exception = e_AttributeNotPublished ;
     }
     catch (AttributeNotSubscribed &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_AttributeNotSubscribed);
+        exception = e_AttributeNotSubscribed ;
     }
     catch (ConcurrentAccessAttempted &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ConcurrentAccessAttempted);
+        exception = e_ConcurrentAccessAttempted ;
     }
     catch (CouldNotDiscover &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_CouldNotDiscover);
+        exception = e_CouldNotDiscover ;
     }
     catch (CouldNotOpenRID &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_CouldNotOpenRID);
+        exception = e_CouldNotOpenRID ;
     }
     catch (CouldNotOpenFED &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_CouldNotOpenFED);
+        exception = e_CouldNotOpenFED ;
     }
     catch (CouldNotRestore &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_CouldNotRestore);
+        exception = e_CouldNotRestore ;
     }
     catch (DeletePrivilegeNotHeld &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_DeletePrivilegeNotHeld);
+        exception = e_DeletePrivilegeNotHeld ;
     }
     catch (ErrorReadingRID &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ErrorReadingRID);
+        exception = e_ErrorReadingRID ;
     }
     catch (EventNotKnown &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_EventNotKnown);
+        exception = e_EventNotKnown ;
     }
     catch (FederateAlreadyPaused &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateAlreadyPaused);
+        exception = e_FederateAlreadyPaused ;
     }
     catch (FederateAlreadyExecutionMember &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateAlreadyExecutionMember);
+        exception = e_FederateAlreadyExecutionMember ;
     }
     catch (FederateDoesNotExist &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateDoesNotExist);
+        exception = e_FederateDoesNotExist ;
     }
     catch (FederateInternalError &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateInternalError);
+        exception = e_FederateInternalError ;
     }
     catch (FederateNameAlreadyInUse &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateNameAlreadyInUse);
+        exception = e_FederateNameAlreadyInUse ;
     }
     catch (FederateNotExecutionMember &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateNotExecutionMember);
+        exception = e_FederateNotExecutionMember ;
     }
     catch (FederateNotPaused &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateNotPaused);
+        exception = e_FederateNotPaused ;
     }
     catch (FederateNotPublishing &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateNotPublishing);
+        exception = e_FederateNotPublishing ;
     }
     catch (FederateNotSubscribing &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateNotSubscribing);
+        exception = e_FederateNotSubscribing ;
     }
     catch (FederateOwnsAttributes &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateOwnsAttributes);
+        exception = e_FederateOwnsAttributes ;
     }
     catch (FederatesCurrentlyJoined &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederatesCurrentlyJoined);
+        exception = e_FederatesCurrentlyJoined ;
     }
     catch (FederateWasNotAskedToReleaseAttribute &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederateWasNotAskedToReleaseAttribute);
+        exception = e_FederateWasNotAskedToReleaseAttribute ;
     }
     catch (FederationAlreadyPaused &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederationAlreadyPaused);
+        exception = e_FederationAlreadyPaused ;
     }
     catch (FederationExecutionAlreadyExists &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederationExecutionAlreadyExists);
+        exception = e_FederationExecutionAlreadyExists ;
     }
     catch (FederationExecutionDoesNotExist &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederationExecutionDoesNotExist);
+        exception = e_FederationExecutionDoesNotExist ;
     }
     catch (FederationNotPaused &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederationNotPaused);
+        exception = e_FederationNotPaused ;
     }
     catch (FederationTimeAlreadyPassed &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_FederationTimeAlreadyPassed);
+        exception = e_FederationTimeAlreadyPassed ;
     }
     catch (IDsupplyExhausted &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_IDsupplyExhausted);
+        exception = e_IDsupplyExhausted ;
     }
     catch (InteractionClassNotDefined &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InteractionClassNotDefined);
+        exception = e_InteractionClassNotDefined ;
     }
     catch (InteractionClassNotKnown &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InteractionClassNotKnown);
+        exception = e_InteractionClassNotKnown ;
     }
     catch (InteractionClassNotPublished &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InteractionClassNotPublished);
+        exception = e_InteractionClassNotPublished ;
     }
     catch (InteractionParameterNotDefined &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InteractionParameterNotDefined);
+        exception = e_InteractionParameterNotDefined ;
     }
     catch (InteractionParameterNotKnown &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InteractionParameterNotKnown);
+        exception = e_InteractionParameterNotKnown ;
     }
     catch (InvalidDivestitureCondition &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidDivestitureCondition);
+        exception = e_InvalidDivestitureCondition ;
     }
     catch (InvalidExtents &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidExtents);
+        exception = e_InvalidExtents ;
     }
     catch (InvalidFederationTime &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidFederationTime);
+        exception = e_InvalidFederationTime ;
     }
     catch (InvalidFederationTimeDelta &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidFederationTimeDelta);
+        exception = e_InvalidFederationTimeDelta ;
     }
     catch (InvalidObjectHandle &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidObjectHandle);
+        exception = e_InvalidObjectHandle ;
     }
     catch (InvalidOrderingHandle &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidOrderingHandle);
+        exception = e_InvalidOrderingHandle ;
     }
     catch (InvalidResignAction &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidResignAction);
+        exception = e_InvalidResignAction ;
     }
     catch (InvalidRetractionHandle &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidRetractionHandle);
+        exception = e_InvalidRetractionHandle ;
     }
     catch (InvalidRoutingSpace &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidRoutingSpace);
+        exception = e_InvalidRoutingSpace ;
     }
     catch (InvalidTransportationHandle &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_InvalidTransportationHandle);
+        exception = e_InvalidTransportationHandle ;
     }
     catch (MemoryExhausted &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_MemoryExhausted);
+        exception = e_MemoryExhausted ;
     }
     catch (NameNotFound &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_NameNotFound);
+        exception = e_NameNotFound ;
     }
     catch (NoPauseRequested &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_NoPauseRequested);
+        exception = e_NoPauseRequested ;
     }
     catch (NoResumeRequested &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_NoResumeRequested);
+        exception = e_NoResumeRequested ;
     }
     catch (ObjectClassNotDefined &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ObjectClassNotDefined);
+        exception = e_ObjectClassNotDefined ;
     }
     catch (ObjectClassNotKnown &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ObjectClassNotKnown);
+        exception = e_ObjectClassNotKnown ;
     }
     catch (ObjectClassNotPublished &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ObjectClassNotPublished);
+        exception = e_ObjectClassNotPublished ;
     }
     catch (ObjectClassNotSubscribed &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ObjectClassNotSubscribed);
+        exception = e_ObjectClassNotSubscribed ;
     }
     catch (ObjectNotKnown &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ObjectNotKnown);
+        exception = e_ObjectNotKnown ;
     }
     catch (ObjectAlreadyRegistered &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ObjectAlreadyRegistered);
+        exception = e_ObjectAlreadyRegistered ;
     }
     catch (RegionNotKnown &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_RegionNotKnown);
+        exception = e_RegionNotKnown ;
     }
     catch (RestoreInProgress &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_RestoreInProgress);
+        exception = e_RestoreInProgress ;
     }
     catch (RestoreNotRequested &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_RestoreNotRequested);
+        exception = e_RestoreNotRequested ;
     }
     catch (RTIinternalError &e) {
         if (e._reason.empty())
@@ -951,110 +1273,116 @@ RTIG::processIncomingMessage(Socket *link) throw (NetworkError)
         else
             D.Out(pdExcept, "Catching \"%s\" exception: %s.", e._name, e._reason.c_str());
         CPY_NOT_NULL(e);
-        rep->setException(e_RTIinternalError);
+        exception = e_RTIinternalError ;
     }
     catch (SaveInProgress &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_SaveInProgress);
+        exception = e_SaveInProgress ;
     }
     catch (SaveNotInitiated &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_SaveNotInitiated);
+        exception = e_SaveNotInitiated ;
     }
     catch (SecurityError &e) {
         cout << endl << "Security Error : " << e._reason << endl ;
         CPY_NOT_NULL(e);
-        rep->setException(e_SecurityError);
+        exception = e_SecurityError ;
     }
     catch (SpaceNotDefined &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_SpaceNotDefined);
+        exception = e_SpaceNotDefined ;
     }
     catch (SpecifiedSaveLabelDoesNotExist &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_SpecifiedSaveLabelDoesNotExist);
+        exception = e_SpecifiedSaveLabelDoesNotExist ;
     }
     catch (TimeAdvanceAlreadyInProgress &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_TimeAdvanceAlreadyInProgress);
+        exception = e_TimeAdvanceAlreadyInProgress ;
     }
     catch (TimeAdvanceWasNotInProgress &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_TimeAdvanceWasNotInProgress);
+        exception = e_TimeAdvanceWasNotInProgress ;
     }
     catch (TooManyIDsRequested &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_TooManyIDsRequested);
+        exception = e_TooManyIDsRequested ;
     }
     catch (UnableToPerformSave &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_UnableToPerformSave);
+        exception = e_UnableToPerformSave ;
     }
     catch (UnimplementedService &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_UnimplementedService);
+        exception = e_UnimplementedService ;
     }
     catch (UnknownLabel &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_UnknownLabel);
+        exception = e_UnknownLabel ;
     }
     catch (ValueCountExceeded &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ValueCountExceeded);
+        exception = e_ValueCountExceeded ;
     }
     catch (ValueLengthExceeded &e) {
         D.Out(pdExcept, "Catching \"%s\" exception.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_ValueLengthExceeded);
+        exception = e_ValueLengthExceeded ;
     }
 
     // Non RTI specific exception, Client connection problem(internal)
     catch (NetworkError &e) {
         strcpy(buffer, " - NetworkError");
-        auditServer.endLine(rep->getException(), buffer);
-        delete msg;
+        auditServer.endLine(exception, buffer);
+        MessagePool::release(msg);
         throw e ;
     }
     // Default Handler
     catch (Exception &e) {
         D.Out(pdExcept, "Unknown Exception : %s.", e._name);
         CPY_NOT_NULL(e);
-        rep->setException(e_RTIinternalError);
+        exception = e_RTIinternalError ;
     }
 
     // buffer may contain an exception reason. If not, set it to OK
     // or Exception
     if (strlen(buffer)== 0) {
-        if (rep->getException() == e_NO_EXCEPTION)
+        if (exception == e_NO_EXCEPTION)
             strcpy(buffer, " - OK");
         else
             strcpy(buffer, " - Exception");
     }
 
-    auditServer.endLine(rep->getException(), buffer);
-    delete msg;
+    auditServer.endLine(exception, buffer);
+    EventTrace::record(TRACE_RTIG_DISPATCH, msg->getMessageType(), msg->getFederation(),
+                       msg->getFederate(), 0, exception);
+    NetworkMessage::Type type = msg->getMessageType();
+    MessagePool::release(msg);
     if (link == NULL) return link ;
 
     /* FIXME ***/
-    if (rep->getException() != e_NO_EXCEPTION) {
+    if (exception != e_NO_EXCEPTION) {
         G.Out(pdGendoc,"            processIncomingMessage ===> write on exception to RTIA");
+        std::auto_ptr<NetworkMessage> rep(NM_Factory::create(type));
+        rep->setFederate(federate);
+        rep->setException(exception);
         rep->send(link,NM_msgBufSend);
         D.Out(pdExcept,
               "RTIG catched exception %d and sent it back to federate %d.",
               rep->getException(), rep->getFederate());
     }
-    G.Out(pdGendoc,"exit  RTIG::processIncomingMessage");
+    G.Out(pdGendoc,"exit  RTIG::processMessage");
     return link ;
 }
 
@@ -33,6 +33,10 @@
 #include "HandleManager.hh"
 
 #include <string>
+#include <vector>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 namespace certi {
 namespace rtig {
@@ -47,6 +51,13 @@ namespace rtig {
  *   <li> one part for treating the received message. </li>
  *   <li> another part generating and sending back a response. </li>
  * </li>
+ *
+ * When CERTI_RTIG_SHARDS is set to N > 1, the federations are spread over N
+ * shards by a hash of their name. Each shard is an RTIG running its own event
+ * loop in a worker thread, with its own links, federations and audit file.
+ * The RTIG started by main only accepts connections: the link of a federate
+ * is handed over to the shard hosting the federation named by its first
+ * create, join or destroy request, and stays there once joined.
  */
 class RTIG
 {
@@ -61,10 +72,38 @@ public:
     void execute() throw (NetworkError);
 
 private:
-    // Both methods return the socket, because it may have been closed
-    // & deleted.
+    /** A shard of the RTIG acceptor. */
+    RTIG(RTIG &acceptor, unsigned int index);
+
+    // These methods return the socket, because it may have been closed
+    // & deleted, or handed over to another shard.
     Socket* processIncomingMessage(Socket*) throw (NetworkError) ;
+    Socket* processMessage(Socket*, NetworkMessage *) throw (NetworkError) ;
     Socket* chooseProcessingMethod(Socket*, NetworkMessage *);
+    /** Process msg (if not NULL) then every message already received on link. */
+    void processLink(SocketTCP *link, NetworkMessage *msg);
+
+    /** The RTIG hosting the federation named by msg, this one if none. */
+    RTIG *hostOf(NetworkMessage *msg);
+    void handOver(SocketTuple *tuple, NetworkMessage *msg);
+    void dropHandoffs();
+#ifndef _WIN32
+    void startShards(unsigned int count);
+    void stopShards();
+    void executeShard();
+    static void *runShard(void *shard);
+#endif
+
+    /** Serializes federation creations and destructions over the shards,
+        which share the federation handles and the FOM parsers. */
+    class CreationLock
+    {
+    public:
+        CreationLock(RTIG &rtig);
+        ~CreationLock();
+    private:
+        RTIG &acceptor ;
+    };
 
     void openConnection();
     void closeConnection(Socket*, bool emergency);
@@ -96,6 +135,8 @@ private:
     void processPublishObjectClass(Socket*, NM_Publish_Object_Class*);
     void processSubscribeObjectClass(Socket*, NM_Subscribe_Object_Class*);
     void processPublishInteractionClass(Socket*, NM_Publish_Interaction_Class*);
+    void processChangeAttributeTransportType(Socket*, NM_Change_Attribute_Transport_Type*);
+    void processChangeInteractionTransportType(Socket*, NM_Change_Interaction_Transport_Type*);
     void processSubscribeInteractionClass(Socket*, NM_Subscribe_Interaction_Class*);
     void processUnpublishInteractionClass(Socket*, NetworkMessage*);
     void processUnsubscribeInteractionClass(Socket*, NetworkMessage*msg);
@@ -141,6 +182,26 @@ private:
     MessageBuffer NM_msgBufSend;
     /* The message buffer used to receive Network messages */
     MessageBuffer NM_msgBufReceive;
+
+    /* The RTIG accepting the connections, this one if not a shard */
+    RTIG *acceptor ;
+    std::vector<RTIG *> shards ;
+
+    /* A link handed over by another RTIG, with the request naming a
+       federation of this one */
+    struct Handoff {
+        SocketTuple *tuple ;
+        NetworkMessage *msg ;
+    };
+    std::vector<Handoff> handoffs ;
+#ifndef _WIN32
+    pthread_mutex_t handoffLock ;
+    pthread_mutex_t creationLock ;
+    pthread_t thread ;
+    /* Wakes up the event loop of a shard: handoffs or termination */
+    int wakeup[2] ;
+    bool stopping ;
+#endif
 };
 
 }} // namespaces
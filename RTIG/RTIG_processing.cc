@@ -58,7 +58,10 @@ RTIG::processCreateFederation(Socket *link, NM_Create_Federation_Execution *req)
 	}
 
 	auditServer << "Federation Name : " << federation;
-	Handle h = federationHandles.provide();
+	// The handles are unique over the shards and the FOM parsers are not
+	// reentrant.
+	CreationLock lock(*this);
+	Handle h = acceptor->federationHandles.provide();
 
 #ifdef FEDERATION_USES_MULTICAST
 	// multicast base address
@@ -129,8 +132,11 @@ RTIG::processJoinFederation(Socket *link, NM_Join_Federation_Execution *req)
 	std::string federation = req->getFederationName();
 	std::string federate   = req->getFederateName();
 
+	// The best effort messages go to the address the RTIA link comes from:
+	// the one the RTIA advertises is that of its host name, which may
+	// resolve to a loopback or another interface. Only its port is used.
 	unsigned int peer     = req->getBestEffortPeer();
-	unsigned long address = req->getBestEffortAddress();
+	unsigned long address = link->returnAdress();
 
 	FederateHandle num_federe ;
 
@@ -193,6 +199,9 @@ RTIG::processJoinFederation(Socket *link, NM_Join_Federation_Execution *req)
     std::cout << "(" << num_federation << ") with handle " << num_federe
 			<< ". Socket " << int(link->returnSocket()) <<" and IP-address " << link->addr2string(address) << "\n";
 
+	federations.setDataPeer(num_federation, num_federe, req->getBestEffortAddress(),
+			req->getDataPeer());
+
 	// Prepare answer about JoinFederationExecution
 	rep.setFederationName(federation);
 	rep.setFederate(num_federe);
@@ -239,6 +248,9 @@ RTIG::processResignFederation(Socket *link,Handle federation,
 	reponse.setFederation(federation);
 	reponse.send(link,NM_msgBufSend);
 
+	// The link may now join a federation of another shard.
+	socketServer.clearReferences(link->returnSocket());
+
 	G.Out(pdGendoc,"exit RTIG::processResignFederation");
 	G.Out(pdGendoc,"END ** RESIGN FEDERATION SERVICE **");
 
@@ -263,9 +275,10 @@ RTIG::processDestroyFederation(Socket *link, NM_Destroy_Federation_Execution *re
 	//           FederatesCurrentlyJoined
 	//           FederationExecutionDoesNotExist
 	try {
+		CreationLock lock(*this);
 		federations.destroyFederation(num_federation);
 		// Here delete federation (num_federation) has been done
-		federationHandles.free(num_federation);
+		acceptor->federationHandles.free(num_federation);
 		D.Out(pdInit, "Federation \"%s\" has been destroyed.", federation.c_str());
 	}
 	catch (Exception &e)
@@ -812,6 +825,54 @@ RTIG::processPublishInteractionClass(Socket *link, NM_Publish_Interaction_Class
 	}
 }
 
+// ----------------------------------------------------------------------------
+// processChangeAttributeTransportType
+void
+RTIG::processChangeAttributeTransportType(Socket *link, NM_Change_Attribute_Transport_Type *req)
+{
+	auditServer << "Object = " << req->getObject()
+			<< ", # of att. = " << req->getAttributesSize()
+			<< ", transport = " << req->getTransport() ;
+	federations.changeAttributeTransportationType(req->getFederation(),
+			req->getFederate(),
+			req->getObject(),
+			req->getAttributes(),
+			req->getTransport());
+
+	D.Out(pdRequest, "Federate %u of Federation %u changes the transport of "
+			"object %u.",
+			req->getFederate(), req->getFederation(), req->getObject());
+
+	NM_Change_Attribute_Transport_Type rep ;
+	rep.setFederate(req->getFederate());
+	rep.setObject(req->getObject());
+
+	rep.send(link,NM_msgBufSend); // send answer to RTIA
+}
+
+// ----------------------------------------------------------------------------
+// processChangeInteractionTransportType
+void
+RTIG::processChangeInteractionTransportType(Socket *link, NM_Change_Interaction_Transport_Type *req)
+{
+	auditServer << "Interaction Class = " << req->getInteractionClass()
+			<< ", transport = " << req->getTransport() ;
+	federations.changeInteractionTransportationType(req->getFederation(),
+			req->getFederate(),
+			req->getInteractionClass(),
+			req->getTransport());
+
+	D.Out(pdRequest, "Federate %u of Federation %u changes the transport of "
+			"interaction %u.",
+			req->getFederate(), req->getFederation(), req->getInteractionClass());
+
+	NM_Change_Interaction_Transport_Type rep ;
+	rep.setFederate(req->getFederate());
+	rep.setInteractionClass(req->getInteractionClass());
+
+	rep.send(link,NM_msgBufSend); // send answer to RTIA
+}
+
 // ----------------------------------------------------------------------------
 // processSubscribeInteractionClass
 void
@@ -23,6 +23,7 @@
 #include "RTIG.hh"
 #include "RTIG_cmdline.h"
 #include "certi.hh"
+#include "EventTrace.hh"
 
 #ifdef _WIN32
 #include <signal.h>
@@ -86,6 +87,11 @@ throw (MemoryExhausted)
  *      <li> 60400 or, </li>
  *      <li> the value of environment variable CERTI_TCP_PORT if it is defined</li>
  *    </ol>
+ * Connections are watched with epoll on Linux and with select elsewhere,
+ * the environment variable CERTI_POLLER ("select" or "epoll") may be used
+ * to force one of them. When CERTI_RTIG_SHARDS is set to N > 1, the
+ * federations are served by N worker threads, each one running its own event
+ * loop for the federations whose name hashes to it.
  * The RTIG exchange messages with the \ref certi_executable_RTIA in order
  * to satify HLA request coming from the Federate.
  * In particular RTIG is responsible for giving to the Federate (through its RTIA)
@@ -128,6 +134,7 @@ int main(int argc, char *argv[])
 #endif
 
     std::set_new_handler(NewHandler);
+    EventTrace::configure("rtig");
 
     myRTIG.setVerboseLevel(verboseLevel);
     try {
@@ -236,12 +236,6 @@ typedef basic_stringize<wchar_t> wstringize;
 // You can comment the next line out if you don't want to use Multicast.
 // #define FEDERATION_USES_MULTICAST
 
-// If this macro is defined, some messages will be sent on UDP sockets
-// by the RTIG to the RTIAs. Some messages types are NULL messages, and
-// all Reflect Attributes Values messages, and Receive Interaction messages,
-// even those with data asking for a "RELIABLE" service level.
-// #define HLA_USES_UDP
-
 // The next macro must contain the path name of the Audit File. It should
 // be an absolute path, but it may be a relative path for testing reasons.
 #define RTIG_AUDIT_FILENAME "RTIG.log"
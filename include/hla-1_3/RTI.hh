@@ -72,6 +72,9 @@ public:
 #include "RTIambServices.hh"
 	RTIambPrivateData *privateData ;
     private:
+	void startRTIA(RTIALocation rtia)
+	    throw (MemoryExhausted, RTIinternalError);
+
 	RTIambPrivateRefs* privateRefs ;
     };
 
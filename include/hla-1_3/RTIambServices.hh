@@ -813,6 +813,23 @@ void setAffinityforRTIAProcess(cpu_set_t mask)
 RTIambassador()
     throw (MemoryExhausted, RTIinternalError);
 
+/**
+ * Where the RTIA of an ambassador runs (CERTI extension): as
+ * CERTI_RTIA_THREAD says, in an rtia process, or on a thread of the
+ * federate process.
+ */
+enum RTIALocation { RTIA_FROM_ENVIRONMENT, RTIA_PROCESS, RTIA_THREAD };
+
+/**
+ * Create an ambassador whose RTIA runs at the given location, whatever
+ * CERTI_RTIA_THREAD says. The default constructor uses RTIA_FROM_ENVIRONMENT.
+ * @param rtia where the RTIA runs; RTIA_THREAD is refused with
+ *        RTIinternalError on Windows and when the RTIA link uses TCP
+ * @warning This is a non-standard extension of the HLA 1.3 API.
+ */
+explicit RTIambassador(RTIALocation rtia)
+    throw (MemoryExhausted, RTIinternalError);
+
 ~RTIambassador()
     throw (RTIinternalError);
 
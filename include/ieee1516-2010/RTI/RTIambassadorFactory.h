@@ -39,6 +39,16 @@ namespace rti1516e
       std::auto_ptr< RTIambassador > createRTIambassador ()
          throw (
             RTIinternalError);
+
+      // CERTI extension: where the RTIA of the ambassador runs, the
+      // standard createRTIambassador() following CERTI_RTIA_THREAD.
+      // RTIA_THREAD is refused with RTIinternalError on Windows and when
+      // the RTIA link uses TCP.
+      enum RTIALocation { RTIA_FROM_ENVIRONMENT, RTIA_PROCESS, RTIA_THREAD };
+
+      std::auto_ptr< RTIambassador > createRTIambassador (RTIALocation rtia)
+         throw (
+            RTIinternalError);
    };
 }
 
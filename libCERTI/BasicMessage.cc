@@ -23,6 +23,7 @@
 
 
 #include "BasicMessage.hh"
+#include "MessagePool.hh"
 #include "PrettyDebug.hh"
 
 #include <cassert>
@@ -46,6 +47,14 @@ BasicMessage::~BasicMessage() {
 	
 } /* end of ~BasicMessage */
 
+void *BasicMessage::operator new(size_t size) {
+	return MessagePool::allocate(size);
+} /* end of operator new */
+
+void BasicMessage::operator delete(void *block, size_t size) {
+	MessagePool::deallocate(block, size);
+} /* end of operator delete */
+
 std::ostream& BasicMessage::show(std::ostream& out) {
 	out << "[BasicMessage -Begin]" << std::endl;
 	if (_isDated) {
@@ -120,13 +129,14 @@ void BasicMessage::deserialize(MessageBuffer& msgBuffer) {
 		date = msgBuffer.read_double();
 		D.Out(pdDebug, "Received Message date is  <%f>", date.getTime());
 	}
+	/* read in place, reusing the storage of a recycled message */
 	_isLabelled = msgBuffer.read_bool();
 	if (_isLabelled) {
-		setLabel(msgBuffer.read_string());
+		msgBuffer.read_string(label);
 	}
 	_isTagged = msgBuffer.read_bool();
 	if (_isTagged) {
-	    setTag(msgBuffer.read_string());
+		msgBuffer.read_string(tag);
 	}
 } /* end of deserialize */
 
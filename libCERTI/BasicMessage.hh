@@ -65,10 +65,10 @@ public:
 	{
 		_isTagged = true; 
 		tag = new_tag;
-		wTag = std::wstring(new_tag.begin(), new_tag.end());
 	};
 	const std::string& getTag() const {return this->tag;};
-	const std::wstring& getTagW() const { return this->wTag; }
+	/** Wide copy of the tag, made on demand: few messages need it. */
+	std::wstring getTagW() const { return std::wstring(tag.begin(), tag.end()); }
 
 	/**
 	 * Indicate if the message is Labelled or not
@@ -78,10 +78,10 @@ public:
 	{
 		_isLabelled = true; 
 		label = new_label;
-		wLabel = std::wstring(new_label.begin(), new_label.end());
 	}
 	const std::string& getLabel() const {return this->label;};
-	const std::wstring& getLabelW() const { return this->wLabel; }
+	/** Wide copy of the label, made on demand. */
+	std::wstring getLabelW() const { return std::wstring(label.begin(), label.end()); }
 
 	void setExtents(const std::vector<Extent> &);
 	const std::vector<Extent> &getExtents() const ;
@@ -92,6 +92,12 @@ public:
 
 	virtual std::ostream& show(std::ostream& out);
 
+	/**
+	 * Messages are allocated from the free lists of MessagePool.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *block, size_t size);
+
 protected:
 	BasicMessage();
 	virtual ~BasicMessage();
@@ -139,7 +145,6 @@ protected:
 	 * getter/setter.
 	 */
 	std::string tag;
-	std::wstring wTag;
 	/**
 	 * True is the message contains a tag
 	 * When a message is tagged the tag is transmitted
@@ -153,7 +158,6 @@ protected:
 	 * getter/setter.
 	 */
 	std::string label;
-	std::wstring wLabel;
 
 	/**
 	 * True is the message contains a label
@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "CallbackBatch.hh"
+#include "M_Classes.hh"
+#include "MessagePool.hh"
+#include "PrettyDebug.hh"
+
+namespace certi {
+
+static PrettyDebug D("CALLBACK_BATCH", __FILE__);
+
+// ----------------------------------------------------------------------------
+CallbackBatch::CallbackBatch()
+{
+}
+
+// ----------------------------------------------------------------------------
+CallbackBatch::~CallbackBatch()
+{
+    for (std::deque<Message *>::iterator i = callbacks.begin(); i != callbacks.end(); ++i)
+        delete *i ;
+}
+
+// ----------------------------------------------------------------------------
+Message *
+CallbackBatch::receive(SocketUN *socket) throw (NetworkError, NetworkSignal)
+{
+    if (callbacks.empty()) {
+        Message *msg = M_Factory::receive(socket);
+        if (msg->getMessageType() != Message::TICK_CALLBACKS)
+            return msg ;
+
+        uint32_t count = static_cast<M_Tick_Callbacks *>(msg)->getCount();
+        MessagePool::release(msg);
+        D.Out(pdDebug, "Reading a batch of %u callbacks.", count);
+        for (uint32_t i = 0 ; i < count ; ++i)
+            callbacks.push_back(M_Factory::receive(socket));
+        if (callbacks.empty())
+            throw NetworkError("Empty callback batch.");
+    }
+
+    Message *msg = callbacks.front();
+    callbacks.pop_front();
+    return msg ;
+}
+
+} // namespace certi
@@ -0,0 +1,61 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_CALLBACK_BATCH_HH
+#define CERTI_CALLBACK_BATCH_HH
+
+#include "certi.hh"
+#include "Message.hh"
+#include "SocketUN.hh"
+
+#include <deque>
+
+namespace certi {
+
+/**
+ * Messages read by the libRTI tick() from the RTIA.
+ * When the RTIA sends its callbacks by batches (CERTI_TICK_BATCH), a whole
+ * batch is read before its first callback is delivered, since the federate
+ * may call the RTIA from within the callbacks and wait for the answer.
+ */
+class CERTI_EXPORT CallbackBatch
+{
+public:
+    CallbackBatch();
+
+    /** Delete the callbacks which were not delivered. */
+    ~CallbackBatch();
+
+    /**
+     * Return the next message from the RTIA: the next callback of the
+     * current batch, or a message read from the socket. The caller owns
+     * the message.
+     */
+    Message *receive(SocketUN *socket) throw (NetworkError, NetworkSignal);
+
+    /** Return true if callbacks of the current batch are still to be delivered. */
+    bool pending() const { return !callbacks.empty(); };
+
+private:
+    std::deque<Message *> callbacks ;
+};
+
+} // namespace certi
+
+#endif // CERTI_CALLBACK_BATCH_HH
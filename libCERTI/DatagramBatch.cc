@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include <config.h>
+#include "DatagramBatch.hh"
+#include "PrettyDebug.hh"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace certi {
+
+static PrettyDebug D("DATAGRAMS", "(DatagramBatch) - ");
+
+namespace {
+
+/** IPv4 and UDP headers. */
+const size_t HEADERS = 28 ;
+
+/** Largest UDP payload over IPv4. */
+const size_t MAX_PAYLOAD = 65507 ;
+
+/** append() flushes once this number of datagrams is pending. */
+const size_t MAX_PENDING = 64 ;
+
+size_t
+getConfiguredPayload()
+{
+    const char *mtu = getenv("CERTI_UDP_MTU");
+    long value = mtu == NULL ? 1500 : atol(mtu);
+    if (value < 576)
+        value = 576 ;
+    size_t size = static_cast<size_t>(value) - HEADERS ;
+    return size > MAX_PAYLOAD ? MAX_PAYLOAD : size ;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+DatagramBatch::DatagramBatch()
+    : fd(-1), payload(getConfiguredPayload()), count(0), dropped(0)
+{
+}
+
+// ----------------------------------------------------------------------------
+void
+DatagramBatch::append(const struct sockaddr_in &to, const unsigned char *data, size_t size)
+    throw (NetworkError)
+{
+    if (size > payload)
+        throw NetworkError("Message larger than a datagram");
+
+    Destination destination(to.sin_addr.s_addr, to.sin_port);
+    std::map<Destination, size_t>::iterator o = open.find(destination);
+    if (o != open.end() && pending[o->second].bytes.size() + size <= payload) {
+        std::vector<unsigned char> &bytes = pending[o->second].bytes ;
+        bytes.insert(bytes.end(), data, data + size);
+        return ;
+    }
+
+    if (count == pending.size())
+        pending.push_back(Datagram());
+    Datagram &datagram = pending[count] ;
+    datagram.to = to ;
+    datagram.bytes.assign(data, data + size);
+    open[destination] = count++ ;
+
+    if (count >= MAX_PENDING)
+        flush();
+}
+
+// ----------------------------------------------------------------------------
+void
+DatagramBatch::flush()
+{
+    if (count == 0)
+        return ;
+
+    size_t sent = 0 ;
+#ifdef HAVE_SENDMMSG
+    std::vector<struct mmsghdr> headers(count);
+    std::vector<struct iovec> vectors(count);
+    for (size_t i = 0 ; i < count ; ++i) {
+        vectors[i].iov_base = &pending[i].bytes[0] ;
+        vectors[i].iov_len = pending[i].bytes.size();
+        memset(&headers[i], 0, sizeof(struct mmsghdr));
+        headers[i].msg_hdr.msg_name = &pending[i].to ;
+        headers[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        headers[i].msg_hdr.msg_iov = &vectors[i] ;
+        headers[i].msg_hdr.msg_iovlen = 1 ;
+    }
+    while (sent < count) {
+        int result = sendmmsg(fd, &headers[sent], count - sent, 0);
+        if (result > 0) {
+            sent += result ;
+        }
+        else if (errno != EINTR) {
+            // The datagram in front is not taken: drop it and go on.
+            D.Out(pdExcept, "Datagram dropped: %s.", strerror(errno));
+            ++dropped ;
+            ++sent ;
+        }
+    }
+#else
+    for ( ; sent < count ; ++sent) {
+        const Datagram &datagram = pending[sent] ;
+        if (sendto(fd, reinterpret_cast<const char *>(&datagram.bytes[0]),
+                   datagram.bytes.size(), 0,
+                   reinterpret_cast<const struct sockaddr *>(&datagram.to),
+                   sizeof(struct sockaddr_in)) < 0) {
+            D.Out(pdExcept, "Datagram dropped: %s.", strerror(errno));
+            ++dropped ;
+        }
+    }
+#endif
+
+    count = 0 ;
+    open.clear();
+}
+
+} // namespace certi
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_DATAGRAM_BATCH_HH
+#define CERTI_DATAGRAM_BATCH_HH
+
+#include "Socket.hh"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace certi {
+
+/**
+ * The datagrams an RTIG event loop has to send on its UDP socket.
+ *
+ * The best effort messages sent to a federate through its SocketUDP link
+ * are appended to the datagram being filled for the address of its RTIA,
+ * so that the small messages sent to the same RTIA in a row share a
+ * datagram, up to the payload size. flush() sends every pending datagram,
+ * with a single sendmmsg call where available; the RTIG calls it once it
+ * has serviced the links reported ready, and append() when too many
+ * datagrams are pending.
+ *
+ * A datagram the socket cannot take is dropped, as best effort allows.
+ */
+class CERTI_EXPORT DatagramBatch
+{
+public:
+    /** The payload size comes from CERTI_UDP_MTU (default 1500 bytes). */
+    DatagramBatch();
+
+    /** Set the UDP socket of the RTIG, which the datagrams are sent on. */
+    void setSocket(SOCKET socket) { fd = socket ; }
+
+    /** Largest message the batch takes, IP and UDP headers excluded. */
+    size_t getPayload() const { return payload ; }
+
+    /**
+     * Queue a message for the given address. The message must not be
+     * larger than the payload.
+     */
+    void append(const struct sockaddr_in &to, const unsigned char *data, size_t size)
+        throw (NetworkError);
+
+    /** Send the pending datagrams. */
+    void flush();
+
+    bool empty() const { return count == 0 ; }
+
+    /** Number of datagrams dropped since the creation of the batch. */
+    unsigned long getDropped() const { return dropped ; }
+
+private:
+    struct Datagram {
+        struct sockaddr_in to ;
+        std::vector<unsigned char> bytes ;
+    };
+    typedef std::pair<unsigned long, unsigned short> Destination ;
+
+    SOCKET fd ;
+    size_t payload ;
+    std::vector<Datagram> pending ; //!< Storage kept from one flush to the next
+    size_t count ;                  //!< Pending datagrams at the start of the vector
+    std::map<Destination, size_t> open ; //!< Datagram being filled by destination
+    unsigned long dropped ;
+};
+
+} // namespace certi
+
+#endif // CERTI_DATAGRAM_BATCH_HH
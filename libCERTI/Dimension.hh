@@ -35,7 +35,7 @@ namespace certi {
  * Describes a dimension in a routing space.
  * @sa RoutingSpace
  */
-class Dimension : public Named, public Handled<DimensionHandle>
+class CERTI_EXPORT Dimension : public Named, public Handled<DimensionHandle>
 {
 public:
 	/**
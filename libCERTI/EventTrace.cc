@@ -0,0 +1,251 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "EventTrace.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#ifndef _WIN32
+#include <pthread.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CERTI_TRACE_USES_TSC
+#endif
+
+namespace certi {
+
+bool EventTrace::enabled = false ;
+const uint32_t EventTrace::FORMAT_VERSION ;
+
+#ifndef _WIN32
+namespace {
+
+const uint32_t MAX_RINGS = 256 ;
+
+/** A cache line each, not to share the counters between threads. */
+struct Ring {
+    volatile uint64_t written ;
+    TraceEvent *events ;
+    uint32_t mask ;
+    uint16_t thread ;
+    char padding[64 - 2 * sizeof(uint64_t) - sizeof(TraceEvent *)] ;
+};
+
+/** The rings are never freed: a dump may happen at any time. */
+Ring *rings[MAX_RINGS] ;
+volatile uint32_t ringCount = 0 ;
+uint32_t capacity = 0 ;
+pthread_mutex_t ringLock = PTHREAD_MUTEX_INITIALIZER ;
+
+/** Ring of the threads started once MAX_RINGS rings exist: nothing recorded. */
+Ring noRing ;
+__thread Ring *threadRing = NULL ;
+
+TraceFileHeader fileHeader ;
+char fileName[64] ;
+
+// ----------------------------------------------------------------------------
+uint64_t
+monotonicNanoseconds()
+{
+    struct timespec now ;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec ;
+}
+
+// ----------------------------------------------------------------------------
+Ring *
+attachRing()
+{
+    pthread_mutex_lock(&ringLock);
+    Ring *ring = &noRing ;
+    if (ringCount < MAX_RINGS) {
+        ring = new Ring ;
+        ring->events = new TraceEvent[capacity] ;
+        memset(ring->events, 0, capacity * sizeof(TraceEvent));
+        ring->mask = capacity - 1 ;
+        ring->thread = ringCount ;
+        ring->written = 0 ;
+        rings[ringCount] = ring ;
+        // A dump only reads the rings counted.
+        __sync_synchronize();
+        ringCount = ringCount + 1 ;
+    }
+    pthread_mutex_unlock(&ringLock);
+    threadRing = ring ;
+    return ring ;
+}
+
+// ----------------------------------------------------------------------------
+void
+writeAll(int fd, const void *data, size_t length)
+{
+    const char *bytes = static_cast<const char *>(data);
+    while (length > 0) {
+        ssize_t written = write(fd, bytes, length);
+        if (written <= 0)
+            return ;
+        bytes += written ;
+        length -= written ;
+    }
+}
+
+// ----------------------------------------------------------------------------
+extern "C" void
+dumpOnSignal(int)
+{
+    EventTrace::dump();
+}
+
+// ----------------------------------------------------------------------------
+extern "C" void
+dumpAtExit()
+{
+    EventTrace::dump();
+}
+
+} // anonymous namespace
+#endif
+
+// ----------------------------------------------------------------------------
+void
+EventTrace::configure(const char *process)
+{
+#ifndef _WIN32
+    const char *env = getenv("CERTI_TRACE");
+    if (env == NULL || atoi(env) <= 0)
+        return ;
+
+    pthread_mutex_lock(&ringLock);
+    if (enabled) {
+        // An RTIA running on a thread of its federate shares its trace.
+        pthread_mutex_unlock(&ringLock);
+        return ;
+    }
+    capacity = 1 ;
+    while (capacity < static_cast<uint32_t>(atoi(env)) && capacity < (1U << 24))
+        capacity <<= 1 ;
+
+    memset(&fileHeader, 0, sizeof(fileHeader));
+    memcpy(fileHeader.magic, "CERTITRC", sizeof(fileHeader.magic));
+    fileHeader.version = FORMAT_VERSION ;
+    fileHeader.eventSize = sizeof(TraceEvent);
+    fileHeader.pid = getpid();
+    strncpy(fileHeader.process, process, sizeof(fileHeader.process) - 1);
+    fileHeader.startTicks = getTicks();
+    fileHeader.startNanoseconds = monotonicNanoseconds();
+    snprintf(fileName, sizeof(fileName), "%s.%u.trace", fileHeader.process, fileHeader.pid);
+
+    // Leave alone a handler installed by the application.
+    struct sigaction action ;
+    if (sigaction(SIGUSR2, NULL, &action) == 0 && action.sa_handler == SIG_DFL) {
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = dumpOnSignal ;
+        action.sa_flags = SA_RESTART ;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGUSR2, &action, NULL);
+    }
+    atexit(dumpAtExit);
+    enabled = true ;
+    pthread_mutex_unlock(&ringLock);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+uint64_t
+EventTrace::getTicks()
+{
+#ifdef CERTI_TRACE_USES_TSC
+    return __rdtsc();
+#elif !defined(_WIN32)
+    return monotonicNanoseconds();
+#else
+    return 0 ;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+void
+EventTrace::append(TracePoint point, uint32_t type, uint32_t federation,
+                   uint32_t federate, uint32_t handle, uint32_t size)
+{
+#ifndef _WIN32
+    Ring *ring = threadRing ;
+    if (ring == NULL)
+        ring = attachRing();
+    if (ring == &noRing)
+        return ;
+
+    uint64_t written = ring->written ;
+    TraceEvent &event = ring->events[written & ring->mask] ;
+    event.time = getTicks();
+    event.type = type ;
+    event.federation = federation ;
+    event.federate = federate ;
+    event.handle = handle ;
+    event.size = size ;
+    event.point = point ;
+    event.thread = ring->thread ;
+    ring->written = written + 1 ;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+void
+EventTrace::dump()
+{
+#ifndef _WIN32
+    if (!enabled)
+        return ;
+    int fd = ::open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        return ;
+
+    TraceFileHeader header = fileHeader ;
+    header.rings = ringCount ;
+    header.dumpTicks = getTicks();
+    header.dumpNanoseconds = monotonicNanoseconds();
+    writeAll(fd, &header, sizeof(header));
+
+    for (uint32_t r = 0 ; r < header.rings ; ++r) {
+        const Ring *ring = rings[r] ;
+        TraceRingHeader ringHeader ;
+        ringHeader.thread = ring->thread ;
+        ringHeader.capacity = capacity ;
+        ringHeader.written = ring->written ;
+        writeAll(fd, &ringHeader, sizeof(ringHeader));
+
+        // Oldest event first, the ring may have wrapped around.
+        uint64_t kept = ringHeader.written < capacity ? ringHeader.written : capacity ;
+        uint32_t first = (ringHeader.written - kept) & ring->mask ;
+        uint32_t tail = capacity - first < kept ? capacity - first : kept ;
+        writeAll(fd, ring->events + first, tail * sizeof(TraceEvent));
+        writeAll(fd, ring->events, (kept - tail) * sizeof(TraceEvent));
+    }
+    close(fd);
+#endif
+}
+
+} // namespace certi
@@ -0,0 +1,120 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_EVENT_TRACE_HH
+#define CERTI_EVENT_TRACE_HH
+
+#include "certi.hh"
+
+namespace certi {
+
+/** Points of the message path where EventTrace records events. */
+enum TracePoint {
+    TRACE_RTIG_RECEIVE = 1,  //!< RTIG read a message from a link
+    TRACE_RTIG_DISPATCH,     //!< RTIG processed the message, size: exception
+    TRACE_RTIG_BROADCAST,    //!< RTIG broadcasting a message, size: federates listed
+    TRACE_NETWORK_SEND,      //!< Network message written, handle: socket
+    TRACE_RTIA_RECEIVE,      //!< RTIA read a message from the network
+    TRACE_RTIA_REQUEST,      //!< RTIA read a request of its federate
+    TRACE_RTIA_CALLBACK,     //!< RTIA sent a callback to its federate
+    TRACE_TICK_BEGIN,        //!< Federate entering tick()
+    TRACE_TICK_CALLBACK,     //!< Federate delivering a callback in tick()
+    TRACE_TICK_END           //!< Federate leaving tick()
+};
+
+/**
+ * A traced event, written as is in the trace files. The type is a
+ * NetworkMessage::Type, or a Message::Type for the points between a
+ * federate and its RTIA.
+ */
+struct TraceEvent {
+    uint64_t time ;       //!< Ticks, see EventTrace::getTicks
+    uint32_t type ;
+    uint32_t federation ;
+    uint32_t federate ;
+    uint32_t handle ;     //!< Object or interaction class, if known
+    uint32_t size ;       //!< Bytes, unless stated by the point
+    uint16_t point ;      //!< TracePoint
+    uint16_t thread ;     //!< Rank of the ring of the thread
+};
+
+/** Header of a trace file, followed by the rings of the threads. */
+struct TraceFileHeader {
+    char magic[8] ;       //!< "CERTITRC"
+    uint32_t version ;
+    uint32_t eventSize ;
+    uint32_t pid ;
+    uint32_t rings ;
+    char process[16] ;    //!< Name given to EventTrace::configure
+    /** Ticks and monotonic clock nanoseconds, at start and at dump. */
+    uint64_t startTicks, startNanoseconds ;
+    uint64_t dumpTicks, dumpNanoseconds ;
+};
+
+/** Header of a ring in a trace file, followed by its events, oldest first. */
+struct TraceRingHeader {
+    uint32_t thread ;
+    uint32_t capacity ;
+    uint64_t written ;    //!< Events recorded, the oldest ones overwritten
+};
+
+/**
+ * Binary event tracing of the message path, to measure latencies without
+ * the cost of PrettyDebug or of the RTIG audit.
+ *
+ * Each thread records fixed size events in its own ring, without any lock,
+ * the oldest events being overwritten. The rings are written in a file
+ * named <process>.<pid>.trace when the process receives SIGUSR2 and when
+ * it exits; CertiTraceDump decodes it.
+ *
+ * Tracing is enabled by setting CERTI_TRACE to the number of events kept
+ * per thread. Otherwise, or on Windows, record only tests a flag.
+ */
+class CERTI_EXPORT EventTrace
+{
+public:
+    static const uint32_t FORMAT_VERSION = 1 ;
+
+    /** Enable tracing if CERTI_TRACE is set, once per process. */
+    static void configure(const char *process);
+
+    static bool isEnabled() { return enabled ; }
+
+    static void record(TracePoint point, uint32_t type, uint32_t federation,
+                       uint32_t federate, uint32_t handle, uint32_t size) {
+        if (enabled)
+            append(point, type, federation, federate, handle, size);
+    }
+
+    /** Write the trace file. Async signal safe. */
+    static void dump();
+
+    /** Current timestamp: time stamp counter where available. */
+    static uint64_t getTicks();
+
+private:
+    static void append(TracePoint point, uint32_t type, uint32_t federation,
+                       uint32_t federate, uint32_t handle, uint32_t size);
+
+    static bool enabled ;
+};
+
+} // namespace certi
+
+#endif // CERTI_EVENT_TRACE_HH
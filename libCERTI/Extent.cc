@@ -25,6 +25,7 @@
 #include "Extent.hh"
 #include "Dimension.hh"
 #include "PrettyDebug.hh"
+#include <algorithm>
 #include <iostream>
 
 using std::vector ;
@@ -94,12 +95,12 @@ Extent::size() const
 bool
 Extent::overlaps(const Extent &e) const
 {
-    for (unsigned int i = 1 ; i <= size(); ++i) {
-	Debug(D, pdTrace) << e.getRangeLowerBound(i) << " < " << getRangeUpperBound(i)
-		   << " or " << e.getRangeUpperBound(i) << " < "
-		   << getRangeLowerBound(i) << " ?" << std::endl ;
-	if (e.getRangeLowerBound(i) > getRangeUpperBound(i) ||
-	    e.getRangeUpperBound(i) < getRangeLowerBound(i))
+    // Called for each candidate region of each routed update: compare the
+    // ranges directly, both extents being in the same routing space.
+    size_t n = std::min(ranges.size(), e.ranges.size());
+    for (size_t i = 0 ; i < n ; ++i) {
+	if (e.ranges[i].first > ranges[i].second ||
+	    e.ranges[i].second < ranges[i].first)
 	    return false ;
     }
     return true ;
@@ -69,6 +69,15 @@ public:
 	 */
 	void free(T handle);
 
+	/** Return the first handle not provided yet. */
+	T getNext() const { return highest ; }
+
+	/**
+	 * Provide handles from the given one on, e.g. after a federation
+	 * restore. The handles below it are considered in use.
+	 */
+	void setNext(T next) { highest = next ; available.clear(); }
+
 private:
 	size_t maximum ;
 	T highest ;
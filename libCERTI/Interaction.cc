@@ -157,6 +157,25 @@ Interaction::broadcastInteractionMessage(InteractionBroadcastList *ibList,
     G.Out(pdGendoc,"exit Interaction::broadcastInteractionMessage");
 }  /* end of broadcastInteractionMessage */
 
+// ----------------------------------------------------------------------------
+void
+Interaction::getRoutes(NM_Interaction_Class_Routes &msg) const
+{
+    msg.setInteractionClass(handle);
+    msg.setFederatesSize(0);
+    msg.setRegional(false);
+
+    const std::list<Subscriber> &subscribers = getSubscribers();
+    for (std::list<Subscriber>::const_iterator s = subscribers.begin(); s != subscribers.end(); ++s) {
+        if (s->getRegion() != NULL) {
+            msg.setRegional(true);
+            continue ;
+        }
+        msg.setFederatesSize(msg.getFederatesSize() + 1);
+        msg.setFederates(s->getHandle(), msg.getFederatesSize() - 1);
+    }
+}
+
 // ----------------------------------------------------------------------------
 //! changeTransportationType.
 void
@@ -387,7 +406,7 @@ throw (FederateNotPublishing, RTIinternalError, SecurityError)
 InteractionBroadcastList *
 Interaction::sendInteraction(FederateHandle federate_handle,
         const std::vector <ParameterHandle> &parameter_list,
-        const std::vector <ParameterValue_t> &value_list,
+        const ValueArena &value_list,
         uint16_t list_size,
         FederationTime time,
         const RTIRegion *region,
@@ -417,10 +436,11 @@ throw (FederateNotPublishing,
         answer->setLabel(the_tag);
 
         answer->setParametersSize(list_size);
+        // The values share the arena of the received message.
+        answer->setValues(value_list);
         answer->setValuesSize(list_size) ;
         for (int i = 0 ; i < list_size ; i++) {
             answer->setParameters(parameter_list[i],i);
-            answer->setValues(value_list[i],i);
         }
 
         D.Out(pdProtocol, "Preparing broadcast list.");
@@ -447,7 +467,7 @@ throw (FederateNotPublishing,
 InteractionBroadcastList *
 Interaction::sendInteraction(FederateHandle federate_handle,
         const std::vector <ParameterHandle> &parameter_list,
-        const std::vector <ParameterValue_t> &value_list,
+        const ValueArena &value_list,
         uint16_t list_size,
         const RTIRegion *region,
         const std::string& the_tag)
@@ -474,15 +494,16 @@ throw (FederateNotPublishing,
         answer->setLabel(the_tag);
 
         answer->setParametersSize(list_size);
+        answer->setValues(value_list);
         answer->setValuesSize(list_size);
 
         for (int i = 0 ; i < list_size ; i++) {
             answer->setParameters(parameter_list[i],i);
-            answer->setValues(value_list[i],i);
         }
 
         D.Out(pdProtocol, "Preparing broadcast list.");
-        ibList = new InteractionBroadcastList(answer);
+        // Only receive order interactions may go over the best effort links.
+        ibList = new InteractionBroadcastList(answer, transport);
 
         broadcastInteractionMessage(ibList, region);
     }
@@ -28,6 +28,7 @@
 namespace certi {
 class InteractionBroadcastList;
 class InteractionSet;
+class NM_Interaction_Class_Routes;
 }  // namespace certi
 
 // CERTI headers
@@ -35,6 +36,7 @@ class InteractionSet;
 #include "SecurityServer.hh"
 #include "Parameter.hh"
 #include "Subscribable.hh"
+#include "ValueArena.hh"
 
 #include <map>
 #include <set>
@@ -138,6 +140,17 @@ public:
     void unpublish(FederateHandle)
     throw (FederateNotPublishing, RTIinternalError, SecurityError);
 
+    typedef std::set<FederateHandle> PublishersList ;
+    const PublishersList &getPublishers() const { return publishers ; }
+
+    /**
+     * Fill a routing table message with the routes of this class, those
+     * the RTIAs using direct links route their interactions with: the
+     * federates subscribed with the default region, and whether some
+     * subscriptions have a region.
+     */
+    void getRoutes(NM_Interaction_Class_Routes &msg) const ;
+
     // -- RTI Support Services --
     ParameterHandle getParameterHandle(const std::string&) const
     throw (NameNotFound, RTIinternalError);
@@ -179,7 +192,7 @@ public:
     InteractionBroadcastList *
     sendInteraction(FederateHandle federate_handle,
             const std::vector <ParameterHandle> &parameter_list,
-            const std::vector <ParameterValue_t> &value_list,
+            const ValueArena &value_list,
             uint16_t list_size,
             FederationTime the_time,
             const RTIRegion *,
@@ -192,7 +205,7 @@ public:
     InteractionBroadcastList *
     sendInteraction(FederateHandle federate_handle,
             const std::vector <ParameterHandle> &parameter_list,
-            const std::vector <ParameterValue_t> &value_list,
+            const ValueArena &value_list,
             uint16_t list_size,
             const RTIRegion *,
             const std::string& the_tag)
@@ -254,7 +267,6 @@ private:
     //! List of this Interaction Class' Parameters.
     HandleParameterMap _handleParameterMap;
 
-    typedef std::set<FederateHandle> PublishersList ;
     PublishersList publishers ;
 };
 
@@ -25,6 +25,7 @@
 
 #include "InteractionBroadcastList.hh"
 #include "PrettyDebug.hh"
+#include "EventTrace.hh"
 
 using std::list ;
 
@@ -60,7 +61,9 @@ InteractionBroadcastList::addFederate(FederateHandle federate)
 /*! theMsg must have been allocated, and will be destroyed by the destructor.
   theMsg->NumeroFedere is added to the list, and its state is set as "Sent".
 */
-InteractionBroadcastList::InteractionBroadcastList(NM_Receive_Interaction *theMsg)
+InteractionBroadcastList::InteractionBroadcastList(NM_Receive_Interaction *theMsg,
+                                                   TransportType theTransport)
+    : transport(theTransport)
 {
 
     G.Out(pdGendoc,"enter InteractionBroadcastList::InteractionBroadcastList");
@@ -132,7 +135,11 @@ InteractionBroadcastList::sendPendingMessage(SecurityServer *server)
 {
 
     G.Out(pdGendoc,"enter InteractionBroadcastList::sendPendingMessage");
+    EventTrace::record(TRACE_RTIG_BROADCAST, message->getMessageType(), message->getFederation(),
+                       message->getFederate(), message->getInteractionClass(), lines.size());
 
+    // The message is encoded once, on the first recipient.
+    WireBuffer wire ;
     list<InteractionBroadcastLine *>::iterator i ;
     for (i = lines.begin(); i != lines.end(); i++) {
         // If federate is waiting for a message.
@@ -144,15 +151,13 @@ InteractionBroadcastList::sendPendingMessage(SecurityServer *server)
 
             Socket *socket = 0 ;
             try {
-#ifdef HLA_USES_UDP
-                socket = server->getSocketLink((*i)->federate, BEST_EFFORT);
-#else
-                socket = server->getSocketLink((*i)->federate);
-#endif
+                socket = server->getSocketLink((*i)->federate, transport);
 
                 G.Out(pdGendoc,"sendPendingMessage===>write");
 
-                message->send(socket,NM_msgBufSend);
+                if (wire.empty())
+                    wire = WireBuffer(*message);
+                wire.send(socket, transport);
             }
             catch (RTIinternalError &e) {
                 D.Out(pdExcept,
@@ -26,6 +26,7 @@
 #include "NetworkMessage.hh"
 #include "SecurityServer.hh"
 #include "NM_Classes.hh"
+#include "WireBuffer.hh"
 
 #include <list>
 
@@ -48,7 +49,12 @@ public:
 class InteractionBroadcastList
 {
 public:
-    InteractionBroadcastList(NM_Receive_Interaction *theMsg);
+    /**
+     * The message goes over the best effort link of the federates if
+     * theTransport is BEST_EFFORT.
+     */
+    InteractionBroadcastList(NM_Receive_Interaction *theMsg,
+                             TransportType theTransport = RELIABLE);
     ~InteractionBroadcastList();
 
     void clear();
@@ -63,9 +69,8 @@ public:
 
 private:
     InteractionBroadcastLine *getLineWithFederate(FederateHandle theFederate);
-    /* The message buffer used to send Network messages */
-    MessageBuffer NM_msgBufSend;
     std::list<InteractionBroadcastLine *> lines ;
+    TransportType transport ;
 };
 
 }
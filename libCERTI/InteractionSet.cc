@@ -63,7 +63,7 @@ void
 InteractionSet::broadcastInteraction(FederateHandle federate_handle,
         InteractionClassHandle interaction_handle,
         const std::vector <ParameterHandle> &parameter_list,
-        const std::vector <ParameterValue_t> &value_list,
+        const ValueArena &value_list,
         uint16_t list_size,
         FederationTime the_time,
         const RTIRegion *region,
@@ -109,7 +109,7 @@ void
 InteractionSet::broadcastInteraction(FederateHandle federate_handle,
         InteractionClassHandle interaction_handle,
         const std::vector <ParameterHandle> &parameter_list,
-        const std::vector <ParameterValue_t> &value_list,
+        const ValueArena &value_list,
         uint16_t list_size,
         const RTIRegion *region,
         const std::string& the_tag)
@@ -125,7 +125,7 @@ public:
 	void broadcastInteraction(FederateHandle theFederateHandle,
 			InteractionClassHandle theInteractionHandle,
 			const std::vector <ParameterHandle> &theParameterList,
-			const std::vector <ParameterValue_t> &theValueList,
+			const ValueArena &theValueList,
 			uint16_t theListSize,
 			FederationTime theTime,
 			const RTIRegion *,
@@ -138,7 +138,7 @@ public:
 	void broadcastInteraction(FederateHandle theFederateHandle,
 			InteractionClassHandle theInteractionHandle,
 			const std::vector <ParameterHandle> &theParameterList,
-			const std::vector <ParameterValue_t> &theValueList,
+			const ValueArena &theValueList,
 			uint16_t theListSize,
 			const RTIRegion *,
 			const std::string& theTag)
@@ -37,7 +37,7 @@ static PrettyDebug D("LBTS", __FILE__);
 // ----------------------------------------------------------------------------
 /** Constructor.  */
 LBTS::LBTS()
-    : MyFederateNumber(0)
+    : MyFederateNumber(0), hasFloor(false)
 {
   anonymousUpdateReceived = false;
   _LBTS.setPositiveInfinity();
@@ -50,19 +50,14 @@ LBTS::~LBTS()
 void
 LBTS::compute()
 {
-    FederationTime hl ;
-
     // LBTS = + l'infini
     _LBTS.setPositiveInfinity();
 
-    ClockSet::iterator i ;
-    for (i = clocks.begin(); i != clocks.end(); ++i) {
-        if (i->first != MyFederateNumber) {
-            hl = i->second ;
-            if (hl < _LBTS)
-                _LBTS = hl ;
-        }
-    }
+    ClockIndex::const_iterator i = index.begin();
+    if (i != index.end() && i->second == MyFederateNumber)
+        ++i ;
+    if (i != index.end())
+        _LBTS = effective(clocks.find(i->second)->second);
 } /* end of compute */
 
 bool
@@ -83,7 +78,55 @@ LBTS::get(std::vector<FederateClock> &v) const
     // note, the ClockSet::value_type and FederateClock differ in const-ness
     for(ClockSet::const_iterator pos = clocks.begin();
         pos != clocks.end(); pos++)
-        v.push_back(FederateClock(pos->first, pos->second));
+        v.push_back(FederateClock(pos->first, effective(pos->second)));
+}
+
+// ----------------------------------------------------------------------------
+FederationTime
+LBTS::getClock(FederateHandle federate) const
+{
+    ClockSet::const_iterator it = clocks.find(federate);
+
+    if (it == clocks.end())
+        throw RTIinternalError(stringize() << "LBTS: Federate <" << federate << "> not found.");
+
+    return effective(it->second);
+}
+
+// ----------------------------------------------------------------------------
+/** Return the value of a clock once the anonymous updates are applied.
+ */
+FederationTime
+LBTS::effective(const FederationTime &time) const
+{
+    return (hasFloor && floor > time) ? floor : time ;
+}
+
+// ----------------------------------------------------------------------------
+/** Move the clocks lower than the anonymous update floor to the floor, so
+    that a clock may be given a time lower than the floor.
+ */
+void
+LBTS::applyFloor()
+{
+    vector<FederateHandle> late ;
+    for (ClockIndex::const_iterator i = index.begin();
+         i != index.end() && floor > FederationTime(i->first); ++i)
+        late.push_back(i->second);
+    for (vector<FederateHandle>::const_iterator i = late.begin(); i != late.end(); ++i)
+        setClock(clocks.find(*i), floor);
+    hasFloor = false ;
+}
+
+// ----------------------------------------------------------------------------
+/** Move a clock to a new time, keeping the index ordered.
+ */
+void
+LBTS::setClock(ClockSet::iterator it, FederationTime time)
+{
+    index.erase(std::make_pair(it->second.getTime(), it->first));
+    it->second = time ;
+    index.insert(std::make_pair(time.getTime(), it->first));
 }
 
 // ----------------------------------------------------------------------------
@@ -96,8 +139,12 @@ LBTS::insert(FederateHandle num_fed, FederationTime time)
     if (exists(num_fed))
         throw RTIinternalError("LBTS: Federate already present.");
 
+    if (hasFloor && floor > time)
+        applyFloor();
+
     // BUG: We should verify that clock time is correct.
     clocks[num_fed] = time ;
+    index.insert(std::make_pair(time.getTime(), num_fed));
     compute();
 }
 
@@ -106,8 +153,6 @@ void
 LBTS::update(FederateHandle federateHandle, FederationTime time)
 {
     D.Out(pdDebug, "LBTS.update: Updating federate %d (time=%f).", federateHandle, time.getTime());
-    ClockSet::iterator it;
-    ClockSet::iterator itend = clocks.end();
 
     /*
      * num fed will be 0 if it is an 'anonymous' Null Message
@@ -115,33 +160,48 @@ LBTS::update(FederateHandle federateHandle, FederationTime time)
      * sent after NERx (NMRx) calls.
      */
     if (federateHandle!=0) {
-    	it = clocks.find(federateHandle);
-    	if (it == clocks.end()) {
+    	ClockSet::iterator it = clocks.find(federateHandle);
+    	if (it == clocks.end())
     		throw RTIinternalError(stringize() << "LBTS: Federate <" << federateHandle << "> not found.");
-    	} else {
-    		itend = it;
-    	}
-    } else {
-    	anonymousUpdateReceived = true;
-    	it = clocks.begin();
-    }
 
-    do {
     	// Coherence test.
-    	if (it->second > time)
+    	if (effective(it->second) > time)
     		D.Out(pdDebug,
     				"LBTS.update: federate-%u, new time lower than oldest one.",federateHandle);
     	else {
     		D.Out(pdDebug, "LBTS.update: federate-%u, time %f --> %f (old-->new)",
-    				it->first, it->second.getTime(),time.getTime());
-    		it->second = time;
+    				it->first, effective(it->second).getTime(),time.getTime());
+    		setClock(it, time);
+    	}
+    } else {
+    	anonymousUpdateReceived = true;
+    	/* Every clock lower than time is now at time. */
+    	if (!hasFloor || !(floor > time)) {
+    		D.Out(pdDebug, "LBTS.update: anonymous update, clocks below %f moved to it.",
+    				time.getTime());
+    		floor = time ;
+    		hasFloor = true ;
     	}
-    	if (it!=itend) ++it;
-    } while (it!=itend);
+    }
     /* now update LBTS */
 	compute();
 } /* end of update */
 
+// ----------------------------------------------------------------------------
+void
+LBTS::set(FederateHandle federateHandle, FederationTime time)
+{
+    ClockSet::iterator it = clocks.find(federateHandle);
+
+    if (it == clocks.end())
+        throw RTIinternalError(stringize() << "LBTS: Federate <" << federateHandle << "> not found.");
+
+    if (hasFloor && floor > time)
+        applyFloor();
+    setClock(it, time);
+    compute();
+}
+
 // ----------------------------------------------------------------------------
 //! Remove a federate
 void
@@ -152,6 +212,7 @@ LBTS::remove(FederateHandle num_fed)
     if (it == clocks.end())
         throw RTIinternalError(stringize() << "LBTS: Federate <"<< num_fed << "not found.");
 
+    index.erase(std::make_pair(it->second.getTime(), it->first));
     clocks.erase(it);
     compute();
 }
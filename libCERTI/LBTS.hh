@@ -28,6 +28,7 @@
 #include "FedTimeD.hh"
 
 #include <map>
+#include <set>
 #include <vector>
 
 namespace certi {
@@ -55,6 +56,8 @@ public:
 
     /**
      *  Compute the LBTS from the federate clocks value.
+     *  The clocks are kept ordered, so this only looks at the two
+     *  smallest ones and at the anonymous update floor.
      */
     void compute();
 
@@ -67,6 +70,12 @@ public:
      */
     bool exists(FederateHandle) const ;
     void get(std::vector<FederateClock> &) const ;
+
+    /**
+     * Return the logical time of one federate.
+     * @throw RTIinternalError if the federate is not present.
+     */
+    FederationTime getClock(FederateHandle) const ;
     void insert(FederateHandle num_fed, FederationTime the_time);
     void remove(FederateHandle num_fed);
     void setFederate(FederateHandle handle) { MyFederateNumber = handle ; };
@@ -80,6 +89,12 @@ public:
      */
     void update(FederateHandle federateHandle, FederationTime logicalTime);
 
+    /**
+     * Set the logical time of one federate, even if it is lower than
+     * its current one.
+     */
+    void set(FederateHandle federateHandle, FederationTime logicalTime);
+
     /**
      * Return true is the last call to update was done with an "anonymous"
      * federate handle. I.e. was the consequence of the NULL PRIME message
@@ -99,8 +114,21 @@ protected:
 
 private:
     typedef std::map<FederateHandle, FederationTime> ClockSet ;
+    /** The clocks ordered by time, then by federate handle. */
+    typedef std::set<std::pair<double, FederateHandle> > ClockIndex ;
+
+    FederationTime effective(const FederationTime &) const ;
+    void setClock(ClockSet::iterator, FederationTime);
+    void applyFloor();
 
     ClockSet clocks ;
+    ClockIndex index ;
+    /**
+     * Time of the last anonymous updates. The clocks lower than the floor
+     * are not moved by these updates: their value is the floor.
+     */
+    FederationTime floor ;
+    bool           hasFloor ;
 };
 
 }
@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "LocalLink.hh"
+#include "Message.hh"
+
+#include <deque>
+#include <pthread.h>
+
+namespace certi {
+
+struct LocalLink::Queue {
+    Queue() : waiting(false) {}
+    std::deque<Message *> messages ;
+    bool waiting ;
+};
+
+struct LocalLink::Shared {
+    Shared() : sides(1) { pthread_mutex_init(&lock, NULL); }
+    ~Shared() {
+        for (int i = 0 ; i < 2 ; ++i)
+            for (std::deque<Message *>::iterator m = queues[i].messages.begin();
+                 m != queues[i].messages.end(); ++m)
+                delete *m ;
+        pthread_mutex_destroy(&lock);
+    }
+    mutable pthread_mutex_t lock ;
+    Queue queues[2] ;
+    int sides ;
+};
+
+namespace {
+
+class Guard
+{
+public:
+    Guard(pthread_mutex_t &m) : mutex(m) { pthread_mutex_lock(&mutex); }
+    ~Guard() { pthread_mutex_unlock(&mutex); }
+private:
+    pthread_mutex_t &mutex ;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+LocalLink::LocalLink()
+    : shared(new Shared())
+{
+    out = &shared->queues[0] ;
+    in = &shared->queues[1] ;
+}
+
+// ----------------------------------------------------------------------------
+LocalLink::LocalLink(LocalLink &peer)
+    : shared(peer.shared), out(peer.in), in(peer.out)
+{
+    Guard guard(shared->lock);
+    ++shared->sides ;
+}
+
+// ----------------------------------------------------------------------------
+LocalLink::~LocalLink()
+{
+    bool last ;
+    {
+        Guard guard(shared->lock);
+        last = --shared->sides == 0 ;
+    }
+    if (last)
+        delete shared ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+LocalLink::push(Message *msg)
+{
+    Guard guard(shared->lock);
+    out->messages.push_back(msg);
+    bool waiting = out->waiting ;
+    out->waiting = false ;
+    return waiting ;
+}
+
+// ----------------------------------------------------------------------------
+Message *
+LocalLink::pop()
+{
+    Guard guard(shared->lock);
+    if (in->messages.empty())
+        return NULL ;
+    Message *msg = in->messages.front();
+    in->messages.pop_front();
+    return msg ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+LocalLink::isReadable() const
+{
+    Guard guard(shared->lock);
+    return !in->messages.empty();
+}
+
+// ----------------------------------------------------------------------------
+void
+LocalLink::setWaiting()
+{
+    Guard guard(shared->lock);
+    in->waiting = true ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+LocalLink::clearWaiting()
+{
+    Guard guard(shared->lock);
+    bool waiting = in->waiting ;
+    in->waiting = false ;
+    return waiting ;
+}
+
+} // namespace certi
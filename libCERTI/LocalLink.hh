@@ -0,0 +1,84 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_LOCAL_LINK_HH
+#define CERTI_LOCAL_LINK_HH
+
+#include "certi.hh"
+
+namespace certi {
+
+class Message ;
+
+/**
+ * One side of the in-memory link between a federate and the RTIA running
+ * on one of its threads (CERTI_RTIA_THREAD).
+ *
+ * The messages themselves go from one side to the other, through two
+ * queues guarded by a mutex: nothing is serialized. Both sides share the
+ * queues, which the last side to be deleted frees with the messages left.
+ *
+ * The waiting flags follow the SHMLink protocol: a consumer about to sleep
+ * sets the flag of its queue, and the producer which takes the flag back
+ * on a push wakes it up through the socket the link doubles.
+ */
+class CERTI_EXPORT LocalLink
+{
+public:
+    /** Create the link, as its first side. */
+    LocalLink();
+
+    /** The other side of the link of peer. */
+    explicit LocalLink(LocalLink &peer);
+
+    ~LocalLink();
+
+    /** Queue a message for the peer, which takes ownership of it.
+     *  @return true if the peer is asleep and has to be woken up
+     */
+    bool push(Message *msg);
+
+    /** @return the next message from the peer, NULL if none */
+    Message *pop();
+
+    bool isReadable() const ;
+
+    /** Set the waiting flag of the incoming queue, before sleeping. */
+    void setWaiting();
+
+    /** Take back the waiting flag of the incoming queue.
+     *  @return false if the producer already took it, and thus wakes us up
+     */
+    bool clearWaiting();
+
+private:
+    struct Queue ;
+    struct Shared ;
+
+    LocalLink(const LocalLink &);
+    LocalLink &operator=(const LocalLink &);
+
+    Shared *shared ;
+    Queue *out ;
+    Queue *in ;
+};
+
+} // namespace certi
+
+#endif // CERTI_LOCAL_LINK_HH
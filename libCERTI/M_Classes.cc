@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include "M_Classes.hh"
+#include "MessagePool.hh"
 // ----------------------------------------------------------------------------
 // CERTI - HLA RunTime Infrastructure
 // Copyright (C) 2002-2008  ONERA
@@ -4566,6 +4567,38 @@ namespace certi {
    M_Tick_Request_Stop::~M_Tick_Request_Stop() {
    }
 
+   M_Tick_Callbacks::M_Tick_Callbacks() {
+      this->messageName = "M_Tick_Callbacks";
+      this->type = Message::TICK_CALLBACKS;
+      //count= <no default value in message spec using builtin>
+   }
+
+   M_Tick_Callbacks::~M_Tick_Callbacks() {
+   }
+
+   void M_Tick_Callbacks::serialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::serialize(msgBuffer);
+      //Specific serialization code
+      msgBuffer.write_uint32(count);
+   }
+
+   void M_Tick_Callbacks::deserialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::deserialize(msgBuffer);
+      //Specific deserialization code
+      count = msgBuffer.read_uint32();
+   }
+
+   std::ostream& M_Tick_Callbacks::show(std::ostream& out) {
+      out << "[M_Tick_Callbacks -Begin]" << std::endl;      //Call mother class
+      Super::show(out);
+      //Specific show code
+      out << " count = " << count << " "       << std::endl;
+      out << "[M_Tick_Callbacks -End]" << std::endl;
+      return out;
+   }
+
    M_Reserve_Object_Instance_Name::M_Reserve_Object_Instance_Name() {
       this->messageName = "M_Reserve_Object_Instance_Name";
       this->type = Message::RESERVE_OBJECT_INSTANCE_NAME;
@@ -5053,6 +5086,9 @@ namespace certi {
          case Message::TICK_REQUEST_STOP:
             msg = new M_Tick_Request_Stop();
             break;
+         case Message::TICK_CALLBACKS:
+            msg = new M_Tick_Callbacks();
+            break;
          case Message::RESERVE_OBJECT_INSTANCE_NAME:
             msg = new M_Reserve_Object_Instance_Name();
             break;
@@ -5070,15 +5106,23 @@ namespace certi {
    } /* end of M_Factory::create */
 
    Message* M_Factory::receive(MStreamType stream) throw (NetworkError ,NetworkSignal) { 
-      // FIXME This is not thread safe
+      // FIXME This is not thread safe, concurrent callers
+      // have to give their own buffer
       static libhla::MessageBuffer msgBuffer;
+      return receive(stream,msgBuffer);
+   } /* end of M_Factory::receive */ 
+
+   Message* M_Factory::receive(MStreamType stream, libhla::MessageBuffer& msgBuffer) throw (NetworkError ,NetworkSignal) { 
+      // messages of an in-process link are not serialized
+      if (stream->usesLocalLink())
+         return stream->receiveMessage();
       Message  msgGen;
       Message* msg;
 
       // receive generic message 
       msgGen.receive(stream,msgBuffer);
       // create specific message from type 
-      msg = M_Factory::create(msgGen.getMessageType());
+      msg = MessagePool::get(msgGen.getMessageType());
       msgBuffer.assumeSizeFromReservedBytes();
       msg->deserialize(msgBuffer);
       return msg;
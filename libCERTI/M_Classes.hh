@@ -50,7 +50,7 @@ namespace certi {
    typedef Message::Type M_Type;
    namespace CERTI_Message {
       static const uint32_t versionMajor = 1;
-      static const uint32_t versionMinor = 0;
+      static const uint32_t versionMinor = 1;
 
    }
    // The EventRetraction is not inheriting from base "Message"   
@@ -83,6 +83,8 @@ namespace certi {
          typedef Message Super;
          M_Open_Connexion();
          virtual ~M_Open_Connexion();
+         virtual Message* clone() const {return new M_Open_Connexion(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Open_Connexion&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -103,6 +105,8 @@ namespace certi {
          typedef Message Super;
          M_Close_Connexion();
          virtual ~M_Close_Connexion();
+         virtual Message* clone() const {return new M_Close_Connexion(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Close_Connexion&>(other);}
       protected:
       private:
    };
@@ -112,6 +116,8 @@ namespace certi {
          typedef Message Super;
          M_Create_Federation_Execution();
          virtual ~M_Create_Federation_Execution();
+         virtual Message* clone() const {return new M_Create_Federation_Execution(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Create_Federation_Execution&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -132,6 +138,8 @@ namespace certi {
          typedef Message Super;
          M_Destroy_Federation_Execution();
          virtual ~M_Destroy_Federation_Execution();
+         virtual Message* clone() const {return new M_Destroy_Federation_Execution(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Destroy_Federation_Execution&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -149,6 +157,8 @@ namespace certi {
          typedef Message Super;
          M_Join_Federation_Execution();
          virtual ~M_Join_Federation_Execution();
+         virtual Message* clone() const {return new M_Join_Federation_Execution(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Join_Federation_Execution&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -172,6 +182,8 @@ namespace certi {
          typedef Message Super;
          M_Resign_Federation_Execution();
          virtual ~M_Resign_Federation_Execution();
+         virtual Message* clone() const {return new M_Resign_Federation_Execution(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Resign_Federation_Execution&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -189,6 +201,8 @@ namespace certi {
          typedef Message Super;
          M_Register_Federation_Synchronization_Point();
          virtual ~M_Register_Federation_Synchronization_Point();
+         virtual Message* clone() const {return new M_Register_Federation_Synchronization_Point(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Register_Federation_Synchronization_Point&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -211,6 +225,8 @@ namespace certi {
          typedef Message Super;
          M_Synchronization_Point_Registration_Failed();
          virtual ~M_Synchronization_Point_Registration_Failed();
+         virtual Message* clone() const {return new M_Synchronization_Point_Registration_Failed(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Synchronization_Point_Registration_Failed&>(other);}
       protected:
       private:
    };
@@ -220,6 +236,8 @@ namespace certi {
          typedef Message Super;
          M_Synchronization_Point_Registration_Succeeded();
          virtual ~M_Synchronization_Point_Registration_Succeeded();
+         virtual Message* clone() const {return new M_Synchronization_Point_Registration_Succeeded(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Synchronization_Point_Registration_Succeeded&>(other);}
       protected:
       private:
    };
@@ -229,6 +247,8 @@ namespace certi {
          typedef Message Super;
          M_Announce_Synchronization_Point();
          virtual ~M_Announce_Synchronization_Point();
+         virtual Message* clone() const {return new M_Announce_Synchronization_Point(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Announce_Synchronization_Point&>(other);}
       protected:
       private:
    };
@@ -238,6 +258,8 @@ namespace certi {
          typedef Message Super;
          M_Synchronization_Point_Achieved();
          virtual ~M_Synchronization_Point_Achieved();
+         virtual Message* clone() const {return new M_Synchronization_Point_Achieved(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Synchronization_Point_Achieved&>(other);}
       protected:
       private:
    };
@@ -247,6 +269,8 @@ namespace certi {
          typedef Message Super;
          M_Federation_Synchronized();
          virtual ~M_Federation_Synchronized();
+         virtual Message* clone() const {return new M_Federation_Synchronized(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federation_Synchronized&>(other);}
       protected:
       private:
    };
@@ -256,6 +280,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Federation_Save();
          virtual ~M_Request_Federation_Save();
+         virtual Message* clone() const {return new M_Request_Federation_Save(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Federation_Save&>(other);}
       protected:
       private:
    };
@@ -265,6 +291,8 @@ namespace certi {
          typedef Message Super;
          M_Initiate_Federate_Save();
          virtual ~M_Initiate_Federate_Save();
+         virtual Message* clone() const {return new M_Initiate_Federate_Save(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Initiate_Federate_Save&>(other);}
       protected:
       private:
    };
@@ -274,6 +302,8 @@ namespace certi {
          typedef Message Super;
          M_Federate_Save_Begun();
          virtual ~M_Federate_Save_Begun();
+         virtual Message* clone() const {return new M_Federate_Save_Begun(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federate_Save_Begun&>(other);}
       protected:
       private:
    };
@@ -283,6 +313,8 @@ namespace certi {
          typedef Message Super;
          M_Federate_Save_Complete();
          virtual ~M_Federate_Save_Complete();
+         virtual Message* clone() const {return new M_Federate_Save_Complete(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federate_Save_Complete&>(other);}
       protected:
       private:
    };
@@ -292,6 +324,8 @@ namespace certi {
          typedef Message Super;
          M_Federate_Save_Not_Complete();
          virtual ~M_Federate_Save_Not_Complete();
+         virtual Message* clone() const {return new M_Federate_Save_Not_Complete(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federate_Save_Not_Complete&>(other);}
       protected:
       private:
    };
@@ -301,6 +335,8 @@ namespace certi {
          typedef Message Super;
          M_Federation_Saved();
          virtual ~M_Federation_Saved();
+         virtual Message* clone() const {return new M_Federation_Saved(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federation_Saved&>(other);}
       protected:
       private:
    };
@@ -310,6 +346,8 @@ namespace certi {
          typedef Message Super;
          M_Federation_Not_Saved();
          virtual ~M_Federation_Not_Saved();
+         virtual Message* clone() const {return new M_Federation_Not_Saved(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federation_Not_Saved&>(other);}
       protected:
       private:
    };
@@ -319,6 +357,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Federation_Restore();
          virtual ~M_Request_Federation_Restore();
+         virtual Message* clone() const {return new M_Request_Federation_Restore(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Federation_Restore&>(other);}
       protected:
       private:
    };
@@ -328,6 +368,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Federation_Restore_Failed();
          virtual ~M_Request_Federation_Restore_Failed();
+         virtual Message* clone() const {return new M_Request_Federation_Restore_Failed(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Federation_Restore_Failed&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -345,6 +387,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Federation_Restore_Succeeded();
          virtual ~M_Request_Federation_Restore_Succeeded();
+         virtual Message* clone() const {return new M_Request_Federation_Restore_Succeeded(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Federation_Restore_Succeeded&>(other);}
       protected:
       private:
    };
@@ -354,6 +398,8 @@ namespace certi {
          typedef Message Super;
          M_Initiate_Federate_Restore();
          virtual ~M_Initiate_Federate_Restore();
+         virtual Message* clone() const {return new M_Initiate_Federate_Restore(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Initiate_Federate_Restore&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -371,6 +417,8 @@ namespace certi {
          typedef Message Super;
          M_Federate_Restore_Complete();
          virtual ~M_Federate_Restore_Complete();
+         virtual Message* clone() const {return new M_Federate_Restore_Complete(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federate_Restore_Complete&>(other);}
       protected:
       private:
    };
@@ -380,6 +428,8 @@ namespace certi {
          typedef Message Super;
          M_Federate_Restore_Not_Complete();
          virtual ~M_Federate_Restore_Not_Complete();
+         virtual Message* clone() const {return new M_Federate_Restore_Not_Complete(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federate_Restore_Not_Complete&>(other);}
       protected:
       private:
    };
@@ -389,6 +439,8 @@ namespace certi {
          typedef Message Super;
          M_Federation_Restored();
          virtual ~M_Federation_Restored();
+         virtual Message* clone() const {return new M_Federation_Restored(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federation_Restored&>(other);}
       protected:
       private:
    };
@@ -398,6 +450,8 @@ namespace certi {
          typedef Message Super;
          M_Federation_Not_Restored();
          virtual ~M_Federation_Not_Restored();
+         virtual Message* clone() const {return new M_Federation_Not_Restored(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federation_Not_Restored&>(other);}
       protected:
       private:
    };
@@ -407,6 +461,8 @@ namespace certi {
          typedef Message Super;
          M_Federation_Restore_Begun();
          virtual ~M_Federation_Restore_Begun();
+         virtual Message* clone() const {return new M_Federation_Restore_Begun(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Federation_Restore_Begun&>(other);}
       protected:
       private:
    };
@@ -416,6 +472,8 @@ namespace certi {
          typedef Message Super;
          M_Publish_Object_Class();
          virtual ~M_Publish_Object_Class();
+         virtual Message* clone() const {return new M_Publish_Object_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Publish_Object_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -441,6 +499,8 @@ namespace certi {
          typedef Message Super;
          M_Unpublish_Object_Class();
          virtual ~M_Unpublish_Object_Class();
+         virtual Message* clone() const {return new M_Unpublish_Object_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Unpublish_Object_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -458,6 +518,8 @@ namespace certi {
          typedef Message Super;
          M_Publish_Interaction_Class();
          virtual ~M_Publish_Interaction_Class();
+         virtual Message* clone() const {return new M_Publish_Interaction_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Publish_Interaction_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -475,6 +537,8 @@ namespace certi {
          typedef Message Super;
          M_Unpublish_Interaction_Class();
          virtual ~M_Unpublish_Interaction_Class();
+         virtual Message* clone() const {return new M_Unpublish_Interaction_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Unpublish_Interaction_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -492,6 +556,8 @@ namespace certi {
          typedef Message Super;
          M_Subscribe_Object_Class_Attributes();
          virtual ~M_Subscribe_Object_Class_Attributes();
+         virtual Message* clone() const {return new M_Subscribe_Object_Class_Attributes(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Subscribe_Object_Class_Attributes&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -520,6 +586,8 @@ namespace certi {
          typedef Message Super;
          M_Unsubscribe_Object_Class();
          virtual ~M_Unsubscribe_Object_Class();
+         virtual Message* clone() const {return new M_Unsubscribe_Object_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Unsubscribe_Object_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -537,6 +605,8 @@ namespace certi {
          typedef Message Super;
          M_Subscribe_Interaction_Class();
          virtual ~M_Subscribe_Interaction_Class();
+         virtual Message* clone() const {return new M_Subscribe_Interaction_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Subscribe_Interaction_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -554,6 +624,8 @@ namespace certi {
          typedef Message Super;
          M_Unsubscribe_Interaction_Class();
          virtual ~M_Unsubscribe_Interaction_Class();
+         virtual Message* clone() const {return new M_Unsubscribe_Interaction_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Unsubscribe_Interaction_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -571,6 +643,8 @@ namespace certi {
          typedef Message Super;
          M_Start_Registration_For_Object_Class();
          virtual ~M_Start_Registration_For_Object_Class();
+         virtual Message* clone() const {return new M_Start_Registration_For_Object_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Start_Registration_For_Object_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -588,6 +662,8 @@ namespace certi {
          typedef Message Super;
          M_Stop_Registration_For_Object_Class();
          virtual ~M_Stop_Registration_For_Object_Class();
+         virtual Message* clone() const {return new M_Stop_Registration_For_Object_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Stop_Registration_For_Object_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -605,6 +681,8 @@ namespace certi {
          typedef Message Super;
          M_Turn_Interactions_On();
          virtual ~M_Turn_Interactions_On();
+         virtual Message* clone() const {return new M_Turn_Interactions_On(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Turn_Interactions_On&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -622,6 +700,8 @@ namespace certi {
          typedef Message Super;
          M_Turn_Interactions_Off();
          virtual ~M_Turn_Interactions_Off();
+         virtual Message* clone() const {return new M_Turn_Interactions_Off(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Turn_Interactions_Off&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -639,6 +719,8 @@ namespace certi {
          typedef Message Super;
          M_Register_Object_Instance();
          virtual ~M_Register_Object_Instance();
+         virtual Message* clone() const {return new M_Register_Object_Instance(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Register_Object_Instance&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -667,6 +749,8 @@ namespace certi {
          typedef Message Super;
          M_Update_Attribute_Values();
          virtual ~M_Update_Attribute_Values();
+         virtual Message* clone() const {return new M_Update_Attribute_Values(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Update_Attribute_Values&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -711,6 +795,8 @@ namespace certi {
          typedef Message Super;
          M_Discover_Object_Instance();
          virtual ~M_Discover_Object_Instance();
+         virtual Message* clone() const {return new M_Discover_Object_Instance(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Discover_Object_Instance&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -742,6 +828,8 @@ namespace certi {
          typedef Message Super;
          M_Reflect_Attribute_Values();
          virtual ~M_Reflect_Attribute_Values();
+         virtual Message* clone() const {return new M_Reflect_Attribute_Values(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Reflect_Attribute_Values&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -786,6 +874,8 @@ namespace certi {
          typedef Message Super;
          M_Send_Interaction();
          virtual ~M_Send_Interaction();
+         virtual Message* clone() const {return new M_Send_Interaction(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Send_Interaction&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -830,6 +920,8 @@ namespace certi {
          typedef Message Super;
          M_Receive_Interaction();
          virtual ~M_Receive_Interaction();
+         virtual Message* clone() const {return new M_Receive_Interaction(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Receive_Interaction&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -874,6 +966,8 @@ namespace certi {
          typedef Message Super;
          M_Delete_Object_Instance();
          virtual ~M_Delete_Object_Instance();
+         virtual Message* clone() const {return new M_Delete_Object_Instance(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Delete_Object_Instance&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -905,6 +999,8 @@ namespace certi {
          typedef Message Super;
          M_Local_Delete_Object_Instance();
          virtual ~M_Local_Delete_Object_Instance();
+         virtual Message* clone() const {return new M_Local_Delete_Object_Instance(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Local_Delete_Object_Instance&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -922,6 +1018,8 @@ namespace certi {
          typedef Message Super;
          M_Remove_Object_Instance();
          virtual ~M_Remove_Object_Instance();
+         virtual Message* clone() const {return new M_Remove_Object_Instance(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Remove_Object_Instance&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -953,6 +1051,8 @@ namespace certi {
          typedef Message Super;
          M_Change_Attribute_Transportation_Type();
          virtual ~M_Change_Attribute_Transportation_Type();
+         virtual Message* clone() const {return new M_Change_Attribute_Transportation_Type(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Change_Attribute_Transportation_Type&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -984,6 +1084,8 @@ namespace certi {
          typedef Message Super;
          M_Change_Interaction_Transportation_Type();
          virtual ~M_Change_Interaction_Transportation_Type();
+         virtual Message* clone() const {return new M_Change_Interaction_Transportation_Type(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Change_Interaction_Transportation_Type&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1007,6 +1109,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Object_Attribute_Value_Update();
          virtual ~M_Request_Object_Attribute_Value_Update();
+         virtual Message* clone() const {return new M_Request_Object_Attribute_Value_Update(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Object_Attribute_Value_Update&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1032,6 +1136,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Class_Attribute_Value_Update();
          virtual ~M_Request_Class_Attribute_Value_Update();
+         virtual Message* clone() const {return new M_Request_Class_Attribute_Value_Update(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Class_Attribute_Value_Update&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1057,6 +1163,8 @@ namespace certi {
          typedef Message Super;
          M_Provide_Attribute_Value_Update();
          virtual ~M_Provide_Attribute_Value_Update();
+         virtual Message* clone() const {return new M_Provide_Attribute_Value_Update(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Provide_Attribute_Value_Update&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1082,6 +1190,8 @@ namespace certi {
          typedef Message Super;
          M_Attributes_In_Scope();
          virtual ~M_Attributes_In_Scope();
+         virtual Message* clone() const {return new M_Attributes_In_Scope(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attributes_In_Scope&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1107,6 +1217,8 @@ namespace certi {
          typedef Message Super;
          M_Attributes_Out_Of_Scope();
          virtual ~M_Attributes_Out_Of_Scope();
+         virtual Message* clone() const {return new M_Attributes_Out_Of_Scope(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attributes_Out_Of_Scope&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1132,6 +1244,8 @@ namespace certi {
          typedef Message Super;
          M_Turn_Updates_On_For_Object_Instance();
          virtual ~M_Turn_Updates_On_For_Object_Instance();
+         virtual Message* clone() const {return new M_Turn_Updates_On_For_Object_Instance(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Turn_Updates_On_For_Object_Instance&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1157,6 +1271,8 @@ namespace certi {
          typedef Message Super;
          M_Turn_Updates_Off_For_Object_Instance();
          virtual ~M_Turn_Updates_Off_For_Object_Instance();
+         virtual Message* clone() const {return new M_Turn_Updates_Off_For_Object_Instance(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Turn_Updates_Off_For_Object_Instance&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1182,6 +1298,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Attribute_Ownership_Divestiture();
          virtual ~M_Request_Attribute_Ownership_Divestiture();
+         virtual Message* clone() const {return new M_Request_Attribute_Ownership_Divestiture(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Attribute_Ownership_Divestiture&>(other);}
       protected:
       private:
    };
@@ -1191,6 +1309,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Attribute_Ownership_Assumption();
          virtual ~M_Request_Attribute_Ownership_Assumption();
+         virtual Message* clone() const {return new M_Request_Attribute_Ownership_Assumption(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Attribute_Ownership_Assumption&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1216,6 +1336,8 @@ namespace certi {
          typedef Message Super;
          M_Negotiated_Attribute_Ownership_Divestiture();
          virtual ~M_Negotiated_Attribute_Ownership_Divestiture();
+         virtual Message* clone() const {return new M_Negotiated_Attribute_Ownership_Divestiture(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Negotiated_Attribute_Ownership_Divestiture&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1241,6 +1363,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Ownership_Divestiture_Notification();
          virtual ~M_Attribute_Ownership_Divestiture_Notification();
+         virtual Message* clone() const {return new M_Attribute_Ownership_Divestiture_Notification(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Ownership_Divestiture_Notification&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1266,6 +1390,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Ownership_Acquisition_Notification();
          virtual ~M_Attribute_Ownership_Acquisition_Notification();
+         virtual Message* clone() const {return new M_Attribute_Ownership_Acquisition_Notification(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Ownership_Acquisition_Notification&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1291,6 +1417,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Attribute_Ownership_Acquisition();
          virtual ~M_Request_Attribute_Ownership_Acquisition();
+         virtual Message* clone() const {return new M_Request_Attribute_Ownership_Acquisition(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Attribute_Ownership_Acquisition&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1316,6 +1444,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Attribute_Ownership_Release();
          virtual ~M_Request_Attribute_Ownership_Release();
+         virtual Message* clone() const {return new M_Request_Attribute_Ownership_Release(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Attribute_Ownership_Release&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1341,6 +1471,8 @@ namespace certi {
          typedef Message Super;
          M_Query_Attribute_Ownership();
          virtual ~M_Query_Attribute_Ownership();
+         virtual Message* clone() const {return new M_Query_Attribute_Ownership(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Query_Attribute_Ownership&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1361,6 +1493,8 @@ namespace certi {
          typedef Message Super;
          M_Inform_Attribute_Ownership();
          virtual ~M_Inform_Attribute_Ownership();
+         virtual Message* clone() const {return new M_Inform_Attribute_Ownership(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Inform_Attribute_Ownership&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1384,6 +1518,8 @@ namespace certi {
          typedef Message Super;
          M_Is_Attribute_Owned_By_Federate();
          virtual ~M_Is_Attribute_Owned_By_Federate();
+         virtual Message* clone() const {return new M_Is_Attribute_Owned_By_Federate(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Is_Attribute_Owned_By_Federate&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1404,6 +1540,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Is_Not_Owned();
          virtual ~M_Attribute_Is_Not_Owned();
+         virtual Message* clone() const {return new M_Attribute_Is_Not_Owned(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Is_Not_Owned&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1427,6 +1565,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Owned_By_Rti();
          virtual ~M_Attribute_Owned_By_Rti();
+         virtual Message* clone() const {return new M_Attribute_Owned_By_Rti(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Owned_By_Rti&>(other);}
       protected:
       private:
    };
@@ -1436,6 +1576,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Ownership_Acquisition_If_Available();
          virtual ~M_Attribute_Ownership_Acquisition_If_Available();
+         virtual Message* clone() const {return new M_Attribute_Ownership_Acquisition_If_Available(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Ownership_Acquisition_If_Available&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1461,6 +1603,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Ownership_Unavailable();
          virtual ~M_Attribute_Ownership_Unavailable();
+         virtual Message* clone() const {return new M_Attribute_Ownership_Unavailable(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Ownership_Unavailable&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1486,6 +1630,8 @@ namespace certi {
          typedef Message Super;
          M_Unconditional_Attribute_Ownership_Divestiture();
          virtual ~M_Unconditional_Attribute_Ownership_Divestiture();
+         virtual Message* clone() const {return new M_Unconditional_Attribute_Ownership_Divestiture(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Unconditional_Attribute_Ownership_Divestiture&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1511,6 +1657,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Ownership_Acquisition();
          virtual ~M_Attribute_Ownership_Acquisition();
+         virtual Message* clone() const {return new M_Attribute_Ownership_Acquisition(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Ownership_Acquisition&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1536,6 +1684,8 @@ namespace certi {
          typedef Message Super;
          M_Cancel_Negotiated_Attribute_Ownership_Divestiture();
          virtual ~M_Cancel_Negotiated_Attribute_Ownership_Divestiture();
+         virtual Message* clone() const {return new M_Cancel_Negotiated_Attribute_Ownership_Divestiture(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Cancel_Negotiated_Attribute_Ownership_Divestiture&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1561,6 +1711,8 @@ namespace certi {
          typedef Message Super;
          M_Attribute_Ownership_Release_Response();
          virtual ~M_Attribute_Ownership_Release_Response();
+         virtual Message* clone() const {return new M_Attribute_Ownership_Release_Response(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Attribute_Ownership_Release_Response&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1586,6 +1738,8 @@ namespace certi {
          typedef Message Super;
          M_Cancel_Attribute_Ownership_Acquisition();
          virtual ~M_Cancel_Attribute_Ownership_Acquisition();
+         virtual Message* clone() const {return new M_Cancel_Attribute_Ownership_Acquisition(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Cancel_Attribute_Ownership_Acquisition&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1611,6 +1765,8 @@ namespace certi {
          typedef Message Super;
          M_Confirm_Attribute_Ownership_Acquisition_Cancellation();
          virtual ~M_Confirm_Attribute_Ownership_Acquisition_Cancellation();
+         virtual Message* clone() const {return new M_Confirm_Attribute_Ownership_Acquisition_Cancellation(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Confirm_Attribute_Ownership_Acquisition_Cancellation&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1636,6 +1792,8 @@ namespace certi {
          typedef Message Super;
          M_Change_Attribute_Order_Type();
          virtual ~M_Change_Attribute_Order_Type();
+         virtual Message* clone() const {return new M_Change_Attribute_Order_Type(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Change_Attribute_Order_Type&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1667,6 +1825,8 @@ namespace certi {
          typedef Message Super;
          M_Change_Interaction_Order_Type();
          virtual ~M_Change_Interaction_Order_Type();
+         virtual Message* clone() const {return new M_Change_Interaction_Order_Type(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Change_Interaction_Order_Type&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1690,6 +1850,8 @@ namespace certi {
          typedef Message Super;
          M_Enable_Time_Regulation();
          virtual ~M_Enable_Time_Regulation();
+         virtual Message* clone() const {return new M_Enable_Time_Regulation(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Enable_Time_Regulation&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1707,6 +1869,8 @@ namespace certi {
          typedef Message Super;
          M_Disable_Time_Regulation();
          virtual ~M_Disable_Time_Regulation();
+         virtual Message* clone() const {return new M_Disable_Time_Regulation(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Disable_Time_Regulation&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1724,6 +1888,8 @@ namespace certi {
          typedef Message Super;
          M_Enable_Time_Constrained();
          virtual ~M_Enable_Time_Constrained();
+         virtual Message* clone() const {return new M_Enable_Time_Constrained(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Enable_Time_Constrained&>(other);}
       protected:
       private:
    };
@@ -1733,6 +1899,8 @@ namespace certi {
          typedef Message Super;
          M_Disable_Time_Constrained();
          virtual ~M_Disable_Time_Constrained();
+         virtual Message* clone() const {return new M_Disable_Time_Constrained(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Disable_Time_Constrained&>(other);}
       protected:
       private:
    };
@@ -1742,6 +1910,8 @@ namespace certi {
          typedef Message Super;
          M_Query_Lbts();
          virtual ~M_Query_Lbts();
+         virtual Message* clone() const {return new M_Query_Lbts(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Query_Lbts&>(other);}
       protected:
       private:
    };
@@ -1751,6 +1921,8 @@ namespace certi {
          typedef Message Super;
          M_Query_Federate_Time();
          virtual ~M_Query_Federate_Time();
+         virtual Message* clone() const {return new M_Query_Federate_Time(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Query_Federate_Time&>(other);}
       protected:
       private:
    };
@@ -1760,6 +1932,8 @@ namespace certi {
          typedef Message Super;
          M_Query_Min_Next_Event_Time();
          virtual ~M_Query_Min_Next_Event_Time();
+         virtual Message* clone() const {return new M_Query_Min_Next_Event_Time(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Query_Min_Next_Event_Time&>(other);}
       protected:
       private:
    };
@@ -1769,6 +1943,8 @@ namespace certi {
          typedef Message Super;
          M_Modify_Lookahead();
          virtual ~M_Modify_Lookahead();
+         virtual Message* clone() const {return new M_Modify_Lookahead(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Modify_Lookahead&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1786,6 +1962,8 @@ namespace certi {
          typedef Message Super;
          M_Query_Lookahead();
          virtual ~M_Query_Lookahead();
+         virtual Message* clone() const {return new M_Query_Lookahead(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Query_Lookahead&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1803,6 +1981,8 @@ namespace certi {
          typedef Message Super;
          M_Retract();
          virtual ~M_Retract();
+         virtual Message* clone() const {return new M_Retract(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Retract&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1820,6 +2000,8 @@ namespace certi {
          typedef Message Super;
          M_Request_Retraction();
          virtual ~M_Request_Retraction();
+         virtual Message* clone() const {return new M_Request_Retraction(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Request_Retraction&>(other);}
       protected:
       private:
    };
@@ -1829,6 +2011,8 @@ namespace certi {
          typedef Message Super;
          M_Time_Advance_Request();
          virtual ~M_Time_Advance_Request();
+         virtual Message* clone() const {return new M_Time_Advance_Request(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Time_Advance_Request&>(other);}
       protected:
       private:
    };
@@ -1838,6 +2022,8 @@ namespace certi {
          typedef Message Super;
          M_Time_Advance_Request_Available();
          virtual ~M_Time_Advance_Request_Available();
+         virtual Message* clone() const {return new M_Time_Advance_Request_Available(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Time_Advance_Request_Available&>(other);}
       protected:
       private:
    };
@@ -1847,6 +2033,8 @@ namespace certi {
          typedef Message Super;
          M_Next_Event_Request();
          virtual ~M_Next_Event_Request();
+         virtual Message* clone() const {return new M_Next_Event_Request(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Next_Event_Request&>(other);}
       protected:
       private:
    };
@@ -1856,6 +2044,8 @@ namespace certi {
          typedef Message Super;
          M_Next_Event_Request_Available();
          virtual ~M_Next_Event_Request_Available();
+         virtual Message* clone() const {return new M_Next_Event_Request_Available(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Next_Event_Request_Available&>(other);}
       protected:
       private:
    };
@@ -1865,6 +2055,8 @@ namespace certi {
          typedef Message Super;
          M_Flush_Queue_Request();
          virtual ~M_Flush_Queue_Request();
+         virtual Message* clone() const {return new M_Flush_Queue_Request(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Flush_Queue_Request&>(other);}
       protected:
       private:
    };
@@ -1874,6 +2066,8 @@ namespace certi {
          typedef Message Super;
          M_Time_Advance_Grant();
          virtual ~M_Time_Advance_Grant();
+         virtual Message* clone() const {return new M_Time_Advance_Grant(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Time_Advance_Grant&>(other);}
       protected:
       private:
    };
@@ -1883,6 +2077,8 @@ namespace certi {
          typedef Message Super;
          M_Enable_Asynchronous_Delivery();
          virtual ~M_Enable_Asynchronous_Delivery();
+         virtual Message* clone() const {return new M_Enable_Asynchronous_Delivery(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Enable_Asynchronous_Delivery&>(other);}
       protected:
       private:
    };
@@ -1892,6 +2088,8 @@ namespace certi {
          typedef Message Super;
          M_Disable_Asynchronous_Delivery();
          virtual ~M_Disable_Asynchronous_Delivery();
+         virtual Message* clone() const {return new M_Disable_Asynchronous_Delivery(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Disable_Asynchronous_Delivery&>(other);}
       protected:
       private:
    };
@@ -1901,6 +2099,8 @@ namespace certi {
          typedef Message Super;
          M_Time_Regulation_Enabled();
          virtual ~M_Time_Regulation_Enabled();
+         virtual Message* clone() const {return new M_Time_Regulation_Enabled(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Time_Regulation_Enabled&>(other);}
       protected:
       private:
    };
@@ -1910,6 +2110,8 @@ namespace certi {
          typedef Message Super;
          M_Time_Constrained_Enabled();
          virtual ~M_Time_Constrained_Enabled();
+         virtual Message* clone() const {return new M_Time_Constrained_Enabled(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Time_Constrained_Enabled&>(other);}
       protected:
       private:
    };
@@ -1919,6 +2121,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Create_Region();
          virtual ~M_Ddm_Create_Region();
+         virtual Message* clone() const {return new M_Ddm_Create_Region(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Create_Region&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1947,6 +2151,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Modify_Region();
          virtual ~M_Ddm_Modify_Region();
+         virtual Message* clone() const {return new M_Ddm_Modify_Region(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Modify_Region&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1972,6 +2178,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Delete_Region();
          virtual ~M_Ddm_Delete_Region();
+         virtual Message* clone() const {return new M_Ddm_Delete_Region(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Delete_Region&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -1989,6 +2197,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Register_Object();
          virtual ~M_Ddm_Register_Object();
+         virtual Message* clone() const {return new M_Ddm_Register_Object(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Register_Object&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2025,6 +2235,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Associate_Region();
          virtual ~M_Ddm_Associate_Region();
+         virtual Message* clone() const {return new M_Ddm_Associate_Region(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Associate_Region&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2053,6 +2265,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Unassociate_Region();
          virtual ~M_Ddm_Unassociate_Region();
+         virtual Message* clone() const {return new M_Ddm_Unassociate_Region(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Unassociate_Region&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2073,6 +2287,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Subscribe_Attributes();
          virtual ~M_Ddm_Subscribe_Attributes();
+         virtual Message* clone() const {return new M_Ddm_Subscribe_Attributes(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Subscribe_Attributes&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2105,6 +2321,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Unsubscribe_Attributes();
          virtual ~M_Ddm_Unsubscribe_Attributes();
+         virtual Message* clone() const {return new M_Ddm_Unsubscribe_Attributes(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Unsubscribe_Attributes&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2125,6 +2343,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Subscribe_Interaction();
          virtual ~M_Ddm_Subscribe_Interaction();
+         virtual Message* clone() const {return new M_Ddm_Subscribe_Interaction(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Subscribe_Interaction&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2149,6 +2369,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Unsubscribe_Interaction();
          virtual ~M_Ddm_Unsubscribe_Interaction();
+         virtual Message* clone() const {return new M_Ddm_Unsubscribe_Interaction(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Unsubscribe_Interaction&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2173,6 +2395,8 @@ namespace certi {
          typedef Message Super;
          M_Ddm_Request_Update();
          virtual ~M_Ddm_Request_Update();
+         virtual Message* clone() const {return new M_Ddm_Request_Update(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Ddm_Request_Update&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2201,6 +2425,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Object_Class_Handle();
          virtual ~M_Get_Object_Class_Handle();
+         virtual Message* clone() const {return new M_Get_Object_Class_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Object_Class_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2221,6 +2447,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Object_Class_Name();
          virtual ~M_Get_Object_Class_Name();
+         virtual Message* clone() const {return new M_Get_Object_Class_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Object_Class_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2241,6 +2469,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Attribute_Handle();
          virtual ~M_Get_Attribute_Handle();
+         virtual Message* clone() const {return new M_Get_Attribute_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Attribute_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2264,6 +2494,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Attribute_Name();
          virtual ~M_Get_Attribute_Name();
+         virtual Message* clone() const {return new M_Get_Attribute_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Attribute_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2287,6 +2519,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Interaction_Class_Handle();
          virtual ~M_Get_Interaction_Class_Handle();
+         virtual Message* clone() const {return new M_Get_Interaction_Class_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Interaction_Class_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2307,6 +2541,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Interaction_Class_Name();
          virtual ~M_Get_Interaction_Class_Name();
+         virtual Message* clone() const {return new M_Get_Interaction_Class_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Interaction_Class_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2327,6 +2563,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Parameter_Handle();
          virtual ~M_Get_Parameter_Handle();
+         virtual Message* clone() const {return new M_Get_Parameter_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Parameter_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2350,6 +2588,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Parameter_Name();
          virtual ~M_Get_Parameter_Name();
+         virtual Message* clone() const {return new M_Get_Parameter_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Parameter_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2373,6 +2613,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Object_Instance_Handle();
          virtual ~M_Get_Object_Instance_Handle();
+         virtual Message* clone() const {return new M_Get_Object_Instance_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Object_Instance_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2393,6 +2635,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Object_Instance_Name();
          virtual ~M_Get_Object_Instance_Name();
+         virtual Message* clone() const {return new M_Get_Object_Instance_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Object_Instance_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2413,6 +2657,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Space_Handle();
          virtual ~M_Get_Space_Handle();
+         virtual Message* clone() const {return new M_Get_Space_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Space_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2433,6 +2679,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Space_Name();
          virtual ~M_Get_Space_Name();
+         virtual Message* clone() const {return new M_Get_Space_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Space_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2453,6 +2701,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Dimension_Handle();
          virtual ~M_Get_Dimension_Handle();
+         virtual Message* clone() const {return new M_Get_Dimension_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Dimension_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2476,6 +2726,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Dimension_Name();
          virtual ~M_Get_Dimension_Name();
+         virtual Message* clone() const {return new M_Get_Dimension_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Dimension_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2499,6 +2751,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Attribute_Space_Handle();
          virtual ~M_Get_Attribute_Space_Handle();
+         virtual Message* clone() const {return new M_Get_Attribute_Space_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Attribute_Space_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2522,6 +2776,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Object_Class();
          virtual ~M_Get_Object_Class();
+         virtual Message* clone() const {return new M_Get_Object_Class(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Object_Class&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2542,6 +2798,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Interaction_Space_Handle();
          virtual ~M_Get_Interaction_Space_Handle();
+         virtual Message* clone() const {return new M_Get_Interaction_Space_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Interaction_Space_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2562,6 +2820,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Transportation_Handle();
          virtual ~M_Get_Transportation_Handle();
+         virtual Message* clone() const {return new M_Get_Transportation_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Transportation_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2582,6 +2842,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Transportation_Name();
          virtual ~M_Get_Transportation_Name();
+         virtual Message* clone() const {return new M_Get_Transportation_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Transportation_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2602,6 +2864,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Ordering_Handle();
          virtual ~M_Get_Ordering_Handle();
+         virtual Message* clone() const {return new M_Get_Ordering_Handle(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Ordering_Handle&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2622,6 +2886,8 @@ namespace certi {
          typedef Message Super;
          M_Get_Ordering_Name();
          virtual ~M_Get_Ordering_Name();
+         virtual Message* clone() const {return new M_Get_Ordering_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Get_Ordering_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2642,6 +2908,8 @@ namespace certi {
          typedef Message Super;
          M_Enable_Class_Relevance_Advisory_Switch();
          virtual ~M_Enable_Class_Relevance_Advisory_Switch();
+         virtual Message* clone() const {return new M_Enable_Class_Relevance_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Enable_Class_Relevance_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2651,6 +2919,8 @@ namespace certi {
          typedef Message Super;
          M_Disable_Class_Relevance_Advisory_Switch();
          virtual ~M_Disable_Class_Relevance_Advisory_Switch();
+         virtual Message* clone() const {return new M_Disable_Class_Relevance_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Disable_Class_Relevance_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2660,6 +2930,8 @@ namespace certi {
          typedef Message Super;
          M_Enable_Attribute_Relevance_Advisory_Switch();
          virtual ~M_Enable_Attribute_Relevance_Advisory_Switch();
+         virtual Message* clone() const {return new M_Enable_Attribute_Relevance_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Enable_Attribute_Relevance_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2669,6 +2941,8 @@ namespace certi {
          typedef Message Super;
          M_Disable_Attribute_Relevance_Advisory_Switch();
          virtual ~M_Disable_Attribute_Relevance_Advisory_Switch();
+         virtual Message* clone() const {return new M_Disable_Attribute_Relevance_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Disable_Attribute_Relevance_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2678,6 +2952,8 @@ namespace certi {
          typedef Message Super;
          M_Enable_Attribute_Scope_Advisory_Switch();
          virtual ~M_Enable_Attribute_Scope_Advisory_Switch();
+         virtual Message* clone() const {return new M_Enable_Attribute_Scope_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Enable_Attribute_Scope_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2687,6 +2963,8 @@ namespace certi {
          typedef Message Super;
          M_Disable_Attribute_Scope_Advisory_Switch();
          virtual ~M_Disable_Attribute_Scope_Advisory_Switch();
+         virtual Message* clone() const {return new M_Disable_Attribute_Scope_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Disable_Attribute_Scope_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2696,6 +2974,8 @@ namespace certi {
          typedef Message Super;
          M_Enable_Interaction_Relevance_Advisory_Switch();
          virtual ~M_Enable_Interaction_Relevance_Advisory_Switch();
+         virtual Message* clone() const {return new M_Enable_Interaction_Relevance_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Enable_Interaction_Relevance_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2705,6 +2985,8 @@ namespace certi {
          typedef Message Super;
          M_Disable_Interaction_Relevance_Advisory_Switch();
          virtual ~M_Disable_Interaction_Relevance_Advisory_Switch();
+         virtual Message* clone() const {return new M_Disable_Interaction_Relevance_Advisory_Switch(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Disable_Interaction_Relevance_Advisory_Switch&>(other);}
       protected:
       private:
    };
@@ -2714,6 +2996,8 @@ namespace certi {
          typedef Message Super;
          M_Tick_Request();
          virtual ~M_Tick_Request();
+         virtual Message* clone() const {return new M_Tick_Request(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Tick_Request&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2737,6 +3021,8 @@ namespace certi {
          typedef Message Super;
          M_Tick_Request_Next();
          virtual ~M_Tick_Request_Next();
+         virtual Message* clone() const {return new M_Tick_Request_Next(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Tick_Request_Next&>(other);}
       protected:
       private:
    };
@@ -2746,15 +3032,40 @@ namespace certi {
          typedef Message Super;
          M_Tick_Request_Stop();
          virtual ~M_Tick_Request_Stop();
+         virtual Message* clone() const {return new M_Tick_Request_Stop(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Tick_Request_Stop&>(other);}
       protected:
       private:
    };
+   // Header of a batch of callbacks sent in a single transfer by the RTIA,
+   // followed by count callback messages. The last one may be the
+   // M_Tick_Request ending the tick.
+   class CERTI_EXPORT M_Tick_Callbacks : public Message {
+      public:
+         typedef Message Super;
+         M_Tick_Callbacks();
+         virtual ~M_Tick_Callbacks();
+         virtual Message* clone() const {return new M_Tick_Callbacks(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Tick_Callbacks&>(other);}
+         virtual void serialize(libhla::MessageBuffer& msgBuffer);
+         virtual void deserialize(libhla::MessageBuffer& msgBuffer);
+         // specific Getter(s)/Setter(s)
+         const uint32_t& getCount() const {return count;}
+         void setCount(const uint32_t& newCount) {count=newCount;}
+         // the show method
+         virtual std::ostream& show(std::ostream& out);
+      protected:
+         uint32_t count;
+      private:
+   };
    // HLA 1516 - §6.2
    class CERTI_EXPORT M_Reserve_Object_Instance_Name : public Message {
       public:
          typedef Message Super;
          M_Reserve_Object_Instance_Name();
          virtual ~M_Reserve_Object_Instance_Name();
+         virtual Message* clone() const {return new M_Reserve_Object_Instance_Name(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Reserve_Object_Instance_Name&>(other);}
          virtual void serialize(libhla::MessageBuffer& msgBuffer);
          virtual void deserialize(libhla::MessageBuffer& msgBuffer);
          // specific Getter(s)/Setter(s)
@@ -2772,6 +3083,8 @@ namespace certi {
          typedef M_Reserve_Object_Instance_Name Super;
          M_Reserve_Object_Instance_Name_Succeeded();
          virtual ~M_Reserve_Object_Instance_Name_Succeeded();
+         virtual Message* clone() const {return new M_Reserve_Object_Instance_Name_Succeeded(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Reserve_Object_Instance_Name_Succeeded&>(other);}
       protected:
       private:
    };
@@ -2781,6 +3094,8 @@ namespace certi {
          typedef M_Reserve_Object_Instance_Name Super;
          M_Reserve_Object_Instance_Name_Failed();
          virtual ~M_Reserve_Object_Instance_Name_Failed();
+         virtual Message* clone() const {return new M_Reserve_Object_Instance_Name_Failed(*this);}
+         virtual void copy(const Message& other) {*this=static_cast<const M_Reserve_Object_Instance_Name_Failed&>(other);}
       protected:
       private:
    };
@@ -2789,6 +3104,7 @@ namespace certi {
       public:
          static Message* create(M_Type type) throw (NetworkError ,NetworkSignal); 
          static Message* receive(MStreamType stream) throw (NetworkError ,NetworkSignal); 
+         static Message* receive(MStreamType stream, libhla::MessageBuffer& msgBuffer) throw (NetworkError ,NetworkSignal); 
       protected:
       private:
    };
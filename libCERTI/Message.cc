@@ -43,6 +43,22 @@ Message::Message()
     dimension = 0 ;
 } /* end of Message default constructor */
 
+// ----------------------------------------------------------------------------
+Message &
+Message::operator=(const Message &other)
+{
+    BasicMessage::operator=(other);
+    type = other.type ;
+    exception = other.exception ;
+    exceptionReason = other.exceptionReason ;
+    resignAction = other.resignAction ;
+    eventRetraction = other.eventRetraction ;
+    space = other.space ;
+    dimension = other.dimension ;
+    messageName = other.messageName ;
+    return *this ;
+}
+
 // ----------------------------------------------------------------------------
 /** Store exception into message
     @param the_exception : exception type (enum)
@@ -206,6 +206,7 @@ public:
         RESERVE_OBJECT_INSTANCE_NAME, // HLA1516
 		RESERVE_OBJECT_INSTANCE_NAME_SUCCEEDED, // HLA1516
 		RESERVE_OBJECT_INSTANCE_NAME_FAILED, // HLA1516
+        TICK_CALLBACKS, // since protocol 1.1
         
 	LAST // should be the "last" (not used)
     };
@@ -254,6 +255,18 @@ public:
 	 */
 	void receive(SocketUN* socket, MessageBuffer& msgBuffer) throw (NetworkError, NetworkSignal);
 
+	/**
+	 * Copy of the message, of the same class. The messages of an
+	 * in-process federate/RTIA link are copied instead of serialized.
+	 */
+	virtual Message* clone() const { return new Message(*this); }
+
+	/**
+	 * Assign a message of the same class to this one.
+	 * @param[in] other the message to copy, whose type is the one of this message
+	 */
+	virtual void copy(const Message& other) { *this = other ; }
+
     void setException(TypeException, const std::string& the_reason = "");
     TypeException getExceptionType() const { return exception ; };
     const char *getExceptionReason() const { return exceptionReason.c_str() ; };
@@ -270,8 +283,8 @@ protected:
     DimensionHandle dimension ;
     const char* messageName ;
 
-private:
-    Message &operator=(const Message &);
+    /** Only derived classes assign messages, through copy(). */
+    Message &operator=(const Message &) ;
 };
 
 } // namespace certi
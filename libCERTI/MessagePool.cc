@@ -0,0 +1,235 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "MessagePool.hh"
+#include "NM_Classes.hh"
+#include "M_Classes.hh"
+
+#include <new>
+#include <vector>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace certi {
+
+#ifndef _WIN32
+namespace {
+
+/** Blocks of 16, 32, ... 1024 bytes, the larger ones are not kept. */
+const size_t BLOCK_GRANULARITY = 16 ;
+const size_t BLOCK_CLASSES = 64 ;
+const uint32_t BLOCKS_KEPT = 1024 ;
+/** Messages kept per type: more than one message of a type is rarely held
+    at once, except in the queues of the RTIA. */
+const uint32_t MESSAGES_KEPT = 32 ;
+
+struct FreeBlock {
+    FreeBlock *next ;
+};
+
+struct ThreadPools {
+    ThreadPools() {
+        for (size_t c = 0 ; c < BLOCK_CLASSES ; ++c) {
+            blocks[c] = NULL ;
+            blockCount[c] = 0 ;
+        }
+    }
+    FreeBlock *blocks[BLOCK_CLASSES] ;
+    uint32_t blockCount[BLOCK_CLASSES] ;
+    std::vector<NetworkMessage *> networkMessages[NetworkMessage::LAST] ;
+    std::vector<Message *> messages[Message::LAST] ;
+};
+
+__thread ThreadPools *threadPools = NULL ;
+pthread_key_t poolsKey ;
+pthread_once_t poolsKeyOnce = PTHREAD_ONCE_INIT ;
+
+// ----------------------------------------------------------------------------
+template<typename T> void
+deleteAll(std::vector<T *> &kept)
+{
+    for (size_t i = 0 ; i < kept.size() ; ++i)
+        delete kept[i] ;
+    kept.clear();
+}
+
+// ----------------------------------------------------------------------------
+extern "C" void
+destroyPools(void *data)
+{
+    ThreadPools *pools = static_cast<ThreadPools *>(data);
+    // The messages deleted below give their memory back to the system.
+    threadPools = NULL ;
+    for (int t = 0 ; t < NetworkMessage::LAST ; ++t)
+        deleteAll(pools->networkMessages[t]);
+    for (int t = 0 ; t < Message::LAST ; ++t)
+        deleteAll(pools->messages[t]);
+    for (size_t c = 0 ; c < BLOCK_CLASSES ; ++c) {
+        while (pools->blocks[c] != NULL) {
+            FreeBlock *block = pools->blocks[c] ;
+            pools->blocks[c] = block->next ;
+            ::operator delete(block);
+        }
+    }
+    delete pools ;
+}
+
+// ----------------------------------------------------------------------------
+extern "C" void
+createPoolsKey()
+{
+    pthread_key_create(&poolsKey, destroyPools);
+}
+
+// ----------------------------------------------------------------------------
+ThreadPools *
+getPools()
+{
+    if (threadPools == NULL) {
+        pthread_once(&poolsKeyOnce, createPoolsKey);
+        threadPools = new ThreadPools ;
+        pthread_setspecific(poolsKey, threadPools);
+    }
+    return threadPools ;
+}
+
+// ----------------------------------------------------------------------------
+template<typename T, typename Factory> T *
+getMessage(std::vector<T *> &kept, typename T::Type type)
+{
+    if (kept.empty())
+        return Factory::create(type);
+    T *msg = kept.back();
+    kept.pop_back();
+    return msg ;
+}
+
+// ----------------------------------------------------------------------------
+template<typename T> bool
+keepMessage(std::vector<T *> &kept, T *msg)
+{
+    if (kept.size() >= MESSAGES_KEPT)
+        return false ;
+    if (kept.capacity() == 0)
+        kept.reserve(MESSAGES_KEPT);
+    kept.push_back(msg);
+    return true ;
+}
+
+} // anonymous namespace
+#endif
+
+// ----------------------------------------------------------------------------
+NetworkMessage *
+MessagePool::get(NetworkMessage::Type type)
+    throw (NetworkError, NetworkSignal)
+{
+#ifndef _WIN32
+    if (type > NetworkMessage::NOT_USED && type < NetworkMessage::LAST)
+        return getMessage<NetworkMessage, NM_Factory>(getPools()->networkMessages[type], type);
+#endif
+    return NM_Factory::create(type);
+}
+
+// ----------------------------------------------------------------------------
+Message *
+MessagePool::get(Message::Type type)
+    throw (NetworkError, NetworkSignal)
+{
+#ifndef _WIN32
+    if (type > Message::NOT_USED && type < Message::LAST)
+        return getMessage<Message, M_Factory>(getPools()->messages[type], type);
+#endif
+    return M_Factory::create(type);
+}
+
+// ----------------------------------------------------------------------------
+void
+MessagePool::release(NetworkMessage *msg)
+{
+    if (msg == NULL)
+        return ;
+#ifndef _WIN32
+    NetworkMessage::Type type = msg->getMessageType();
+    if (type > NetworkMessage::NOT_USED && type < NetworkMessage::LAST
+        && keepMessage(getPools()->networkMessages[type], msg))
+        return ;
+#endif
+    delete msg ;
+}
+
+// ----------------------------------------------------------------------------
+void
+MessagePool::release(Message *msg)
+{
+    if (msg == NULL)
+        return ;
+#ifndef _WIN32
+    Message::Type type = msg->getMessageType();
+    if (type > Message::NOT_USED && type < Message::LAST
+        && keepMessage(getPools()->messages[type], msg))
+        return ;
+#endif
+    delete msg ;
+}
+
+// ----------------------------------------------------------------------------
+void *
+MessagePool::allocate(size_t size)
+{
+#ifndef _WIN32
+    size_t rank = (size + BLOCK_GRANULARITY - 1) / BLOCK_GRANULARITY ;
+    if (rank > 0 && rank <= BLOCK_CLASSES) {
+        ThreadPools *pools = getPools();
+        FreeBlock *block = pools->blocks[rank - 1] ;
+        if (block != NULL) {
+            pools->blocks[rank - 1] = block->next ;
+            --pools->blockCount[rank - 1] ;
+            return block ;
+        }
+        // Any block of a class can hold the largest size of the class.
+        return ::operator new(rank * BLOCK_GRANULARITY);
+    }
+#endif
+    return ::operator new(size);
+}
+
+// ----------------------------------------------------------------------------
+void
+MessagePool::deallocate(void *block, size_t size)
+{
+    if (block == NULL)
+        return ;
+#ifndef _WIN32
+    size_t rank = (size + BLOCK_GRANULARITY - 1) / BLOCK_GRANULARITY ;
+    ThreadPools *pools = threadPools ;
+    if (pools != NULL && rank > 0 && rank <= BLOCK_CLASSES
+        && pools->blockCount[rank - 1] < BLOCKS_KEPT) {
+        FreeBlock *freed = static_cast<FreeBlock *>(block);
+        freed->next = pools->blocks[rank - 1] ;
+        pools->blocks[rank - 1] = freed ;
+        ++pools->blockCount[rank - 1] ;
+        return ;
+    }
+#endif
+    ::operator delete(block);
+}
+
+} // namespace certi
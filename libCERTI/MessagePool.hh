@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_MESSAGE_POOL_HH
+#define CERTI_MESSAGE_POOL_HH
+
+#include "NetworkMessage.hh"
+#include "Message.hh"
+
+#include <cstddef>
+
+namespace certi {
+
+/**
+ * Recycling of the message objects, so that receiving a message allocates
+ * nothing once the pools are warm.
+ *
+ * A message given back by release is kept whole, with the capacity of its
+ * strings and vectors, and get hands it out again for the next message of
+ * the same type: deserializing into it then reuses its storage. Beyond a few
+ * messages per type, released messages are deleted, and the memory of the
+ * message objects themselves comes from free lists of fixed size blocks
+ * (see BasicMessage::operator new).
+ *
+ * The pools belong to the calling thread: a message may be released by
+ * another thread than the one which got it, it then joins the pool of the
+ * releasing thread. On Windows, get creates and release deletes.
+ */
+class CERTI_EXPORT MessagePool
+{
+public:
+    /** A message of the type, recycled or created by NM_Factory. */
+    static NetworkMessage *get(NetworkMessage::Type type)
+        throw (NetworkError, NetworkSignal);
+    /** A message of the type, recycled or created by M_Factory. */
+    static Message *get(Message::Type type)
+        throw (NetworkError, NetworkSignal);
+
+    /** Give back a message of get, or of new. NULL is ignored. */
+    static void release(NetworkMessage *msg);
+    static void release(Message *msg);
+
+    /** Memory of the message objects, in blocks of a few sizes. */
+    static void *allocate(size_t size);
+    static void deallocate(void *block, size_t size);
+};
+
+} // namespace certi
+
+#endif // CERTI_MESSAGE_POOL_HH
@@ -22,6 +22,7 @@
 #include "Message.hh"
 #include <cassert>
 #include <iostream>
+#include <memory>
 
 namespace certi {
 
@@ -70,6 +71,8 @@ void Message::deserialize(MessageBuffer& msgBuffer) {
 	exception   = static_cast<TypeException>(msgBuffer.read_int32());
 	if (exception != e_NO_EXCEPTION) {
 		msgBuffer.read_string(exceptionReason);
+		// no stale option of a recycled message
+		_isDated = _isLabelled = _isTagged = false;
 	} else {
 		BasicMessage::deserialize(msgBuffer);
 	}
@@ -79,6 +82,12 @@ void Message::deserialize(MessageBuffer& msgBuffer) {
 void
 Message::send(SocketUN *socket, MessageBuffer &msgBuffer) throw (NetworkError, NetworkSignal) {
 	G.Out(pdGendoc,"enter Message::send");
+	/* The in-process link carries a copy of the message itself */
+	if (socket->usesLocalLink()) {
+		socket->sendMessage(clone());
+		G.Out(pdGendoc,"exit  Message::send");
+		return;
+	}
 	/* 0- reset send buffer */
 	msgBuffer.reset();
 	/* 1- serialize the message
@@ -98,6 +107,17 @@ Message::send(SocketUN *socket, MessageBuffer &msgBuffer) throw (NetworkError, N
 void
 Message::receive(SocketUN* socket, MessageBuffer &msgBuffer) throw (NetworkError, NetworkSignal) {
 	G.Out(pdGendoc,"enter Message::receive");
+	/* The in-process link carries the message itself */
+	if (socket->usesLocalLink()) {
+		std::auto_ptr<Message> msg(socket->receiveMessage());
+		if (msg->getMessageType() != type) {
+			throw NetworkError(stringize() << "Received <" << msg->getMessageName()
+			                   << "> instead of <" << getMessageName() << ">");
+		}
+		copy(*msg);
+		G.Out(pdGendoc,"exit  Message::receive");
+		return;
+	}
 	/* 0- Reset receive buffer */
 	/* FIXME this reset may not be necessary since we do
 	 * raw-receive + assume-size
@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include "NM_Classes.hh"
+#include "MessagePool.hh"
 // ----------------------------------------------------------------------------
 // CERTI - HLA RunTime Infrastructure
 // Copyright (C) 2002-2008  ONERA
@@ -366,6 +367,7 @@ namespace certi {
       //multicastAddress= <no default value in message spec using builtin>
       //bestEffortAddress= <no default value in message spec using builtin>
       //bestEffortPeer= <no default value in message spec using builtin>
+      dataPeer=0;
       //federationName= <no default value in message spec using builtin>
       //federateName= <no default value in message spec using builtin>
       //routingSpaces= <no default value in message spec using builtin>
@@ -384,6 +386,7 @@ namespace certi {
       msgBuffer.write_uint32(multicastAddress);
       msgBuffer.write_uint32(bestEffortAddress);
       msgBuffer.write_uint32(bestEffortPeer);
+      msgBuffer.write_uint32(dataPeer);
       msgBuffer.write_string(federationName);
       msgBuffer.write_string(federateName);
       uint32_t routingSpacesSize = routingSpaces.size();
@@ -411,6 +414,7 @@ namespace certi {
       multicastAddress = msgBuffer.read_uint32();
       bestEffortAddress = msgBuffer.read_uint32();
       bestEffortPeer = msgBuffer.read_uint32();
+      dataPeer = msgBuffer.read_uint32();
       msgBuffer.read_string(federationName);
       msgBuffer.read_string(federateName);
       uint32_t routingSpacesSize = msgBuffer.read_uint32();
@@ -438,6 +442,7 @@ namespace certi {
       out << " multicastAddress = " << multicastAddress << " "       << std::endl;
       out << " bestEffortAddress = " << bestEffortAddress << " "       << std::endl;
       out << " bestEffortPeer = " << bestEffortPeer << " "       << std::endl;
+      out << " dataPeer = " << dataPeer << " "       << std::endl;
       out << " federationName = " << federationName << " "       << std::endl;
       out << " federateName = " << federateName << " "       << std::endl;
       out << "    routingSpaces [] =" << std::endl;
@@ -1208,13 +1213,7 @@ namespace certi {
       for (uint32_t i = 0; i < attributesSize; ++i) {
          msgBuffer.write_uint32(attributes[i]);
       }
-      uint32_t valuesSize = values.size();
-      msgBuffer.write_uint32(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //serialize native whose representation is 'repeated' byte 
-         msgBuffer.write_uint32(values[i].size());
-         msgBuffer.write_bytes(&(values[i][0]),values[i].size());
-      }
+      values.serialize(msgBuffer);
       msgBuffer.write_bool(_hasEvent);
       if (_hasEvent) {
                }
@@ -1230,13 +1229,7 @@ namespace certi {
       for (uint32_t i = 0; i < attributesSize; ++i) {
          attributes[i] = static_cast<AttributeHandle>(msgBuffer.read_uint32());
       }
-      uint32_t valuesSize = msgBuffer.read_uint32();
-      values.resize(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //deserialize native whose representation is 'repeated' byte 
-         values[i].resize(msgBuffer.read_uint32());
-         msgBuffer.read_bytes(&(values[i][0]),values[i].size());
-      }
+      values.deserialize(msgBuffer);
       _hasEvent = msgBuffer.read_bool();
       if (_hasEvent) {
                }
@@ -1254,7 +1247,7 @@ namespace certi {
       out << std::endl;
       out << "    values [] =" << std::endl;
       for (uint32_t i = 0; i < getValuesSize(); ++i) {
-         out << "         //FIXME FIXME don't know how to serialize native field <values> of type <AttributeValue_t>";
+         out << values.length(i) << " bytes ";
       }
       out << std::endl;
       out << "(opt) event =" << "      //FIXME FIXME don't know how to serialize native field <event> of type <EventRetractionHandle>"      << std::endl;
@@ -1285,13 +1278,7 @@ namespace certi {
       for (uint32_t i = 0; i < attributesSize; ++i) {
          msgBuffer.write_uint32(attributes[i]);
       }
-      uint32_t valuesSize = values.size();
-      msgBuffer.write_uint32(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //serialize native whose representation is 'repeated' byte 
-         msgBuffer.write_uint32(values[i].size());
-         msgBuffer.write_bytes(&(values[i][0]),values[i].size());
-      }
+      values.serialize(msgBuffer);
       msgBuffer.write_bool(_hasEvent);
       if (_hasEvent) {
                }
@@ -1307,13 +1294,7 @@ namespace certi {
       for (uint32_t i = 0; i < attributesSize; ++i) {
          attributes[i] = static_cast<AttributeHandle>(msgBuffer.read_uint32());
       }
-      uint32_t valuesSize = msgBuffer.read_uint32();
-      values.resize(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //deserialize native whose representation is 'repeated' byte 
-         values[i].resize(msgBuffer.read_uint32());
-         msgBuffer.read_bytes(&(values[i][0]),values[i].size());
-      }
+      values.deserialize(msgBuffer);
       _hasEvent = msgBuffer.read_bool();
       if (_hasEvent) {
                }
@@ -1331,7 +1312,7 @@ namespace certi {
       out << std::endl;
       out << "    values [] =" << std::endl;
       for (uint32_t i = 0; i < getValuesSize(); ++i) {
-         out << "         //FIXME FIXME don't know how to serialize native field <values> of type <AttributeValue_t>";
+         out << values.length(i) << " bytes ";
       }
       out << std::endl;
       out << "(opt) event =" << "      //FIXME FIXME don't know how to serialize native field <event> of type <EventRetractionHandle>"      << std::endl;
@@ -1361,13 +1342,7 @@ namespace certi {
       for (uint32_t i = 0; i < parametersSize; ++i) {
          msgBuffer.write_uint32(parameters[i]);
       }
-      uint32_t valuesSize = values.size();
-      msgBuffer.write_uint32(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //serialize native whose representation is 'repeated' byte 
-         msgBuffer.write_uint32(values[i].size());
-         msgBuffer.write_bytes(&(values[i][0]),values[i].size());
-      }
+      values.serialize(msgBuffer);
       msgBuffer.write_uint32(region);
    }
 
@@ -1381,13 +1356,7 @@ namespace certi {
       for (uint32_t i = 0; i < parametersSize; ++i) {
          parameters[i] = static_cast<ParameterHandle>(msgBuffer.read_uint32());
       }
-      uint32_t valuesSize = msgBuffer.read_uint32();
-      values.resize(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //deserialize native whose representation is 'repeated' byte 
-         values[i].resize(msgBuffer.read_uint32());
-         msgBuffer.read_bytes(&(values[i][0]),values[i].size());
-      }
+      values.deserialize(msgBuffer);
       region = static_cast<RegionHandle>(msgBuffer.read_uint32());
    }
 
@@ -1403,7 +1372,7 @@ namespace certi {
       out << std::endl;
       out << "    values [] =" << std::endl;
       for (uint32_t i = 0; i < getValuesSize(); ++i) {
-         out << "         //FIXME FIXME don't know how to serialize native field <values> of type <ParameterValue_t>";
+         out << values.length(i) << " bytes ";
       }
       out << std::endl;
       out << " region = " << region << " "       << std::endl;
@@ -1434,13 +1403,7 @@ namespace certi {
       for (uint32_t i = 0; i < parametersSize; ++i) {
          msgBuffer.write_uint32(parameters[i]);
       }
-      uint32_t valuesSize = values.size();
-      msgBuffer.write_uint32(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //serialize native whose representation is 'repeated' byte 
-         msgBuffer.write_uint32(values[i].size());
-         msgBuffer.write_bytes(&(values[i][0]),values[i].size());
-      }
+      values.serialize(msgBuffer);
       msgBuffer.write_bool(_hasEvent);
       if (_hasEvent) {
                }
@@ -1456,13 +1419,7 @@ namespace certi {
       for (uint32_t i = 0; i < parametersSize; ++i) {
          parameters[i] = static_cast<ParameterHandle>(msgBuffer.read_uint32());
       }
-      uint32_t valuesSize = msgBuffer.read_uint32();
-      values.resize(valuesSize);
-      for (uint32_t i = 0; i < valuesSize; ++i) {
-         //deserialize native whose representation is 'repeated' byte 
-         values[i].resize(msgBuffer.read_uint32());
-         msgBuffer.read_bytes(&(values[i][0]),values[i].size());
-      }
+      values.deserialize(msgBuffer);
       _hasEvent = msgBuffer.read_bool();
       if (_hasEvent) {
                }
@@ -1480,7 +1437,7 @@ namespace certi {
       out << std::endl;
       out << "    values [] =" << std::endl;
       for (uint32_t i = 0; i < getValuesSize(); ++i) {
-         out << "         //FIXME FIXME don't know how to serialize native field <values> of type <ParameterValue_t>";
+         out << values.length(i) << " bytes ";
       }
       out << std::endl;
       out << "(opt) event =" << "      //FIXME FIXME don't know how to serialize native field <event> of type <EventRetractionHandle>"      << std::endl;
@@ -2785,6 +2742,190 @@ namespace certi {
       return out;
    }
 
+   NM_Data_Peer::NM_Data_Peer() {
+      this->messageName = "NM_Data_Peer";
+      this->type = NetworkMessage::DATA_PEER;
+      //address= <no default value in message spec using builtin>
+      //port= <no default value in message spec using builtin>
+   }
+
+   NM_Data_Peer::~NM_Data_Peer() {
+   }
+
+   void NM_Data_Peer::serialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::serialize(msgBuffer);
+      //Specific serialization code
+      msgBuffer.write_uint32(address);
+      msgBuffer.write_uint32(port);
+   }
+
+   void NM_Data_Peer::deserialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::deserialize(msgBuffer);
+      //Specific deserialization code
+      address = msgBuffer.read_uint32();
+      port = msgBuffer.read_uint32();
+   }
+
+   std::ostream& NM_Data_Peer::show(std::ostream& out) {
+      out << "[NM_Data_Peer -Begin]" << std::endl;      //Call mother class
+      Super::show(out);
+      //Specific show code
+      out << " address = " << address << " "       << std::endl;
+      out << " port = " << port << " "       << std::endl;
+      out << "[NM_Data_Peer -End]" << std::endl;
+      return out;
+   }
+
+   NM_Object_Class_Routes::NM_Object_Class_Routes() {
+      this->messageName = "NM_Object_Class_Routes";
+      this->type = NetworkMessage::OBJECT_CLASS_ROUTES;
+      //objectClass= <no default value in message spec using builtin>
+      //attributes= <no default value in message spec using builtin>
+      //routeSizes= <no default value in message spec using builtin>
+      //federates= <no default value in message spec using builtin>
+      //regionalAttributes= <no default value in message spec using builtin>
+   }
+
+   NM_Object_Class_Routes::~NM_Object_Class_Routes() {
+   }
+
+   void NM_Object_Class_Routes::serialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::serialize(msgBuffer);
+      //Specific serialization code
+      msgBuffer.write_uint32(objectClass);
+      uint32_t attributesSize = attributes.size();
+      msgBuffer.write_uint32(attributesSize);
+      for (uint32_t i = 0; i < attributesSize; ++i) {
+         msgBuffer.write_uint32(attributes[i]);
+      }
+      uint32_t routeSizesSize = routeSizes.size();
+      msgBuffer.write_uint32(routeSizesSize);
+      for (uint32_t i = 0; i < routeSizesSize; ++i) {
+         msgBuffer.write_uint32(routeSizes[i]);
+      }
+      uint32_t federatesSize = federates.size();
+      msgBuffer.write_uint32(federatesSize);
+      for (uint32_t i = 0; i < federatesSize; ++i) {
+         msgBuffer.write_uint32(federates[i]);
+      }
+      uint32_t regionalAttributesSize = regionalAttributes.size();
+      msgBuffer.write_uint32(regionalAttributesSize);
+      for (uint32_t i = 0; i < regionalAttributesSize; ++i) {
+         msgBuffer.write_uint32(regionalAttributes[i]);
+      }
+   }
+
+   void NM_Object_Class_Routes::deserialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::deserialize(msgBuffer);
+      //Specific deserialization code
+      objectClass = static_cast<ObjectClassHandle>(msgBuffer.read_uint32());
+      uint32_t attributesSize = msgBuffer.read_uint32();
+      attributes.resize(attributesSize);
+      for (uint32_t i = 0; i < attributesSize; ++i) {
+         attributes[i] = static_cast<AttributeHandle>(msgBuffer.read_uint32());
+      }
+      uint32_t routeSizesSize = msgBuffer.read_uint32();
+      routeSizes.resize(routeSizesSize);
+      for (uint32_t i = 0; i < routeSizesSize; ++i) {
+         routeSizes[i] = msgBuffer.read_uint32();
+      }
+      uint32_t federatesSize = msgBuffer.read_uint32();
+      federates.resize(federatesSize);
+      for (uint32_t i = 0; i < federatesSize; ++i) {
+         federates[i] = static_cast<FederateHandle>(msgBuffer.read_uint32());
+      }
+      uint32_t regionalAttributesSize = msgBuffer.read_uint32();
+      regionalAttributes.resize(regionalAttributesSize);
+      for (uint32_t i = 0; i < regionalAttributesSize; ++i) {
+         regionalAttributes[i] = static_cast<AttributeHandle>(msgBuffer.read_uint32());
+      }
+   }
+
+   std::ostream& NM_Object_Class_Routes::show(std::ostream& out) {
+      out << "[NM_Object_Class_Routes -Begin]" << std::endl;      //Call mother class
+      Super::show(out);
+      //Specific show code
+      out << " objectClass = " << objectClass << " "       << std::endl;
+      out << "    attributes [] =" << std::endl;
+      for (uint32_t i = 0; i < getAttributesSize(); ++i) {
+         out << attributes[i] << " " ;
+      }
+      out << std::endl;
+      out << "    routeSizes [] =" << std::endl;
+      for (uint32_t i = 0; i < getRouteSizesSize(); ++i) {
+         out << routeSizes[i] << " " ;
+      }
+      out << std::endl;
+      out << "    federates [] =" << std::endl;
+      for (uint32_t i = 0; i < getFederatesSize(); ++i) {
+         out << federates[i] << " " ;
+      }
+      out << std::endl;
+      out << "    regionalAttributes [] =" << std::endl;
+      for (uint32_t i = 0; i < getRegionalAttributesSize(); ++i) {
+         out << regionalAttributes[i] << " " ;
+      }
+      out << std::endl;
+      out << "[NM_Object_Class_Routes -End]" << std::endl;
+      return out;
+   }
+
+   NM_Interaction_Class_Routes::NM_Interaction_Class_Routes() {
+      this->messageName = "NM_Interaction_Class_Routes";
+      this->type = NetworkMessage::INTERACTION_CLASS_ROUTES;
+      //interactionClass= <no default value in message spec using builtin>
+      //federates= <no default value in message spec using builtin>
+      //regional= <no default value in message spec using builtin>
+   }
+
+   NM_Interaction_Class_Routes::~NM_Interaction_Class_Routes() {
+   }
+
+   void NM_Interaction_Class_Routes::serialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::serialize(msgBuffer);
+      //Specific serialization code
+      msgBuffer.write_uint32(interactionClass);
+      uint32_t federatesSize = federates.size();
+      msgBuffer.write_uint32(federatesSize);
+      for (uint32_t i = 0; i < federatesSize; ++i) {
+         msgBuffer.write_uint32(federates[i]);
+      }
+      msgBuffer.write_bool(regional);
+   }
+
+   void NM_Interaction_Class_Routes::deserialize(libhla::MessageBuffer& msgBuffer) {
+      //Call mother class
+      Super::deserialize(msgBuffer);
+      //Specific deserialization code
+      interactionClass = static_cast<InteractionClassHandle>(msgBuffer.read_uint32());
+      uint32_t federatesSize = msgBuffer.read_uint32();
+      federates.resize(federatesSize);
+      for (uint32_t i = 0; i < federatesSize; ++i) {
+         federates[i] = static_cast<FederateHandle>(msgBuffer.read_uint32());
+      }
+      regional = msgBuffer.read_bool();
+   }
+
+   std::ostream& NM_Interaction_Class_Routes::show(std::ostream& out) {
+      out << "[NM_Interaction_Class_Routes -Begin]" << std::endl;      //Call mother class
+      Super::show(out);
+      //Specific show code
+      out << " interactionClass = " << interactionClass << " "       << std::endl;
+      out << "    federates [] =" << std::endl;
+      for (uint32_t i = 0; i < getFederatesSize(); ++i) {
+         out << federates[i] << " " ;
+      }
+      out << std::endl;
+      out << " regional = " << regional << " "       << std::endl;
+      out << "[NM_Interaction_Class_Routes -End]" << std::endl;
+      return out;
+   }
+
    New_NetworkMessage::New_NetworkMessage() {
       type=0;
       _hasDate=false;
@@ -3135,6 +3276,15 @@ namespace certi {
          case NetworkMessage::MESSAGE_NULL_PRIME:
             msg = new NM_Message_Null_Prime();
             break;
+         case NetworkMessage::DATA_PEER:
+            msg = new NM_Data_Peer();
+            break;
+         case NetworkMessage::OBJECT_CLASS_ROUTES:
+            msg = new NM_Object_Class_Routes();
+            break;
+         case NetworkMessage::INTERACTION_CLASS_ROUTES:
+            msg = new NM_Interaction_Class_Routes();
+            break;
          case NetworkMessage::LAST:
             throw NetworkError("LAST message type should not be used!!");
             break;
@@ -3143,15 +3293,20 @@ namespace certi {
    } /* end of NM_Factory::create */
 
    NetworkMessage* NM_Factory::receive(NMStreamType stream) throw (NetworkError ,NetworkSignal) { 
-      // FIXME This is not thread safe
+      // FIXME This is not thread safe, concurrent callers
+      // have to give their own buffer
       static libhla::MessageBuffer msgBuffer;
+      return receive(stream,msgBuffer);
+   } /* end of NM_Factory::receive */ 
+
+   NetworkMessage* NM_Factory::receive(NMStreamType stream, libhla::MessageBuffer& msgBuffer) throw (NetworkError ,NetworkSignal) { 
       NetworkMessage  msgGen;
       NetworkMessage* msg;
 
       // receive generic message 
       msgGen.receive(stream,msgBuffer);
       // create specific message from type 
-      msg = NM_Factory::create(msgGen.getMessageType());
+      msg = MessagePool::get(msgGen.getMessageType());
       msgBuffer.assumeSizeFromReservedBytes();
       msg->deserialize(msgBuffer);
       return msg;
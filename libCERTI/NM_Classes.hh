@@ -13,6 +13,8 @@
 #include "FedTimeD.hh"
 
 #include "certi.hh"
+
+#include "ValueArena.hh"
 // ----------------------------------------------------------------------------
 // CERTI - HLA RunTime Infrastructure
 // Copyright (C) 2002-2008  ONERA
@@ -293,6 +295,8 @@ namespace certi {
          void setBestEffortAddress(const uint32_t& newBestEffortAddress) {bestEffortAddress=newBestEffortAddress;}
          const uint32_t& getBestEffortPeer() const {return bestEffortPeer;}
          void setBestEffortPeer(const uint32_t& newBestEffortPeer) {bestEffortPeer=newBestEffortPeer;}
+         const uint32_t& getDataPeer() const {return dataPeer;}
+         void setDataPeer(const uint32_t& newDataPeer) {dataPeer=newDataPeer;}
          const std::string& getFederationName() const {return federationName;}
          void setFederationName(const std::string& newFederationName) {federationName=newFederationName;}
          const std::string& getFederateName() const {return federateName;}
@@ -325,6 +329,7 @@ namespace certi {
          uint32_t multicastAddress;
          uint32_t bestEffortAddress;
          uint32_t bestEffortPeer;
+         uint32_t dataPeer;// port of the direct links of the RTIA, 0 if none
          std::string federationName;// the federation name
          std::string federateName;// the federate name (should be unique within a federation)
          std::vector<NM_FOM_Routing_Space> routingSpaces;
@@ -887,11 +892,11 @@ namespace certi {
          void removeAttributes(uint32_t rank) {attributes.erase(attributes.begin() + rank);}
          uint32_t getValuesSize() const {return values.size();}
          void setValuesSize(uint32_t num) {values.resize(num);}
-         const std::vector<AttributeValue_t>& getValues() const {return values;}
-         const AttributeValue_t& getValues(uint32_t rank) const {return values[rank];}
-         AttributeValue_t& getValues(uint32_t rank) {return values[rank];}
-         void setValues(const AttributeValue_t& newValues, uint32_t rank) {values[rank]=newValues;}
-         void removeValues(uint32_t rank) {values.erase(values.begin() + rank);}
+         const ValueArena& getValues() const {return values;}
+         ValueArena& getValues() {return values;}
+         void setValues(const ValueArena& newValues) {values=newValues;}
+         void setValues(const AttributeValue_t& newValues, uint32_t rank) {values.set(rank, newValues);}
+         void removeValues(uint32_t rank) {values.erase(rank);}
          const EventRetractionHandle& getEvent() const {return event;}
          void setEvent(const EventRetractionHandle& newEvent) {
             _hasEvent=true;
@@ -903,7 +908,7 @@ namespace certi {
       protected:
          ObjectHandle object;
          std::vector<AttributeHandle> attributes;
-         std::vector<AttributeValue_t> values;
+         ValueArena values;
          EventRetractionHandle event;
          bool _hasEvent;
       private:
@@ -928,11 +933,11 @@ namespace certi {
          void removeAttributes(uint32_t rank) {attributes.erase(attributes.begin() + rank);}
          uint32_t getValuesSize() const {return values.size();}
          void setValuesSize(uint32_t num) {values.resize(num);}
-         const std::vector<AttributeValue_t>& getValues() const {return values;}
-         const AttributeValue_t& getValues(uint32_t rank) const {return values[rank];}
-         AttributeValue_t& getValues(uint32_t rank) {return values[rank];}
-         void setValues(const AttributeValue_t& newValues, uint32_t rank) {values[rank]=newValues;}
-         void removeValues(uint32_t rank) {values.erase(values.begin() + rank);}
+         const ValueArena& getValues() const {return values;}
+         ValueArena& getValues() {return values;}
+         void setValues(const ValueArena& newValues) {values=newValues;}
+         void setValues(const AttributeValue_t& newValues, uint32_t rank) {values.set(rank, newValues);}
+         void removeValues(uint32_t rank) {values.erase(rank);}
          const EventRetractionHandle& getEvent() const {return event;}
          void setEvent(const EventRetractionHandle& newEvent) {
             _hasEvent=true;
@@ -944,7 +949,7 @@ namespace certi {
       protected:
          ObjectHandle object;
          std::vector<AttributeHandle> attributes;
-         std::vector<AttributeValue_t> values;
+         ValueArena values;
          EventRetractionHandle event;
          bool _hasEvent;
       private:
@@ -969,11 +974,11 @@ namespace certi {
          void removeParameters(uint32_t rank) {parameters.erase(parameters.begin() + rank);}
          uint32_t getValuesSize() const {return values.size();}
          void setValuesSize(uint32_t num) {values.resize(num);}
-         const std::vector<ParameterValue_t>& getValues() const {return values;}
-         const ParameterValue_t& getValues(uint32_t rank) const {return values[rank];}
-         ParameterValue_t& getValues(uint32_t rank) {return values[rank];}
-         void setValues(const ParameterValue_t& newValues, uint32_t rank) {values[rank]=newValues;}
-         void removeValues(uint32_t rank) {values.erase(values.begin() + rank);}
+         const ValueArena& getValues() const {return values;}
+         ValueArena& getValues() {return values;}
+         void setValues(const ValueArena& newValues) {values=newValues;}
+         void setValues(const ParameterValue_t& newValues, uint32_t rank) {values.set(rank, newValues);}
+         void removeValues(uint32_t rank) {values.erase(rank);}
          const RegionHandle& getRegion() const {return region;}
          void setRegion(const RegionHandle& newRegion) {region=newRegion;}
          // the show method
@@ -981,7 +986,7 @@ namespace certi {
       protected:
          InteractionClassHandle interactionClass;
          std::vector<ParameterHandle> parameters;
-         std::vector<ParameterValue_t> values;
+         ValueArena values;
          RegionHandle region;// FIXME check this....
       private:
    };
@@ -1005,11 +1010,11 @@ namespace certi {
          void removeParameters(uint32_t rank) {parameters.erase(parameters.begin() + rank);}
          uint32_t getValuesSize() const {return values.size();}
          void setValuesSize(uint32_t num) {values.resize(num);}
-         const std::vector<ParameterValue_t>& getValues() const {return values;}
-         const ParameterValue_t& getValues(uint32_t rank) const {return values[rank];}
-         ParameterValue_t& getValues(uint32_t rank) {return values[rank];}
-         void setValues(const ParameterValue_t& newValues, uint32_t rank) {values[rank]=newValues;}
-         void removeValues(uint32_t rank) {values.erase(values.begin() + rank);}
+         const ValueArena& getValues() const {return values;}
+         ValueArena& getValues() {return values;}
+         void setValues(const ValueArena& newValues) {values=newValues;}
+         void setValues(const ParameterValue_t& newValues, uint32_t rank) {values.set(rank, newValues);}
+         void removeValues(uint32_t rank) {values.erase(rank);}
          const EventRetractionHandle& getEvent() const {return event;}
          void setEvent(const EventRetractionHandle& newEvent) {
             _hasEvent=true;
@@ -1021,7 +1026,7 @@ namespace certi {
       protected:
          InteractionClassHandle interactionClass;
          std::vector<ParameterHandle> parameters;
-         std::vector<ParameterValue_t> values;
+         ValueArena values;
          EventRetractionHandle event;
          bool _hasEvent;
       private:
@@ -1822,6 +1827,106 @@ namespace certi {
       private:
    };
 
+   // Address of the direct links of a federate (port 0: no direct link)
+   class CERTI_EXPORT NM_Data_Peer : public NetworkMessage {
+      public:
+         typedef NetworkMessage Super;
+         NM_Data_Peer();
+         virtual ~NM_Data_Peer();
+         virtual void serialize(libhla::MessageBuffer& msgBuffer);
+         virtual void deserialize(libhla::MessageBuffer& msgBuffer);
+         // specific Getter(s)/Setter(s)
+         const uint32_t& getAddress() const {return address;}
+         void setAddress(const uint32_t& newAddress) {address=newAddress;}
+         const uint32_t& getPort() const {return port;}
+         void setPort(const uint32_t& newPort) {port=newPort;}
+         // the show method
+         virtual std::ostream& show(std::ostream& out);
+      protected:
+         uint32_t address;
+         uint32_t port;
+      private:
+   };
+   // Subscribers of the attributes of an object class, for the direct links.
+   // The federates of attributes[i] follow those of the previous attributes,
+   // routeSizes[i] of them.
+   class CERTI_EXPORT NM_Object_Class_Routes : public NetworkMessage {
+      public:
+         typedef NetworkMessage Super;
+         NM_Object_Class_Routes();
+         virtual ~NM_Object_Class_Routes();
+         virtual void serialize(libhla::MessageBuffer& msgBuffer);
+         virtual void deserialize(libhla::MessageBuffer& msgBuffer);
+         // specific Getter(s)/Setter(s)
+         const ObjectClassHandle& getObjectClass() const {return objectClass;}
+         void setObjectClass(const ObjectClassHandle& newObjectClass) {objectClass=newObjectClass;}
+         uint32_t getAttributesSize() const {return attributes.size();}
+         void setAttributesSize(uint32_t num) {attributes.resize(num);}
+         const std::vector<AttributeHandle>& getAttributes() const {return attributes;}
+         const AttributeHandle& getAttributes(uint32_t rank) const {return attributes[rank];}
+         AttributeHandle& getAttributes(uint32_t rank) {return attributes[rank];}
+         void setAttributes(const AttributeHandle& newAttributes, uint32_t rank) {attributes[rank]=newAttributes;}
+         void removeAttributes(uint32_t rank) {attributes.erase(attributes.begin() + rank);}
+         uint32_t getRouteSizesSize() const {return routeSizes.size();}
+         void setRouteSizesSize(uint32_t num) {routeSizes.resize(num);}
+         const std::vector<uint32_t>& getRouteSizes() const {return routeSizes;}
+         const uint32_t& getRouteSizes(uint32_t rank) const {return routeSizes[rank];}
+         uint32_t& getRouteSizes(uint32_t rank) {return routeSizes[rank];}
+         void setRouteSizes(const uint32_t& newRouteSizes, uint32_t rank) {routeSizes[rank]=newRouteSizes;}
+         void removeRouteSizes(uint32_t rank) {routeSizes.erase(routeSizes.begin() + rank);}
+         uint32_t getFederatesSize() const {return federates.size();}
+         void setFederatesSize(uint32_t num) {federates.resize(num);}
+         const std::vector<FederateHandle>& getFederates() const {return federates;}
+         const FederateHandle& getFederates(uint32_t rank) const {return federates[rank];}
+         FederateHandle& getFederates(uint32_t rank) {return federates[rank];}
+         void setFederates(const FederateHandle& newFederates, uint32_t rank) {federates[rank]=newFederates;}
+         void removeFederates(uint32_t rank) {federates.erase(federates.begin() + rank);}
+         uint32_t getRegionalAttributesSize() const {return regionalAttributes.size();}
+         void setRegionalAttributesSize(uint32_t num) {regionalAttributes.resize(num);}
+         const std::vector<AttributeHandle>& getRegionalAttributes() const {return regionalAttributes;}
+         const AttributeHandle& getRegionalAttributes(uint32_t rank) const {return regionalAttributes[rank];}
+         AttributeHandle& getRegionalAttributes(uint32_t rank) {return regionalAttributes[rank];}
+         void setRegionalAttributes(const AttributeHandle& newRegionalAttributes, uint32_t rank) {regionalAttributes[rank]=newRegionalAttributes;}
+         void removeRegionalAttributes(uint32_t rank) {regionalAttributes.erase(regionalAttributes.begin() + rank);}
+         // the show method
+         virtual std::ostream& show(std::ostream& out);
+      protected:
+         ObjectClassHandle objectClass;
+         std::vector<AttributeHandle> attributes;
+         std::vector<uint32_t> routeSizes;
+         std::vector<FederateHandle> federates;
+         std::vector<AttributeHandle> regionalAttributes;// with subscriptions to regions
+      private:
+   };
+   // Subscribers of an interaction class, for the direct links.
+   class CERTI_EXPORT NM_Interaction_Class_Routes : public NetworkMessage {
+      public:
+         typedef NetworkMessage Super;
+         NM_Interaction_Class_Routes();
+         virtual ~NM_Interaction_Class_Routes();
+         virtual void serialize(libhla::MessageBuffer& msgBuffer);
+         virtual void deserialize(libhla::MessageBuffer& msgBuffer);
+         // specific Getter(s)/Setter(s)
+         const InteractionClassHandle& getInteractionClass() const {return interactionClass;}
+         void setInteractionClass(const InteractionClassHandle& newInteractionClass) {interactionClass=newInteractionClass;}
+         uint32_t getFederatesSize() const {return federates.size();}
+         void setFederatesSize(uint32_t num) {federates.resize(num);}
+         const std::vector<FederateHandle>& getFederates() const {return federates;}
+         const FederateHandle& getFederates(uint32_t rank) const {return federates[rank];}
+         FederateHandle& getFederates(uint32_t rank) {return federates[rank];}
+         void setFederates(const FederateHandle& newFederates, uint32_t rank) {federates[rank]=newFederates;}
+         void removeFederates(uint32_t rank) {federates.erase(federates.begin() + rank);}
+         const bool& getRegional() const {return regional;}
+         void setRegional(const bool& newRegional) {regional=newRegional;}
+         // the show method
+         virtual std::ostream& show(std::ostream& out);
+      protected:
+         InteractionClassHandle interactionClass;
+         std::vector<FederateHandle> federates;
+         bool regional;// with subscriptions to regions
+      private:
+   };
+
    class CERTI_EXPORT New_NetworkMessage {
       public:
          New_NetworkMessage();
@@ -1866,6 +1971,7 @@ namespace certi {
       public:
          static NetworkMessage* create(NM_Type type) throw (NetworkError ,NetworkSignal); 
          static NetworkMessage* receive(NMStreamType stream) throw (NetworkError ,NetworkSignal); 
+         static NetworkMessage* receive(NMStreamType stream, libhla::MessageBuffer& msgBuffer) throw (NetworkError ,NetworkSignal); 
       protected:
       private:
    };
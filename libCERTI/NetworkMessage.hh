@@ -149,6 +149,9 @@ public:
 				RESERVE_OBJECT_INSTANCE_NAME_SUCCEEDED, // HLA1516, only RTIG->RTIA
 				RESERVE_OBJECT_INSTANCE_NAME_FAILED, // HLA1516, only RTIG->RTIA
 				MESSAGE_NULL_PRIME, // CERTI specific for handling NER or NERA and zero-lk
+				DATA_PEER, // only RTIG->RTIA
+				OBJECT_CLASS_ROUTES, // only RTIG->RTIA
+				INTERACTION_CLASS_ROUTES, // only RTIG->RTIA
 				LAST
 	} Message_T;	
 
@@ -187,6 +190,13 @@ public:
 	 */
 	virtual void deserialize(MessageBuffer& msgBuffer);
 
+	/**
+	 * Serialize the message in a reset buffer and update its header
+	 * so that the buffer content may be written as is on any socket.
+	 * @param[out] msgBuffer the buffer holding the encoded message
+	 */
+	void encode(MessageBuffer& msgBuffer);
+
 	/**
 	 * Send a message buffer to the socket
 	 */
@@ -20,6 +20,7 @@
 
 #include "NetworkMessage.hh"
 #include "PrettyDebug.hh"
+#include "EventTrace.hh"
 
 using std::vector;
 using std::endl;
@@ -65,6 +66,8 @@ void NetworkMessage::deserialize(MessageBuffer& msgBuffer) {
 	exception   = static_cast<TypeException>(msgBuffer.read_int32());
 	if (exception != e_NO_EXCEPTION) {
 			msgBuffer.read_string(exceptionReason);
+			// no stale option of a recycled message
+			_isDated = _isLabelled = _isTagged = false;
 	} else {
 			BasicMessage::deserialize(msgBuffer);
 	}
@@ -72,8 +75,7 @@ void NetworkMessage::deserialize(MessageBuffer& msgBuffer) {
 } /* end of deserialize */
 
 void
-NetworkMessage::send(Socket *socket, MessageBuffer& msgBuffer) throw (NetworkError, NetworkSignal){
-	G.Out(pdGendoc,"enter NetworkMessage::send");
+NetworkMessage::encode(MessageBuffer& msgBuffer) {
 	/* 0- reset send buffer */
 	msgBuffer.reset();
 	/* 1- serialize the message
@@ -83,11 +85,20 @@ NetworkMessage::send(Socket *socket, MessageBuffer& msgBuffer) throw (NetworkErr
 	serialize(msgBuffer);
 	/* 2- update message buffer 'reserved bytes' header */
 	msgBuffer.updateReservedBytes();
+} /* end of encode */
+
+void
+NetworkMessage::send(Socket *socket, MessageBuffer& msgBuffer) throw (NetworkError, NetworkSignal){
+	G.Out(pdGendoc,"enter NetworkMessage::send");
+	encode(msgBuffer);
 	D.Out(pdDebug,"Sending <%s> whose buffer has <%u> bytes",getMessageName(),msgBuffer.size());
 	//msgBuffer.show(msgBuf(0),5);
 	/* 3- effectively send the raw message to socket */
 
 	if (NULL != socket) { // send only if socket is unequal to null
+		if (EventTrace::isEnabled())
+			EventTrace::record(TRACE_NETWORK_SEND, type, federation, federate,
+			                   socket->returnSocket(), msgBuffer.size());
 		socket->send(static_cast<unsigned char*>(msgBuffer(0)), msgBuffer.size());
 	} else { // socket pointer was null - not sending
 		D.Out( pdDebug, "Not sending -- socket is deleted." );
@@ -25,6 +25,7 @@
 
 #include "Object.hh"
 #include "ObjectAttribute.hh"
+#include "OwnershipIndex.hh"
 #include "RTIRegion.hh"
 
 #include <sstream>
@@ -38,7 +39,7 @@ namespace certi {
 // ----------------------------------------------------------------------------
 //! Constructor.
 Object::Object(FederateHandle the_owner)
-    : Owner(the_owner)
+    : Owner(the_owner), ownership(NULL)
 {
 }
 
@@ -51,6 +52,8 @@ Object::~Object()
     for (i = _attributeMap.begin(); i != _attributeMap.end(); ++i) {
     	delete i->second;
     }
+    if (ownership != NULL)
+        ownership->removeObject(Owner, handle);
 }
 
 // ----------------------------------------------------------------------------
@@ -74,6 +77,8 @@ Object::addAttribute(ObjectAttribute * new_attribute)
     if (_attributeMap.find(attributeHandle) != _attributeMap.end())
         throw RTIinternalError("Attribute already defined");
     _attributeMap[attributeHandle] = new_attribute;
+    if (ownership != NULL)
+        new_attribute->setOwnershipIndex(ownership);
 }
 
 // ----------------------------------------------------------------------------
@@ -101,9 +106,25 @@ Object::setClass(ObjectClassHandle h)
 void
 Object::setOwner(FederateHandle the_federate)
 {
+    if (ownership != NULL) {
+        ownership->removeObject(Owner, handle);
+        ownership->addObject(the_federate, handle);
+    }
     Owner = the_federate ;
 }
 
+// ----------------------------------------------------------------------------
+void
+Object::setOwnershipIndex(OwnershipIndex *index)
+{
+    ownership = index ;
+    ownership->addObject(Owner, handle);
+    AttributeMap::const_iterator i;
+    for (i = _attributeMap.begin(); i != _attributeMap.end(); ++i) {
+        i->second->setOwnershipIndex(ownership);
+    }
+}
+
 // ----------------------------------------------------------------------------
 //! Verify that the attribute owner is federate.
 bool
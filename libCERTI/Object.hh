@@ -28,6 +28,7 @@
 // forward declaration
 namespace certi {
 	class ObjectAttribute;
+	class OwnershipIndex;
 	class RTIRegion;
 }
 
@@ -43,6 +44,8 @@ namespace certi {
 class CERTI_EXPORT Object : public Named, public Handled<ObjectHandle>
 {
 public:
+    typedef std::map<AttributeHandle,ObjectAttribute*> AttributeMap;
+
     Object(FederateHandle the_owner);
     virtual ~Object();
 
@@ -51,6 +54,7 @@ public:
     void addAttribute(ObjectAttribute * new_attribute);
     ObjectAttribute *getAttribute(AttributeHandle the_attribute) const
         throw (AttributeNotDefined);
+    const AttributeMap &getAttributes() const { return _attributeMap ; }
 
     bool isAttributeOwnedByFederate(FederateHandle, AttributeHandle) const
         throw (AttributeNotDefined, RTIinternalError);
@@ -61,6 +65,12 @@ public:
     FederateHandle getOwner() const { return Owner; }
     void setOwner(FederateHandle);
 
+    /**
+     * Record the owner of the object and of its attributes, present and
+     * added later, in the given index, until the object is deleted.
+     */
+    void setOwnershipIndex(OwnershipIndex *index);
+
     void unassociate(RTIRegion *);
     
     void killFederate(FederateHandle);
@@ -71,7 +81,8 @@ private:
     */
     FederateHandle Owner ;
 
-    typedef std::map<AttributeHandle,ObjectAttribute*> AttributeMap;
+    OwnershipIndex *ownership ; //!< NULL if the owners are not indexed
+
     //! Attribute list from object class instance.
     AttributeMap _attributeMap;
 
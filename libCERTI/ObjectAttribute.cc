@@ -24,6 +24,8 @@
 
 
 #include "ObjectAttribute.hh"
+#include "ObjectClassAttribute.hh"
+#include "OwnershipIndex.hh"
 #include "RTIRegion.hh"
 #include "PrettyDebug.hh"
 
@@ -42,14 +44,17 @@ ObjectAttribute::ObjectAttribute(AttributeHandle new_handle,
                                  FederateHandle new_owner,
                                  ObjectClassAttribute *associated_attribute)
     : handle(new_handle), owner(new_owner), divesting(false), space(0),
-      source(associated_attribute), region(0)
+      transport(associated_attribute != NULL ? associated_attribute->transport : RELIABLE),
+      source(associated_attribute), region(0), ownership(NULL)
 {
 }
 
 // ----------------------------------------------------------------------------
-//! Destructor (nothing to do).
+//! Destructor.
 ObjectAttribute::~ObjectAttribute()
 {
+    if (ownership != NULL)
+        ownership->removeAttribute(owner, this);
 }
 
 // ----------------------------------------------------------------------------
@@ -74,9 +79,21 @@ ObjectAttribute::getOwner() const
 void
 ObjectAttribute::setOwner(FederateHandle newOwner)
 {
+    if (ownership != NULL) {
+        ownership->removeAttribute(owner, this);
+        ownership->addAttribute(newOwner, this);
+    }
     owner = newOwner ;
 }
 
+// ----------------------------------------------------------------------------
+void
+ObjectAttribute::setOwnershipIndex(OwnershipIndex *index)
+{
+    ownership = index ;
+    ownership->addAttribute(owner, this);
+}
+
 // ----------------------------------------------------------------------------
 //! Returns attribute divesting state.
 bool
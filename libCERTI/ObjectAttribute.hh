@@ -34,13 +34,16 @@ namespace certi {
 class RTIRegion ;
 
 class ObjectClassAttribute ;
+class OwnershipIndex ;
 
 //! Object attribute information.
 /*! This class maintains information about an attribute:
   - handle,
   - ownerCandidates,
   - current owner,
-  - divesting state.
+  - divesting state,
+  - transportation type, the one of the class attribute until changed
+    for this instance.
 */
 class CERTI_EXPORT ObjectAttribute {
 
@@ -56,6 +59,9 @@ public:
     FederateHandle getOwner() const ;
     void setOwner(FederateHandle NewOwner);
 
+    /** Record the owner in the given index, until the attribute is deleted. */
+    void setOwnershipIndex(OwnershipIndex *index);
+
     void setDivesting(bool divesting_state);
     bool beingDivested() const ;
 
@@ -64,6 +70,7 @@ public:
     void removeCandidate(FederateHandle candidate);
     FederateHandle getFirstCandidate() const throw (RTIinternalError);
     bool hasCandidates() const ;
+    const std::set<FederateHandle> &getCandidates() const { return ownerCandidates ; }
 
     AttributeHandle getHandle() const ;
     void setHandle(AttributeHandle h);
@@ -71,6 +78,9 @@ public:
     SpaceHandle getSpace() const ;
     void setSpace(SpaceHandle);
 
+    TransportType getTransport() const { return transport ; }
+    void setTransport(TransportType type) { transport = type ; }
+
     ObjectClassAttribute *getObjectClassAttribute() const { return source ; };
 
     void associate(RTIRegion *);
@@ -87,8 +97,10 @@ private:
     bool divesting ; //!< Divesting state.
     std::set<FederateHandle> ownerCandidates ; //!< Federates candidate.
     SpaceHandle space ; //!< Associated routing space
+    TransportType transport ; //!< Transportation of the updates.
     ObjectClassAttribute *source ; //!< The associated class attribute.
     RTIRegion *region ;
+    OwnershipIndex *ownership ; //!< NULL if the owner is not indexed
 };
 
 }
@@ -32,9 +32,13 @@
 #include "SocketTCP.hh"
 #include "PrettyDebug.hh"
 #include "helper.hh"
+#include "RTIRegion.hh"
+#include "RoutingSpace.hh"
 #include <sstream>
 #include <memory>
+#include <set>
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <cassert>
 
@@ -46,6 +50,24 @@ namespace certi {
 static PrettyDebug D("OBJECTCLASS", __FILE__);
 static PrettyDebug G("GENDOC",__FILE__);
 
+namespace {
+
+/** Order of the regional subscriptions of a route. */
+struct RegionOrder {
+    bool operator()(const Subscriber &a, const Subscriber &b) const {
+        return less(a.getRegion(), b.getRegion());
+    }
+    bool operator()(const Subscriber &a, const BaseRegion *b) const {
+        return less(a.getRegion(), b);
+    }
+    bool operator()(const BaseRegion *a, const Subscriber &b) const {
+        return less(a, b.getRegion());
+    }
+    std::less<const BaseRegion *> less ;
+};
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 //! To be used only by CRead, it returns the new Attribute's Handle.
 AttributeHandle
@@ -178,6 +200,184 @@ ObjectClass::broadcastClassMessage(ObjectClassBroadcastList *ocbList,
     G.Out(pdGendoc,"exit  ObjectClass::broadcastClassMessage");
 }
 
+// ----------------------------------------------------------------------------
+/*! Broadcast a ReflectAttributeValues message: each subscriber found in the
+  route of an updated attribute is added to the list if its region overlaps
+  the update region of the attribute. Routes already hold the superclass
+  subscribers, so the message is sent once for the whole hierarchy.
+
+  The regions overlapping an update region are taken from the index of its
+  routing space, once for all the attributes associated with it, and then
+  looked up in the regional subscriptions of each route.
+*/
+void
+ObjectClass::routeUpdate(ObjectClassBroadcastList *ocbList,
+                         const Object *object)
+{
+    if (!routesValid)
+        buildRoutes();
+
+    RegionIndex::RegionList overlapping ;
+    const RTIRegion *indexed = NULL ;
+
+    NM_Reflect_Attribute_Values *msg = ocbList->getMsgRAV();
+    for (uint32_t i = 0 ; i < msg->getAttributesSize() ; ++i) {
+        AttributeHandle attributeHandle = msg->getAttributes(i);
+
+        RoutingTable::const_iterator r = routes.find(attributeHandle);
+        if (r == routes.end())
+            continue ;
+
+        const RTIRegion *update_region = object->getAttribute(attributeHandle)->getRegion();
+        Debug(D, pdTrace) << "RAV: attr " << attributeHandle
+                          << " / region " << (update_region ? update_region->getHandle() : 0)
+                          << " / " << r->second.everywhere.size() << "+"
+                          << r->second.regional.size() << " subscriptions" << std::endl ;
+
+        const Route &route = r->second ;
+        std::vector<FederateHandle>::const_iterator f ;
+        for (f = route.everywhere.begin(); f != route.everywhere.end(); ++f)
+            ocbList->addFederate(*f, attributeHandle);
+
+        std::vector<Subscriber>::const_iterator s ;
+        if (update_region == NULL) {
+            for (s = route.regional.begin(); s != route.regional.end(); ++s)
+                ocbList->addFederate(s->getHandle(), attributeHandle);
+            continue ;
+        }
+        if (route.regional.empty())
+            continue ;
+
+        if (update_region != indexed) {
+            update_region->getRoutingSpace().getRegionIndex().overlapping(*update_region, overlapping);
+            indexed = update_region ;
+        }
+        if (overlapping.size() < route.regional.size()) {
+            RegionIndex::RegionList::const_iterator o ;
+            for (o = overlapping.begin(); o != overlapping.end(); ++o) {
+                std::pair<std::vector<Subscriber>::const_iterator,
+                          std::vector<Subscriber>::const_iterator> range =
+                    std::equal_range(route.regional.begin(), route.regional.end(), *o, RegionOrder());
+                for (s = range.first ; s != range.second ; ++s)
+                    ocbList->addFederate(s->getHandle(), attributeHandle);
+            }
+        }
+        else {
+            for (s = route.regional.begin(); s != route.regional.end(); ++s) {
+                if (std::binary_search(overlapping.begin(), overlapping.end(),
+                                       static_cast<const BaseRegion *>(s->getRegion())))
+                    ocbList->addFederate(s->getHandle(), attributeHandle);
+            }
+        }
+    }
+
+    ocbList->sendPendingMessage(server);
+}
+
+// ----------------------------------------------------------------------------
+/*! Gather, for each attribute, the subscriptions made in this class and in
+  the superclasses defining it. A federate subscribed with the default region
+  somewhere gets a single default region entry, since it receives every
+  update anyway.
+*/
+void
+ObjectClass::buildRoutes()
+{
+    routes.clear();
+
+    std::vector<const std::list<Subscriber> *> levels ;
+    std::set<FederateHandle> everywhere ;
+    std::set<std::pair<FederateHandle, const RTIRegion *> > seen ;
+
+    for (HandleClassAttributeMap::const_iterator a = _handleClassAttributeMap.begin();
+         a != _handleClassAttributeMap.end(); ++a) {
+        levels.clear();
+        everywhere.clear();
+        seen.clear();
+
+        // Attributes are inherited: once a superclass does not define the
+        // attribute, none of its own superclasses does.
+        for (ObjectClass *c = this ; c != NULL ; c = c->parentClass) {
+            HandleClassAttributeMap::const_iterator ca = c->_handleClassAttributeMap.find(a->first);
+            if (ca == c->_handleClassAttributeMap.end())
+                break ;
+            levels.push_back(&ca->second->getSubscribers());
+
+            std::list<Subscriber>::const_iterator s ;
+            for (s = levels.back()->begin(); s != levels.back()->end(); ++s) {
+                if (s->getRegion() == NULL)
+                    everywhere.insert(s->getHandle());
+            }
+        }
+
+        Route route ;
+        for (unsigned int l = 0 ; l < levels.size() ; ++l) {
+            std::list<Subscriber>::const_iterator s ;
+            for (s = levels[l]->begin(); s != levels[l]->end(); ++s) {
+                if (s->getRegion() != NULL && everywhere.count(s->getHandle()))
+                    continue ;
+                if (!seen.insert(std::make_pair(s->getHandle(), s->getRegion())).second)
+                    continue ;
+                if (s->getRegion() == NULL)
+                    route.everywhere.push_back(s->getHandle());
+                else
+                    route.regional.push_back(*s);
+            }
+        }
+        if (!route.everywhere.empty() || !route.regional.empty()) {
+            std::stable_sort(route.regional.begin(), route.regional.end(), RegionOrder());
+            Route &entry = routes[a->first] ;
+            entry.everywhere.swap(route.everywhere);
+            entry.regional.swap(route.regional);
+        }
+    }
+
+    routesValid = true ;
+    Debug(D, pdDebug) << "ObjectClass " << handle << ": routes built for "
+                      << routes.size() << " subscribed attributes" << std::endl ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectClass::getRoutes(NM_Object_Class_Routes &msg)
+{
+    if (!routesValid)
+        buildRoutes();
+
+    msg.setObjectClass(handle);
+    msg.setAttributesSize(routes.size());
+    msg.setRouteSizesSize(routes.size());
+    msg.setFederatesSize(0);
+    msg.setRegionalAttributesSize(0);
+
+    uint32_t rank = 0 ;
+    for (RoutingTable::const_iterator r = routes.begin(); r != routes.end(); ++r, ++rank) {
+        const std::vector<FederateHandle> &everywhere = r->second.everywhere ;
+        uint32_t first = msg.getFederatesSize();
+        msg.setAttributes(r->first, rank);
+        msg.setRouteSizes(everywhere.size(), rank);
+        msg.setFederatesSize(first + everywhere.size());
+        for (uint32_t i = 0 ; i < everywhere.size(); ++i)
+            msg.setFederates(everywhere[i], first + i);
+        if (!r->second.regional.empty()) {
+            msg.setRegionalAttributesSize(msg.getRegionalAttributesSize() + 1);
+            msg.setRegionalAttributes(r->first, msg.getRegionalAttributesSize() - 1);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectClass::invalidateRoutes()
+{
+    routesValid = false ;
+    routes.clear();
+
+    for (ObjectClassSet::const_iterator i = subClasses->begin(); i != subClasses->end(); ++i) {
+        i->second->invalidateRoutes();
+    }
+}
+
 // ----------------------------------------------------------------------------
 //! sendToFederate.
 void
@@ -186,11 +386,7 @@ ObjectClass::sendToFederate(NetworkMessage *msg, FederateHandle theFederate)
     // Send the message 'msg' to the Federate which Handle is theFederate.
     Socket *socket = NULL ;
     try {
-#ifdef HLA_USES_UDP
-        socket = server->getSocketLink(theFederate, BEST_EFFORT);
-#else
         socket = server->getSocketLink(theFederate);
-#endif
         msg->send(socket,NM_msgBufSend);
     }
     catch (RTIinternalError &e) {
@@ -268,7 +464,7 @@ ObjectClass::checkFederateAccess(FederateHandle the_federate,
 // ----------------------------------------------------------------------------
 ObjectClass::ObjectClass(const std::string& name, ObjectClassHandle handle)
     : Named(name), server(NULL), handle(handle), maxSubscriberHandle(0), securityLevelId(PublicLevelID),
-      superClass(0), subClasses(NULL)
+      superClass(0), parentClass(NULL), subClasses(NULL), routesValid(false)
 {
 	subClasses = new ObjectClassSet(NULL);
 }
@@ -547,7 +743,7 @@ ObjectClass::isInstanceInClass(ObjectHandle objectHandle)
 
 // ----------------------------------------------------------------------------
 //! killFederate.
-ObjectClassBroadcastList *
+void
 ObjectClass::killFederate(FederateHandle the_federate)
     throw ()
 {
@@ -568,24 +764,8 @@ ObjectClass::killFederate(FederateHandle the_federate)
     }
     catch (SecurityError &e) {}
 
-    // Does federate owns instances ?
-    for (HandleObjectMap::const_iterator i = _handleObjectMap.begin(); i != _handleObjectMap.end(); ++i) {
-        if (i->second->getOwner() == the_federate) {
-            // Return non-NULL to indicate that :
-            // 1- A RemoveObject message should be broadcasted through parent
-            // class
-            // 2- The federate may own another instance, and this function
-            // must be called again.
-            // BUG: String \/
-            return deleteInstance(the_federate, i->second, "Killed");
-        }
-    }
-
     D.Out(pdRegister, "Object Class %d:Federate %d killed.",
           handle, the_federate);
-
-    // Return NULL if the Federate did not own any instance.
-    return NULL ;
 }
 
 // ----------------------------------------------------------------------------
@@ -663,26 +843,7 @@ ObjectClass::registerObjectInstance(FederateHandle the_federate,
         throw ObjectClassNotPublished("");
     }
 
-    // Ownership management :
-    // Copy instance attributes
-    // Federate only owns attributes it publishes.
-    for (HandleClassAttributeMap::iterator i = _handleClassAttributeMap.begin(); i != _handleClassAttributeMap.end(); ++i) {
-        ObjectAttribute * oa ;
-	oa = new ObjectAttribute(i->second->getHandle(),
-				 i->second->isPublishing(the_federate) ? the_federate : 0,
-				 i->second);
-
-        // privilegeToDelete is owned by federate even not published.
-        if (i->second->isNamed("HLAprivilegeToDeleteObject")) {
-            oa->setOwner(the_federate);
-        }
-
-        the_object->addAttribute(oa);
-    }
-
-    _handleObjectMap[the_object->getHandle()] = the_object;
-    Debug(D, pdTrace) << "Added object " << the_object->getHandle() << "/"
-	       << _handleObjectMap.size() << " to class " << handle << std::endl ;
+    addInstance(the_federate, the_object);
 
     // Prepare and Broadcast message for this class
     ObjectClassBroadcastList *ocbList = NULL ;
@@ -715,6 +876,32 @@ ObjectClass::registerObjectInstance(FederateHandle the_federate,
     return ocbList ;
 }
 
+// ----------------------------------------------------------------------------
+void
+ObjectClass::addInstance(FederateHandle the_federate, Object *the_object)
+{
+    // Ownership management :
+    // Copy instance attributes
+    // Federate only owns attributes it publishes.
+    for (HandleClassAttributeMap::iterator i = _handleClassAttributeMap.begin(); i != _handleClassAttributeMap.end(); ++i) {
+        ObjectAttribute * oa ;
+	oa = new ObjectAttribute(i->second->getHandle(),
+				 i->second->isPublishing(the_federate) ? the_federate : 0,
+				 i->second);
+
+        // privilegeToDelete is owned by federate even not published.
+        if (i->second->isNamed("HLAprivilegeToDeleteObject")) {
+            oa->setOwner(the_federate);
+        }
+
+        the_object->addAttribute(oa);
+    }
+
+    _handleObjectMap[the_object->getHandle()] = the_object;
+    Debug(D, pdTrace) << "Added object " << the_object->getHandle() << "/"
+	       << _handleObjectMap.size() << " to class " << handle << std::endl ;
+}
+
 // ----------------------------------------------------------------------------
 /** Send a "Discover Object" message to a federate for each object of
     this class, if the federate was not already subscribed. Subclass
@@ -816,6 +1003,7 @@ throw (AttributeNotDefined, RTIinternalError, SecurityError) {
          it != attributes.end(); ++it) {
         getAttribute(*it)->subscribe(fed, region);
     }
+    invalidateRoutes();
 
     return (attributes.size() > 0) && !was_subscriber ;
 } /* end of subscribe */
@@ -826,7 +1014,7 @@ ObjectClassBroadcastList *
 ObjectClass::updateAttributeValues(FederateHandle the_federate,
                                    Object *object,
                                    const std::vector <AttributeHandle> &the_attributes,
-                                   const std::vector <AttributeValue_t> &the_values,
+                                   const ValueArena &the_values,
                                    int the_size,
                                    FederationTime the_time,
                                    const std::string& the_tag)
@@ -855,20 +1043,21 @@ ObjectClass::updateAttributeValues(FederateHandle the_federate,
         answer->setDate(the_time);
         answer->setLabel(the_tag);
         answer->setAttributesSize(the_size) ;
+        // The values share the arena of the received message.
+        answer->setValues(the_values);
         answer->setValuesSize(the_size);
 
         for (int32_t i = 0 ; i < the_size ; i++) {
             answer->setAttributes(the_attributes[i],i);
-            answer->setValues(the_values[i],i) ;
         }
 
-        ocbList = new ObjectClassBroadcastList(answer, _handleClassAttributeMap.size());
+        ocbList = new ObjectClassBroadcastList(answer, _handleClassAttributeMap.size(), &linePool);
 
         D.Out(pdProtocol,
               "Object %u updated in class %u, now broadcasting...",
               object->getHandle(), handle);
 
-        broadcastClassMessage(ocbList, object);
+        routeUpdate(ocbList, object);
     }
     else {
         D.Out(pdExcept,
@@ -876,8 +1065,8 @@ ObjectClass::updateAttributeValues(FederateHandle the_federate,
         throw RTIinternalError("UpdateAttributeValues called on the RTIA.");
     }
 
-    // Return the BroadcastList in case it had to be passed to the parent
-    // class.
+    // The superclass subscribers have been reached as well, the list is
+    // only returned to be freed.
     return ocbList ;
 }
 
@@ -887,7 +1076,7 @@ ObjectClassBroadcastList *
 ObjectClass::updateAttributeValues(FederateHandle the_federate,
                                    Object *object,
                                    const std::vector <AttributeHandle> &the_attributes,
-                                   const std::vector <AttributeValue_t> &the_values,
+                                   const ValueArena &the_values,
                                    int the_size,
                                    const std::string& the_tag)
     throw (AttributeNotDefined,
@@ -917,20 +1106,24 @@ ObjectClass::updateAttributeValues(FederateHandle the_federate,
         answer->setLabel(the_tag);
 
         answer->setAttributesSize(the_size);
+        answer->setValues(the_values);
         answer->setValuesSize(the_size);
 
         for (int32_t i = 0 ; i < the_size ; i++) {
             answer->setAttributes(the_attributes[i],i);
-            answer->setValues(the_values[i],i);
         }
 
-        ocbList = new ObjectClassBroadcastList(answer, _handleClassAttributeMap.size());
+        ocbList = new ObjectClassBroadcastList(answer, _handleClassAttributeMap.size(), &linePool);
+        for (int32_t i = 0 ; i < the_size ; i++) {
+            if (object->getAttribute(the_attributes[i])->getTransport() == BEST_EFFORT)
+                ocbList->setBestEffort(i);
+        }
 
         D.Out(pdProtocol,
               "Object %u updated in class %u, now broadcasting...",
               object->getHandle(), handle);
 
-        broadcastClassMessage(ocbList, object);
+        routeUpdate(ocbList, object);
     }
     else {
         D.Out(pdExcept,
@@ -938,8 +1131,8 @@ ObjectClass::updateAttributeValues(FederateHandle the_federate,
         throw RTIinternalError("UpdateAttributeValues called on the RTIA.");
     }
 
-    // Return the BroadcastList in case it had to be passed to the parent
-    // class.
+    // The superclass subscribers have been reached as well, the list is
+    // only returned to be freed.
     return ocbList ;
 }
 
@@ -1613,6 +1806,7 @@ ObjectClass::unsubscribe(FederateHandle fed, const RTIRegion *region)
             i->second->unsubscribe(fed, region);
         }
     }
+    invalidateRoutes();
 }
 
 // ----------------------------------------------------------------------------
@@ -1626,6 +1820,7 @@ ObjectClass::unsubscribe(FederateHandle fed)
 	    i->second->unsubscribe(fed);
 	}
     }
+    invalidateRoutes();
 } /* end of unsubscribe */
 
 void
@@ -1636,6 +1831,7 @@ ObjectClass::addSubClass(ObjectClass *child) {
     subClasses->addClass(child,NULL);
     /* link child to parent */
     child->superClass = handle;
+    child->parentClass = this;
     /* forward inherited properties to child */
     /* Add Object Class Attribute */
     addInheritedClassAttributes(child);
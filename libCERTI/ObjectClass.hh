@@ -40,10 +40,13 @@ class    ObjectClassBroadcastList;
 #include "Named.hh"
 #include "GAV.hh"
 #include "NM_Classes.hh"
+#include "Subscribable.hh"
+#include "ObjectClassBroadcastList.hh"
 
 // Standard
 #include <map>
 #include <string>
+#include <vector>
 
 namespace certi {
 
@@ -210,7 +213,11 @@ public:
 	const std::string& getAttributeName(AttributeHandle theHandle) const
 	throw (AttributeNotDefined, RTIinternalError);
 
-	ObjectClassBroadcastList *killFederate(FederateHandle theFederate)
+	/**
+	 * Remove the publications and subscriptions of a federate. Its
+	 * instances are deleted by RootObject::killFederate.
+	 */
+	void killFederate(FederateHandle theFederate)
 	throw ();
 
 	ObjectClassAttribute *getAttribute(AttributeHandle the_handle) const
@@ -241,18 +248,27 @@ public:
 	throw (ObjectClassNotPublished, ObjectAlreadyRegistered,
 			RTIinternalError);
 
+	/**
+	 * Add an instance with the attributes of the class, those the
+	 * federate publishes being owned by it, without any message.
+	 */
+	void addInstance(FederateHandle theFederate, Object *object);
+
+	/** Forget every instance of the class, without any message. */
+	void clearInstances() { _handleObjectMap.clear(); }
+
 	void broadcastClassMessage(ObjectClassBroadcastList *ocb_list,
 			const Object * = NULL);
 
 	ObjectClassBroadcastList *
 	updateAttributeValues(FederateHandle, Object *, const std::vector <AttributeHandle> &,
-			const std::vector <AttributeValue_t> &, int, FederationTime, const std::string&)
+			const ValueArena &, int, FederationTime, const std::string&)
 			throw (AttributeNotDefined, AttributeNotOwned,
 					RTIinternalError, InvalidObjectHandle);
 
 	ObjectClassBroadcastList *
 	updateAttributeValues(FederateHandle, Object *, const std::vector <AttributeHandle> &,
-			const std::vector <AttributeValue_t> &, int, const std::string&)
+			const ValueArena &, int, const std::string&)
 			throw (AttributeNotDefined, AttributeNotOwned,
 					RTIinternalError, InvalidObjectHandle);
 
@@ -266,6 +282,14 @@ public:
 	const HandleClassAttributeMap& getHandleClassAttributeMap(void) const
         { return _handleClassAttributeMap; }
 
+	/**
+	 * Fill a routing table message with the routes of this class, those
+	 * the RTIAs using direct links route their updates with: the federates
+	 * subscribed with the default region to each attribute, and the
+	 * attributes also subscribed with regions.
+	 */
+	void getRoutes(NM_Object_Class_Routes &msg);
+
 	//! This Object help to find a TCPLink from a Federate Handle.
 	SecurityServer *server ;
 
@@ -309,6 +333,33 @@ private:
 	bool isFederatePublisher(FederateHandle the_federate) const ;
 	bool isSubscribed(FederateHandle) const ;
 
+	/**
+	 * The subscriptions an update of one attribute of this class is sent
+	 * to: those made to the attribute in this class and in each superclass
+	 * defining it, one entry per federate/region pair.
+	 */
+	struct Route {
+	    /** Federates subscribed with the default region. */
+	    std::vector<FederateHandle> everywhere ;
+	    /** Subscriptions with a region, sorted by region. */
+	    std::vector<Subscriber> regional ;
+	};
+	typedef std::map<AttributeHandle, Route> RoutingTable ;
+
+	/**
+	 * Add the subscribers of the updated attributes to the broadcast list
+	 * and send the reflections, for the whole class hierarchy at once.
+	 */
+	void routeUpdate(ObjectClassBroadcastList *ocb_list, const Object *object);
+
+	/**
+	 * Drop the routing table of this class and of its subclasses, whose
+	 * routes include the subscriptions made to this class.
+	 */
+	void invalidateRoutes();
+
+	void buildRoutes();
+
 	// The second parameter is the Class of whose behalf the message
 	// are sent. If SDM is called on the original class, the Federate
 	// may be a subscriber of the class without stopping the
@@ -350,11 +401,28 @@ private:
 	 */
 	ObjectClassHandle superClass;
 
+	/**
+	 * The super class, NULL if there is none.
+	 */
+	ObjectClass *parentClass;
+
 	/**
 	 * The set of object classes sub classes of this object class
 	 */
 	ObjectClassSet*   subClasses;
 
+	/**
+	 * Reflection routes by attribute handle, built on the first update
+	 * following a subscription change in this class or a superclass.
+	 */
+	RoutingTable routes;
+	bool routesValid;
+
+	/**
+	 * Broadcast lines reused from one update of this class to the next.
+	 */
+	ObjectBroadcastLinePool linePool;
+
 	/* The message buffer used to send Network messages */
 	libhla::MessageBuffer NM_msgBufSend;
 };
@@ -27,8 +27,9 @@
 #include "ObjectClassBroadcastList.hh"
 #include "PrettyDebug.hh"
 #include "NM_Classes.hh"
+#include "EventTrace.hh"
 
-using std::list ;
+#include <map>
 
 namespace certi {
 
@@ -36,108 +37,154 @@ static PrettyDebug D("BROADCAST", __FILE__);
 static PrettyDebug G("GENDOC",__FILE__);
 
 template <typename T>
-T* ObjectClassBroadcastList::createReducedMessage(T* msg, ObjectBroadcastLine *line) {
-
-	// Create the reduced message
-	// FIXME whould be better to msg->clone() if a clone method was generated
-	// FIXME or maybe copy constructor
-	// FIXME T *reducedMessage = new T(msg)
-	T *reducedMessage = new T();
-
-	// Copy static informations.
-	reducedMessage->setException(msg->getException());
-	reducedMessage->setFederation(msg->getFederation());
-	reducedMessage->setFederate(msg->getFederate());
-	reducedMessage->setObject(msg->getObject());
+void ObjectClassBroadcastList::copyHeader(T* msg, T& reducedMessage) {
+	reducedMessage.setException(msg->getException());
+	reducedMessage.setFederation(msg->getFederation());
+	reducedMessage.setFederate(msg->getFederate());
+	reducedMessage.setObject(msg->getObject());
 	if (msg->isDated()) {
-		reducedMessage->setDate(msg->getDate());
+		reducedMessage.setDate(msg->getDate());
 	}
 	if (msg->isTagged()) {
-		reducedMessage->setTag(msg->getTag());
+		reducedMessage.setTag(msg->getTag());
 	}
-
 	if (msg->isLabelled()) {
-		reducedMessage->setLabel(msg->getLabel());
+		reducedMessage.setLabel(msg->getLabel());
 	}
+}
 
-	// Copy attributes that are in the bsWaiting state in Line.
-	uint32_t currentSize ;
-	AttributeHandle currentAttrib ;
-
-	currentSize = 0;
-	reducedMessage->setAttributesSize(currentSize);
-
-	for (uint32_t i = 0 ; i < msg->getAttributesSize() ; ++i) {
-		currentAttrib = msg->getAttributes(i);
-		if (line->state[currentAttrib] == ObjectBroadcastLine::waiting) {
-			// Update number of attributes in ReducedMessage.
-			++currentSize; ;
-			reducedMessage->setAttributesSize(currentSize);
-			// Copy Attribute Handle.
-			reducedMessage->setAttributes(currentAttrib,currentSize-1);
-		}
+template <typename T>
+WireBuffer ObjectClassBroadcastList::encodeReducedMessage(T* msg, const std::vector<uint32_t> &ranks) {
+
+	// The reduced message only lives for its encoding.
+	T reducedMessage ;
+	copyHeader(msg, reducedMessage);
+
+	// Copy attributes whose rank in msg is given.
+	reducedMessage.setAttributesSize(ranks.size());
+	for (uint32_t i = 0 ; i < ranks.size() ; ++i) {
+		reducedMessage.setAttributes(msg->getAttributes(ranks[i]), i);
 	}
-	return reducedMessage;
+	return WireBuffer(reducedMessage);
 }
 
 template <typename T>
-T* ObjectClassBroadcastList::createReducedMessageWithValue(T* msg, ObjectBroadcastLine *line) {
-
-	// Create the reduced message
-	// FIXME whould be better to msg->clone() if a clone method was generated
-	// FIXME or maybe copy constructor
-	// FIXME T *reducedMessage = new T(msg)
-	T *reducedMessage = new T();
-
-	// Copy static informations.
-	reducedMessage->setException(msg->getException());
-	reducedMessage->setFederation(msg->getFederation());
-	reducedMessage->setFederate(msg->getFederate());
-	reducedMessage->setObject(msg->getObject());
-	if (msg->isDated()) {
-		reducedMessage->setDate(msg->getDate());
-	}
-	if (msg->isTagged()) {
-		reducedMessage->setTag(msg->getTag());
-	}
+WireBuffer ObjectClassBroadcastList::encodeReducedMessageWithValue(T* msg, const std::vector<uint32_t> &ranks) {
 
-	if (msg->isLabelled()) {
-		reducedMessage->setLabel(msg->getLabel());
-	}
+	// The reduced message only lives for its encoding: its values are
+	// slices of the arena of msg instead of copies.
+	T reducedMessage ;
+	copyHeader(msg, reducedMessage);
 
-	// Copy attributes that are in the bsWaiting state in Line.
-	uint32_t currentSize ;
-	AttributeHandle currentAttrib ;
-
-	currentSize = 0;
-	reducedMessage->setAttributesSize(currentSize);
-
-	for (uint32_t i = 0 ; i < msg->getAttributesSize() ; ++i) {
-		currentAttrib = msg->getAttributes(i);
-		if (line->state[currentAttrib] == ObjectBroadcastLine::waiting) {
-			// Update number of attributes in ReducedMessage.
-			++currentSize;
-			reducedMessage->setAttributesSize(currentSize);
-			// Copy Attribute Handle.
-			reducedMessage->setAttributes(currentAttrib,currentSize-1);
-
-			reducedMessage->setValuesSize(currentSize);
-			// Copy Attribute Value.
-			reducedMessage->setValues(msg->getValues(i),currentSize-1);
-		}
+	reducedMessage.setAttributesSize(ranks.size());
+	for (uint32_t i = 0 ; i < ranks.size() ; ++i) {
+		reducedMessage.setAttributes(msg->getAttributes(ranks[i]), i);
 	}
-	return reducedMessage;
+	reducedMessage.setValues(ValueArena(msg->getValues(), ranks));
+
+	return WireBuffer(reducedMessage);
 }
 
 // ----------------------------------------------------------------------------
 /** ObjectBroadcastLine  
  */
 ObjectBroadcastLine::ObjectBroadcastLine(FederateHandle theFederate,
+		AttributeHandle maxHandle,
+		ObjectBroadcastLine::State init_state)
+{
+	reset(theFederate, maxHandle, init_state);
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectBroadcastLine::reset(FederateHandle theFederate,
+		AttributeHandle maxHandle,
 		ObjectBroadcastLine::State init_state)
 {
 	Federate = theFederate ;
-	for (AttributeHandle i = 0 ; i <= MAX_STATE_SIZE ; i++)
-		state[i] = init_state ;
+
+	// Attributes 0..maxHandle, 32 per word.
+	unsigned int words = maxHandle / 32 + 1 ;
+	sentBits.assign(words, init_state == sent ? ~0u : 0u);
+	waitingBits.assign(words, init_state == waiting ? ~0u : 0u);
+	waitingCount = init_state == waiting ? maxHandle + 1 : 0 ;
+}
+
+// ----------------------------------------------------------------------------
+ObjectBroadcastLine::State
+ObjectBroadcastLine::getState(AttributeHandle attribute) const
+{
+	unsigned int word = attribute / 32 ;
+	uint32_t bit = 1u << (attribute % 32);
+
+	if (word >= sentBits.size())
+		return notSub ;
+	if (sentBits[word] & bit)
+		return sent ;
+	if (waitingBits[word] & bit)
+		return waiting ;
+	return notSub ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+ObjectBroadcastLine::setWaiting(AttributeHandle attribute)
+{
+	unsigned int word = attribute / 32 ;
+	uint32_t bit = 1u << (attribute % 32);
+
+	if (sentBits[word] & bit)
+		return false ;
+	if (!(waitingBits[word] & bit)) {
+		waitingBits[word] |= bit ;
+		++waitingCount ;
+	}
+	return true ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectBroadcastLine::setWaitingSent()
+{
+	if (waitingCount == 0)
+		return ;
+
+	for (unsigned int word = 0 ; word < waitingBits.size() ; ++word) {
+		sentBits[word] |= waitingBits[word] ;
+		waitingBits[word] = 0 ;
+	}
+	waitingCount = 0 ;
+}
+
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+ObjectBroadcastLinePool::~ObjectBroadcastLinePool()
+{
+	for (unsigned int i = 0 ; i < lines.size() ; ++i)
+		delete lines[i] ;
+}
+
+// ----------------------------------------------------------------------------
+ObjectBroadcastLine *
+ObjectBroadcastLinePool::get(FederateHandle theFederate,
+		AttributeHandle maxHandle,
+		ObjectBroadcastLine::State init_state)
+{
+	if (lines.empty())
+		return new ObjectBroadcastLine(theFederate, maxHandle, init_state);
+
+	ObjectBroadcastLine *line = lines.back();
+	lines.pop_back();
+	line->reset(theFederate, maxHandle, init_state);
+	return line ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectBroadcastLinePool::release(ObjectBroadcastLine *line)
+{
+	lines.push_back(line);
 }
 
 // ============================================================================
@@ -163,15 +210,12 @@ ObjectClassBroadcastList::addFederate(FederateHandle theFederate,
 	ObjectBroadcastLine *line = getLineWithFederate(theFederate);
 
 	if (line == 0) {
-		line =
-				new ObjectBroadcastLine(theFederate, ObjectBroadcastLine::notSub);
-		lines.push_front(line);
+		line = newLine(theFederate, ObjectBroadcastLine::notSub);
 		D.Out(pdRegister, "Adding new line in list for Federate %d.",
 				theFederate);
 	}
 
-	if (line->state[theAttribute] != ObjectBroadcastLine::sent) {
-		line->state[theAttribute] = ObjectBroadcastLine::waiting ;
+	if (line->setWaiting(theAttribute)) {
 		D.Out(pdRegister, "List attribute %d for Federate %d is now "
 				"ObjectBroadcastLine::waiting.", theAttribute, theFederate);
 	}
@@ -184,12 +228,11 @@ ObjectClassBroadcastList::addFederate(FederateHandle theFederate,
 // ----------------------------------------------------------------------------
 
 ObjectClassBroadcastList::ObjectClassBroadcastList(NetworkMessage *msg,
-		AttributeHandle maxAttHandle)
+		AttributeHandle maxAttHandle,
+		ObjectBroadcastLinePool *linePool)
 throw (RTIinternalError)
-: maxHandle(maxAttHandle)
+: maxHandle(maxAttHandle), pool(linePool)
 {
-	ObjectBroadcastLine *firstLine = NULL;
-
 	if (NULL==msg) {
 		throw RTIinternalError("Null Broadcast Message.");
 	}
@@ -228,8 +271,7 @@ throw (RTIinternalError)
 
 	// Add reference of the sender.
 	if (msg->getFederate() != 0) {
-		firstLine = new ObjectBroadcastLine(msg->getFederate(),ObjectBroadcastLine::sent);
-		lines.push_front(firstLine);
+		newLine(msg->getFederate(), ObjectBroadcastLine::sent);
 	}
 }
 
@@ -250,44 +292,65 @@ ObjectClassBroadcastList::clear()
 
 	maxHandle = 0 ;
 
-	while (!lines.empty()) {
-		delete lines.front();
-		lines.pop_front();
+	for (unsigned int i = 0 ; i < lines.size() ; ++i) {
+		if (pool != NULL)
+			pool->release(lines[i]);
+		else
+			delete lines[i] ;
 	}
+	lines.clear();
+	lineIndex.clear();
 
 	D.Out(pdTerm, "List is now empty.");
 }
 
 
 
-ObjectBroadcastLine*
-ObjectClassBroadcastList::getLineWithFederate(FederateHandle theFederate)
+// ----------------------------------------------------------------------------
+ObjectBroadcastLine *
+ObjectClassBroadcastList::newLine(FederateHandle theFederate,
+		ObjectBroadcastLine::State init_state)
 {
-	list<ObjectBroadcastLine *>::iterator i ;
-	for (i = lines.begin(); i != lines.end(); i++) {
-		if ((*i)->Federate == theFederate)
-			return (*i);
-	}
+	ObjectBroadcastLine *line = pool != NULL
+			? pool->get(theFederate, maxHandle, init_state)
+			: new ObjectBroadcastLine(theFederate, maxHandle, init_state);
 
-	return 0 ;
+	lines.push_back(line);
+	lineIndex[theFederate] = line ;
+	return line ;
 }
 
 // ----------------------------------------------------------------------------
-/** Check if some attributes in the provided line have the "waiting"
-    status.
- */
-bool
-ObjectClassBroadcastList::isWaiting(ObjectBroadcastLine *line)
+void
+ObjectClassBroadcastList::setBestEffort(uint32_t rank)
 {
-	for (unsigned int attrIndex = 1 ; attrIndex <= maxHandle ; attrIndex++) {
-		if (line->state[attrIndex] == ObjectBroadcastLine::waiting) {
-			return true ;
-		}
-	}
+	if (NULL == msgRAV || msgRAV->isDated())
+		return ;
+	if (bestEffort.empty())
+		bestEffort.resize(msgRAV->getAttributesSize(), false);
+	bestEffort[rank] = true ;
+}
 
-	return false ;
+// ----------------------------------------------------------------------------
+TransportType
+ObjectClassBroadcastList::getTransport(const std::vector<uint32_t> &ranks) const
+{
+	if (bestEffort.empty())
+		return RELIABLE ;
+	for (std::vector<uint32_t>::const_iterator r = ranks.begin(); r != ranks.end(); ++r) {
+		if (!bestEffort[*r])
+			return RELIABLE ;
+	}
+	return BEST_EFFORT ;
 }
 
+// ----------------------------------------------------------------------------
+ObjectBroadcastLine *
+ObjectClassBroadcastList::getLineWithFederate(FederateHandle theFederate)
+{
+	LineIndex::const_iterator i = lineIndex.find(theFederate);
+	return i == lineIndex.end() ? 0 : i->second ;
+}
 
 // --------------------------
 // -- SendPendingDOMessage --
@@ -297,12 +360,13 @@ void
 ObjectClassBroadcastList::sendPendingDOMessage(SecurityServer *server)
 {
 	Socket *socket = NULL ;
+	WireBuffer wire ;
 
 	// Pour chaque ligne de la liste
-	list<ObjectBroadcastLine *>::iterator i ;
+	std::vector<ObjectBroadcastLine *>::iterator i ;
 	for (i = lines.begin(); i != lines.end(); ++i) {
 		// Si le federe attend un message(attribute 0 en attente)
-		if ((*i)->state[0] == ObjectBroadcastLine::waiting) {
+		if ((*i)->getState(0) == ObjectBroadcastLine::waiting) {
 
 			// 1. Envoyer le message au federe
 			D.Out(pdProtocol,
@@ -310,8 +374,12 @@ ObjectClassBroadcastList::sendPendingDOMessage(SecurityServer *server)
 			try {
 				socket = server->getSocketLink((*i)->Federate);
 				// socket NULL means federate dead (killed ?)
-				if ( socket != NULL )
-					msg->send(socket,NM_msgBufSend);
+				if ( socket != NULL ) {
+					// encode once for all the federates
+					if (wire.empty())
+						wire = WireBuffer(*msg);
+					wire.send(socket);
+				}
 			}
 			catch (RTIinternalError &e) {
 				D.Out(pdExcept,
@@ -322,7 +390,7 @@ ObjectClassBroadcastList::sendPendingDOMessage(SecurityServer *server)
 			}
 
 			// 2. Marquer le federe comme ayant recu le message.
-			(*i)->state[0] = ObjectBroadcastLine::sent ;
+			(*i)->setWaitingSent();
 		}
 		else
 			D.Out(pdProtocol, "No message sent to Federate %d.",
@@ -346,6 +414,12 @@ ObjectClassBroadcastList::sendPendingDOMessage(SecurityServer *server)
 void ObjectClassBroadcastList::sendPendingMessage(SecurityServer *server)
 {
 	G.Out(pdGendoc,"enter ObjectClassBroadcastList::sendPendingMessage");
+	if (EventTrace::isEnabled()) {
+		ObjectHandle object = msgRAV ? msgRAV->getObject() : msgDO ? msgDO->getObject()
+			: msgRAOA ? msgRAOA->getObject() : 0 ;
+		EventTrace::record(TRACE_RTIG_BROADCAST, msg->getMessageType(), msg->getFederation(),
+		                   msg->getFederate(), object, lines.size());
+	}
 	switch (msg->getMessageType()) {
 
 	case NetworkMessage::REFLECT_ATTRIBUTE_VALUES:
@@ -372,44 +446,44 @@ void
 ObjectClassBroadcastList::sendPendingRAVMessage(SecurityServer *server)
 {
 	Socket         *socket         = NULL;
-	NetworkMessage *currentMessage = NULL;
-	uint32_t attributeSize   = 0;
-	std::vector<AttributeHandle>  vATH;
+	const std::vector<AttributeHandle> &vATH =
+			NULL != msgRAV ? msgRAV->getAttributes() : msgRAOA->getAttributes();
+	uint32_t attributeSize = vATH.size();
 
-	if (NULL!=msgRAV) {
-		attributeSize = msgRAV->getAttributesSize();
-		vATH = msgRAV->getAttributes();
-	}
-
-	if (NULL!=msgRAOA) {
-		attributeSize = msgRAOA->getAttributesSize();
-		vATH = msgRAOA->getAttributes();
-	}
+	// Each distinct message is encoded once: the complete one, and the
+	// reduced ones indexed by the ranks of the attributes they carry.
+	WireBuffer complete ;
+	std::map<std::vector<uint32_t>, WireBuffer> reduced ;
+	std::vector<uint32_t> ranks ;
 
 	G.Out(pdGendoc,"enter ObjectClassBroadcastList::sendPendingRAVMessage");
 	// For each line :
-	list<ObjectBroadcastLine *>::iterator i ;
+	std::vector<ObjectBroadcastLine *>::iterator i ;
 	for (i = lines.begin(); i != lines.end(); ++i) {
 
 		// Si AU MOINS UN des attributs est en ObjectBroadcastLine::waiting
-		if (isWaiting(*i)) {
+		if ((*i)->isWaiting()) {
 
 			// 1. Est-ce que tous les attributs du message sont en
 			// ObjectBroadcastLine::waiting ?
-			bool all_waiting = true ;
+			ranks.clear();
 			for (uint32_t attrIndex = 0 ; attrIndex < attributeSize ;	++attrIndex ) {
-				if ((*i)->state[vATH[attrIndex]] != ObjectBroadcastLine::waiting)
-					all_waiting = false ;
+				if ((*i)->getState(vATH[attrIndex]) == ObjectBroadcastLine::waiting)
+					ranks.push_back(attrIndex);
 			}
 
-			if (!all_waiting) {
-				// NO: Create a new message containing only ObjectBroadcastLine::waiting
+			WireBuffer *wire ;
+			if (ranks.size() != attributeSize) {
+				// NO: Use a message containing only ObjectBroadcastLine::waiting
 				// attributes.
-				if (NULL!=msgRAV) {
-					currentMessage = createReducedMessageWithValue(msgRAV,*i);
-				}
-				if (NULL!=msgRAOA) {
-					currentMessage = createReducedMessage(msgRAOA,*i);
+				wire = &reduced[ranks] ;
+				if (wire->empty()) {
+					if (NULL!=msgRAV) {
+						*wire = encodeReducedMessageWithValue(msgRAV, ranks);
+					}
+					if (NULL!=msgRAOA) {
+						*wire = encodeReducedMessage(msgRAOA, ranks);
+					}
 				}
 				D.Out(pdProtocol,
 						"Broadcasting reduced message to Federate %d.",
@@ -417,7 +491,10 @@ ObjectClassBroadcastList::sendPendingRAVMessage(SecurityServer *server)
 			}
 			else {
 				// YES: Nothing to do.
-				currentMessage = msg ;
+				wire = &complete ;
+				if (wire->empty()) {
+					*wire = WireBuffer(*msg);
+				}
 				D.Out(pdProtocol,
 						"Broadcasting complete message to Federate %d.",
 						(*i)->Federate);
@@ -425,16 +502,13 @@ ObjectClassBroadcastList::sendPendingRAVMessage(SecurityServer *server)
 
 			// 2. Send message (or reduced one).
 			try {
-#ifdef HLA_USES_UDP
-				socket = server->getSocketLink((*i)->Federate, BEST_EFFORT);
-#else
-				socket = server->getSocketLink((*i)->Federate);
-#endif
+				TransportType transport = getTransport(ranks);
+				socket = server->getSocketLink((*i)->Federate, transport);
 				// socket NULL means federate is dead (killed ?)
 				if ( socket != NULL )
 				{
 					G.Out(pdGendoc,"                                 sendPendingRAVMessage=====> write");
-					currentMessage->send(socket,NM_msgBufSend);
+					wire->send(socket, transport);
 				}
 			}
 			catch (RTIinternalError &e) {
@@ -446,19 +520,7 @@ ObjectClassBroadcastList::sendPendingRAVMessage(SecurityServer *server)
 			}
 
 			// 3. marquer les attributs en ObjectBroadcastLine::sent.
-			for (unsigned int attrIndex = 1 ;
-					attrIndex <= maxHandle ;
-					attrIndex ++) {
-				if ((*i)->state[attrIndex] == ObjectBroadcastLine::waiting) {
-					(*i)->state[attrIndex] = ObjectBroadcastLine::sent ;
-				}
-			}
-
-			// 4. Eventuellement effacer la copie du message.
-			if (currentMessage != msg) {
-				delete currentMessage ;
-				currentMessage = NULL ;
-			}
+			(*i)->setWaitingSent();
 
 		} // Si AU MOINS UN des attributs est en ObjectBroadcastLine::waiting
 		else
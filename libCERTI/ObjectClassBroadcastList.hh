@@ -28,10 +28,10 @@
 #include "NetworkMessage.hh"
 #include "NM_Classes.hh"
 #include "SecurityServer.hh"
+#include "WireBuffer.hh"
 
-#include <list>
-
-#define MAX_STATE_SIZE 1024
+#include <map>
+#include <vector>
 
 namespace certi {
 
@@ -39,6 +39,9 @@ namespace certi {
  * An object broadcast line represents a federate
  * interested in part (or all) of the attributes of
  * the message referenced in the ObjectClassBroadcastList.
+ * The attribute states are kept in two bit sets sized to
+ * the attribute handles of the class, attribute 0 standing
+ * for the whole object (Discover/Remove Object messages).
  */
 class ObjectBroadcastLine {
 public:
@@ -52,19 +55,61 @@ public:
 		notSub   /**< the federate did not subscribed to this attribute */
 	};
 
-	ObjectBroadcastLine(FederateHandle fed, State init = notSub);
+	ObjectBroadcastLine(FederateHandle fed, AttributeHandle maxHandle,
+	                    State init = notSub);
 
-	/* The Federate Handle */
-	FederateHandle Federate ;
+	/**
+	 * Make the line describe another federate, all its attributes
+	 * being in the given state. The bit sets storage is kept.
+	 */
+	void reset(FederateHandle fed, AttributeHandle maxHandle,
+	           State init = notSub);
 
 	/**
-	 * The state of the attributes.
-	 * The index of the state array is the attribute handle
-	 * FIXME we should rather use a map, because the
-	 * FIXME attribute handle may be very sparse.
+	 * Get the state of an attribute, notSub beyond the line handles.
 	 */
-	State state[MAX_STATE_SIZE+1] ;
+	State getState(AttributeHandle attribute) const ;
 
+	/**
+	 * Mark an attribute as waiting.
+	 * @return false if the attribute has already been sent.
+	 */
+	bool setWaiting(AttributeHandle attribute);
+
+	/**
+	 * Mark all the waiting attributes as sent.
+	 */
+	void setWaitingSent();
+
+	/**
+	 * Return true if at least one attribute is waiting.
+	 */
+	bool isWaiting() const { return waitingCount > 0 ; }
+
+	/* The Federate Handle */
+	FederateHandle Federate ;
+
+private:
+	std::vector<uint32_t> sentBits ;
+	std::vector<uint32_t> waitingBits ;
+	unsigned int waitingCount ;
+};
+
+/**
+ * A store of broadcast lines left by previous broadcasts, so that
+ * broadcasting to the same number of federates again does not allocate.
+ * An object class keeps one for its updates.
+ */
+class ObjectBroadcastLinePool {
+public:
+	~ObjectBroadcastLinePool();
+
+	ObjectBroadcastLine *get(FederateHandle fed, AttributeHandle maxHandle,
+	                         ObjectBroadcastLine::State init);
+	void release(ObjectBroadcastLine *line);
+
+private:
+	std::vector<ObjectBroadcastLine *> lines ;
 };
 
 /**
@@ -92,9 +137,11 @@ public:
 	 * msg->federate is added to the list, and its state is set as "Sent"
 	 * for all attributes. For RAVs messages, MaxAttHandle is the greatest
 	 * attribute handle of the class. For Discover_Object message, it can be 0 to
-	 * mean "any attribute".
+	 * mean "any attribute". Lines are taken from the pool, if any,
+	 * and given back to it by clear().
 	 */
-	ObjectClassBroadcastList(NetworkMessage *msg, AttributeHandle maxAttributeHandles = 0)
+	ObjectClassBroadcastList(NetworkMessage *msg, AttributeHandle maxAttributeHandles = 0,
+	                         ObjectBroadcastLinePool *pool = NULL)
 	throw (RTIinternalError);
 
 	~ObjectClassBroadcastList();
@@ -118,6 +165,14 @@ public:
 	 */
 	void addFederate(FederateHandle federate, AttributeHandle attribute = 0);
 
+	/**
+	 * Mark the attribute of the given rank in a Reflect Attribute Values
+	 * message as best effort. The message, or the part of it sent to a
+	 * federate, goes over the best effort link of the federate when all
+	 * its attributes are best effort and it is not timestamped.
+	 */
+	void setBestEffort(uint32_t rank);
+
 	/**
 	 * Send all the pending message to all concerned
 	 * Federate stored in the broadcast lines.
@@ -145,16 +200,27 @@ protected:
 private:
 
 	template <typename T>
-	T* createReducedMessage(T* msg, ObjectBroadcastLine *line);
+	void copyHeader(T* msg, T& reducedMessage);
 
+	/**
+	 * Encode msg restricted to the attributes of the given ranks.
+	 */
 	template <typename T>
-	T* createReducedMessageWithValue(T* msg, ObjectBroadcastLine *line);
+	WireBuffer encodeReducedMessage(T* msg, const std::vector<uint32_t> &ranks);
+
+	/**
+	 * Encode msg restricted to the attributes (and values) of the given
+	 * ranks, without copying the values.
+	 */
+	template <typename T>
+	WireBuffer encodeReducedMessageWithValue(T* msg, const std::vector<uint32_t> &ranks);
 
 
 	//! Return the line of the list describing federate 'theFederate', or NULL.
 	ObjectBroadcastLine *getLineWithFederate(FederateHandle theFederate);
 
-	bool isWaiting(ObjectBroadcastLine *line);
+	ObjectBroadcastLine *newLine(FederateHandle theFederate,
+	                             ObjectBroadcastLine::State init);
 
 	/*! The two next methods are called by the public SendPendingMessage
       methods. They respectively handle DiscoverObject and
@@ -163,10 +229,18 @@ private:
 	void sendPendingDOMessage(SecurityServer *server);
 	void sendPendingRAVMessage(SecurityServer *server);
 
+	//! Return the transportation of the attributes of the given ranks.
+	TransportType getTransport(const std::vector<uint32_t> &ranks) const ;
+
+	typedef std::map<FederateHandle, ObjectBroadcastLine *> LineIndex ;
+
 	AttributeHandle maxHandle ;
-	std::list<ObjectBroadcastLine *> lines ;
-	/* The message buffer used to send Network messages */
-	MessageBuffer NM_msgBufSend;
+	ObjectBroadcastLinePool *pool ;
+	std::vector<ObjectBroadcastLine *> lines ;
+	//! The lines indexed by federate, addFederate is called for each recipient.
+	LineIndex lineIndex ;
+	//! The best effort attributes by rank, empty if there is none.
+	std::vector<bool> bestEffort ;
 };
 
 } // namespace certi
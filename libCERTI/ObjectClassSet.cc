@@ -73,7 +73,7 @@ ObjectClassSet::deleteObject(FederateHandle federate,
     throw (DeletePrivilegeNotHeld, ObjectNotKnown, RTIinternalError)
 {
     // It may throw ObjectNotKnown
-    ObjectClass *oclass = getInstanceClass(object->getHandle());
+    ObjectClass *oclass = getInstanceClass(object);
 
     D.Out(pdRegister,
           "Federate %d attempts to delete instance %d in class %d.",
@@ -115,7 +115,7 @@ ObjectClassSet::deleteObject(FederateHandle federate,
     throw (DeletePrivilegeNotHeld, ObjectNotKnown, RTIinternalError)
 {
     // It may throw ObjectNotKnown
-    ObjectClass *oclass = getInstanceClass(object->getHandle());
+    ObjectClass *oclass = getInstanceClass(object);
 
     D.Out(pdRegister,
           "Federate %d attempts to delete instance %d in class %d.",
@@ -223,6 +223,18 @@ ObjectClassSet::getInstanceClass(ObjectHandle theObjectHandle) const
     throw ObjectNotKnown(msg.str());
 }
 
+// ----------------------------------------------------------------------------
+ObjectClass *
+ObjectClassSet::getInstanceClass(const Object *object) const
+    throw (ObjectNotKnown)
+{
+    handled_const_iterator i = fromHandle.find(object->getClass());
+    if (i != fromHandle.end() && i->second->isInstanceInClass(object->getHandle()))
+        return i->second ;
+
+    return getInstanceClass(object->getHandle());
+}
+
 // ----------------------------------------------------------------------------
 //! getObjectClassHandle.
 ObjectClassHandle
@@ -246,41 +258,11 @@ ObjectClassSet::getObjectClassName(ObjectClassHandle the_handle) const
 void ObjectClassSet::killFederate(FederateHandle theFederate)
     throw ()
 {
-    ObjectClassBroadcastList *ocbList      = NULL ;
-    ObjectClassHandle         currentClass = 0 ;
+    D.Out(pdExcept, "Kill Federate Handle %d .", theFederate);
 
     handled_iterator i;
-
     for (i = fromHandle.begin(); i != fromHandle.end(); ++i) {
-        // Call KillFederate on every class of the current class set
-        // until it returns NULL.
-        do {
-            D.Out(pdExcept, "Kill Federate Handle %d .", theFederate);
-            ocbList = i->second->killFederate(theFederate);
-
-            D.Out(pdExcept, "Federate Handle %d Killed.", theFederate);
-
-            // Broadcast RemoveObject message recursively
-            // going from current class to its superclass.
-            if (ocbList != NULL) {
-                currentClass = i->second->getSuperclass();
-                D.Out(pdExcept, "List not NULL");
-                while (currentClass != 0) {
-                    D.Out(pdRegister,
-                          "Broadcasting Remove msg to parent class %d(Killed).",
-                          currentClass);
-
-                    // It may throw ObjectClassNotDefined
-                    ObjectClass* currentClassObject = getObjectFromHandle(currentClass);
-
-                    currentClassObject->broadcastClassMessage(ocbList);
-
-                    currentClass = currentClassObject->getSuperclass();
-                }
-
-                delete ocbList ;
-            }
-        } while (ocbList != NULL);
+        i->second->killFederate(theFederate);
     }
     D.Out(pdExcept, "End of the KillFederate Procedure.");
 } /* end of killFederate */
@@ -383,7 +365,7 @@ void
 ObjectClassSet::updateAttributeValues(FederateHandle federate,
                                       Object* object,
                                       const std::vector <AttributeHandle> &attributes,
-                                      const std::vector <AttributeValue_t> &values,
+                                      const ValueArena &values,
                                       const FederationTime& time,
                                       const std::string& tag)
     throw (AttributeNotDefined,
@@ -402,21 +384,7 @@ ObjectClassSet::updateAttributeValues(FederateHandle federate,
     ocbList = object_class->updateAttributeValues(
                                                   federate, object, attributes, values, attributes.size(), time, tag);
 
-    // Broadcast ReflectAttributeValues message recursively
-    current_class = object_class->getSuperclass();
-
-    while (0!=current_class) {
-        D.Out(pdProtocol,
-              "Broadcasting RAV msg to parent class %d for instance %d.",
-              current_class, object->getHandle());
-
-        // It may throw ObjectClassNotDefined
-        object_class = getObjectFromHandle(current_class);
-        object_class->broadcastClassMessage(ocbList, object);
-
-        current_class = object_class->getSuperclass();
-    }
-
+    // The class routes already reached the superclass subscribers.
     delete ocbList ;
 }
 
@@ -426,7 +394,7 @@ void
 ObjectClassSet::updateAttributeValues(FederateHandle federate,
                                       Object* object,
                                       const std::vector <AttributeHandle> &attributes,
-                                      const std::vector <AttributeValue_t> &values,
+                                      const ValueArena &values,
                                       const std::string& tag)
     throw (AttributeNotDefined,
            AttributeNotOwned,
@@ -444,21 +412,7 @@ ObjectClassSet::updateAttributeValues(FederateHandle federate,
     ocbList = object_class->updateAttributeValues(
                                                   federate, object, attributes, values, attributes.size(), tag);
 
-    // Broadcast ReflectAttributeValues message recursively
-    current_class = object_class->getSuperclass();
-
-    while (current_class != 0) {
-        D.Out(pdProtocol,
-              "Broadcasting RAV msg to parent class %d for instance %d.",
-              current_class, object->getHandle());
-
-        // It may throw ObjectClassNotDefined
-        object_class = getObjectFromHandle(current_class);
-        object_class->broadcastClassMessage(ocbList, object);
-
-        current_class = object_class->getSuperclass();
-    }
-
+    // The class routes already reached the superclass subscribers.
     delete ocbList ;
 }
 
@@ -476,7 +430,7 @@ negotiatedAttributeOwnershipDivestiture(FederateHandle theFederateHandle,
            RTIinternalError)
 {
     // It may throw ObjectNotKnown
-    ObjectClass *objectClass = getInstanceClass(object->getHandle());
+    ObjectClass *objectClass = getInstanceClass(object);
     ObjectClassHandle currentClass = objectClass->getHandle();
 
     // It may throw a bunch of exceptions.
@@ -520,7 +474,7 @@ attributeOwnershipAcquisitionIfAvailable(FederateHandle theFederateHandle,
            RTIinternalError)
 {
     // It may throw ObjectNotKnown
-    ObjectClass * objectClass = getInstanceClass(object->getHandle());
+    ObjectClass * objectClass = getInstanceClass(object);
 
     // It may throw a bunch of exceptions.
     objectClass->attributeOwnershipAcquisitionIfAvailable(theFederateHandle,
@@ -539,7 +493,7 @@ unconditionalAttributeOwnershipDivestiture(FederateHandle theFederateHandle,
            AttributeNotOwned,
            RTIinternalError)
 {
-    ObjectClass *objectClass = getInstanceClass(object->getHandle());
+    ObjectClass *objectClass = getInstanceClass(object);
     ObjectClassHandle currentClass = objectClass->getHandle();
 
     // It may throw a bunch of exceptions.
@@ -580,7 +534,7 @@ attributeOwnershipAcquisition(FederateHandle theFederateHandle,
            RTIinternalError)
 {
     // It may throw ObjectNotKnown
-    ObjectClass * objectClass = getInstanceClass(object->getHandle());
+    ObjectClass * objectClass = getInstanceClass(object);
     
     // It may throw a bunch of exceptions.
     objectClass->attributeOwnershipAcquisition(theFederateHandle, object, theAttributeList, theTag);
@@ -598,7 +552,7 @@ attributeOwnershipReleaseResponse(FederateHandle theFederateHandle,
            RTIinternalError)
 {
     // It may throw ObjectNotKnown
-    ObjectClass *objectClass = getInstanceClass(object->getHandle());
+    ObjectClass *objectClass = getInstanceClass(object);
 
     // It may throw a bunch of exceptions.
     return objectClass->attributeOwnershipReleaseResponse(theFederateHandle, object, theAttributeList);
@@ -616,7 +570,7 @@ cancelAttributeOwnershipAcquisition(FederateHandle theFederateHandle,
            RTIinternalError)
 {
     // It may throw ObjectNotKnown
-    ObjectClass *objectClass = getInstanceClass(object->getHandle());
+    ObjectClass *objectClass = getInstanceClass(object);
 
     // It may throw a bunch of exceptions.
     objectClass->cancelAttributeOwnershipAcquisition(theFederateHandle, object, theAttributeList);
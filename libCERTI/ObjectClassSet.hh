@@ -123,7 +123,7 @@ public:
 	void updateAttributeValues(FederateHandle theFederateHandle,
                         Object* object,
 			const std::vector <AttributeHandle> &theAttribArray,
-			const std::vector <AttributeValue_t> &theValueArray,
+			const ValueArena &theValueArray,
 			const FederationTime& theTime,
 			const std::string& theUserTag)
 	throw (AttributeNotDefined, AttributeNotOwned,
@@ -132,7 +132,7 @@ public:
 	void updateAttributeValues(FederateHandle theFederateHandle,
                         Object* object,
 			const std::vector <AttributeHandle> &theAttribArray,
-			const std::vector <AttributeValue_t> &theValueArray,
+			const ValueArena &theValueArray,
 			const std::string& theUserTag)
 	throw (AttributeNotDefined, AttributeNotOwned,
 			RTIinternalError, InvalidObjectHandle);
@@ -189,6 +189,10 @@ private:
 
 	ObjectClass *getInstanceClass(ObjectHandle theObjectHandle) const
 	throw (ObjectNotKnown);
+
+	/** Same as above, starting with the class the object is registered in. */
+	ObjectClass *getInstanceClass(const Object *object) const
+	throw (ObjectNotKnown);
 };
 
 } // namespace certi
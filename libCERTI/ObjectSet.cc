@@ -51,6 +51,13 @@ ObjectSet::ObjectSet(SecurityServer *the_server)
 
 // ----------------------------------------------------------------------------
 ObjectSet::~ObjectSet()
+{
+    clear();
+}
+
+// ----------------------------------------------------------------------------
+void
+ObjectSet::clear()
 {
     for (auto i = OFromHandle.begin(); i != OFromHandle.end(); i++) {
         delete i->second ;
@@ -61,17 +68,30 @@ ObjectSet::~ObjectSet()
 
 // ----------------------------------------------------------------------------
 void
-ObjectSet::changeAttributeTransportationType(ObjectHandle,
-                                             AttributeHandle *,
-                                             uint16_t,
-                                             TransportType)
+ObjectSet::changeAttributeTransportationType(FederateHandle the_federate,
+                                             ObjectHandle the_object,
+                                             const std::vector <AttributeHandle> &the_attributes,
+                                             TransportType the_type)
     throw (ObjectNotKnown,
            AttributeNotDefined,
            AttributeNotOwned,
-           RTIinternalError,
-           InvalidObjectHandle)
+           InvalidTransportationHandle)
 {
-    // Object *object = getObject(the_object);
+    if ((the_type != RELIABLE) && (the_type != BEST_EFFORT))
+        throw InvalidTransportationHandle("");
+
+    Object *object = getObject(the_object);
+
+    // Nothing is changed unless every attribute is owned.
+    for (size_t i = 0 ; i < the_attributes.size(); ++i) {
+        if (object->getAttribute(the_attributes[i])->getOwner() != the_federate)
+            throw AttributeNotOwned(stringize() << "Federate <" << the_federate
+                                    << "> is not owner of attribute <" << the_attributes[i] << ">");
+    }
+    for (size_t i = 0 ; i < the_attributes.size(); ++i)
+        object->getAttribute(the_attributes[i])->setTransport(the_type);
+
+    D.Out(pdDebug, "Object %u: new transport type is %u.", the_object, the_type);
 }
 
 // ----------------------------------------------------------------------------
@@ -142,6 +162,7 @@ Object * ObjectSet::registerObjectInstance(FederateHandle the_federate, 				  Ob
     object->setClass(the_class);
 
     object->setName(FilledName);
+    object->setOwnershipIndex(&ownership);
 
     OFromHandle[the_object] = object;
     OFromName[FilledName] = object;
@@ -174,20 +195,25 @@ void
 ObjectSet::killFederate(FederateHandle the_federate)
     throw (RTIinternalError)
 {
-	auto i = OFromHandle.begin();
-	while( i != OFromHandle.end() ) {
-		if ((i->second)->getOwner() == the_federate) 
-        {
-            OFromName.erase(i->second->getName());
-            OFromHandle.erase(i->first);
-			i = OFromHandle.begin();
-		}
-		else {
-            // It is safe to run this multiple times
-            i->second->killFederate(the_federate);
-			i++;
-		}
-	}
+    // Copies: deleting an object or changing an owner updates the index.
+    const OwnershipIndex::ObjectList owned = ownership.getObjects(the_federate);
+    for (OwnershipIndex::ObjectList::const_iterator i = owned.begin(); i != owned.end(); ++i) {
+        Handle2ObjectMap_t::iterator object = OFromHandle.find(*i);
+        if (object == OFromHandle.end())
+            continue ;
+        OFromName.erase(object->second->getName());
+        delete object->second ;
+        OFromHandle.erase(object);
+    }
+
+    const OwnershipIndex::AttributeList attributes = ownership.getAttributes(the_federate);
+    OwnershipIndex::AttributeList::const_iterator a ;
+    for (a = attributes.begin(); a != attributes.end(); ++a) {
+        (*a)->setOwner(0);
+    }
+    D.Out(pdRegister, "Federate %d killed: %u objects deleted, %u attributes released.",
+          the_federate, static_cast<unsigned>(owned.size()),
+          static_cast<unsigned>(attributes.size()));
 } /* end of killFederate */
 
 // ----------------------------------------------------------------------------
@@ -414,10 +440,8 @@ ObjectSet::getObjectByName(const std::string &the_object_name) const
 void
 ObjectSet::getAllObjectInstancesFromFederate(FederateHandle the_federate, std::vector<ObjectHandle>& ownedObjectInstances)
 {
-	ownedObjectInstances.clear();
-	for (auto i = OFromHandle.begin(); i != OFromHandle.end(); ++i) 
-		if (i->second != 0 && i->second->getOwner() == the_federate) 
-			ownedObjectInstances.push_back(i->first);
+	const OwnershipIndex::ObjectList &owned = ownership.getObjects(the_federate);
+	ownedObjectInstances.assign(owned.begin(), owned.end());
 }
 
 // ----------------------------------------------------------------------------
@@ -428,11 +452,7 @@ ObjectSet::sendToFederate(NetworkMessage *msg, FederateHandle the_federate) cons
     // Send the message 'msg' to the Federate which Handle is theFederate.
     Socket *socket = NULL ;
     try {
-#ifdef HLA_USES_UDP
-        socket = server->getSocketLink(the_federate, BEST_EFFORT);
-#else
         socket = server->getSocketLink(the_federate);
-#endif
         msg->send(socket,const_cast<MessageBuffer&>(NM_msgBufSend));
     }
     catch (RTIinternalError &e) {
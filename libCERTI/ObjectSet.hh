@@ -29,6 +29,7 @@ class Object;
 #include "SecurityServer.hh"
 #include "MessageBuffer.hh"
 #include "GAV.hh"
+#include "OwnershipIndex.hh"
 #include "certi.hh"
 
 // Standard
@@ -44,6 +45,17 @@ public:
     ObjectSet(SecurityServer *the_server);
     ~ObjectSet();
 
+    typedef std::map<ObjectHandle,Object*,std::less<ObjectHandle> > Handle2ObjectMap_t;
+    typedef Handle2ObjectMap_t::const_iterator const_iterator;
+
+    /** The registered objects, by handle. */
+    const_iterator begin() const { return OFromHandle.begin(); }
+    const_iterator end() const { return OFromHandle.end(); }
+    size_t size() const { return OFromHandle.size(); }
+
+    /** Delete every object, without any message. */
+    void clear();
+
     ObjectHandle
     getObjectInstanceHandle(const std::string&) const
         throw (ObjectNotKnown, RTIinternalError);
@@ -57,12 +69,14 @@ public:
         throw (ObjectNotKnown, FederateNotExecutionMember,
                ConcurrentAccessAttempted, RTIinternalError);
 
-    void changeAttributeTransportationType(ObjectHandle the_object,
-                                           AttributeHandle *the_attributes,
-                                           uint16_t the_size,
+    /** Change the transportation of the given attributes of an object,
+        which must all be owned by the federate. */
+    void changeAttributeTransportationType(FederateHandle the_federate,
+                                           ObjectHandle the_object,
+                                           const std::vector <AttributeHandle> &the_attributes,
                                            TransportType the_type)
         throw (ObjectNotKnown, AttributeNotDefined, AttributeNotOwned,
-               RTIinternalError, InvalidObjectHandle);
+               InvalidTransportationHandle);
 
     void changeAttributeOrderType(ObjectHandle the_object,
                                   AttributeHandle *the_attributes,
@@ -85,6 +99,11 @@ public:
                                   ObjectHandle the_object)
     throw (ObjectNotKnown);
 
+    /**
+     * Delete the objects the federate may still delete, which the object
+     * classes must not reference anymore (see RootObject::killFederate),
+     * and release the attributes it owns.
+     */
     void killFederate(FederateHandle) throw (RTIinternalError);
 
     // Ownership Management.
@@ -164,6 +183,7 @@ public:
 
 	Object *getObjectByName(const std::string &the_object_name) const;
 	
+	/** Get the objects the federate may delete, sorted by handle. */
 	void
 	getAllObjectInstancesFromFederate(FederateHandle the_federate,std::vector<ObjectHandle>& handles);
 
@@ -173,13 +193,14 @@ protected:
 
     SecurityServer *server ;
     
-	typedef std::map<ObjectHandle,Object*,std::less<ObjectHandle> > Handle2ObjectMap_t;
 	typedef std::map<std::string,Object*,std::less<std::string> > Name2ObjectMap_t; 
 	typedef Handle2ObjectMap_t::const_iterator Handle2ObjectMap_const_iterator; 
 	typedef Name2ObjectMap_t::const_iterator Name2ObjectMap_const_iterator;
     
 	Handle2ObjectMap_t OFromHandle;	
 	Name2ObjectMap_t   OFromName;
+	/* The objects and attributes owned by each federate */
+	OwnershipIndex ownership;
 	/* The message buffer used to send Network messages */
 	MessageBuffer NM_msgBufSend;
 };
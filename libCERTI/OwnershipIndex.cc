@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "OwnershipIndex.hh"
+
+namespace certi {
+
+namespace {
+
+const OwnershipIndex::ObjectList NO_OBJECTS ;
+const OwnershipIndex::AttributeList NO_ATTRIBUTES ;
+
+/** Remove an entry, and the list of the federate once empty. */
+template <typename Index, typename Entry>
+void erase(Index &index, FederateHandle owner, const Entry &entry)
+{
+    typename Index::iterator i = index.find(owner);
+    if (i == index.end())
+        return ;
+    i->second.erase(entry);
+    if (i->second.empty())
+        index.erase(i);
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+void
+OwnershipIndex::addObject(FederateHandle owner, ObjectHandle object)
+{
+    if (owner != 0)
+        objects[owner].insert(object);
+}
+
+// ----------------------------------------------------------------------------
+void
+OwnershipIndex::removeObject(FederateHandle owner, ObjectHandle object)
+{
+    erase(objects, owner, object);
+}
+
+// ----------------------------------------------------------------------------
+void
+OwnershipIndex::addAttribute(FederateHandle owner, ObjectAttribute *attribute)
+{
+    if (owner != 0)
+        attributes[owner].insert(attribute);
+}
+
+// ----------------------------------------------------------------------------
+void
+OwnershipIndex::removeAttribute(FederateHandle owner, ObjectAttribute *attribute)
+{
+    erase(attributes, owner, attribute);
+}
+
+// ----------------------------------------------------------------------------
+const OwnershipIndex::ObjectList &
+OwnershipIndex::getObjects(FederateHandle owner) const
+{
+    std::map<FederateHandle, ObjectList>::const_iterator i = objects.find(owner);
+    return i != objects.end() ? i->second : NO_OBJECTS ;
+}
+
+// ----------------------------------------------------------------------------
+const OwnershipIndex::AttributeList &
+OwnershipIndex::getAttributes(FederateHandle owner) const
+{
+    std::map<FederateHandle, AttributeList>::const_iterator i = attributes.find(owner);
+    return i != attributes.end() ? i->second : NO_ATTRIBUTES ;
+}
+
+} // namespace certi
@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_OWNERSHIP_INDEX_HH
+#define CERTI_OWNERSHIP_INDEX_HH
+
+#include "certi.hh"
+
+#include <map>
+#include <set>
+
+namespace certi {
+
+class ObjectAttribute ;
+
+/**
+ * The object instances and instance attributes owned by each federate.
+ *
+ * The objects of an ObjectSet record in its index the federate holding
+ * their deletion privilege, and their attributes record their owner, each
+ * setOwner call moving the entry from one federate to the other. The
+ * cleanup of a resigning or crashed federate then only visits what it
+ * owns instead of every object of the federation. No entry is kept for
+ * the objects and attributes owned by no federate (handle 0).
+ */
+class CERTI_EXPORT OwnershipIndex
+{
+public:
+    typedef std::set<ObjectHandle> ObjectList ;
+    typedef std::set<ObjectAttribute *> AttributeList ;
+
+    void addObject(FederateHandle owner, ObjectHandle object);
+    void removeObject(FederateHandle owner, ObjectHandle object);
+
+    void addAttribute(FederateHandle owner, ObjectAttribute *attribute);
+    void removeAttribute(FederateHandle owner, ObjectAttribute *attribute);
+
+    /** Objects whose deletion privilege the federate holds, by handle. */
+    const ObjectList &getObjects(FederateHandle owner) const ;
+
+    /** Instance attributes the federate owns. */
+    const AttributeList &getAttributes(FederateHandle owner) const ;
+
+private:
+    std::map<FederateHandle, ObjectList> objects ;
+    std::map<FederateHandle, AttributeList> attributes ;
+};
+
+} // namespace certi
+
+#endif // CERTI_OWNERSHIP_INDEX_HH
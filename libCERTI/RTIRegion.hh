@@ -40,6 +40,8 @@ public:
     virtual SpaceHandle getSpaceHandle() const
         throw ();
 
+    const RoutingSpace &getRoutingSpace() const { return space ; }
+
 protected:
     const RoutingSpace &space ;
 };
@@ -0,0 +1,226 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "RegionIndex.hh"
+#include "BaseRegion.hh"
+#include "Dimension.hh"
+
+#include <algorithm>
+
+namespace certi {
+
+namespace {
+
+/** An extent spanning more cells is kept with the wide ones. */
+const size_t MAX_EXTENT_CELLS = 64 ;
+
+/** A query covering more than this share of the cells tests every region. */
+const size_t QUERY_CELLS_RATIO = 4 ;
+
+void erase(RegionIndex::RegionList &list, const BaseRegion *region)
+{
+    RegionIndex::RegionList::iterator it = std::find(list.begin(), list.end(), region);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+RegionIndex::RegionIndex()
+    : axes(0), cellsPerAxis(0)
+{
+    span[0] = span[1] = 0 ;
+}
+
+// ----------------------------------------------------------------------------
+//! Cut the first (at most two) dimensions into 1024 or 64x64 cells.
+void
+RegionIndex::setAxes(size_t dimensions)
+{
+    axes = std::min(dimensions, static_cast<size_t>(2));
+    cellsPerAxis = axes == 2 ? 64 : 1024 ;
+    cells.resize(axes == 0 ? 0 : (axes == 2 ? 64 * 64 : 1024));
+}
+
+// ----------------------------------------------------------------------------
+unsigned int
+RegionIndex::getCell(uint32_t value) const
+{
+    uint32_t lower = Dimension::getLowerBound();
+    uint32_t upper = Dimension::getUpperBound();
+
+    if (value <= lower || upper <= lower)
+        return 0 ;
+    if (value >= upper)
+        return cellsPerAxis - 1 ;
+    return static_cast<unsigned int>(
+        (static_cast<uint64_t>(value - lower) * cellsPerAxis)
+        / (static_cast<uint64_t>(upper - lower) + 1));
+}
+
+// ----------------------------------------------------------------------------
+/** Get the first and last cells covered by an extent on each axis.
+    @return the number of cells covered, 0 if the extent cannot be indexed
+ */
+size_t
+RegionIndex::getBox(const Extent &extent, unsigned int first[2], unsigned int last[2]) const
+{
+    if (axes == 0 || extent.size() < axes)
+        return 0 ;
+
+    size_t count = 1 ;
+    for (size_t i = 0 ; i < axes ; ++i) {
+        first[i] = getCell(extent.getRangeLowerBound(i + 1));
+        last[i] = getCell(extent.getRangeUpperBound(i + 1));
+        if (last[i] < first[i])
+            return 0 ; // inverted range, left to the exact test
+        count *= last[i] - first[i] + 1 ;
+    }
+    return count ;
+}
+
+// ----------------------------------------------------------------------------
+/** Record a region in the cell of the lower corner of each of its extents.
+    The largest number of cells an extent spans on each axis is kept, for
+    the queries to look back as far as the lower corners of the extents
+    they may overlap.
+ */
+void
+RegionIndex::insert(const BaseRegion *region)
+{
+    remove(region);
+
+    const std::vector<Extent> &extents = region->getExtents();
+    if (cells.empty() && !extents.empty())
+        setAxes(extents.front().size());
+
+    Placement &placement = placements[region] ;
+    unsigned int first[2], last[2], extentSpan[2] = { 0, 0 };
+    for (std::vector<Extent>::const_iterator e = extents.begin(); e != extents.end(); ++e) {
+        size_t count = getBox(*e, first, last);
+        if (count == 0 || count > MAX_EXTENT_CELLS) {
+            placement.wide = true ;
+            break ;
+        }
+        placement.cells.push_back(axes == 1 ? first[0] : first[0] * cellsPerAxis + first[1]);
+        for (size_t i = 0 ; i < axes ; ++i)
+            extentSpan[i] = std::max(extentSpan[i], last[i] - first[i]);
+    }
+
+    if (placement.wide) {
+        placement.cells.clear();
+        wide.push_back(region);
+        return ;
+    }
+    for (size_t i = 0 ; i < axes ; ++i)
+        span[i] = std::max(span[i], extentSpan[i]);
+    std::sort(placement.cells.begin(), placement.cells.end());
+    placement.cells.erase(std::unique(placement.cells.begin(), placement.cells.end()),
+                          placement.cells.end());
+    for (CellList::const_iterator c = placement.cells.begin(); c != placement.cells.end(); ++c)
+        cells[*c].push_back(region);
+}
+
+// ----------------------------------------------------------------------------
+void
+RegionIndex::remove(const BaseRegion *region)
+{
+    std::map<const BaseRegion *, Placement>::iterator p = placements.find(region);
+    if (p == placements.end())
+        return ;
+
+    if (p->second.wide)
+        erase(wide, region);
+    for (CellList::const_iterator c = p->second.cells.begin(); c != p->second.cells.end(); ++c)
+        erase(cells[*c], region);
+    placements.erase(p);
+}
+
+// ----------------------------------------------------------------------------
+void
+RegionIndex::update(BaseRegion *region, const std::vector<Extent> &extents)
+    throw (InvalidExtents)
+{
+    remove(region);
+    try {
+        region->replaceExtents(extents);
+    }
+    catch (InvalidExtents &) {
+        insert(region);
+        throw ;
+    }
+    insert(region);
+}
+
+// ----------------------------------------------------------------------------
+void
+RegionIndex::overlapping(const BaseRegion &region, RegionList &result) const
+{
+    result.clear();
+
+    RegionList candidates ;
+    CellList covered ;
+    const std::vector<Extent> &extents = region.getExtents();
+    bool everything = axes == 0 ;
+    for (std::vector<Extent>::const_iterator e = extents.begin();
+         !everything && e != extents.end(); ++e) {
+        unsigned int first[2], last[2] ;
+        size_t count = getBox(*e, first, last);
+        for (size_t i = 0 ; i < axes && count != 0 ; ++i) {
+            unsigned int back = std::min(first[i], span[i]);
+            count = count / (last[i] - first[i] + 1) * (last[i] - first[i] + back + 1);
+            first[i] -= back ;
+        }
+        if (count == 0 || count > cells.size() / QUERY_CELLS_RATIO) {
+            everything = true ;
+        }
+        else if (axes == 1) {
+            for (unsigned int x = first[0] ; x <= last[0] ; ++x)
+                covered.push_back(x);
+        }
+        else {
+            for (unsigned int x = first[0] ; x <= last[0] ; ++x)
+                for (unsigned int y = first[1] ; y <= last[1] ; ++y)
+                    covered.push_back(x * cellsPerAxis + y);
+        }
+    }
+
+    if (everything) {
+        std::map<const BaseRegion *, Placement>::const_iterator p ;
+        for (p = placements.begin(); p != placements.end(); ++p)
+            candidates.push_back(p->first);
+    }
+    else {
+        for (CellList::const_iterator c = covered.begin(); c != covered.end(); ++c)
+            candidates.insert(candidates.end(), cells[*c].begin(), cells[*c].end());
+        candidates.insert(candidates.end(), wide.begin(), wide.end());
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    for (RegionList::const_iterator c = candidates.begin(); c != candidates.end(); ++c) {
+        if ((*c)->overlaps(region))
+            result.push_back(*c);
+    }
+}
+
+} // namespace certi
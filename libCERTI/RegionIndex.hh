@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_REGION_INDEX_HH
+#define CERTI_REGION_INDEX_HH
+
+#include "certi.hh"
+#include "Exception.hh"
+
+#include <map>
+#include <vector>
+
+namespace certi {
+
+class BaseRegion ;
+class Extent ;
+
+/**
+ * Spatial index of the regions of a routing space, used to find the
+ * regions overlapping an update region without testing every one.
+ *
+ * The axis of the first two dimensions of the space is cut into equal
+ * cells, and each extent of an indexed region is recorded in the cell of
+ * its lower corner. An overlap query only tests the regions found in the
+ * cells covered by the queried region, widened down by the largest span of
+ * the indexed extents. Extents covering too many cells are kept in a
+ * separate list, tested by every query.
+ *
+ * The index does not see the changes of the extents of a region: the
+ * region must be removed before the change and inserted again after it
+ * (see update).
+ */
+class CERTI_EXPORT RegionIndex
+{
+public:
+    typedef std::vector<const BaseRegion *> RegionList ;
+
+    RegionIndex();
+
+    void insert(const BaseRegion *region);
+    void remove(const BaseRegion *region);
+
+    /** Replace the extents of an indexed region and index it again. */
+    void update(BaseRegion *region, const std::vector<Extent> &extents)
+        throw (InvalidExtents);
+
+    /**
+     * Get the indexed regions overlapping the given one.
+     * @param region the region to match, which may not be indexed
+     * @param result the overlapping regions, sorted by address
+     */
+    void overlapping(const BaseRegion &region, RegionList &result) const ;
+
+    /** Number of indexed regions. */
+    size_t size() const { return placements.size(); }
+
+private:
+    typedef std::vector<unsigned int> CellList ;
+
+    /** Where an indexed region is recorded. */
+    struct Placement {
+        Placement() : wide(false) {}
+        CellList cells ;
+        bool wide ;
+    };
+
+    void setAxes(size_t dimensions);
+    size_t getBox(const Extent &extent, unsigned int first[2], unsigned int last[2]) const ;
+    unsigned int getCell(uint32_t value) const ;
+
+    size_t axes ;          //!< Dimensions cut into cells (0 until first use)
+    unsigned int cellsPerAxis ;
+    unsigned int span[2] ; //!< Largest extent span in cells, minus one
+    std::vector<RegionList> cells ;
+    RegionList wide ;
+    std::map<const BaseRegion *, Placement> placements ;
+};
+
+} // namespace certi
+
+#endif // CERTI_REGION_INDEX_HH
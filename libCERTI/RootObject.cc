@@ -37,11 +37,14 @@
 #include "NM_Classes.hh"
 #include "helper.hh"
 #include "NameReservation.hh"
+#include "Snapshot.hh"
 
 #include <string>
 #include <stdio.h>
 #include <cassert>
 #include <algorithm>
+#include <map>
+#include <set>
 
 using std::vector ;
 using std::cout ;
@@ -54,6 +57,53 @@ namespace certi {
 static PrettyDebug D("ROOTOBJECT", "(RootObject) ");
 static PrettyDebug G("GENDOC",__FILE__);
 
+namespace {
+
+// Snapshot sections
+const uint32_t REGIONS_SECTION = 0x5247534e ;        // "RGSN"
+const uint32_t OBJECT_CLASSES_SECTION = 0x4f43534e ; // "OCSN"
+const uint32_t INTERACTIONS_SECTION = 0x4943534e ;   // "ICSN"
+const uint32_t OBJECTS_SECTION = 0x4f42534e ;        // "OBSN"
+
+typedef std::map<RegionHandle, RTIRegion *> RegionMap ;
+
+void
+saveSubscribers(SnapshotWriter &snapshot, const std::list<Subscriber> &subscribers)
+{
+    snapshot.writeUInt32(subscribers.size());
+    for (std::list<Subscriber>::const_iterator s = subscribers.begin(); s != subscribers.end(); ++s) {
+        snapshot.writeUInt32(s->getHandle());
+        snapshot.writeUInt32(s->getRegion() ? s->getRegion()->getHandle() : 0);
+    }
+}
+
+template <typename List>
+void
+saveFederates(SnapshotWriter &snapshot, const List &federates)
+{
+    snapshot.writeUInt32(federates.size());
+    for (typename List::const_iterator f = federates.begin(); f != federates.end(); ++f)
+        snapshot.writeUInt32(*f);
+}
+
+void
+checkRegion(const std::set<RegionHandle> &regions, RegionHandle handle)
+    throw (RTIinternalError)
+{
+    if (handle != 0 && regions.find(handle) == regions.end())
+        throw RTIinternalError(stringize() << "Snapshot refers to unknown region " << handle);
+}
+
+/** Region of a checked snapshot, NULL for the default region. */
+RTIRegion *
+findRegion(const RegionMap &regions, RegionHandle handle)
+{
+    RegionMap::const_iterator r = regions.find(handle);
+    return r == regions.end() ? NULL : r->second ;
+}
+
+} // anonymous namespace
+
 
 RootObject::RootObject(SecurityServer *security_server)
     : server(security_server), regionHandles(1)
@@ -175,6 +225,7 @@ void
 RootObject::addRegion(RTIRegion *region)
 {
     regions.push_back(region);
+    getRoutingSpace(region->getSpaceHandle()).getRegionIndex().insert(region);
 }
 
 // ----------------------------------------------------------------------------
@@ -199,7 +250,7 @@ RootObject::modifyRegion(RegionHandle handle, const std::vector<Extent> &extents
     throw (RegionNotKnown, InvalidExtents)
 {
     RTIRegion *region = getRegion(handle);
-    region->replaceExtents(extents);
+    getRoutingSpace(region->getSpaceHandle()).getRegionIndex().update(region, extents);
 }
 
 // ----------------------------------------------------------------------------
@@ -218,9 +269,11 @@ RootObject::deleteRegion(RegionHandle region_handle)
     if (it == regions.end()) throw RegionNotKnown("");
     else {
 	// TODO: check RegionInUse
-	regions.remove(*it);
-	regionHandles.free((*it)->getHandle());
-	delete *it ;
+	RTIRegion *region = *it ;
+	regions.erase(it);
+	getRoutingSpace(region->getSpaceHandle()).getRegionIndex().remove(region);
+	regionHandles.free(region->getHandle());
+	delete region ;
     }
 }
 
@@ -364,9 +417,343 @@ RootObject::killFederate(FederateHandle the_federate)
 {
     ObjectClasses->killFederate(the_federate);
     Interactions->killFederate(the_federate);
+
+    // Only the instances of the federate are visited, through the
+    // ownership index of the object set.
+    std::vector<ObjectHandle> owned ;
+    objects->getAllObjectInstancesFromFederate(the_federate, owned);
+    for (std::vector<ObjectHandle>::const_iterator i = owned.begin(); i != owned.end(); ++i) {
+        try {
+            ObjectClasses->deleteObject(the_federate, objects->getObject(*i), "Killed");
+        }
+        catch (Exception &e) {
+            D.Out(pdExcept, "Object %u of killed federate %d: %s.", *i, the_federate, e._name);
+        }
+    }
     objects->killFederate(the_federate);
 }
 
+// ----------------------------------------------------------------------------
+void
+RootObject::saveSnapshot(SnapshotWriter &snapshot) const
+    throw (RTIinternalError)
+{
+    snapshot.writeSection(REGIONS_SECTION);
+    snapshot.writeUInt32(regionHandles.getNext());
+    snapshot.writeUInt32(regions.size());
+    for (list<RTIRegion *>::const_iterator r = regions.begin(); r != regions.end(); ++r) {
+        snapshot.writeUInt32((*r)->getHandle());
+        snapshot.writeUInt32((*r)->getSpaceHandle());
+        const vector<Extent> &extents = (*r)->getExtents();
+        snapshot.writeUInt32(extents.size());
+        for (vector<Extent>::const_iterator e = extents.begin(); e != extents.end(); ++e) {
+            snapshot.writeUInt32(e->size());
+            for (DimensionHandle d = 1 ; d <= e->size(); ++d) {
+                snapshot.writeUInt32(e->getRangeLowerBound(d));
+                snapshot.writeUInt32(e->getRangeUpperBound(d));
+            }
+        }
+    }
+
+    // Only the attributes somebody publishes or subscribes to are written,
+    // each list ending with a 0 handle.
+    snapshot.writeSection(OBJECT_CLASSES_SECTION);
+    ObjectClassSet::handled_const_iterator c ;
+    for (c = ObjectClasses->handled_begin(); c != ObjectClasses->handled_end(); ++c) {
+        const ObjectClass::HandleClassAttributeMap &attributes = c->second->getHandleClassAttributeMap();
+        bool declared = false ;
+        ObjectClass::HandleClassAttributeMap::const_iterator a ;
+        for (a = attributes.begin(); a != attributes.end(); ++a) {
+            if (a->second->getPublishers().empty() && a->second->getSubscribers().empty())
+                continue ;
+            if (!declared) {
+                snapshot.writeUInt32(c->first);
+                declared = true ;
+            }
+            snapshot.writeUInt32(a->first);
+            saveFederates(snapshot, a->second->getPublishers());
+            saveSubscribers(snapshot, a->second->getSubscribers());
+        }
+        if (declared)
+            snapshot.writeUInt32(0);
+    }
+    snapshot.writeUInt32(0);
+
+    snapshot.writeSection(INTERACTIONS_SECTION);
+    snapshot.writeUInt32(Interactions->size());
+    InteractionSet::handled_const_iterator i ;
+    for (i = Interactions->handled_begin(); i != Interactions->handled_end(); ++i) {
+        snapshot.writeUInt32(i->first);
+        snapshot.writeUInt32(i->second->transport);
+        snapshot.writeUInt32(i->second->order);
+        saveFederates(snapshot, i->second->getPublishers());
+        saveSubscribers(snapshot, i->second->getSubscribers());
+    }
+
+    snapshot.writeSection(OBJECTS_SECTION);
+    snapshot.writeUInt32(objects->size());
+    for (ObjectSet::const_iterator o = objects->begin(); o != objects->end(); ++o) {
+        const Object *object = o->second ;
+        snapshot.writeUInt32(object->getHandle());
+        snapshot.writeUInt32(object->getClass());
+        snapshot.writeString(object->getName());
+        snapshot.writeUInt32(object->getOwner());
+        const Object::AttributeMap &attributes = object->getAttributes();
+        snapshot.writeUInt32(attributes.size());
+        for (Object::AttributeMap::const_iterator a = attributes.begin(); a != attributes.end(); ++a) {
+            const ObjectAttribute *attribute = a->second ;
+            snapshot.writeUInt32(a->first);
+            snapshot.writeUInt32(attribute->getOwner());
+            snapshot.writeBool(attribute->beingDivested());
+            snapshot.writeUInt32(attribute->getTransport());
+            snapshot.writeUInt32(attribute->getSpace());
+            snapshot.writeUInt32(attribute->getRegion() ? attribute->getRegion()->getHandle() : 0);
+            saveFederates(snapshot, attribute->getCandidates());
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+RootObject::clearSnapshotState()
+{
+    // Declarations first, some subscriptions using the regions.
+    ObjectClassSet::handled_const_iterator c ;
+    for (c = ObjectClasses->handled_begin(); c != ObjectClasses->handled_end(); ++c) {
+        std::set<FederateHandle> federates ;
+        const ObjectClass::HandleClassAttributeMap &attributes = c->second->getHandleClassAttributeMap();
+        ObjectClass::HandleClassAttributeMap::const_iterator a ;
+        for (a = attributes.begin(); a != attributes.end(); ++a) {
+            federates.insert(a->second->getPublishers().begin(), a->second->getPublishers().end());
+            const std::list<Subscriber> &subscribers = a->second->getSubscribers();
+            for (std::list<Subscriber>::const_iterator s = subscribers.begin(); s != subscribers.end(); ++s)
+                federates.insert(s->getHandle());
+        }
+        for (std::set<FederateHandle>::const_iterator f = federates.begin(); f != federates.end(); ++f)
+            c->second->killFederate(*f);
+        c->second->clearInstances();
+    }
+    InteractionSet::handled_const_iterator i ;
+    for (i = Interactions->handled_begin(); i != Interactions->handled_end(); ++i) {
+        std::set<FederateHandle> federates(i->second->getPublishers());
+        const std::list<Subscriber> &subscribers = i->second->getSubscribers();
+        for (std::list<Subscriber>::const_iterator s = subscribers.begin(); s != subscribers.end(); ++s)
+            federates.insert(s->getHandle());
+        for (std::set<FederateHandle>::const_iterator f = federates.begin(); f != federates.end(); ++f)
+            i->second->killFederate(*f);
+    }
+
+    objects->clear();
+
+    for (list<RTIRegion *>::iterator r = regions.begin(); r != regions.end(); ++r) {
+        getRoutingSpace((*r)->getSpaceHandle()).getRegionIndex().remove(*r);
+        delete *r ;
+    }
+    regions.clear();
+}
+
+// ----------------------------------------------------------------------------
+void
+RootObject::readSnapshot(SnapshotReader &snapshot, SnapshotState &state) const
+    throw (RTIinternalError)
+{
+    try {
+        snapshot.readSection(REGIONS_SECTION);
+        state.nextRegion = snapshot.readUInt32();
+        std::set<RegionHandle> knownRegions ;
+        for (uint32_t n = snapshot.readUInt32(); n > 0 ; --n) {
+            SnapshotState::Region region ;
+            region.handle = snapshot.readUInt32();
+            region.space = snapshot.readUInt32();
+            if (region.handle == 0 || !knownRegions.insert(region.handle).second)
+                throw RTIinternalError(stringize() << "Snapshot has an invalid region " << region.handle);
+            if (region.space == 0 || region.space > spaces.size())
+                throw RTIinternalError(stringize() << "Snapshot region " << region.handle
+                                       << " is in unknown space " << region.space);
+            for (uint32_t e = snapshot.readUInt32(); e > 0 ; --e) {
+                uint32_t dimensions = snapshot.readUInt32();
+                if (dimensions != spaces[region.space - 1].size())
+                    throw RTIinternalError(stringize() << "Snapshot region " << region.handle
+                                           << " has extents of another space");
+                Extent extent(dimensions);
+                for (DimensionHandle d = 1 ; d <= extent.size(); ++d) {
+                    extent.setRangeLowerBound(d, snapshot.readUInt32());
+                    extent.setRangeUpperBound(d, snapshot.readUInt32());
+                }
+                region.extents.push_back(extent);
+            }
+            state.regions.push_back(region);
+        }
+
+        snapshot.readSection(OBJECT_CLASSES_SECTION);
+        for (ObjectClassHandle handle = snapshot.readUInt32(); handle != 0 ; handle = snapshot.readUInt32()) {
+            ObjectClass *oc = ObjectClasses->getObjectFromHandle(handle);
+            state.classes.push_back(SnapshotState::Declarations());
+            SnapshotState::Declarations &declarations = state.classes.back();
+            declarations.handle = handle ;
+            for (AttributeHandle a = snapshot.readUInt32(); a != 0 ; a = snapshot.readUInt32()) {
+                oc->getAttribute(a);
+                for (uint32_t n = snapshot.readUInt32(); n > 0 ; --n) {
+                    FederateHandle federate = snapshot.readFederate();
+                    oc->checkFederateAccess(federate, "Restore");
+                    declarations.published[federate].push_back(a);
+                }
+                for (uint32_t n = snapshot.readUInt32(); n > 0 ; --n) {
+                    FederateHandle federate = snapshot.readFederate();
+                    RegionHandle region = snapshot.readUInt32();
+                    checkRegion(knownRegions, region);
+                    oc->checkFederateAccess(federate, "Restore");
+                    declarations.subscribed[std::make_pair(federate, region)].push_back(a);
+                }
+            }
+        }
+
+        snapshot.readSection(INTERACTIONS_SECTION);
+        for (uint32_t n = snapshot.readUInt32(); n > 0 ; --n) {
+            SnapshotState::InteractionState interaction ;
+            interaction.handle = snapshot.readUInt32();
+            Interaction *ic = Interactions->getObjectFromHandle(interaction.handle);
+            interaction.transport = static_cast<TransportType>(snapshot.readUInt32());
+            interaction.order = static_cast<OrderType>(snapshot.readUInt32());
+            for (uint32_t p = snapshot.readUInt32(); p > 0 ; --p) {
+                FederateHandle federate = snapshot.readFederate();
+                ic->checkFederateAccess(federate, "Restore");
+                interaction.publishers.push_back(federate);
+            }
+            for (uint32_t s = snapshot.readUInt32(); s > 0 ; --s) {
+                FederateHandle federate = snapshot.readFederate();
+                RegionHandle region = snapshot.readUInt32();
+                checkRegion(knownRegions, region);
+                interaction.subscribers.push_back(std::make_pair(federate, region));
+            }
+            state.interactions.push_back(interaction);
+        }
+
+        snapshot.readSection(OBJECTS_SECTION);
+        std::set<ObjectHandle> knownObjects ;
+        std::set<std::string> knownNames ;
+        ObjectClass *oc = NULL ;
+        for (uint32_t n = snapshot.readUInt32(); n > 0 ; --n) {
+            state.objects.push_back(SnapshotState::ObjectState());
+            SnapshotState::ObjectState &object = state.objects.back();
+            object.handle = snapshot.readUInt32();
+            object.objectClass = snapshot.readUInt32();
+            object.name = snapshot.readString();
+            object.owner = snapshot.readFederate();
+            // Names are given as ObjectSet::registerObjectInstance does.
+            std::string name = object.name ;
+            if (name.empty())
+                name = stringize() << "HLAobject_" << object.handle ;
+            if (!knownObjects.insert(object.handle).second || !knownNames.insert(name).second)
+                throw RTIinternalError(stringize() << "Snapshot registers object " << object.handle
+                                       << " <" << name << "> twice");
+
+            if (oc == NULL || oc->getHandle() != object.objectClass)
+                oc = ObjectClasses->getObjectFromHandle(object.objectClass);
+            for (uint32_t a = snapshot.readUInt32(); a > 0 ; --a) {
+                object.attributes.push_back(SnapshotState::AttributeState());
+                SnapshotState::AttributeState &attribute = object.attributes.back();
+                attribute.handle = snapshot.readUInt32();
+                oc->getAttribute(attribute.handle);
+                attribute.owner = snapshot.readFederate();
+                attribute.divesting = snapshot.readBool();
+                attribute.transport = static_cast<TransportType>(snapshot.readUInt32());
+                attribute.space = snapshot.readUInt32();
+                attribute.region = snapshot.readUInt32();
+                checkRegion(knownRegions, attribute.region);
+                for (uint32_t c = snapshot.readUInt32(); c > 0 ; --c)
+                    attribute.candidates.push_back(snapshot.readFederate());
+            }
+        }
+    }
+    catch (RTIinternalError &) {
+        throw ;
+    }
+    catch (Exception &e) {
+        throw RTIinternalError(stringize() << "Invalid snapshot: " << e._name << " " << e._reason);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+RootObject::applySnapshot(const SnapshotState &state)
+{
+    // Every handle, region and access used below was checked by
+    // readSnapshot: nothing throws once the current state is cleared.
+    clearSnapshotState();
+
+    regionHandles.setNext(state.nextRegion);
+    RegionMap regionMap ;
+    vector<SnapshotState::Region>::const_iterator r ;
+    for (r = state.regions.begin(); r != state.regions.end(); ++r) {
+        RTIRegion *region = new RTIRegion(r->handle, getRoutingSpace(r->space), r->extents.size());
+        region->replaceExtents(r->extents);
+        addRegion(region);
+        regionMap[r->handle] = region ;
+    }
+
+    // The declarations are made again a federate at a time, as the
+    // federates made them, for the classes to update their routes.
+    vector<SnapshotState::Declarations>::const_iterator c ;
+    for (c = state.classes.begin(); c != state.classes.end(); ++c) {
+        ObjectClass *oc = ObjectClasses->getObjectFromHandle(c->handle);
+        std::map<FederateHandle, vector<AttributeHandle> >::const_iterator p ;
+        for (p = c->published.begin(); p != c->published.end(); ++p)
+            oc->publish(p->first, p->second, true);
+        std::map<SnapshotState::Subscription, vector<AttributeHandle> >::const_iterator s ;
+        for (s = c->subscribed.begin(); s != c->subscribed.end(); ++s)
+            oc->subscribe(s->first.first, s->second, findRegion(regionMap, s->first.second));
+    }
+
+    vector<SnapshotState::InteractionState>::const_iterator i ;
+    for (i = state.interactions.begin(); i != state.interactions.end(); ++i) {
+        Interaction *interaction = Interactions->getObjectFromHandle(i->handle);
+        interaction->transport = i->transport ;
+        interaction->order = i->order ;
+        for (vector<FederateHandle>::const_iterator p = i->publishers.begin(); p != i->publishers.end(); ++p)
+            interaction->publish(*p);
+        vector<SnapshotState::Subscription>::const_iterator s ;
+        for (s = i->subscribers.begin(); s != i->subscribers.end(); ++s)
+            interaction->subscribe(s->first, findRegion(regionMap, s->second));
+    }
+
+    ObjectClass *oc = NULL ;
+    vector<SnapshotState::ObjectState>::const_iterator o ;
+    for (o = state.objects.begin(); o != state.objects.end(); ++o) {
+        if (oc == NULL || oc->getHandle() != o->objectClass)
+            oc = ObjectClasses->getObjectFromHandle(o->objectClass);
+        Object *object = objects->registerObjectInstance(o->owner, o->objectClass, o->handle, o->name);
+        oc->addInstance(o->owner, object);
+
+        vector<SnapshotState::AttributeState>::const_iterator a ;
+        for (a = o->attributes.begin(); a != o->attributes.end(); ++a) {
+            ObjectAttribute *attribute = object->getAttribute(a->handle);
+            attribute->setOwner(a->owner);
+            attribute->setDivesting(a->divesting);
+            attribute->setTransport(a->transport);
+            attribute->setSpace(a->space);
+            RTIRegion *region = findRegion(regionMap, a->region);
+            if (region != NULL)
+                attribute->associate(region);
+            for (vector<FederateHandle>::const_iterator f = a->candidates.begin(); f != a->candidates.end(); ++f)
+                attribute->addCandidate(*f);
+        }
+    }
+
+    D.Out(pdRegister, "Snapshot restored: %u regions, %u objects.",
+          static_cast<unsigned>(regions.size()), static_cast<unsigned>(objects->size()));
+}
+
+// ----------------------------------------------------------------------------
+void
+RootObject::restoreSnapshot(SnapshotReader &snapshot)
+    throw (RTIinternalError)
+{
+    SnapshotState state ;
+    readSnapshot(snapshot, state);
+    applySnapshot(state);
+}
+
 // ----------------------------------------------------------------------------
 // getObjectClassAttribute
 ObjectClassAttribute *
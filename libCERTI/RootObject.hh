@@ -37,6 +37,8 @@ namespace certi {
    class InteractionSet;
    class RTIRegion;
    class RoutingSpace;
+   class SnapshotReader;
+   class SnapshotWriter;
    class NM_Join_Federation_Execution;
 }  // namespace certi
 
@@ -46,6 +48,8 @@ namespace certi {
 #include "RoutingSpace.hh"
 #include "NameReservation.hh"
 
+#include <map>
+#include <string>
 #include <vector>
 
 namespace certi {
@@ -129,6 +133,77 @@ public:
 
     void killFederate(FederateHandle) throw (RTIinternalError);
 
+    /**
+     * Write the regions, the publications and subscriptions, and the
+     * object instances with the state of their attributes.
+     */
+    void saveSnapshot(SnapshotWriter &snapshot) const throw (RTIinternalError);
+
+    /**
+     * Content of a snapshot written by saveSnapshot, read and checked
+     * against the federation by readSnapshot before applySnapshot
+     * replaces anything.
+     */
+    struct SnapshotState {
+        struct Region {
+            RegionHandle handle ;
+            SpaceHandle space ;
+            std::vector<Extent> extents ;
+        };
+        typedef std::pair<FederateHandle, RegionHandle> Subscription ;
+        struct Declarations {
+            ObjectClassHandle handle ;
+            std::map<FederateHandle, std::vector<AttributeHandle> > published ;
+            std::map<Subscription, std::vector<AttributeHandle> > subscribed ;
+        };
+        struct InteractionState {
+            InteractionClassHandle handle ;
+            TransportType transport ;
+            OrderType order ;
+            std::vector<FederateHandle> publishers ;
+            std::vector<Subscription> subscribers ;
+        };
+        struct AttributeState {
+            AttributeHandle handle ;
+            FederateHandle owner ;
+            bool divesting ;
+            TransportType transport ;
+            SpaceHandle space ;
+            RegionHandle region ;
+            std::vector<FederateHandle> candidates ;
+        };
+        struct ObjectState {
+            ObjectHandle handle ;
+            ObjectClassHandle objectClass ;
+            std::string name ;
+            FederateHandle owner ;
+            std::vector<AttributeState> attributes ;
+        };
+
+        RegionHandle nextRegion ;
+        std::vector<Region> regions ;
+        std::vector<Declarations> classes ;
+        std::vector<InteractionState> interactions ;
+        std::vector<ObjectState> objects ;
+    };
+
+    /**
+     * Read the sections written by saveSnapshot, checking that every
+     * class, attribute, region and access they refer to is valid here.
+     * Nothing is changed.
+     */
+    void readSnapshot(SnapshotReader &snapshot, SnapshotState &state) const
+        throw (RTIinternalError);
+
+    /**
+     * Replace the regions, declarations and instances by those of a
+     * snapshot checked by readSnapshot, without sending any message.
+     */
+    void applySnapshot(const SnapshotState &state);
+
+    /** Read a snapshot and apply it: nothing is changed if it is invalid. */
+    void restoreSnapshot(SnapshotReader &snapshot) throw (RTIinternalError);
+
     // Access to elements of the RootObject hierarchy
     ObjectAttribute*      getObjectAttribute(ObjectHandle, AttributeHandle);
     ObjectClass*          getObjectClass(ObjectClassHandle);
@@ -189,6 +264,9 @@ public:
 
 private:
 
+    /** Remove the regions, declarations and instances, without any message. */
+    void clearSnapshotState();
+
     std::vector<RoutingSpace> spaces;
     /**
      * The associated socket server.
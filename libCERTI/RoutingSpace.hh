@@ -31,6 +31,7 @@
 #include "Handled.hh"
 #include "Extent.hh"
 #include "Named.hh"
+#include "RegionIndex.hh"
 
 // Standard headers
 #include <vector>
@@ -88,8 +89,13 @@ public:
 
     const std::vector<Dimension>& getDimensions() const { return dimensions; }
 
+    /** The index of the regions created in this space. */
+    RegionIndex &getRegionIndex() { return regionIndex ; }
+    const RegionIndex &getRegionIndex() const { return regionIndex ; }
+
 private:
     std::vector<Dimension> dimensions ;
+    RegionIndex regionIndex ;
 };
 
 } // namespace certi
@@ -0,0 +1,215 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "SHMLink.hh"
+#include "PrettyDebug.hh"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace certi {
+
+static PrettyDebug D("SHMLINK", "(SHMLink) ");
+
+namespace {
+const size_t MIN_CAPACITY = 4096 ;
+const size_t CACHE_LINE = 64 ;
+}
+
+/** Ring positions, each on its own cache line. The data follows the headers. */
+struct SHMLink::Ring {
+    uint64_t head ;                     // written by the producer
+    char headPad[CACHE_LINE - sizeof(uint64_t)];
+    uint64_t tail ;                     // written by the consumer
+    char tailPad[CACHE_LINE - sizeof(uint64_t)];
+    uint32_t waiting ;                  // set by the consumer
+    uint32_t capacity ;                 // set once by the creator
+    char waitingPad[CACHE_LINE - 2 * sizeof(uint32_t)];
+};
+
+// ----------------------------------------------------------------------------
+size_t
+SHMLink::segmentSize(size_t capacity)
+{
+    return 2 * sizeof(Ring) + 2 * capacity ;
+}
+
+// ----------------------------------------------------------------------------
+int
+SHMLink::create(size_t ringSize)
+{
+    size_t capacity = MIN_CAPACITY ;
+    while (capacity < ringSize)
+        capacity *= 2 ;
+
+    static unsigned int counter = 0 ;
+    std::ostringstream name ;
+    name << "/certi-link-" << getpid() << "-" << counter++ ;
+
+    int fd = shm_open(name.str().c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+        D.Out(pdError, "Cannot create shared memory segment %s.", name.str().c_str());
+        return -1 ;
+    }
+    // Only the file descriptor gives access to the segment from now on.
+    shm_unlink(name.str().c_str());
+
+    if (ftruncate(fd, segmentSize(capacity)) == -1) {
+        D.Out(pdError, "Cannot size shared memory segment to %lu bytes.", segmentSize(capacity));
+        close(fd);
+        return -1 ;
+    }
+
+    void *header = mmap(NULL, sizeof(Ring), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (header == MAP_FAILED) {
+        close(fd);
+        return -1 ;
+    }
+    Ring *first = static_cast<Ring *>(header);
+    first->capacity = capacity ;
+    munmap(header, sizeof(Ring));
+
+    D.Out(pdInit, "Created shared memory link with rings of %lu bytes.", capacity);
+    return fd ;
+}
+
+// ----------------------------------------------------------------------------
+SHMLink::SHMLink(int fd, bool creator)
+    : segment(NULL), length(0), out(NULL), in(NULL), outData(NULL), inData(NULL)
+{
+    struct stat status ;
+    if (fstat(fd, &status) == -1 || static_cast<size_t>(status.st_size) < segmentSize(MIN_CAPACITY)) {
+        D.Out(pdError, "Invalid shared memory segment %d.", fd);
+        return ;
+    }
+    void *address = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        D.Out(pdError, "Cannot map shared memory segment %d.", fd);
+        return ;
+    }
+
+    Ring *first = static_cast<Ring *>(address);
+    Ring *second = first + 1 ;
+    size_t capacity = first->capacity ;
+    if (segmentSize(capacity) != static_cast<size_t>(status.st_size)) {
+        D.Out(pdError, "Inconsistent shared memory segment %d.", fd);
+        munmap(address, status.st_size);
+        return ;
+    }
+    second->capacity = capacity ;
+
+    segment = address ;
+    length = status.st_size ;
+    unsigned char *firstData = reinterpret_cast<unsigned char *>(second + 1);
+    unsigned char *secondData = firstData + capacity ;
+    out = creator ? first : second ;
+    in = creator ? second : first ;
+    outData = creator ? firstData : secondData ;
+    inData = creator ? secondData : firstData ;
+}
+
+// ----------------------------------------------------------------------------
+SHMLink::~SHMLink()
+{
+    if (segment != NULL)
+        munmap(segment, length);
+}
+
+// ----------------------------------------------------------------------------
+size_t
+SHMLink::write(const unsigned char *buffer, size_t size)
+{
+    const uint64_t capacity = out->capacity ;
+    const uint64_t head = out->head ;
+    const uint64_t tail = __atomic_load_n(&out->tail, __ATOMIC_ACQUIRE);
+
+    size_t count = std::min<uint64_t>(size, capacity - (head - tail));
+    if (count == 0)
+        return 0 ;
+
+    size_t offset = head & (capacity - 1);
+    size_t first = std::min<size_t>(count, capacity - offset);
+    memcpy(outData + offset, buffer, first);
+    memcpy(outData, buffer + first, count - first);
+
+    __atomic_store_n(&out->head, head + count, __ATOMIC_RELEASE);
+    return count ;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+SHMLink::read(unsigned char *buffer, size_t size)
+{
+    const uint64_t capacity = in->capacity ;
+    const uint64_t tail = in->tail ;
+    const uint64_t head = __atomic_load_n(&in->head, __ATOMIC_ACQUIRE);
+
+    size_t count = std::min<uint64_t>(size, head - tail);
+    if (count == 0)
+        return 0 ;
+
+    size_t offset = tail & (capacity - 1);
+    size_t first = std::min<size_t>(count, capacity - offset);
+    memcpy(buffer, inData + offset, first);
+    memcpy(buffer + first, inData, count - first);
+
+    __atomic_store_n(&in->tail, tail + count, __ATOMIC_RELEASE);
+    return count ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+SHMLink::isReadable() const
+{
+    return __atomic_load_n(&in->head, __ATOMIC_SEQ_CST) != in->tail ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+SHMLink::peerWaiting()
+{
+    // Orders the head update before the flag test, see setWaiting.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return __atomic_load_n(&out->waiting, __ATOMIC_RELAXED) != 0
+        && __atomic_exchange_n(&out->waiting, 0, __ATOMIC_SEQ_CST) != 0 ;
+}
+
+// ----------------------------------------------------------------------------
+void
+SHMLink::setWaiting()
+{
+    // Either the producer sees the flag after its write, or the caller
+    // sees the written data when checking the ring after this call.
+    __atomic_store_n(&in->waiting, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+// ----------------------------------------------------------------------------
+bool
+SHMLink::clearWaiting()
+{
+    return __atomic_exchange_n(&in->waiting, 0, __ATOMIC_SEQ_CST) != 0 ;
+}
+
+} // namespace certi
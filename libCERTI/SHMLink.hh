@@ -0,0 +1,96 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_SHM_LINK_HH
+#define CERTI_SHM_LINK_HH
+
+#include "certi.hh"
+
+#include <cstddef>
+
+namespace certi {
+
+/**
+ * Shared memory segment holding the two byte rings of a federate/RTIA link.
+ *
+ * Each ring has a single producer and a single consumer: the side which
+ * created the segment writes to the first ring and reads from the second,
+ * its peer does the opposite. Positions are free running 64 bits counters
+ * updated with atomic loads and stores, so that no lock nor system call is
+ * needed while both sides keep up with each other.
+ *
+ * A consumer about to sleep sets the waiting flag of its ring. The producer
+ * which takes the flag back after a write has to wake the consumer up, which
+ * SocketUN does by writing one byte on the socket the link doubles.
+ */
+class CERTI_EXPORT SHMLink
+{
+public:
+    /** Create an anonymous segment whose rings hold at least ringSize bytes.
+     *  @return the segment file descriptor to give to the peer, -1 on error
+     */
+    static int create(size_t ringSize);
+
+    /** Map the segment, as its creator or as the peer. */
+    SHMLink(int fd, bool creator);
+    ~SHMLink();
+
+    bool isMapped() const { return segment != NULL ; }
+
+    /** Copy at most size bytes to the outgoing ring.
+     *  @return the number of bytes copied, 0 if the ring is full
+     */
+    size_t write(const unsigned char *buffer, size_t size);
+
+    /** Copy at most size bytes from the incoming ring.
+     *  @return the number of bytes copied, 0 if the ring is empty
+     */
+    size_t read(unsigned char *buffer, size_t size);
+
+    bool isReadable() const ;
+
+    /** Take back the waiting flag of the outgoing ring, after a write.
+     *  @return true if the peer is asleep and has to be woken up
+     */
+    bool peerWaiting();
+
+    /** Set the waiting flag of the incoming ring, before sleeping. */
+    void setWaiting();
+
+    /** Take back the waiting flag of the incoming ring.
+     *  @return false if the producer already took it, and thus wakes us up
+     */
+    bool clearWaiting();
+
+private:
+    struct Ring ;
+
+    static size_t segmentSize(size_t capacity);
+
+    void *segment ;
+    size_t length ;
+    Ring *out ;
+    Ring *in ;
+    unsigned char *outData ;
+    unsigned char *inData ;
+};
+
+} // namespace certi
+
+#endif // CERTI_SHM_LINK_HH
@@ -0,0 +1,347 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "Snapshot.hh"
+#include "PrettyDebug.hh"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <cstring>
+
+namespace certi {
+
+static PrettyDebug D("SNAPSHOT", "(Snapshot) ");
+
+namespace {
+
+const char MAGIC[8] = { 'C', 'E', 'R', 'T', 'I', 'S', 'N', 'P' };
+const uint32_t BYTE_ORDER_MARK = 0x01020304 ;
+const size_t BUFFER_SIZE = 64 * 1024 ;
+
+} // anonymous namespace
+
+const uint32_t SnapshotWriter::FORMAT_VERSION ;
+
+// ----------------------------------------------------------------------------
+SnapshotWriter::SnapshotWriter()
+    : buffer(BUFFER_SIZE), used(0), size(0), file(NULL)
+{
+}
+
+// ----------------------------------------------------------------------------
+SnapshotWriter::~SnapshotWriter()
+{
+    if (file != NULL)
+        fclose(file);
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::open(const std::string &the_filename)
+    throw (RTIinternalError)
+{
+    filename = the_filename ;
+    file = fopen(filename.c_str(), "wb");
+    if (file == NULL)
+        throw RTIinternalError(stringize() << "Cannot create snapshot <" << filename << ">");
+    used = 0 ;
+    size = 0 ;
+
+    write(MAGIC, sizeof(MAGIC));
+    writeUInt32(FORMAT_VERSION);
+    writeUInt32(BYTE_ORDER_MARK);
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::close()
+    throw (RTIinternalError)
+{
+    if (file == NULL)
+        return ;
+    flush();
+    int status = fclose(file);
+    file = NULL ;
+    if (status != 0)
+        throw RTIinternalError(stringize() << "Cannot write snapshot <" << filename << ">");
+    D.Out(pdDebug, "Snapshot %s: %lu bytes written.", filename.c_str(),
+          static_cast<unsigned long>(size));
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::flush()
+    throw (RTIinternalError)
+{
+    if (used > 0 && fwrite(&buffer[0], 1, used, file) != used)
+        throw RTIinternalError(stringize() << "Cannot write snapshot <" << filename << ">");
+    used = 0 ;
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::write(const void *data, size_t length)
+    throw (RTIinternalError)
+{
+    if (file == NULL)
+        throw RTIinternalError("Snapshot not open");
+    size += length ;
+    const char *bytes = static_cast<const char *>(data);
+    while (used + length > buffer.size()) {
+        size_t part = buffer.size() - used ;
+        memcpy(&buffer[used], bytes, part);
+        used += part ;
+        bytes += part ;
+        length -= part ;
+        flush();
+    }
+    memcpy(&buffer[used], bytes, length);
+    used += length ;
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::writeSection(uint32_t tag)
+    throw (RTIinternalError)
+{
+    writeUInt32(tag);
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::writeBool(bool value)
+    throw (RTIinternalError)
+{
+    unsigned char byte = value ? 1 : 0 ;
+    write(&byte, 1);
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::writeUInt32(uint32_t value)
+    throw (RTIinternalError)
+{
+    write(&value, sizeof(value));
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::writeUInt64(uint64_t value)
+    throw (RTIinternalError)
+{
+    write(&value, sizeof(value));
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::writeDouble(double value)
+    throw (RTIinternalError)
+{
+    uint64_t bits ;
+    memcpy(&bits, &value, sizeof(bits));
+    writeUInt64(bits);
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotWriter::writeString(const std::string &value)
+    throw (RTIinternalError)
+{
+    writeUInt32(value.size());
+    write(value.data(), value.size());
+}
+
+// ----------------------------------------------------------------------------
+SnapshotReader::SnapshotReader()
+    : data(NULL), length(0), position(0), swapped(false), mapped(false)
+{
+}
+
+// ----------------------------------------------------------------------------
+SnapshotReader::~SnapshotReader()
+{
+    close();
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotReader::open(const std::string &the_filename)
+    throw (RTIinternalError)
+{
+    close();
+    filename = the_filename ;
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw RTIinternalError(stringize() << "Cannot open snapshot <" << filename << ">");
+    struct stat status ;
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+        void *address = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            data = static_cast<const char *>(address);
+            length = status.st_size ;
+            mapped = true ;
+        }
+    }
+    ::close(fd);
+#endif
+
+    if (!mapped) {
+        FILE *file = fopen(filename.c_str(), "rb");
+        if (file == NULL)
+            throw RTIinternalError(stringize() << "Cannot open snapshot <" << filename << ">");
+        char chunk[BUFSIZ];
+        size_t n ;
+        while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            copy.insert(copy.end(), chunk, chunk + n);
+        fclose(file);
+        data = copy.empty() ? NULL : &copy[0] ;
+        length = copy.size();
+    }
+    position = 0 ;
+
+    if (length < sizeof(MAGIC) || memcmp(read(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0)
+        throw RTIinternalError(stringize() << "<" << filename << "> is not a CERTI snapshot");
+    uint32_t version = readUInt32();
+    uint32_t mark = readUInt32();
+    if (mark != BYTE_ORDER_MARK) {
+        swapped = true ;
+        version = CERTI_UINT32_SWAP_BYTES(version);
+    }
+    if (version != SnapshotWriter::FORMAT_VERSION)
+        throw RTIinternalError(stringize() << "Snapshot <" << filename << "> has version "
+                               << version << ", " << SnapshotWriter::FORMAT_VERSION << " expected");
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotReader::close()
+{
+#ifndef _WIN32
+    if (mapped)
+        munmap(const_cast<char *>(data), length);
+#endif
+    mapped = false ;
+    swapped = false ;
+    copy.clear();
+    data = NULL ;
+    length = position = 0 ;
+    federates.clear();
+}
+
+// ----------------------------------------------------------------------------
+const void *
+SnapshotReader::read(size_t size)
+    throw (RTIinternalError)
+{
+    if (size > length - position)
+        throw RTIinternalError(stringize() << "Snapshot <" << filename << "> is truncated");
+    const void *bytes = data + position ;
+    position += size ;
+    return bytes ;
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotReader::readSection(uint32_t tag)
+    throw (RTIinternalError)
+{
+    uint32_t found = readUInt32();
+    if (found != tag)
+        throw RTIinternalError(stringize() << "Snapshot <" << filename << "> is corrupted: section "
+                               << found << " instead of " << tag);
+}
+
+// ----------------------------------------------------------------------------
+bool
+SnapshotReader::readBool()
+    throw (RTIinternalError)
+{
+    return *static_cast<const unsigned char *>(read(1)) != 0 ;
+}
+
+// ----------------------------------------------------------------------------
+uint32_t
+SnapshotReader::readUInt32()
+    throw (RTIinternalError)
+{
+    uint32_t value ;
+    memcpy(&value, read(sizeof(value)), sizeof(value));
+    return swapped ? CERTI_UINT32_SWAP_BYTES(value) : value ;
+}
+
+// ----------------------------------------------------------------------------
+uint64_t
+SnapshotReader::readUInt64()
+    throw (RTIinternalError)
+{
+    uint64_t value ;
+    memcpy(&value, read(sizeof(value)), sizeof(value));
+    return swapped ? CERTI_UINT64_SWAP_BYTES(value) : value ;
+}
+
+// ----------------------------------------------------------------------------
+double
+SnapshotReader::readDouble()
+    throw (RTIinternalError)
+{
+    uint64_t bits = readUInt64();
+    double value ;
+    memcpy(&value, &bits, sizeof(value));
+    return value ;
+}
+
+// ----------------------------------------------------------------------------
+std::string
+SnapshotReader::readString()
+    throw (RTIinternalError)
+{
+    uint32_t size = readUInt32();
+    const char *chars = static_cast<const char *>(read(size));
+    return std::string(chars, size);
+}
+
+// ----------------------------------------------------------------------------
+void
+SnapshotReader::mapFederate(FederateHandle saved, FederateHandle current)
+{
+    federates[saved] = current ;
+}
+
+// ----------------------------------------------------------------------------
+FederateHandle
+SnapshotReader::readFederate()
+    throw (RTIinternalError)
+{
+    FederateHandle saved = readUInt32();
+    if (saved == 0 || federates.empty())
+        return saved ;
+    std::map<FederateHandle, FederateHandle>::const_iterator i = federates.find(saved);
+    if (i == federates.end())
+        throw RTIinternalError(stringize() << "Snapshot <" << filename
+                               << "> refers to unknown federate " << saved);
+    return i->second ;
+}
+
+} // namespace certi
@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_SNAPSHOT_HH
+#define CERTI_SNAPSHOT_HH
+
+#include "certi.hh"
+#include "Exception.hh"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace certi {
+
+/**
+ * Binary snapshot of the state of a federation, written by the RTIG when
+ * a federation save succeeds and read back on a federation restore.
+ *
+ * A snapshot starts with a header (magic, format version, byte order
+ * mark) followed by tagged sections. The values are written in the byte
+ * order of the writer and swapped by a reader of the other byte order.
+ * Strings are written as a 32 bits length followed by their characters.
+ */
+class CERTI_EXPORT SnapshotWriter
+{
+public:
+    /** Version of the snapshot format, checked by SnapshotReader. */
+    static const uint32_t FORMAT_VERSION = 1 ;
+
+    SnapshotWriter();
+    ~SnapshotWriter();
+
+    /** Create the file and write the header. */
+    void open(const std::string &filename) throw (RTIinternalError);
+
+    /** Write what is still buffered and close the file. */
+    void close() throw (RTIinternalError);
+
+    void writeSection(uint32_t tag) throw (RTIinternalError);
+    void writeBool(bool value) throw (RTIinternalError);
+    void writeUInt32(uint32_t value) throw (RTIinternalError);
+    void writeUInt64(uint64_t value) throw (RTIinternalError);
+    void writeDouble(double value) throw (RTIinternalError);
+    void writeString(const std::string &value) throw (RTIinternalError);
+
+    /** Number of bytes written so far, header included. */
+    uint64_t getSize() const { return size ; }
+
+private:
+    void write(const void *data, size_t length) throw (RTIinternalError);
+    void flush() throw (RTIinternalError);
+
+    /**
+     * The values are streamed to the file through this fixed size buffer,
+     * no image of the whole snapshot being built in memory.
+     */
+    std::vector<char> buffer ;
+    size_t used ;
+    uint64_t size ;
+    FILE *file ;
+    std::string filename ;
+};
+
+/**
+ * Reader of a snapshot written by SnapshotWriter. The file is mapped in
+ * memory where possible, and read at once otherwise.
+ *
+ * The handles of the federates may differ from those they had when the
+ * snapshot was written: mapFederate records the handle a saved federate
+ * has now, and readFederate translates the saved handles read.
+ */
+class CERTI_EXPORT SnapshotReader
+{
+public:
+    SnapshotReader();
+    ~SnapshotReader();
+
+    /** Map the file and check its header. */
+    void open(const std::string &filename) throw (RTIinternalError);
+    void close();
+
+    /** Check that the next section is the expected one. */
+    void readSection(uint32_t tag) throw (RTIinternalError);
+    bool readBool() throw (RTIinternalError);
+    uint32_t readUInt32() throw (RTIinternalError);
+    uint64_t readUInt64() throw (RTIinternalError);
+    double readDouble() throw (RTIinternalError);
+    std::string readString() throw (RTIinternalError);
+
+    /** True once every byte of the snapshot has been read. */
+    bool atEnd() const { return position == length ; }
+
+    void mapFederate(FederateHandle saved, FederateHandle current);
+
+    /**
+     * Return the current handle of a saved federate, read from the
+     * snapshot. Without any mapFederate call, the handles are kept.
+     */
+    FederateHandle readFederate() throw (RTIinternalError);
+
+private:
+    const void *read(size_t size) throw (RTIinternalError);
+
+    const char *data ;
+    size_t length ;
+    size_t position ;
+    bool swapped ; //!< Snapshot written with the other byte order
+    bool mapped ;  //!< data is a mapping of the file, not a copy
+    std::vector<char> copy ;
+    std::string filename ;
+    std::map<FederateHandle, FederateHandle> federates ;
+};
+
+} // namespace certi
+
+#endif // CERTI_SNAPSHOT_HH
@@ -60,6 +60,10 @@ public:
     virtual void createConnection(const char *server_name, unsigned int port)
         throw (NetworkError) = 0;
     virtual void send(const unsigned char *, size_t) = 0;
+    /** Send a message which may be lost, as a best effort one: the socket
+        may drop it rather than wait for a slow peer. */
+    virtual void sendBestEffort(const unsigned char *buffer, size_t size)
+        { send(buffer, size); }
     virtual void receive(void *Buffer, unsigned long Size) = 0 ;
     virtual void close() = 0 ;
 
@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#include "config.h"
+#include "SocketPoller.hh"
+#include "SocketPollerSelect.hh"
+#ifdef HAVE_SYS_EPOLL_H
+#include "SocketPollerEpoll.hh"
+#endif
+#include "PrettyDebug.hh"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace certi {
+
+static PrettyDebug D("SOCKPOLL", "(SocketPoller) - ");
+
+// ----------------------------------------------------------------------------
+SocketPoller *
+SocketPoller::create()
+{
+    const char *wanted = getenv("CERTI_POLLER");
+
+#ifdef HAVE_SYS_EPOLL_H
+    if (NULL == wanted || strcmp(wanted, "epoll") == 0) {
+        try {
+            return new SocketPollerEpoll();
+        }
+        catch (NetworkError &e) {
+            D.Out(pdExcept, "epoll unavailable (%s), falling back to select.",
+                  e._reason.c_str());
+        }
+    }
+#else
+    if (NULL != wanted && strcmp(wanted, "epoll") == 0) {
+        D.Out(pdExcept, "epoll not supported on this host, using select.");
+    }
+#endif
+    return new SocketPollerSelect();
+}
+
+} // namespace certi
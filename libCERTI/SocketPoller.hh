@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_SOCKET_POLLER_HH
+#define CERTI_SOCKET_POLLER_HH
+
+#include "certi.hh"
+#include "Socket.hh"
+
+#include <vector>
+
+namespace certi {
+
+/**
+ * Readiness notification interface used by the RTIG event loop.
+ *
+ * A poller keeps the set of descriptors it watches between calls so that
+ * the event loop does not have to rebuild it on every iteration, and
+ * wait() reports every ready descriptor at once so that all of them may be
+ * serviced during the same wakeup.
+ *
+ * Two implementations are provided:
+ *   - SocketPollerSelect, portable, limited to FD_SETSIZE descriptors;
+ *   - SocketPollerEpoll, Linux only, with no descriptor limit and a wait
+ *     cost which only depends on the number of ready descriptors.
+ * @sa SocketPoller::create
+ */
+class CERTI_EXPORT SocketPoller
+{
+public:
+    virtual ~SocketPoller() {}
+
+    /** Start watching the given descriptor for readability. */
+    virtual void add(SOCKET fd) throw (NetworkError) = 0 ;
+
+    /** Stop watching the given descriptor (unknown descriptors are ignored). */
+    virtual void remove(SOCKET fd) = 0 ;
+
+    /** Watch a descriptor added before for writability as well, or stop
+        doing so: a link with queued output asks to be reported writable. */
+    virtual void watchOutput(SOCKET fd, bool watch) = 0 ;
+
+    /**
+     * Wait until at least one watched descriptor is readable, or writable
+     * if so asked.
+     * @param[out] ready the ready descriptors (previous content is cleared)
+     * @param[in] timeout_ms maximum wait in milliseconds, -1 waits forever
+     * @return the number of ready descriptors, 0 on timeout
+     * @exception NetworkSignal if the wait was interrupted by a signal
+     * @exception NetworkError on any other failure
+     */
+    virtual int wait(std::vector<SOCKET> &ready, int timeout_ms)
+        throw (NetworkError, NetworkSignal) = 0 ;
+
+    /** The name of the underlying mechanism ("select", "epoll"). */
+    virtual const char *getName() const = 0 ;
+
+    /**
+     * Build the best poller available on this host.
+     * The choice may be forced with the CERTI_POLLER environment
+     * variable ("select" or "epoll").
+     */
+    static SocketPoller *create();
+};
+
+} // namespace certi
+
+#endif // CERTI_SOCKET_POLLER_HH
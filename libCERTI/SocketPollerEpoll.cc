@@ -0,0 +1,116 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#include "SocketPollerEpoll.hh"
+#include "PrettyDebug.hh"
+
+#include <unistd.h>
+
+namespace certi {
+
+static PrettyDebug D("SOCKPOLL", "(SocketPollerEpoll) - ");
+
+// ----------------------------------------------------------------------------
+SocketPollerEpoll::SocketPollerEpoll()
+    throw (NetworkError)
+    : watched(0), events(64)
+{
+    epfd = epoll_create(64);
+    if (epfd < 0)
+        throw NetworkError(stringize() << "epoll_create failed <" << strerror(errno) << ">");
+}
+
+// ----------------------------------------------------------------------------
+SocketPollerEpoll::~SocketPollerEpoll()
+{
+    ::close(epfd);
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketPollerEpoll::add(SOCKET fd)
+    throw (NetworkError)
+{
+    struct epoll_event ev ;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN ;
+    ev.data.fd = fd ;
+
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        if (errno == EEXIST)
+            return ;
+        throw NetworkError(stringize() << "epoll_ctl(ADD, " << fd << ") failed <"
+                           << strerror(errno) << ">");
+    }
+    ++watched ;
+    // Let a single wait report every watched descriptor.
+    if (watched > events.size())
+        events.resize(2 * events.size());
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketPollerEpoll::remove(SOCKET fd)
+{
+    // Closing a descriptor removes it from the epoll set as well, so a
+    // failure here only means the socket has already been closed.
+    struct epoll_event ev ;
+    memset(&ev, 0, sizeof(ev));
+    if (epoll_ctl(epfd, EPOLL_CTL_DEL, fd, &ev) == 0)
+        --watched ;
+    else
+        D.Out(pdDebug, "epoll_ctl(DEL, %d) : %s.", fd, strerror(errno));
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketPollerEpoll::watchOutput(SOCKET fd, bool watch)
+{
+    struct epoll_event ev ;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = watch ? (EPOLLIN | EPOLLOUT) : EPOLLIN ;
+    ev.data.fd = fd ;
+    if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev) < 0)
+        D.Out(pdDebug, "epoll_ctl(MOD, %d) : %s.", fd, strerror(errno));
+}
+
+// ----------------------------------------------------------------------------
+int
+SocketPollerEpoll::wait(std::vector<SOCKET> &ready, int timeout_ms)
+    throw (NetworkError, NetworkSignal)
+{
+    ready.clear();
+
+    int result = epoll_wait(epfd, &events[0], events.size(), timeout_ms);
+    if (result < 0) {
+        if (errno == EINTR)
+            throw NetworkSignal("EINTR on epoll_wait");
+        throw NetworkError(stringize() << "epoll_wait failed <" << strerror(errno) << ">");
+    }
+
+    for (int i = 0 ; i < result ; ++i)
+        ready.push_back(events[i].data.fd);
+    return result ;
+}
+
+} // namespace certi
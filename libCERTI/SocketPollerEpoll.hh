@@ -0,0 +1,60 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_SOCKET_POLLER_EPOLL_HH
+#define CERTI_SOCKET_POLLER_EPOLL_HH
+
+#include "SocketPoller.hh"
+
+#include <sys/epoll.h>
+
+namespace certi {
+
+/**
+ * Linux poller built on epoll (level triggered).
+ * Registration is done once per descriptor, wait() only returns the
+ * descriptors which are ready, so that its cost does not depend on the
+ * number of connected federates.
+ */
+class CERTI_EXPORT SocketPollerEpoll : public SocketPoller
+{
+public:
+    SocketPollerEpoll() throw (NetworkError);
+    virtual ~SocketPollerEpoll();
+
+    virtual void add(SOCKET fd) throw (NetworkError);
+    virtual void remove(SOCKET fd);
+    virtual void watchOutput(SOCKET fd, bool watch);
+    virtual int wait(std::vector<SOCKET> &ready, int timeout_ms)
+        throw (NetworkError, NetworkSignal);
+    virtual const char *getName() const { return "epoll" ; }
+
+private:
+    int epfd ;
+    unsigned int watched ;
+    std::vector<struct epoll_event> events ;
+};
+
+} // namespace certi
+
+#endif // CERTI_SOCKET_POLLER_EPOLL_HH
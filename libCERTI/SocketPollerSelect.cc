@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#include "SocketPollerSelect.hh"
+
+#ifndef _WIN32
+#include <sys/select.h>
+#include <sys/time.h>
+#endif
+
+namespace certi {
+
+// ----------------------------------------------------------------------------
+SocketPollerSelect::SocketPollerSelect()
+{
+}
+
+// ----------------------------------------------------------------------------
+SocketPollerSelect::~SocketPollerSelect()
+{
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketPollerSelect::add(SOCKET fd)
+    throw (NetworkError)
+{
+#ifndef _WIN32
+    // On Windows FD_SETSIZE bounds the number of sockets, not their value.
+    if (fd >= FD_SETSIZE)
+        throw NetworkError(stringize() << "Socket " << fd
+                           << " exceeds FD_SETSIZE (" << FD_SETSIZE
+                           << "), use the epoll poller.");
+#endif
+    fds.insert(fd);
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketPollerSelect::remove(SOCKET fd)
+{
+    fds.erase(fd);
+    outputFds.erase(fd);
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketPollerSelect::watchOutput(SOCKET fd, bool watch)
+{
+    if (!watch)
+        outputFds.erase(fd);
+    else if (fds.count(fd) > 0)
+        outputFds.insert(fd);
+}
+
+// ----------------------------------------------------------------------------
+int
+SocketPollerSelect::wait(std::vector<SOCKET> &ready, int timeout_ms)
+    throw (NetworkError, NetworkSignal)
+{
+    fd_set fdset, outputSet ;
+    SOCKET fd_max = 0 ;
+
+    ready.clear();
+    FD_ZERO(&fdset);
+    FD_ZERO(&outputSet);
+    for (std::set<SOCKET>::const_iterator i = fds.begin(); i != fds.end(); ++i) {
+        FD_SET(*i, &fdset);
+        fd_max = *i > fd_max ? *i : fd_max ;
+    }
+    for (std::set<SOCKET>::const_iterator i = outputFds.begin(); i != outputFds.end(); ++i)
+        FD_SET(*i, &outputSet);
+
+    timeval watchDog ;
+    timeval *timeout = NULL ;
+    if (timeout_ms >= 0) {
+        watchDog.tv_sec = timeout_ms / 1000 ;
+        watchDog.tv_usec = (timeout_ms % 1000) * 1000L ;
+        timeout = &watchDog ;
+    }
+
+    int result = select(fd_max + 1, &fdset,
+                        outputFds.empty() ? NULL : &outputSet, NULL, timeout);
+    if (result < 0) {
+#ifdef _WIN32
+        if (WSAGetLastError() == WSAEINTR)
+#else
+        if (errno == EINTR)
+#endif
+            throw NetworkSignal("EINTR on select");
+        throw NetworkError(stringize() << "select failed <" << strerror(errno) << ">");
+    }
+
+    // A descriptor both readable and writable counts twice in result.
+    for (std::set<SOCKET>::const_iterator i = fds.begin();
+         i != fds.end() && static_cast<int>(ready.size()) < result; ++i) {
+        if (FD_ISSET(*i, &fdset) || FD_ISSET(*i, &outputSet))
+            ready.push_back(*i);
+    }
+    return ready.size();
+}
+
+} // namespace certi
@@ -0,0 +1,58 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_SOCKET_POLLER_SELECT_HH
+#define CERTI_SOCKET_POLLER_SELECT_HH
+
+#include "SocketPoller.hh"
+
+#include <set>
+
+namespace certi {
+
+/**
+ * Portable poller built on select().
+ * The watched set is kept sorted so that the fd_set may be rebuilt and
+ * scanned without looking up any other structure.
+ */
+class CERTI_EXPORT SocketPollerSelect : public SocketPoller
+{
+public:
+    SocketPollerSelect();
+    virtual ~SocketPollerSelect();
+
+    virtual void add(SOCKET fd) throw (NetworkError);
+    virtual void remove(SOCKET fd);
+    virtual void watchOutput(SOCKET fd, bool watch);
+    virtual int wait(std::vector<SOCKET> &ready, int timeout_ms)
+        throw (NetworkError, NetworkSignal);
+    virtual const char *getName() const { return "select" ; }
+
+private:
+    std::set<SOCKET> fds ;
+    std::set<SOCKET> outputFds ;
+};
+
+} // namespace certi
+
+#endif // CERTI_SOCKET_POLLER_SELECT_HH
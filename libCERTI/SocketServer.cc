@@ -26,31 +26,15 @@
 #include "SocketServer.hh"
 #include "PrettyDebug.hh"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
 using std::list ;
 
 namespace certi {
+static PrettyDebug D("SOCKSERV", "(SocketServer) - ");
 static PrettyDebug G("GENDOC",__FILE__);
-// ----------------------------------------------------------------------------
-/** This method is called when the RTIG wants to initialize its
-    FD_SET before doing a select. It will add all open socket to the set.
-    \return the highest file descriptor in the FD_SET
-*/
-int
-SocketServer::addToFDSet(fd_set *select_fdset)
-{
-    int fd_max = 0 ;
-
-    list<SocketTuple *>::iterator i ;
-    for (i = begin(); i != end(); i++) {
-        if ((*i)->ReliableLink != NULL) {
-	    int fd = (*i)->ReliableLink->returnSocket();
-            FD_SET(fd, select_fdset);
-	    fd_max = fd > fd_max ? fd : fd_max ;
-	}
-    }
-    return fd_max ;
-}
-
 // ----------------------------------------------------------------------------
 /*! Check if 'message' coming from socket link 'Socket' has a valid
   Federate field, that is, the Federate number linked to the socket is
@@ -110,27 +94,32 @@ SocketServer::close(long socket,
     federation_referenced = tuple->Federation ;
     federate_referenced = tuple->Federate ;
 
+    // The link will not be reported active anymore.
+    poller->remove(socket);
+    tuplesBySocket.erase(socket);
+    forget(tuple->ReliableLink);
+
     // If the Tuple had no references, remove it, else just delete the socket.
     // Also, if no federate (no Join)
     if (tuple->Federation == 0 && tuple->Federate != 0) {
         list<SocketTuple *>::iterator i ;
-        list<SocketTuple *>::iterator tmp ;
-        for (i = begin(); i != end(); i++) {
-            if (((*i)->ReliableLink != NULL) &&
-                ((*i)->ReliableLink->returnSocket() == socket)) {
+        for (i = begin(); i != end(); ) {
+            if (*i == tuple) {
                 delete (*i);
-                i= erase(i); // i is dereferenced.
-                //tmp = erase(i); // i is dereferenced.
-                //i = tmp-- ; // loop will increment i ;
+                i = erase(i); // i is dereferenced.
+            }
+            else {
+                ++i ;
             }
         }
     }
     else {
         tuple->ReliableLink->close();
-        tuple->BestEffortLink->close();
-
         delete tuple->ReliableLink ;
-        delete tuple->BestEffortLink ;
+        if (tuple->BestEffortLink != NULL) {
+            tuple->BestEffortLink->close();
+            delete tuple->BestEffortLink ;
+        }
 
         tuple->ReliableLink = NULL ;
         tuple->BestEffortLink = NULL ;
@@ -148,6 +137,21 @@ SocketServer::SocketServer(SocketTCP *tcp_socket,
 
     ServerSocketTCP = tcp_socket ;
     ServerSocketUDP = udp_socket ;
+    poller = SocketPoller::create();
+
+    const char *limit = getenv("CERTI_RTIG_OUTPUT_QUEUE");
+    long kilobytes = limit == NULL ? 4096 : atol(limit);
+    queueLimit = static_cast<size_t>(kilobytes > 0 ? kilobytes : 1) * 1024 ;
+
+    const char *policy = getenv("CERTI_SLOW_CONSUMER");
+    if (policy != NULL && strcmp(policy, "drop") == 0)
+        slowConsumerPolicy = SLOW_CONSUMER_DROP ;
+    else if (policy != NULL && strcmp(policy, "disconnect") == 0)
+        slowConsumerPolicy = SLOW_CONSUMER_DISCONNECT ;
+    else
+        slowConsumerPolicy = SLOW_CONSUMER_BLOCK ;
+
+    coalescing = getenv("CERTI_NO_COALESCING") == NULL ;
 }
 
 // ----------------------------------------------------------------------------
@@ -159,6 +163,7 @@ SocketServer::~SocketServer()
         delete front();
         pop_front();
     }
+    delete poller ;
 }
 
 // ----------------------------------------------------------------------------
@@ -191,20 +196,17 @@ SocketTuple::~SocketTuple()
 }
 
 // ----------------------------------------------------------------------------
-/*! This method return the first socket object who has been declared active
-  in the fd_set. It can be called several times to get all active sockets.
+/*! Return the link whose descriptor has been reported ready by the poller,
+  or NULL if this link has been closed since.
 */
-Socket *
-SocketServer::getActiveSocket(fd_set *select_fdset) const
+SocketTCP *
+SocketServer::getActiveSocket(SOCKET socket_descriptor) const
 {
-    list<SocketTuple *>::const_iterator i ;
-    for (i = begin(); i != end(); i++) {
-        if (((*i)->ReliableLink != NULL) &&
-            (FD_ISSET((*i)->ReliableLink->returnSocket(), select_fdset)))
-            return (*i)->ReliableLink ;
-    }
+    SocketTupleMap::const_iterator i = tuplesBySocket.find(socket_descriptor);
+    if (i == tuplesBySocket.end())
+        return NULL ;
 
-    return NULL ;
+    return i->second->ReliableLink ;
 }
 
 // ----------------------------------------------------------------------------
@@ -218,6 +220,9 @@ SocketServer::getActiveSocket(fd_set *select_fdset) const
   reason why a RTIinternalError is thrown in that case.
 
   JYR : sorry but we return NULL (avoid rtig crash) because development needed
+
+  A BEST_EFFORT link is the reliable one for a federate whose RTIA has no
+  UDP link.
 */
 Socket*
 SocketServer::getSocketLink(Handle the_federation,
@@ -229,38 +234,29 @@ SocketServer::getSocketLink(Handle the_federation,
     // It may throw FederateNotExecutionMember
     SocketTuple *tuple = getWithReferences(the_federation, the_federate);
 
-    if (the_type == RELIABLE) {
-        if (tuple->ReliableLink == 0)
-            {
-            return NULL ;
-            }
-            //throw RTIinternalError("Reference to a killed Federate.");
-        return tuple->ReliableLink ;
-    }
-    else {
-        if (tuple->BestEffortLink == 0)
-            {
-            return NULL ;
-            }
-            //throw RTIinternalError("Reference to a killed Federate.");
+    if (tuple == NULL || tuple->ReliableLink == 0)
+        {
+        return NULL ;
+        }
+        //throw RTIinternalError("Reference to a killed Federate.");
+    if (the_type == BEST_EFFORT && tuple->BestEffortLink != 0)
         return tuple->BestEffortLink ;
-    }
+    return tuple->ReliableLink ;
     // G.Out(pdGendoc,"exit  SocketServer::getSocketLink without return");
 }
 
 // ----------------------------------------------------------------------------
-//! getWithReferences.
+//! getWithReferences, NULL for a resigned federate whose link went to
+//! another server.
 SocketTuple *
 SocketServer::getWithReferences(Handle the_federation,
                                 FederateHandle the_federate) const
     throw (FederateNotExecutionMember)
 {
-    list<SocketTuple *>::const_iterator i ;
-    for (i = begin(); i != end(); i++) {
-        if (((*i)->Federation == the_federation) &&
-            ((*i)->Federate == the_federate))
-            return (*i);
-    }
+    ReferenceTupleMap::const_iterator i =
+        tuplesByReferences.find(FederateReference(the_federation, the_federate));
+    if (i != tuplesByReferences.end())
+        return i->second ;
 
     throw FederateNotExecutionMember(certi::stringize() << "Federate handle" << the_federate << "is not a member of Federation" << the_federation);
 }
@@ -271,15 +267,9 @@ SocketTuple *
 SocketServer::getWithSocket(long socket_descriptor) const
     throw (RTIinternalError)
 {
-    list<SocketTuple *>::const_iterator i ;
-    for (i = begin(); i != end(); i++) {
-        if (((*i)->ReliableLink != NULL) &&
-            ((*i)->ReliableLink->returnSocket() == socket_descriptor))
-            return (*i);
-        if (((*i)->BestEffortLink != NULL) &&
-            ((*i)->BestEffortLink->returnSocket() == socket_descriptor))
-            return (*i);
-    }
+    SocketTupleMap::const_iterator i = tuplesBySocket.find(socket_descriptor);
+    if (i != tuplesBySocket.end())
+        return i->second ;
 
     throw RTIinternalError("Socket not found.");
 }
@@ -309,7 +299,16 @@ SocketServer::open()
     if (newTuple == NULL)
         throw RTIinternalError("Could not allocate new tuple.");
 
+    try {
+        watch(newLink);
+    }
+    catch (NetworkError &e) {
+        delete newTuple ;
+        throw RTIinternalError(e._reason);
+    }
+
     push_front(newTuple);
+    tuplesBySocket[newLink->returnSocket()] = newTuple ;
 }
 
 // ----------------------------------------------------------------------------
@@ -318,6 +317,9 @@ SocketServer::open()
   be changed. References can be zeros(but should not).
   Throw RTIinternalError if the References have already been set, or
   if the Socket is not found.
+  The best effort messages to the federate go to the UDP port of its RTIA
+  at the given address, that of its reliable link, or through the reliable
+  link if the port is zero.
 */
 void
 SocketServer::setReferences(long socket,
@@ -336,8 +338,157 @@ SocketServer::setReferences(long socket,
 
     tuple->Federation = federation_reference ;
     tuple->Federate = federate_reference ;
+    // A federate handle may be reused, the latest link wins.
+    tuplesByReferences[FederateReference(federation_reference,
+                                         federate_reference)] = tuple ;
+    if (port == 0 || ServerSocketUDP == NULL) {
+        delete tuple->BestEffortLink ;
+        tuple->BestEffortLink = NULL ;
+        return ;
+    }
+    // A link joining again gets a new one, see clearReferences.
+    if (tuple->BestEffortLink == NULL)
+        tuple->BestEffortLink = new SocketUDP();
+    datagrams.setSocket(ServerSocketUDP->returnSocket());
     tuple->BestEffortLink->attach(ServerSocketUDP->returnSocket(), address,
                                   port);
+    tuple->BestEffortLink->setBatch(&datagrams, tuple->ReliableLink);
+}
+
+
+// ----------------------------------------------------------------------------
+/*! Reset the FederationHandle and the FederateHandle associated with
+  "socket" once its federate has resigned, so that setReferences or release
+  may be called again. The messages still sent to the resigned federate go
+  to the link, reliably, until it joins again or is released. Throw
+  RTIinternalError if the Socket is not found.
+*/
+void
+SocketServer::clearReferences(long socket)
+    throw (RTIinternalError)
+{
+    // It may throw RTIinternalError if not found.
+    SocketTuple *tuple = getWithSocket(socket);
+
+    tuple->Federation = 0 ;
+    tuple->Federate = 0 ;
+    if (tuple->BestEffortLink != NULL) {
+        tuple->BestEffortLink->close();
+        delete tuple->BestEffortLink ;
+        tuple->BestEffortLink = NULL ;
+    }
+}
+
+// ----------------------------------------------------------------------------
+/*! Remove the SocketTuple of "socket" from this server without closing its
+  links, and return it. Only a link whose references have not been set can
+  change of server, since the references belong to the federations of this
+  one. Throw RTIinternalError if the Socket is not found or has references.
+*/
+SocketTuple *
+SocketServer::release(long socket)
+    throw (RTIinternalError)
+{
+    // It may throw RTIinternalError if not found.
+    SocketTuple *tuple = getWithSocket(socket);
+
+    if ((tuple->Federation != 0) || (tuple->Federate != 0))
+        throw RTIinternalError("Socket References have already been set.");
+
+    poller->remove(socket);
+    tuplesBySocket.erase(socket);
+    // The federates which resigned on this link have no link here anymore.
+    for (ReferenceTupleMap::iterator i = tuplesByReferences.begin();
+         i != tuplesByReferences.end(); ++i) {
+        if (i->second == tuple)
+            i->second = NULL ;
+    }
+    forget(tuple->ReliableLink);
+    // The adopting server flushes what the link still holds.
+    tuple->ReliableLink->setCoalescing(false);
+    remove(tuple);
+    return tuple ;
+}
+
+// ----------------------------------------------------------------------------
+/*! Insert a SocketTuple released by another server, its reliable link being
+  watched by the poller of this one.
+  Throw RTIinternalError if the link cannot be watched.
+*/
+void
+SocketServer::adopt(SocketTuple *tuple)
+    throw (RTIinternalError)
+{
+    try {
+        watch(tuple->ReliableLink);
+    }
+    catch (NetworkError &e) {
+        delete tuple ;
+        throw RTIinternalError(e._reason);
+    }
+
+    push_front(tuple);
+    tuplesBySocket[tuple->ReliableLink->returnSocket()] = tuple ;
+}
+
+// ----------------------------------------------------------------------------
+/*! Let the poller watch a reliable link, which is switched to the non
+  blocking mode so that a federate which does not read its messages, or
+  sends half of one, does not stall the server. The output queue limit
+  (CERTI_RTIG_OUTPUT_QUEUE, in kilobytes) and the policy beyond it
+  (CERTI_SLOW_CONSUMER) are the ones of the server, and the link coalesces
+  its messages until flushLinks unless CERTI_NO_COALESCING is set.
+  The GSSAPI links stay blocking.
+*/
+void
+SocketServer::watch(SocketTCP *link)
+    throw (NetworkError)
+{
+    poller->add(link->returnSocket());
+#ifndef WITH_GSSAPI
+    try {
+        link->setNonBlocking(poller, queueLimit, slowConsumerPolicy);
+    }
+    catch (NetworkError &e) {
+        poller->remove(link->returnSocket());
+        throw ;
+    }
+    link->setCoalescing(coalescing, &pendingLinks);
+    D.Out(pdInit, "Socket %d is non blocking.", link->returnSocket());
+#endif
+}
+
+// ----------------------------------------------------------------------------
+//! Forget the pending messages of a link which leaves the server.
+void
+SocketServer::forget(SocketTCP *link)
+{
+    if (link != NULL)
+        pendingLinks.erase(std::remove(pendingLinks.begin(), pendingLinks.end(), link),
+                           pendingLinks.end());
+}
+
+// ----------------------------------------------------------------------------
+/*! Write the messages queued by the coalescing links. A broken link is
+  left to the poller, which reports it readable, so that its owner closes it
+  as usual.
+*/
+void
+SocketServer::flushLinks()
+{
+    // A flush may not add a link: only queuing a message does.
+    for (size_t i = 0 ; i < pendingLinks.size() ; ++i) {
+        try {
+            pendingLinks[i]->flush();
+        }
+        catch (NetworkError &e) {
+            D.Out(pdExcept, "Flushing socket %d failed: %s",
+                  pendingLinks[i]->returnSocket(), e._reason.c_str());
+        }
+        catch (NetworkSignal &e) {
+        }
+    }
+    pendingLinks.clear();
 }
 
 }
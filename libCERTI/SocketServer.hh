@@ -29,17 +29,20 @@
 #include "Socket.hh"
 #include "SocketTCP.hh"
 #include "SocketUDP.hh"
+#include "DatagramBatch.hh"
 #include "NetworkMessage.hh"
 #include "SecurityLevel.hh"
 #include "SecureTCPSocket.hh"
+#include "SocketPoller.hh"
 
 #include <list>
+#include <map>
 
 namespace certi {
 
 // ----------------------------------------------------------------------------
 //! Element of the SocketServer internal list.
-class SocketTuple
+class CERTI_EXPORT SocketTuple
 {
 public:
     Handle Federation ;
@@ -86,6 +89,20 @@ public:
                        unsigned int the_port)
         throw (RTIinternalError);
 
+    /** Forget the references of a link whose federate has resigned: it
+        may join again, or be released to another server. */
+    void clearReferences(long the_socket)
+        throw (RTIinternalError);
+
+    /** Give up a link without references, which stays open, so that
+        another server adopts it. */
+    SocketTuple *release(long socket)
+        throw (RTIinternalError);
+
+    /** Take over a link released by another server. */
+    void adopt(SocketTuple *tuple)
+        throw (RTIinternalError);
+
     // -----------------------------
     // -- Message related methods --
     // -----------------------------
@@ -95,8 +112,9 @@ public:
     // --------------------------
     // -- RTIG related methods --
     // --------------------------
-    int addToFDSet(fd_set *select_fdset);
-    Socket *getActiveSocket(fd_set *select_fdset) const ;
+    /** The poller watching every open federate link. */
+    SocketPoller &getPoller() { return *poller ; }
+    SocketTCP *getActiveSocket(SOCKET socket_descriptor) const ;
 
     // ------------------------------------------
     // -- Message Broadcasting related Methods --
@@ -110,16 +128,50 @@ public:
                                    FederateHandle the_federate) const
         throw (FederateNotExecutionMember);
 
+    /** Send the best effort messages queued since the last call. */
+    void flushDatagrams() { datagrams.flush(); }
+
+    /** Write the messages coalesced on the reliable links since the last
+        call, a single system call per link. */
+    void flushLinks();
+
 private:
+    typedef std::map<SOCKET, SocketTuple *> SocketTupleMap ;
+    typedef std::pair<Handle, FederateHandle> FederateReference ;
+    typedef std::map<FederateReference, SocketTuple *> ReferenceTupleMap ;
+
     // The Server socket object(used for Accepts)
     SocketTCP *ServerSocketTCP ;
     SocketUDP *ServerSocketUDP ;
 
+    // Best effort messages waiting to be sent on ServerSocketUDP.
+    DatagramBatch datagrams ;
+
+    // Readiness notification for the open reliable links.
+    SocketPoller *poller ;
+
+    // Output queue limit (bytes) and policy of the non blocking links.
+    size_t queueLimit ;
+    SlowConsumerPolicy slowConsumerPolicy ;
+
+    // Whether the links coalesce their messages (unless CERTI_NO_COALESCING),
+    // and the links with messages waiting for flushLinks.
+    bool coalescing ;
+    std::vector<SocketTCP *> pendingLinks ;
+
+    // Indexes over the tuple list, so that looking up a link from an active
+    // descriptor or from its references does not scan every federate.
+    SocketTupleMap tuplesBySocket ;
+    ReferenceTupleMap tuplesByReferences ;
+
     // ---------------------
     // -- Private Methods --
     // ---------------------
     SocketTuple *getWithSocket(long socket_descriptor) const
         throw (RTIinternalError);
+
+    void watch(SocketTCP *link) throw (NetworkError);
+    void forget(SocketTCP *link);
 };
 
 } // namespace certi
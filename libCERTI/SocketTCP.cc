@@ -20,8 +20,11 @@
 // ----------------------------------------------------------------------------
 
 #include "SocketTCP.hh"
+#include "SocketPoller.hh"
+#include "MessageBuffer.hh"
 #include "PrettyDebug.hh"
 
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <cerrno>
@@ -30,6 +33,8 @@
 #include <cstdio>
 #ifndef _WIN32
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
 #endif
 
 using std::cout ;
@@ -40,6 +45,11 @@ namespace certi {
 static PrettyDebug D("SOCKTCP", "(SocketTCP) - ");
 static PrettyDebug G("GENDOC",__FILE__);
 
+// Bytes a non blocking link tries to read at once.
+static const size_t READ_SIZE = 65536 ;
+
+const size_t SocketTCP::COALESCING_LIMIT = 65536 ;
+
 #ifdef _WIN32
 int SocketTCP::winsockInits = 0;
 
@@ -95,6 +105,19 @@ SocketTCP::SocketTCP()
     SentBytesCount = 0;
     RcvdBytesCount = 0;
 
+    poller = NULL ;
+    queueLimit = 0 ;
+    policy = SLOW_CONSUMER_BLOCK ;
+    inputBegin = 0 ;
+    inputEnd = 0 ;
+    outputBegin = 0 ;
+    watchingOutput = false ;
+    shutDown = false ;
+    dropped = 0 ;
+    coalescing = false ;
+    pendingLinks = NULL ;
+    flushPending = false ;
+
 #ifdef _WIN32
     winsockStartup();
 #endif
@@ -125,6 +148,13 @@ if (_est_init_tcp)
     cout << _socket_tcp << " : total = " ;
     cout.width(9);
     cout << RcvdBytesCount << " Bytes received" << endl ;
+    if (dropped > 0) {
+        cout << " TCP Socket " ;
+        cout.width(2);
+        cout << _socket_tcp << " : total = " ;
+        cout.width(9);
+        cout << dropped << " Messages dropped" << endl ;
+    }
 #endif
 }
 
@@ -345,6 +375,21 @@ long expected_size = size ;
 
 assert(_est_init_tcp);
 
+#ifndef _WIN32
+if (poller != NULL)
+	{
+	queue(buffer, size, false);
+	return ;
+	}
+if (coalescing)
+	{
+	output.insert(output.end(), buffer, buffer + size);
+	if (output.size() >= COALESCING_LIMIT)
+		flush();
+	return ;
+	}
+#endif
+
 D.Out(pdDebug, "Beginning to send TCP message...");
 
 while (total_sent < expected_size)
@@ -385,12 +430,360 @@ while (total_sent < expected_size)
 SentBytesCount += total_sent ;
 }
 
+// ----------------------------------------------------------------------------
+/*! In the non blocking mode, a best effort message is dropped rather than
+  queued beyond the limit with the SLOW_CONSUMER_DROP policy.
+*/
+void
+SocketTCP::sendBestEffort(const unsigned char *buffer, size_t size)
+	throw (NetworkError, NetworkSignal)
+{
+#ifndef _WIN32
+if (poller != NULL)
+	{
+	queue(buffer, size, true);
+	return ;
+	}
+#endif
+send(buffer, size);
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketTCP::setNonBlocking(SocketPoller *the_poller, size_t queue_limit,
+                          SlowConsumerPolicy the_policy)
+	throw (NetworkError)
+{
+#ifndef _WIN32
+	assert(_est_init_tcp);
+	if (poller == NULL)
+		{
+		int flags = fcntl(_socket_tcp, F_GETFL, 0);
+		if (flags < 0 || fcntl(_socket_tcp, F_SETFL, flags | O_NONBLOCK) < 0)
+			throw NetworkError(stringize()
+				<< "Cannot make socket <" << _socket_tcp
+				<< "> non blocking : error =" << strerror(errno));
+		}
+	poller = the_poller ;
+	queueLimit = queue_limit ;
+	policy = the_policy ;
+	// A new poller has to watch the queued output as well.
+	watchingOutput = false ;
+	watchOutput(outputBegin < output.size());
+#endif
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketTCP::readAvailable()
+	throw (NetworkError, NetworkSignal)
+{
+#ifndef _WIN32
+	assert(poller != NULL);
+	// The messages received before the end of the link are processed first.
+	if (!fill() && !isDataReady())
+		{
+		D.Out(pdExcept, "TCP connection has been closed by peer.");
+		throw NetworkError("Connection closed by client.");
+		}
+#endif
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketTCP::flush()
+	throw (NetworkError, NetworkSignal)
+{
+#ifndef _WIN32
+	flushPending = false ;
+	if (shutDown)
+		return ;
+
+	if (outputBegin < output.size())
+		{
+		struct iovec iov ;
+		iov.iov_base = &output[outputBegin] ;
+		iov.iov_len = output.size() - outputBegin ;
+		outputBegin += writeSome(&iov, 1);
+		}
+
+	if (outputBegin == output.size())
+		{
+		output.clear();
+		outputBegin = 0 ;
+		watchOutput(false);
+		}
+	else
+		{
+		if (outputBegin > output.size() / 2)
+			{
+			output.erase(output.begin(), output.begin() + outputBegin);
+			outputBegin = 0 ;
+			}
+		watchOutput(true);
+		}
+#endif
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketTCP::setCoalescing(bool coalesce, std::vector<SocketTCP *> *pending)
+{
+#ifndef _WIN32
+	coalescing = coalesce ;
+	pendingLinks = pending ;
+	flushPending = false ;
+	if (pendingLinks != NULL && outputBegin < output.size())
+		{
+		pendingLinks->push_back(this);
+		flushPending = true ;
+		}
+#endif
+}
+
+#ifndef _WIN32
+// ----------------------------------------------------------------------------
+/*! Send a message in the non blocking mode: the output queue keeps the
+  order of the messages, and what the peer does not take at once waits in
+  it, within the limit given to setNonBlocking.
+*/
+void
+SocketTCP::queue(const unsigned char *buffer, size_t size, bool droppable)
+	throw (NetworkError, NetworkSignal)
+{
+	if (shutDown)
+		{
+		++dropped ;
+		return ;
+		}
+
+	size_t queued = output.size() - outputBegin ;
+	if (coalescing && queued + size <= std::min(COALESCING_LIMIT, queueLimit))
+		{
+		// Written with the next messages, at the latest by the owner's flush.
+		output.insert(output.end(), buffer, buffer + size);
+		if (!flushPending && pendingLinks != NULL)
+			{
+			pendingLinks->push_back(this);
+			flushPending = true ;
+			}
+		return ;
+		}
+
+	if (!watchingOutput)
+		{
+		// The queue and the message go with a single system call.
+		struct iovec iov[2] ;
+		iov[0].iov_base = queued > 0 ? &output[outputBegin] : NULL ;
+		iov[0].iov_len = queued ;
+		iov[1].iov_base = const_cast<unsigned char *>(buffer);
+		iov[1].iov_len = size ;
+		size_t sent = writeSome(iov, 2);
+		if (sent >= queued)
+			{
+			output.clear();
+			outputBegin = 0 ;
+			sent -= queued ;
+			if (sent < size)
+				{
+				// The end of a message partly written follows whatever the limit.
+				output.insert(output.end(), buffer + sent, buffer + size);
+				watchOutput(true);
+				}
+			return ;
+			}
+		outputBegin += sent ;
+		}
+	else if (queued + size > queueLimit)
+		flush();
+
+	if (output.size() - outputBegin + size > queueLimit)
+		{
+		switch (policy)
+			{
+		  case SLOW_CONSUMER_DISCONNECT:
+			disconnect();
+			++dropped ;
+			return ;
+		  case SLOW_CONSUMER_DROP:
+			if (droppable)
+				{
+				D.Out(pdDebug, "Best effort message dropped on socket %d.", _socket_tcp);
+				++dropped ;
+				return ;
+				}
+			// A reliable message waits for the peer as with SLOW_CONSUMER_BLOCK.
+		  case SLOW_CONSUMER_BLOCK:
+			while (outputBegin < output.size()
+			       && output.size() - outputBegin + size > queueLimit)
+				{
+				waitFor(POLLOUT);
+				flush();
+				}
+			break ;
+			}
+		}
+
+	output.insert(output.end(), buffer, buffer + size);
+	watchOutput(true);
+}
+
+// ----------------------------------------------------------------------------
+/*! Write what the peer takes at once of the buffers, all of them in the
+  blocking mode, and return the bytes written. The iovecs are consumed.
+*/
+size_t
+SocketTCP::writeSome(struct iovec *iov, int count)
+	throw (NetworkError, NetworkSignal)
+{
+	size_t total_sent = 0 ;
+	while (count > 0)
+		{
+		ssize_t sent = ::writev(_socket_tcp, iov, count);
+		if (sent < 0)
+			{
+			if (errno == EINTR)
+				continue ;
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				break ;
+			perror("TCP Socket(EmettreTCP) ");
+			throw NetworkError("Error while sending TCP message.");
+			}
+		total_sent += sent ;
+		size_t left = sent ;
+		while (count > 0 && left >= iov->iov_len)
+			{
+			left -= iov->iov_len ;
+			++iov ;
+			--count ;
+			}
+		if (count > 0)
+			{
+			iov->iov_base = static_cast<char *>(iov->iov_base) + left ;
+			iov->iov_len -= left ;
+			}
+		}
+	D.Out(pdTrace, "Sent %ld bytes.", total_sent);
+	SentBytesCount += total_sent ;
+	return total_sent ;
+}
+
+// ----------------------------------------------------------------------------
+/*! Read what has arrived into the input buffer, with room for the whole
+  message being received. Return false if the peer has closed the link.
+*/
+bool
+SocketTCP::fill()
+	throw (NetworkError, NetworkSignal)
+{
+	size_t available = inputEnd - inputBegin ;
+	size_t needed = READ_SIZE ;
+	if (available >= libhla::MessageBuffer::reservedBytes)
+		{
+		size_t message = libhla::MessageBuffer::sizeFromReservedBytes(&input[inputBegin]);
+		if (message > available + needed)
+			needed = message - available ;
+		}
+
+	if (input.size() - inputEnd < needed)
+		{
+		if (inputBegin > 0)
+			{
+			memmove(&input[0], &input[inputBegin], available);
+			inputBegin = 0 ;
+			inputEnd = available ;
+			}
+		if (input.size() - inputEnd < needed)
+			input.resize(inputEnd + needed);
+		}
+
+	for (;;)
+		{
+		ssize_t received = recv(_socket_tcp, &input[inputEnd], input.size() - inputEnd, 0);
+		if (received > 0)
+			{
+			inputEnd += received ;
+			RcvdBytesCount += received ;
+			return true ;
+			}
+		if (received == 0)
+			return false ;
+		if (errno == EINTR)
+			continue ;
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			return true ;
+		perror("TCP Socket(RecevoirTCP) ");
+		throw NetworkError("Error while receiving TCP message.");
+		}
+}
+
+// ----------------------------------------------------------------------------
+//! Wait until the socket is ready for the given poll events.
+void
+SocketTCP::waitFor(short events)
+	throw (NetworkError, NetworkSignal)
+{
+	struct pollfd fd ;
+	fd.fd = _socket_tcp ;
+	fd.events = events ;
+	if (poll(&fd, 1, -1) < 0)
+		{
+		if (errno == EINTR)
+			throw NetworkSignal("");
+		throw NetworkError(stringize() << "poll failed <" << strerror(errno) << ">");
+		}
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketTCP::watchOutput(bool watch)
+{
+	if (poller != NULL && watch != watchingOutput)
+		{
+		poller->watchOutput(_socket_tcp, watch);
+		watchingOutput = watch ;
+		}
+}
+
+// ----------------------------------------------------------------------------
+/*! Drop a slow consumer: once shut down, the link is reported readable and
+  its end is read, so that its owner closes it as any broken link.
+*/
+void
+SocketTCP::disconnect()
+{
+	D.Out(pdExcept, "Slow consumer on socket %d disconnected, %lu bytes queued.",
+	      _socket_tcp, (unsigned long)(output.size() - outputBegin));
+	::shutdown(_socket_tcp, SHUT_RDWR);
+	shutDown = true ;
+	output.clear();
+	outputBegin = 0 ;
+	watchOutput(false);
+}
+#endif
+
 // ----------------------------------------------------------------------------
 void
 SocketTCP::close()
 {
 if (_est_init_tcp)
 	{
+	#ifndef _WIN32
+	if (!shutDown && outputBegin < output.size())
+		{
+		// Whatever the peer takes of the output queue still goes.
+		try {
+			struct iovec iov ;
+			iov.iov_base = &output[outputBegin] ;
+			iov.iov_len = output.size() - outputBegin ;
+			writeSome(&iov, 1);
+		}
+		catch (Exception &e) {
+		}
+		output.clear();
+		outputBegin = 0 ;
+		}
+	#endif
 	#ifdef _WIN32
 		::closesocket(_socket_tcp);
 	#else
@@ -430,6 +823,15 @@ return _sockIn.sin_port ;
 bool
 SocketTCP::isDataReady() const
 {
+#ifndef _WIN32
+	if (poller != NULL)
+		{
+		// A whole message has been read.
+		size_t available = inputEnd - inputBegin ;
+		return available >= libhla::MessageBuffer::reservedBytes
+			&& available >= libhla::MessageBuffer::sizeFromReservedBytes(&input[inputBegin]);
+		}
+#endif
 #ifdef SOCKTCP_BUFFER_LENGTH
 	return RBLength > 0 ;
 #else
@@ -473,6 +875,31 @@ unsigned long RBLength = 0 ;
 
 D.Out(pdDebug, "Beginning to receive TCP message...(Size  %ld)",size);
 
+#ifndef _WIN32
+// The peer may wait for the messages still queued to answer.
+if (poller == NULL && outputBegin < output.size())
+	flush();
+
+if (poller != NULL)
+	{
+	while (inputEnd - inputBegin < size)
+		{
+		// Only when the caller did not wait for isDataReady.
+		waitFor(POLLIN);
+		if (!fill())
+			{
+			D.Out(pdExcept, "TCP connection has been closed by peer.");
+			throw NetworkError("Connection closed by client.");
+			}
+		}
+	memcpy(buffer, &input[inputBegin], size);
+	inputBegin += size ;
+	if (inputBegin == inputEnd)
+		inputBegin = inputEnd = 0 ;
+	return ;
+	}
+#endif
+
 while (RBLength < size)
 	{
 
@@ -28,8 +28,23 @@
 // If the next line is commented out, no buffer will be used at all.
 //#define SOCKTCP_BUFFER_LENGTH 4096
 
+#include <vector>
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 namespace certi {
 
+class SocketPoller ;
+
+/** What a non blocking SocketTCP does with a message its full output queue
+    cannot take, see SocketTCP::setNonBlocking. */
+enum SlowConsumerPolicy {
+    SLOW_CONSUMER_BLOCK,      //!< wait until the peer has read enough
+    SLOW_CONSUMER_DROP,       //!< drop best effort messages, wait for the others
+    SLOW_CONSUMER_DISCONNECT  //!< shut the link down, the peer is then dropped
+};
+
 /** This TCP socket implementation uses a Read Buffer to
   improve global read performances(by reducing Recv system calls). An
   important drawback of this improvement is that a socket can be marked as
@@ -39,6 +54,19 @@ namespace certi {
   data has already been read, and is waiting in the internal buffer.
   Therefore, before returning to a select loop, be sure to call the
   IsDataReady method to check whether any data is waiting for processing.
+
+  The RTIG switches its links to a non blocking mode (setNonBlocking), where
+  the socket never waits for its peer unless told so:
+  - readAvailable reads what has arrived into an input buffer, and
+    isDataReady tells whether a whole message is buffered, so that a peer
+    sending half a message does not stall the reader;
+  - send writes what the peer can take and queues the rest, which flush
+    writes later, the socket asking its SocketPoller to report it writable
+    meanwhile. Beyond the queue limit the SlowConsumerPolicy applies.
+
+  With setCoalescing, blocking or not, send only appends the small messages
+  to the output queue, and flush writes them with a single system call:
+  the owner of the link flushes it once per pass of its event loop.
 */
 class CERTI_EXPORT SocketTCP : public Socket
 {
@@ -54,10 +82,41 @@ public :
 
 	int accept(SocketTCP *serveur) throw (NetworkError);
 	virtual void send(const unsigned char *, size_t)		throw (NetworkError, NetworkSignal);
+	virtual void sendBestEffort(const unsigned char *, size_t)	throw (NetworkError, NetworkSignal);
 	virtual void receive(void *Buffer, unsigned long Size)	throw (NetworkError, NetworkSignal);
 
 	virtual bool isDataReady() const ;
 
+	/** Switch an open link to the non blocking mode, or tell it of a new
+	    poller. The output queue holds at most queueLimit bytes, except
+	    for the end of a message partly written. Ignored on Windows. */
+	void setNonBlocking(SocketPoller *poller, size_t queueLimit,
+	                    SlowConsumerPolicy policy) throw (NetworkError);
+	bool isNonBlocking() const { return poller != NULL ; }
+
+	/** Read what has arrived, without waiting. NetworkError is thrown once
+	    the peer has closed the link and no whole message is left. */
+	void readAvailable() throw (NetworkError, NetworkSignal);
+
+	/** Write the output queue, as far as the peer takes it, or the whole
+	    queue in the blocking mode. */
+	void flush() throw (NetworkError, NetworkSignal);
+
+	/** Keep the messages sent in the output queue until flush, up to
+	    COALESCING_LIMIT bytes, except in the blocking mode the messages
+	    sent before a receive. A link which starts queuing adds itself to
+	    pending, when not NULL, so that its owner knows what to flush.
+	    Ignored on Windows. */
+	void setCoalescing(bool coalesce, std::vector<SocketTCP *> *pending = NULL);
+	bool isCoalescing() const { return coalescing ; }
+	/** Bytes waiting in the output queue. */
+	size_t getQueuedBytes() const { return output.size() - outputBegin ; }
+
+	static const size_t COALESCING_LIMIT ;
+
+	/** Number of messages dropped by the slow consumer policy. */
+	unsigned long getDropped() const { return dropped ; }
+
 	virtual unsigned long returnAdress() const ;
 	
 	SocketTCP &operator=(SocketTCP &theSocket);
@@ -85,6 +144,17 @@ private:
     in_port_t getPort() const ;
     in_addr_t getAddr() const ;
 
+    void queue(const unsigned char *buffer, size_t size, bool droppable)
+        throw (NetworkError, NetworkSignal);
+#ifndef _WIN32
+    size_t writeSome(struct iovec *iov, int count)
+        throw (NetworkError, NetworkSignal);
+#endif
+    bool fill() throw (NetworkError, NetworkSignal);
+    void waitFor(short events) throw (NetworkError, NetworkSignal);
+    void watchOutput(bool watch);
+    void disconnect();
+
     SOCKET _socket_tcp;
     #ifdef _WIN32
     static int winsockInits;
@@ -92,6 +162,22 @@ private:
     bool _est_init_tcp;
     struct sockaddr_in _sockIn;
 
+    // Non blocking mode, poller is NULL in the blocking one.
+    SocketPoller *poller ;
+    size_t queueLimit ;
+    SlowConsumerPolicy policy ;
+    std::vector<char> input ;        // bytes inputBegin..inputEnd are unread
+    size_t inputBegin ;
+    size_t inputEnd ;
+    std::vector<unsigned char> output ; // bytes from outputBegin are unsent
+    size_t outputBegin ;
+    bool watchingOutput ;
+    bool shutDown ;                  // disconnected as a slow consumer
+    unsigned long dropped ;
+    bool coalescing ;
+    std::vector<SocketTCP *> *pendingLinks ;
+    bool flushPending ;              // this link is in pendingLinks
+
 #ifdef SOCKTCP_BUFFER_LENGTH
     // This class can use a buffer to reduce the number of systems calls
     // when reading a lot of small amouts of data. Each time a Receive
@@ -17,8 +17,10 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 // ----------------------------------------------------------------------------
 
+#include <config.h>
 #include "certi.hh"
 #include "SocketUDP.hh"
+#include "DatagramBatch.hh"
 #include "PrettyDebug.hh"
 #include <cstdlib>
 #include <cstring>
@@ -55,7 +57,8 @@ SocketUDP::attach(int socket_ouvert, unsigned long Adresse, unsigned int port)
     // Building Distant Address
     memset((struct sockaddr_in *) &sock_distant, 0, sizeof(struct sockaddr_in));
 
-    sock_distant.sin_addr.s_addr = htonl(Adresse);
+    // The address comes from getAddr() of the RTIA, in network order.
+    sock_distant.sin_addr.s_addr = Adresse ;
     sock_distant.sin_family = AF_INET ;
     sock_distant.sin_port = port ;
 
@@ -179,7 +182,12 @@ SocketUDP::SocketUDP() {
 
     SentBytesCount = 0;
     RcvdBytesCount = 0;
-    BufferSize     = 0;
+
+    Batch          = NULL;
+    ReliableLink   = NULL;
+    DatagramCount  = 0;
+    DatagramIndex  = 0;
+    DatagramOffset = 0;
 
 #ifdef _WIN32 //netDot
     SocketTCP::winsockStartup();
@@ -220,6 +228,18 @@ SocketUDP::send(const unsigned char * Message, size_t Size)
 D.Out(pdDebug, "Beginning to send UDP message... Size = %ld", Size);
 assert(_est_init_udp);
 
+if (Batch != NULL)
+	{
+	if (Size > Batch->getPayload())
+		ReliableLink->sendBestEffort(Message, Size);
+	else
+		{
+		Batch->append(sock_distant, Message, Size);
+		SentBytesCount += Size ;
+		}
+	return ;
+	}
+
 int sent = sendto(_socket_udp, (char*)Message, Size, 0,
       (struct sockaddr *)&sock_distant, sizeof(sock_distant));
 if (sent < 0)
@@ -274,7 +294,7 @@ return sock_local.sin_port ;
 bool
 SocketUDP::isDataReady() const
 {
- return BufferSize > 0 ;
+ return DatagramIndex < DatagramCount ;
 }
 
 // ----------------------------------------------------------------------------
@@ -289,50 +309,97 @@ int SocketUDP::open()
 }
 
 // ----------------------------------------------------------------------------
+/*! Read a part of the datagram in front, receiving new datagrams if every
+  received one has been read. A part missing from the datagram drops it.
+*/
 void
 SocketUDP::receive(void * Message, unsigned long Size)
     throw (NetworkError, NetworkSignal)
 {
+assert(_est_init_udp);
+
+D.Out(pdDebug, "Beginning to receive UDP message...");
+if (Size == 0)
+	return ;
+if (DatagramIndex == DatagramCount)
+	receiveDatagrams();
+
+const char *datagram = &Datagrams[DatagramIndex * DATAGRAM_MAXSIZE] ;
+size_t left = DatagramSize[DatagramIndex] - DatagramOffset ;
+if (left < Size)
+	{
+	++DatagramIndex ;
+	DatagramOffset = 0 ;
+	throw NetworkError("Truncated message in UDP datagram");
+	}
+
+memcpy(Message, datagram + DatagramOffset, Size);
+DatagramOffset += Size ;
+if (DatagramOffset == DatagramSize[DatagramIndex])
+	{
+	++DatagramIndex ;
+	DatagramOffset = 0 ;
+	}
+}
+
+// ----------------------------------------------------------------------------
+/*! Wait for a datagram, and take the ones already queued by the system
+  along with it when recvmmsg is available.
+*/
+void
+SocketUDP::receiveDatagrams()
+    throw (NetworkError, NetworkSignal)
+{
+if (Datagrams.empty())
+	Datagrams.resize(DATAGRAM_SLOTS * DATAGRAM_MAXSIZE);
+
+DatagramCount = 0 ;
+DatagramIndex = 0 ;
+DatagramOffset = 0 ;
+
+#ifdef HAVE_RECVMMSG
+struct mmsghdr headers[DATAGRAM_SLOTS] ;
+struct iovec vectors[DATAGRAM_SLOTS] ;
+memset(headers, 0, sizeof(headers));
+for (unsigned int i = 0 ; i < DATAGRAM_SLOTS ; ++i)
+	{
+	vectors[i].iov_base = &Datagrams[i * DATAGRAM_MAXSIZE] ;
+	vectors[i].iov_len = DATAGRAM_MAXSIZE ;
+	headers[i].msg_hdr.msg_iov = &vectors[i] ;
+	headers[i].msg_hdr.msg_iovlen = 1 ;
+	}
+int CR = recvmmsg(_socket_udp, headers, DATAGRAM_SLOTS, MSG_WAITFORONE, NULL);
+#else
 #ifdef _WIN32								//netDot
 	int taille = sizeof(struct sockaddr_in);
 #else
 	socklen_t taille = sizeof(struct sockaddr_in);
 #endif
-
-int CR ;
-
-assert(_est_init_udp);
-
-D.Out(pdDebug, "Beginning to receive UDP message...");
-if (BufferSize == 0)
-	{
-	CR = recvfrom(_socket_udp,
-	Buffer, BUFFER_MAXSIZE, 0,
+int CR = recvfrom(_socket_udp, &Datagrams[0], DATAGRAM_MAXSIZE, 0,
 	(struct sockaddr *)&sock_source, &taille);
-	//HPUX:(struct sockaddr *)&sock_source, (int*) &taille);
-	if (CR <= 0)
-		{
-		perror("Recvfrom");
-		throw NetworkError("cannot recvfrom");
-		}
-	else
-		{
-		RcvdBytesCount += CR ;
-		BufferSize += CR ;
-		}
-	}
+#endif
 
-if (BufferSize < Size)
+if (CR <= 0)
 	{
-	perror("Taille du Buffer inferieure a celle demandee");
-	throw NetworkError("");
+	if (CR < 0 && errno == EINTR)
+		throw NetworkSignal("EINTR on UDP receive");
+	perror("Recvfrom");
+	throw NetworkError("cannot recvfrom");
 	}
-else
+
+#ifdef HAVE_RECVMMSG
+DatagramCount = CR ;
+for (unsigned int i = 0 ; i < DatagramCount ; ++i)
 	{
-	BufferSize -= Size ;
-	memcpy(Message, (void *)Buffer, Size);
-	memmove((void *) Buffer, (void *)(Buffer + Size), BufferSize);
+	DatagramSize[i] = headers[i].msg_len ;
+	RcvdBytesCount += headers[i].msg_len ;
 	}
+#else
+DatagramCount = 1 ;
+DatagramSize[0] = CR ;
+RcvdBytesCount += CR ;
+#endif
+D.Out(pdDebug, "Received %u UDP datagrams.", DatagramCount);
 }
 
 // ----------------------------------------------------------------------------
@@ -354,6 +421,15 @@ D.Out(pdDebug, "Retourner Socket UDP...");
 return _socket_udp ;
 }
 
+// ----------------------------------------------------------------------------
+void
+SocketUDP::setBatch(DatagramBatch *batch, Socket *reliable)
+{
+assert(!PhysicalLink);
+Batch = batch ;
+ReliableLink = reliable ;
+}
+
 // ----------------------------------------------------------------------------
 void
 SocketUDP::setPort(unsigned int port)
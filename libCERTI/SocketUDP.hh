@@ -22,10 +22,21 @@
 
 #include "Socket.hh"
 
-#define BUFFER_MAXSIZE 2000
+#include <vector>
 
 namespace certi {
 
+class DatagramBatch ;
+
+/**
+ * UDP socket. The RTIA reads the best effort messages of the RTIG on a
+ * SocketUDP created by createConnection; the RTIG sends them through a
+ * SocketUDP attached to the address of each RTIA, which appends them to
+ * the DatagramBatch of its event loop when one is set.
+ *
+ * A datagram carries whole messages: receive() never takes a message
+ * across two datagrams.
+ */
 class CERTI_EXPORT SocketUDP : public Socket
 {
 public :
@@ -59,7 +70,19 @@ public :
 	unsigned int getPort() const ;
 	unsigned long getAddr() const ;
 
+	/**
+	 * Send the messages of an attached link through a batch, and the
+	 * messages too large for a datagram through the reliable link.
+	 */
+	void setBatch(DatagramBatch *batch, Socket *reliable);
+
 private:
+	/** Number of datagrams a receive system call may take. */
+	static const unsigned int DATAGRAM_SLOTS = 8 ;
+	static const size_t DATAGRAM_MAXSIZE = 65536 ;
+
+	void receiveDatagrams() throw (NetworkError, NetworkSignal);
+
 	void setPort(unsigned int port);
 
 	int bind();
@@ -82,8 +105,14 @@ private:
 	ByteCount_t SentBytesCount ;
 	ByteCount_t RcvdBytesCount ;
 
-	unsigned long BufferSize ;
-	char Buffer[4096] ;
+	DatagramBatch *Batch ;
+	Socket *ReliableLink ;
+
+	std::vector<char> Datagrams ;  ///< Receive slots, allocated on first receive
+	size_t DatagramSize[DATAGRAM_SLOTS] ;
+	unsigned int DatagramCount ;   ///< Datagrams received in the slots
+	unsigned int DatagramIndex ;   ///< Slot being read
+	size_t DatagramOffset ;        ///< Bytes already read in this slot
 };
 
 } // namespace certi
@@ -30,6 +30,11 @@
 #include <iostream>
 #ifndef _WIN32
 #include <unistd.h>
+#include <poll.h>
+#include <sched.h>
+#include "SHMLink.hh"
+#include "LocalLink.hh"
+#include "Message.hh"
 #endif
 
 using std::string ;
@@ -178,7 +183,8 @@ SocketUN::socketpair()
 //! Does not open the socket, see Init methods.
 SocketUN::SocketUN(SignalHandlerType theType)
     : _socket_un(-1),
-      HandlerType(theType), SentBytesCount(0), RcvdBytesCount(0)
+      HandlerType(theType), SentBytesCount(0), RcvdBytesCount(0),
+      link(NULL), local(NULL), armed(false)
 {
 #ifdef _WIN32
 	SocketTCP::winsockStartup();
@@ -201,6 +207,11 @@ SocketUN::~SocketUN()
 
   pD->Out(pdTerm, "SocketUN: Closed all sockets.");
 
+#ifndef _WIN32
+  delete link ;
+  delete local ;
+#endif
+
 #ifdef _WIN32
   SocketTCP::winsockShutdown();
 #endif
@@ -226,6 +237,13 @@ unsigned long total_sent = 0 ;
 // G.Out(pdGendoc,"enter SocketUN::send");
 assert(0 <= _socket_un);
 
+#ifndef _WIN32
+if (link != NULL) {
+	sendSHM(buffer, size);
+	return ;
+}
+#endif
+
 pD->Out(pdTrace, "Beginning to send UN message...");
 
 while (total_sent < size)
@@ -288,6 +306,26 @@ void SocketUN::error(const char *msg) throw (NetworkError)
 bool
 SocketUN::isDataReady()
 {
+#ifndef _WIN32
+    if (local != NULL) {
+        if (local->isReadable())
+            return true ;
+        if (!armed) {
+            local->setWaiting();
+            armed = true ;
+        }
+        return local->isReadable();
+    }
+    if (link != NULL) {
+        if (link->isReadable())
+            return true ;
+        if (!armed) {
+            link->setWaiting();
+            armed = true ;
+        }
+        return link->isReadable();
+    }
+#endif
 #ifdef SOCKUN_BUFFER_LENGTH
     return RBLength > 0 ;
 #else
@@ -311,6 +349,13 @@ SocketUN::receive(const unsigned char *buffer, size_t Size)
 
 assert(0 <= _socket_un);
 
+#ifndef _WIN32
+if (link != NULL) {
+	receiveSHM(buffer, Size);
+	return ;
+}
+#endif
+
 long nReceived = 0 ;
 
 #ifndef SOCKUN_BUFFER_LENGTH
@@ -386,4 +431,229 @@ RBLength -= Size ;
 // G.Out(pdGendoc,"exit  SocketUN::receive");
 }
 
+// ----------------------------------------------------------------------------
+int
+SocketUN::createSHMLink(size_t ringSize)
+{
+#ifdef _WIN32
+    return -1 ;
+#else
+    int fd = SHMLink::create(ringSize);
+    if (fd == -1)
+        return -1 ;
+
+    link = new SHMLink(fd, true);
+    if (!link->isMapped()) {
+        delete link ;
+        link = NULL ;
+        close(fd);
+        return -1 ;
+    }
+    pD->Out(pdInit, "Messages go through shared memory segment %d.", fd);
+    return fd ;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+bool
+SocketUN::setSHMLinkFD(int fd)
+{
+#ifdef _WIN32
+    return false ;
+#else
+    link = new SHMLink(fd, false);
+    close(fd);
+    if (!link->isMapped()) {
+        delete link ;
+        link = NULL ;
+        return false ;
+    }
+    pD->Out(pdInit, "Messages go through the shared memory segment of the peer.");
+    return true ;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+LocalLink *
+SocketUN::createLocalLink()
+{
+#ifdef _WIN32
+    return NULL ;
+#else
+    local = new LocalLink();
+    pD->Out(pdInit, "Messages go through an in-memory link.");
+    return new LocalLink(*local);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketUN::setLocalLink(LocalLink *side)
+{
+    local = side ;
+    pD->Out(pdInit, "Messages go through the in-memory link of the peer.");
+}
+
+// ----------------------------------------------------------------------------
+//! Give a message to the peer, waking it up if asleep.
+void
+SocketUN::sendMessage(Message *msg)
+    throw (NetworkError, NetworkSignal)
+{
+#ifdef _WIN32
+    delete msg ;
+    throw NetworkError("No in-memory link on this platform.");
+#else
+    if (local->push(msg))
+        ringBell();
+#endif
+}
+
+// ----------------------------------------------------------------------------
+//! Take a message from the in-memory link, sleeping on the socket if empty.
+Message *
+SocketUN::receiveMessage()
+    throw (NetworkError, NetworkSignal)
+{
+#ifdef _WIN32
+    throw NetworkError("No in-memory link on this platform.");
+#else
+    Message *msg ;
+    while ((msg = local->pop()) == NULL) {
+        if (!armed) {
+            // Check the queue again once the flag is visible to the producer.
+            local->setWaiting();
+            armed = true ;
+        }
+        else {
+            readBell();
+            armed = false ;
+        }
+    }
+
+    // The producer which took the flag back is writing its wake up byte.
+    if (armed) {
+        armed = false ;
+        if (!local->clearWaiting())
+            readBell();
+    }
+    return msg ;
+#endif
+}
+
+#ifndef _WIN32
+// ----------------------------------------------------------------------------
+//! Copy a message to the shared memory link, waking the peer up if asleep.
+void
+SocketUN::sendSHM(const unsigned char *buffer, size_t size)
+    throw (NetworkError, NetworkSignal)
+{
+    size_t total_sent = 0 ;
+    int attempt = 0 ;
+
+    while (total_sent < size) {
+        size_t sent = link->write(buffer + total_sent, size - total_sent);
+        if (sent > 0) {
+            total_sent += sent ;
+            attempt = 0 ;
+            if (link->peerWaiting())
+                ringBell();
+        }
+        else {
+            waitForRoom(attempt++);
+        }
+    }
+    SentBytesCount += total_sent ;
+}
+
+// ----------------------------------------------------------------------------
+//! Copy a message from the shared memory link, sleeping on the socket if empty.
+void
+SocketUN::receiveSHM(const unsigned char *buffer, size_t size)
+    throw (NetworkError, NetworkSignal)
+{
+    unsigned char *data = const_cast<unsigned char *>(buffer);
+    size_t total_received = 0 ;
+
+    while (total_received < size) {
+        size_t received = link->read(data + total_received, size - total_received);
+        if (received > 0) {
+            total_received += received ;
+        }
+        else if (!armed) {
+            // Check the ring again once the flag is visible to the producer.
+            link->setWaiting();
+            armed = true ;
+        }
+        else {
+            readBell();
+            armed = false ;
+        }
+    }
+    RcvdBytesCount += total_received ;
+
+    // The producer which took the flag back is writing its wake up byte.
+    if (armed) {
+        armed = false ;
+        if (!link->clearWaiting())
+            readBell();
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! The outgoing ring is full: let the peer run, and check it is still alive.
+void
+SocketUN::waitForRoom(int attempt) throw (NetworkError)
+{
+    if (attempt < 64) {
+        sched_yield();
+        return ;
+    }
+
+    struct pollfd peer ;
+    peer.fd = _socket_un ;
+    peer.events = 0 ;
+    peer.revents = 0 ;
+    if (poll(&peer, 1, 1) > 0 && (peer.revents & (POLLHUP | POLLERR))) {
+        pD->Out(pdExcept, "UN connection has been closed by peer.");
+        throw NetworkError("Connection closed by client.");
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketUN::ringBell() throw (NetworkError, NetworkSignal)
+{
+    const unsigned char bell = 0 ;
+    while (write(_socket_un, &bell, 1) != 1) {
+        if (errno != EINTR) {
+            perror("UN Socket(EmettreUN) : ");
+            throw NetworkError("Error while sending UN message.");
+        }
+        if (HandlerType == stSignalInterrupt)
+            throw NetworkSignal("");
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+SocketUN::readBell() throw (NetworkError, NetworkSignal)
+{
+    unsigned char bell ;
+    long nReceived ;
+    while ((nReceived = read(_socket_un, &bell, 1)) != 1) {
+        if (nReceived == 0) {
+            pD->Out(pdExcept, "UN connection has been closed by peer.");
+            throw NetworkError("Connection closed by client.");
+        }
+        if (errno != EINTR) {
+            perror("UN Socket(RecevoirUN) : ");
+            throw NetworkError("Error while receiving UN message.");
+        }
+        if (HandlerType == stSignalInterrupt)
+            throw NetworkSignal("");
+    }
+}
+#endif
+
 } // namespace certi
@@ -25,6 +25,11 @@
 #include "PrettyDebug.hh"
 
 namespace certi {
+
+class SHMLink ;
+class LocalLink ;
+class Message ;
+
 // Signal Handler Types for a UNIX socket : - stSignalInterrupt :
 // return when read/write operation is interrupted by a signal. The
 // RW operation may not be complete. - stSignalIgnore : Ignore
@@ -51,6 +56,15 @@ typedef enum { stSignalInterrupt, stIgnoreSignal } SignalHandlerType ;
  * data has already been read, and is waiting in the internal buffer.
  * Therefore, before returning to a select loop, be sure to call the
  * IsDataReady method to check whether any data is waiting for processing.
+ *
+ * The messages may also go through a shared memory link (see SHMLink), the
+ * socket then only carrying the wake up bytes of a sleeping peer. The same
+ * rule applies: isDataReady() tells whether data is waiting in the link and
+ * otherwise asks the peer to make the socket readable on its next send.
+ *
+ * When the RTIA runs on a thread of the federate, the messages themselves
+ * go through an in-memory link (see LocalLink) with the same wake up rule,
+ * using sendMessage() and receiveMessage() instead of bytes.
  */
 class CERTI_EXPORT SocketUN
 {
@@ -65,6 +79,35 @@ public:
 	SOCKET socketpair();
 	void setSocketFD(SOCKET fd) { _socket_un = fd; }
 
+	/** Route the messages through a new shared memory link.
+	 *  @return the segment file descriptor to give to the peer, -1 on error
+	 */
+	int createSHMLink(size_t ringSize);
+	/** Route the messages through the shared memory link of the peer.
+	 *  The file descriptor is closed.
+	 */
+	bool setSHMLinkFD(int fd);
+	bool usesSHMLink() const { return link != NULL ; }
+
+	/** Route the messages through a new in-memory link.
+	 *  @return the side of the link to give to the peer, NULL on error
+	 */
+	LocalLink *createLocalLink();
+	/** Route the messages through the given side of an in-memory link,
+	 *  which the socket then owns.
+	 */
+	void setLocalLink(LocalLink *side);
+	bool usesLocalLink() const { return local != NULL ; }
+
+	/** Give a message to the peer through the in-memory link.
+	 *  The peer takes ownership of the message.
+	 */
+	void sendMessage(Message *msg) throw (NetworkError, NetworkSignal);
+	/** Take the next message of the in-memory link, waiting for it.
+	 *  The caller owns the message.
+	 */
+	Message *receiveMessage() throw (NetworkError, NetworkSignal);
+
 	bool isDataReady();
 
 	SOCKET returnSocket();
@@ -88,6 +131,16 @@ private:
 
 	PrettyDebug *pD ;
 
+	SHMLink *link ;
+	LocalLink *local ;
+	bool armed ;
+
+	void sendSHM(const unsigned char *, size_t) throw (NetworkError, NetworkSignal);
+	void receiveSHM(const unsigned char *, size_t) throw (NetworkError, NetworkSignal);
+	void waitForRoom(int attempt) throw (NetworkError);
+	void ringBell() throw (NetworkError, NetworkSignal);
+	void readBell() throw (NetworkError, NetworkSignal);
+
 #ifdef SOCKUN_BUFFER_LENGTH
 // This class can use a buffer to reduce the number of systems
 	// calls when reading a lot of small amouts of data. Each time a
@@ -24,6 +24,7 @@
 #include "ObjectClassBroadcastList.hh"
 #include "InteractionBroadcastList.hh"
 #include "RTIRegion.hh"
+#include "RoutingSpace.hh"
 #include "Subscribable.hh"
 #include "helper.hh"
 #include "PrettyDebug.hh"
@@ -34,6 +35,24 @@ namespace {
 
 PrettyDebug D("SUBSCRIBABLE", __FILE__);
 
+/** Get the regions overlapping an update region from the index of its
+    routing space, instead of testing each subscription region. */
+void
+getOverlapping(const certi::RTIRegion *region, certi::RegionIndex::RegionList &result)
+{
+    if (region != NULL)
+        region->getRoutingSpace().getRegionIndex().overlapping(*region, result);
+}
+
+bool
+isOverlapping(const certi::Subscriber &subscriber, const certi::RTIRegion *region,
+              const certi::RegionIndex::RegionList &overlapping)
+{
+    return region == NULL || subscriber.getRegion() == NULL ||
+        std::binary_search(overlapping.begin(), overlapping.end(),
+                           static_cast<const certi::BaseRegion *>(subscriber.getRegion()));
+}
+
 }
 
 namespace certi {
@@ -114,9 +133,7 @@ Subscribable::~Subscribable()
 void
 Subscribable::unsubscribe(FederateHandle fed)
 {
-    std::remove_if(subscribers.begin(),
-                   subscribers.end(),
-                   HandleComparator<Subscriber>(fed));
+    subscribers.remove_if(HandleComparator<Subscriber>(fed));
 }
 
 // ----------------------------------------------------------------------------
@@ -185,9 +202,12 @@ Subscribable::subscribe(FederateHandle fed, const RTIRegion *region)
 void
 Subscribable::addFederatesIfOverlap(ObjectClassBroadcastList &lst, const RTIRegion *region, Handle handle) const
 {
+    RegionIndex::RegionList overlapping ;
+    getOverlapping(region, overlapping);
+
     std::list<Subscriber>::const_iterator it = subscribers.begin();
     for (; it != subscribers.end(); ++it) {
-	if (it->match(region))
+	if (isOverlapping(*it, region, overlapping))
 	    lst.addFederate(it->getHandle(), handle);
     }
 }
@@ -200,9 +220,12 @@ Subscribable::addFederatesIfOverlap(ObjectClassBroadcastList &lst, const RTIRegi
 void
 Subscribable::addFederatesIfOverlap(InteractionBroadcastList &lst, const RTIRegion *region) const
 {
+    RegionIndex::RegionList overlapping ;
+    getOverlapping(region, overlapping);
+
     std::list<Subscriber>::const_iterator it = subscribers.begin();
     for (; it != subscribers.end(); ++it) {
-	if (it->match(region))
+	if (isOverlapping(*it, region, overlapping))
 	    lst.addFederate(it->getHandle());
     }
 }
@@ -78,6 +78,9 @@ public:
     void addFederatesIfOverlap(ObjectClassBroadcastList &, const RTIRegion *, Handle) const ;
     void addFederatesIfOverlap(InteractionBroadcastList &, const RTIRegion *) const ;
 
+    /** The current subscriptions, one per federate/region pair. */
+    const std::list<Subscriber> &getSubscribers() const { return subscribers ; }
+
 private:
     std::list<Subscriber> subscribers ;
 };
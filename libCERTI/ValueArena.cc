@@ -0,0 +1,215 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#include "ValueArena.hh"
+
+#include <cstring>
+
+namespace certi {
+
+// ----------------------------------------------------------------------------
+ValueArena::ValueArena()
+    : arena(NULL)
+{
+}
+
+// ----------------------------------------------------------------------------
+ValueArena::ValueArena(const ValueArena &other)
+    : arena(other.arena), slices(other.slices)
+{
+    if (arena != NULL)
+        ++arena->references ;
+}
+
+// ----------------------------------------------------------------------------
+ValueArena::ValueArena(const ValueArena &other, const std::vector<uint32_t> &ranks)
+    : arena(other.arena)
+{
+    if (arena != NULL)
+        ++arena->references ;
+    slices.reserve(ranks.size());
+    for (uint32_t i = 0 ; i < ranks.size() ; ++i)
+        slices.push_back(other.slices[ranks[i]]);
+}
+
+// ----------------------------------------------------------------------------
+ValueArena::~ValueArena()
+{
+    release();
+}
+
+// ----------------------------------------------------------------------------
+ValueArena &
+ValueArena::operator=(const ValueArena &other)
+{
+    if (other.arena != NULL)
+        ++other.arena->references ;
+    release();
+    arena = other.arena ;
+    slices = other.slices ;
+    return *this ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::release()
+{
+    if (arena != NULL && --arena->references == 0)
+        delete arena ;
+    arena = NULL ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::resize(uint32_t count)
+{
+    Slice empty = { 0, 0 };
+    slices.resize(count, empty);
+}
+
+// ----------------------------------------------------------------------------
+const char *
+ValueArena::data(uint32_t rank) const
+{
+    return slices[rank].length == 0 ? NULL : &arena->bytes[slices[rank].offset] ;
+}
+
+// ----------------------------------------------------------------------------
+std::vector<char>
+ValueArena::get(uint32_t rank) const
+{
+    const char *value = data(rank);
+    return std::vector<char>(value, value + length(rank));
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::copy(uint32_t rank, std::vector<char> &value) const
+{
+    const char *bytes = data(rank);
+    value.assign(bytes, bytes + length(rank));
+}
+
+// ----------------------------------------------------------------------------
+uint32_t
+ValueArena::append(const char *value, uint32_t length)
+{
+    if (arena == NULL)
+        arena = new Arena();
+    uint32_t offset = arena->bytes.size();
+    arena->bytes.insert(arena->bytes.end(), value, value + length);
+    return offset ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::set(uint32_t rank, const std::vector<char> &value)
+{
+    set(rank, value.empty() ? NULL : &value[0], value.size());
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::set(uint32_t rank, const char *value, uint32_t length)
+{
+    slices[rank].offset = length == 0 ? 0 : append(value, length);
+    slices[rank].length = length ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::erase(uint32_t rank)
+{
+    slices.erase(slices.begin() + rank);
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::overwrite(uint32_t rank, const char *value, uint32_t length)
+{
+    if (arena != NULL && arena->references == 1 && length <= slices[rank].length) {
+        if (length > 0)
+            memcpy(&arena->bytes[slices[rank].offset], value, length);
+        slices[rank].length = length ;
+        return ;
+    }
+
+    set(rank, value, length);
+    uint32_t live = 0 ;
+    for (uint32_t i = 0 ; i < slices.size() ; ++i)
+        live += slices[i].length ;
+    if (arena != NULL && arena->bytes.size() > 2 * live + 1024)
+        compact();
+}
+
+// ----------------------------------------------------------------------------
+//! Move the values to an arena of their own, without the unused bytes.
+void
+ValueArena::compact()
+{
+    Arena *compacted = new Arena();
+    for (uint32_t i = 0 ; i < slices.size() ; ++i) {
+        const char *value = data(i);
+        slices[i].offset = compacted->bytes.size();
+        compacted->bytes.insert(compacted->bytes.end(), value, value + slices[i].length);
+    }
+    release();
+    arena = compacted ;
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::serialize(libhla::MessageBuffer &msgBuffer) const
+{
+    msgBuffer.write_uint32(slices.size());
+    for (uint32_t i = 0 ; i < slices.size() ; ++i) {
+        msgBuffer.write_uint32(slices[i].length);
+        msgBuffer.write_bytes(data(i), slices[i].length);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+ValueArena::deserialize(libhla::MessageBuffer &msgBuffer)
+{
+    // A shared arena is left to the other sets, an unshared one is reused
+    // as is, which saves its allocation to a recycled message.
+    if (arena != NULL && arena->references == 1)
+        arena->bytes.clear();
+    else
+        release();
+    uint32_t count = msgBuffer.read_uint32();
+    slices.resize(count);
+    if (count == 0)
+        return ;
+
+    // The values cannot be longer than the message, so the arena is
+    // allocated once.
+    if (arena == NULL)
+        arena = new Arena();
+    arena->bytes.reserve(msgBuffer.size());
+    for (uint32_t i = 0 ; i < count ; ++i) {
+        slices[i].length = msgBuffer.read_uint32();
+        slices[i].offset = arena->bytes.size();
+        arena->bytes.resize(slices[i].offset + slices[i].length);
+        msgBuffer.read_bytes(&arena->bytes[0] + slices[i].offset, slices[i].length);
+    }
+}
+
+} // namespace certi
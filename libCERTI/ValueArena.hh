@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_VALUE_ARENA_HH
+#define CERTI_VALUE_ARENA_HH
+
+#include "certi.hh"
+#include "MessageBuffer.hh"
+
+#include <vector>
+
+namespace certi {
+
+/**
+ * Attribute or parameter values of a network message.
+ *
+ * The values are slices of a single byte arena, which copies of the set
+ * share instead of duplicating it. A message read from the network gets all
+ * its values with one allocation, and the messages the RTIG builds from it
+ * (the broadcast one and its reduced variants) only reference that arena.
+ * The arena only grows, so that a set can add values without disturbing the
+ * other sets sharing it. Like the messages, sets are not thread safe.
+ */
+class CERTI_EXPORT ValueArena
+{
+public:
+    ValueArena();
+    ValueArena(const ValueArena &other);
+    /** Share the values of other whose ranks are given, in that order. */
+    ValueArena(const ValueArena &other, const std::vector<uint32_t> &ranks);
+    ~ValueArena();
+
+    ValueArena &operator=(const ValueArena &other);
+
+    uint32_t size() const { return slices.size(); }
+    /** Change the number of values, new ones being empty. */
+    void resize(uint32_t count);
+
+    const char *data(uint32_t rank) const ;
+    uint32_t length(uint32_t rank) const { return slices[rank].length ; }
+
+    /** Copy of one value. */
+    std::vector<char> get(uint32_t rank) const ;
+    void copy(uint32_t rank, std::vector<char> &value) const ;
+
+    void set(uint32_t rank, const std::vector<char> &value);
+    void set(uint32_t rank, const char *value, uint32_t length);
+    void erase(uint32_t rank);
+    /** Replace one value again and again without growing for ever: in place
+        when the arena is not shared and the new value is not longer, else
+        appended, the arena being rebuilt with the live values only once it
+        holds mostly dead ones. */
+    void overwrite(uint32_t rank, const char *value, uint32_t length);
+
+    /** Same encoding as a repeated field of byte arrays. */
+    void serialize(libhla::MessageBuffer &msgBuffer) const ;
+    void deserialize(libhla::MessageBuffer &msgBuffer);
+
+private:
+    struct Arena {
+        Arena() : references(1) {}
+        int references ;
+        std::vector<char> bytes ;
+    };
+    struct Slice {
+        uint32_t offset ;
+        uint32_t length ;
+    };
+
+    /** Append bytes to the arena, which is created if needed. */
+    uint32_t append(const char *value, uint32_t length);
+    void release();
+    void compact();
+
+    Arena *arena ;
+    std::vector<Slice> slices ;
+};
+
+} // namespace certi
+
+#endif // CERTI_VALUE_ARENA_HH
@@ -0,0 +1,118 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#include "WireBuffer.hh"
+#include "PrettyDebug.hh"
+#include "EventTrace.hh"
+
+namespace certi {
+
+static PrettyDebug D("WIREBUF", "(WireBuffer) - ");
+
+// ----------------------------------------------------------------------------
+WireBuffer::WireBuffer()
+    : shared(NULL)
+{
+}
+
+// ----------------------------------------------------------------------------
+WireBuffer::WireBuffer(NetworkMessage &msg)
+    : shared(new Shared())
+{
+    shared->references = 1 ;
+    shared->type = msg.getMessageType();
+    shared->federation = msg.getFederation();
+    shared->federate = msg.getFederate();
+    msg.encode(shared->buffer);
+    D.Out(pdDebug, "<%s> encoded once in %u bytes.",
+          msg.getMessageName(), shared->buffer.size());
+}
+
+// ----------------------------------------------------------------------------
+WireBuffer::WireBuffer(const WireBuffer &other)
+    : shared(other.shared)
+{
+    if (shared != NULL)
+        ++shared->references ;
+}
+
+// ----------------------------------------------------------------------------
+WireBuffer &
+WireBuffer::operator=(const WireBuffer &other)
+{
+    if (other.shared != NULL)
+        ++other.shared->references ;
+    release();
+    shared = other.shared ;
+    return *this ;
+}
+
+// ----------------------------------------------------------------------------
+WireBuffer::~WireBuffer()
+{
+    release();
+}
+
+// ----------------------------------------------------------------------------
+void
+WireBuffer::release()
+{
+    if (shared != NULL && --shared->references == 0)
+        delete shared ;
+    shared = NULL ;
+}
+
+// ----------------------------------------------------------------------------
+const unsigned char *
+WireBuffer::data() const
+{
+    return shared ? static_cast<const unsigned char *>(shared->buffer(0)) : NULL ;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+WireBuffer::size() const
+{
+    return shared ? shared->buffer.size() : 0 ;
+}
+
+// ----------------------------------------------------------------------------
+void
+WireBuffer::send(Socket *socket, TransportType transport) const
+    throw (NetworkError, NetworkSignal)
+{
+    if (socket == NULL || shared == NULL) {
+        D.Out(pdDebug, "Not sending -- socket is deleted.");
+        return ;
+    }
+    if (EventTrace::isEnabled())
+        EventTrace::record(TRACE_NETWORK_SEND, shared->type, shared->federation, shared->federate,
+                           socket->returnSocket(), shared->buffer.size());
+    const unsigned char *bytes = static_cast<const unsigned char *>(shared->buffer(0));
+    if (transport == BEST_EFFORT)
+        socket->sendBestEffort(bytes, shared->buffer.size());
+    else
+        socket->send(bytes, shared->buffer.size());
+}
+
+} // namespace certi
@@ -0,0 +1,87 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This file is part of CERTI-libCERTI
+//
+// CERTI-libCERTI is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// CERTI-libCERTI is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_WIRE_BUFFER_HH
+#define CERTI_WIRE_BUFFER_HH
+
+#include "certi.hh"
+#include "NetworkMessage.hh"
+#include "Socket.hh"
+
+namespace certi {
+
+/**
+ * A network message encoded once and shared by every link it is sent to.
+ *
+ * Broadcasts build one WireBuffer and write the same bytes on each
+ * destination socket instead of serializing the message again for every
+ * federate. Copies share the encoded bytes, which are released with the
+ * last copy, so that they may outlive the broadcast which built them.
+ *
+ * The reference count is not atomic: copies never leave the event loop
+ * that built them. With the RTIG shards, a link handed off to another
+ * shard carries copied bytes, not WireBuffer copies; keep it that way.
+ */
+class CERTI_EXPORT WireBuffer
+{
+public:
+    /** Build an empty buffer (nothing to send). */
+    WireBuffer();
+
+    /** Encode the given message, see NetworkMessage::encode. */
+    explicit WireBuffer(NetworkMessage &msg);
+
+    WireBuffer(const WireBuffer &other);
+    WireBuffer &operator=(const WireBuffer &other);
+    ~WireBuffer();
+
+    bool empty() const { return shared == NULL ; }
+    const unsigned char *data() const ;
+    size_t size() const ;
+
+    /**
+     * Write the encoded message on the socket, a BEST_EFFORT one with
+     * Socket::sendBestEffort.
+     * A NULL socket (killed federate) is ignored as in NetworkMessage::send.
+     */
+    void send(Socket *socket, TransportType transport = RELIABLE) const
+        throw (NetworkError, NetworkSignal);
+
+private:
+    struct Shared {
+        MessageBuffer buffer ;
+        unsigned int references ;
+        // Header of the message, for EventTrace
+        NetworkMessage::Type type ;
+        Handle federation ;
+        FederateHandle federate ;
+    };
+
+    void release();
+
+    Shared *shared ;
+};
+
+} // namespace certi
+
+#endif // CERTI_WIRE_BUFFER_HH
@@ -24,6 +24,104 @@
 #include <iomanip>
 #include <cstring>
 #include <cstdio>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/*
+ * Bulk byte swapping of n values of W bytes from 'from' to 'to', none of
+ * them being necessarily aligned. The vector loops are chosen at compile
+ * time from the instruction sets the compiler targets: AVX2 and SSSE3
+ * shuffle bytes, SSE2 (always there on x86_64) shifts and shuffles words.
+ * The scalar loop swaps what is left.
+ */
+template <unsigned W> inline void swapValue(uint8_t* to, const uint8_t* from);
+
+template <> inline void swapValue<2>(uint8_t* to, const uint8_t* from) {
+	uint16_t an_uint16;
+	memcpy(&an_uint16, from, 2);
+	an_uint16 = LIBHLA_UINT16_SWAP_BYTES(an_uint16);
+	memcpy(to, &an_uint16, 2);
+}
+
+template <> inline void swapValue<4>(uint8_t* to, const uint8_t* from) {
+	uint32_t an_uint32;
+	memcpy(&an_uint32, from, 4);
+	an_uint32 = LIBHLA_UINT32_SWAP_BYTES(an_uint32);
+	memcpy(to, &an_uint32, 4);
+}
+
+template <> inline void swapValue<8>(uint8_t* to, const uint8_t* from) {
+	/* swap the two halves, as well as their bytes */
+	swapValue<4>(to, from+4);
+	swapValue<4>(to+4, from);
+}
+
+#if defined(__SSSE3__)
+/* Shuffle mask reversing the bytes of each W bytes value of 16 bytes. */
+template <unsigned W> inline __m128i swapMask() {
+	uint8_t mask[16];
+	for (unsigned i = 0; i < 16; ++i) {
+		mask[i] = static_cast<uint8_t>((i / W) * W + (W - 1 - i % W));
+	}
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+#elif defined(__SSE2__)
+/* Reverse the bytes of each W bytes value of v. */
+template <unsigned W> inline __m128i swapVector(__m128i v);
+
+template <> inline __m128i swapVector<2>(__m128i v) {
+	return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+template <> inline __m128i swapVector<4>(__m128i v) {
+	v = swapVector<2>(v);
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+}
+
+template <> inline __m128i swapVector<8>(__m128i v) {
+	v = swapVector<2>(v);
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+}
+#endif
+
+template <unsigned W>
+void swapBytes(uint8_t* to, const uint8_t* from, uint32_t n) {
+	const uint32_t bytes = W*n;
+	uint32_t i = 0;
+#if defined(__AVX2__)
+	const __m256i mask256 = _mm256_broadcastsi128_si256(swapMask<W>());
+	for (; i+32 <= bytes; i += 32) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from+i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(to+i), _mm256_shuffle_epi8(v, mask256));
+	}
+#endif
+#if defined(__SSSE3__)
+	const __m128i mask = swapMask<W>();
+	for (; i+16 <= bytes; i += 16) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from+i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(to+i), _mm_shuffle_epi8(v, mask));
+	}
+#elif defined(__SSE2__)
+	for (; i+16 <= bytes; i += 16) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from+i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(to+i), swapVector<W>(v));
+	}
+#endif
+	for (; i < bytes; i += W) {
+		swapValue<W>(to+i, from+i);
+	}
+}
+
+} // anonymous namespace
 
 namespace libhla {
 
@@ -110,6 +208,15 @@ void MessageBuffer::reallocate(uint32_t n) {
 	}
 } /* end of MessageBuffer::MessageBuffer(uint32_t) */
 
+void MessageBuffer::reserve(uint32_t n) {
+	if (n >= (bufferMaxSize - writeOffset)) {
+		/* reallocate buffer on-demand, at least doubling it so that
+		 * a series of writes only reallocates a few times */
+		reallocate(std::max(2*bufferMaxSize,
+				writeOffset + n + DEFAULT_MESSAGE_BUFFER_SIZE));
+	}
+} /* end of MessageBuffer::reserve(uint32_t) */
+
 MessageBuffer::~MessageBuffer() {
 	if (NULL!=buffer) {
 		delete[] buffer;
@@ -174,6 +281,18 @@ void MessageBuffer::assumeSizeFromReservedBytes() {
 	assumeSize(toBeAssumedSize);
 } /* end of assumeSizeFromReservedBytes */
 
+uint32_t MessageBuffer::sizeFromReservedBytes(const void* reserved) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(reserved);
+	/* reserved byte 0 tells the endianity of bytes 1..4 */
+	if (bytes[0]==0x01) {
+		return (uint32_t(bytes[1]) << 24) | (uint32_t(bytes[2]) << 16)
+			| (uint32_t(bytes[3]) << 8) | uint32_t(bytes[4]);
+	} else {
+		return (uint32_t(bytes[4]) << 24) | (uint32_t(bytes[3]) << 16)
+			| (uint32_t(bytes[2]) << 8) | uint32_t(bytes[1]);
+	}
+} /* end of sizeFromReservedBytes */
+
 void MessageBuffer::setSizeInReservedBytes(uint32_t n) {
 	uint32_t oldWR_Offset;
 	/* backup write Offset */
@@ -188,11 +307,7 @@ void MessageBuffer::setSizeInReservedBytes(uint32_t n) {
 
 int32_t MessageBuffer::write_uint8s(const uint8_t* data, uint32_t n) {
 	//std::cerr  << "write_uint8s(" << data << " = [" << (n ? data[0] : 0) <<" ...], " << n << ")" << std::endl;
-    	if (n >= (bufferMaxSize - writeOffset)) {
-		/* reallocate buffer on-demand */
-		reallocate(bufferMaxSize+ (n-(bufferMaxSize-writeOffset))
-				+ DEFAULT_MESSAGE_BUFFER_SIZE);
-	}
+	reserve(n);
 	/* copy data */
 	memcpy(buffer+writeOffset, data, n);
 	/* update write offset */
@@ -216,34 +331,20 @@ int32_t MessageBuffer::read_uint8s(uint8_t* data, uint32_t n) {
 } /* end of MessageBuffer::read_uint8s(uint8_t*, uint32_t) */
 
 int32_t MessageBuffer::write_uint16s(const uint16_t* data, uint32_t n) {
-	uint32_t i;
-	uint16_t an_uint16;
 	//std::cerr  << "write_uint16s(" << data << " = [" << (n ? data[0] : 0) <<" ...], " << n << ")" << std::endl;
-	
-	if ((2*n) >= (bufferMaxSize - writeOffset)) {
-		/* reallocate buffer on-demand */
-		reallocate(bufferMaxSize+ (2*n)-(bufferMaxSize - writeOffset)
-				+ DEFAULT_MESSAGE_BUFFER_SIZE);
-	}
+	reserve(2*n);
 
 	/* do not swap byte if it is not necessary */
 	if (bufferHasMyEndianness) {
 		memcpy(buffer+writeOffset, data, 2*n);
-		writeOffset += 2*n;
 	} else {
-		for (i=0; i<n; ++i) {
-			an_uint16 = LIBHLA_UINT16_SWAP_BYTES(data[i]);
-			memcpy(buffer+writeOffset, &an_uint16, 2);
-			writeOffset += 2;
-		}
+		swapBytes<2>(buffer+writeOffset, reinterpret_cast<const uint8_t*>(data), n);
 	}
+	writeOffset += 2*n;
 	return (writeOffset-2*n);
 } /* end of MessageBuffer::write_uint16s(uint16_t*, uint32_t) */
 
 int32_t MessageBuffer::read_uint16s(uint16_t* data, uint32_t n) {
-	uint32_t i;
-	uint16_t an_uint16;
-
 	if (2*n + readOffset > writeOffset) {
 		throw MessageBufferError(stringize()
 			<< "read_uint16s::invalid read of size <" << 2*n
@@ -255,48 +356,28 @@ int32_t MessageBuffer::read_uint16s(uint16_t* data, uint32_t n) {
 	/* do not swap byte if it is not necessary */
 	if (bufferHasMyEndianness) {
 		memcpy(data, buffer+readOffset, 2*n);
-		readOffset += 2*n;
 	} else {
-		for (i=0; i<n; ++i) {
-			memcpy(&an_uint16, buffer+readOffset,2);
-			data[i] = LIBHLA_UINT16_SWAP_BYTES(an_uint16);
-			readOffset += 2;
-		}
+		swapBytes<2>(reinterpret_cast<uint8_t*>(data), buffer+readOffset, n);
 	}
-	
-	//std::cerr  << "read_uint16s(" << data << " = [" << (n ? data[0] : 0) <<" ...], " << n << ")" << std::endl;
+	readOffset += 2*n;
 	return (readOffset-2*n);
 } /* end of MessageBuffer::read_uint16s(uint16_t*, uint32_t) */
 
 int32_t MessageBuffer::write_uint32s(const uint32_t* data, uint32_t n) {
-	uint32_t i;
-	uint32_t an_uint32;
 	//std::cerr  << "write_uint32s(" << data << " = [" << (n ? data[0] : 0) <<" ...], " << n << ")" << std::endl;
-	
-	if ((4*n) >= (bufferMaxSize - writeOffset)) {
-		/* reallocate buffer on-demand */
-		reallocate(bufferMaxSize+ (4*n)-(bufferMaxSize - writeOffset)
-				+ DEFAULT_MESSAGE_BUFFER_SIZE);
-	}
+	reserve(4*n);
 
 	/* do not swap byte if it is not necessary */
 	if (bufferHasMyEndianness) {
 		memcpy(buffer+writeOffset, data, 4*n);
-		writeOffset += 4*n;
 	} else {
-		for (i=0; i<n; ++i) {
-			an_uint32 = LIBHLA_UINT32_SWAP_BYTES(data[i]);
-			memcpy(buffer+writeOffset,&an_uint32,4);
-			writeOffset += 4;
-		}
+		swapBytes<4>(buffer+writeOffset, reinterpret_cast<const uint8_t*>(data), n);
 	}
+	writeOffset += 4*n;
 	return (writeOffset-4*n);
 } /* end of write_uint32s */
 
 int32_t MessageBuffer::read_uint32s(uint32_t* data, uint32_t n) {
-	uint32_t i;
-	uint32_t an_uint32;
-
 	if (4*n + readOffset > writeOffset) {
 		throw MessageBufferError(stringize()
 			<< "read_uint32s::invalid read of size <" << 4*n
@@ -308,64 +389,33 @@ int32_t MessageBuffer::read_uint32s(uint32_t* data, uint32_t n) {
 	/* do not swap byte if it is not necessary */
 	if (bufferHasMyEndianness) {
 		memcpy(data, buffer+readOffset, 4*n);
-		readOffset += 4*n;
 	} else {
-		for (i=0; i<n; ++i) {
-			memcpy(&an_uint32,buffer+readOffset,4);
-			data[i] = LIBHLA_UINT32_SWAP_BYTES(an_uint32);
-			readOffset += 4;
-		}
+		swapBytes<4>(reinterpret_cast<uint8_t*>(data), buffer+readOffset, n);
 	}
-	//std::cerr  << "read_uint32s(" << data << " = [" << (n ? data[0] : 0) <<" ...], " << n << ")" << std::endl;
+	readOffset += 4*n;
 	return (readOffset-4*n);
 } /* end of read_uint32s */
 
 int32_t MessageBuffer::write_uint64s(const uint64_t* data, uint32_t n) {
-	uint32_t i;
-	union deux32 {
-		uint32_t    ui32[2];
-		uint64_t    ui64;
-	} a_deux32;
-	uint32_t an_uint32;
-
 	//std::cerr  << "write_uint64s(" << data << " = [" << (n ? data[0] : 0) <<" ...], " << n << ")" << std::endl;
-
-	if ((8*n) >= (bufferMaxSize - writeOffset)) {
-		/* reallocate buffer on-demand */
-		reallocate(bufferMaxSize+ (8*n)-(bufferMaxSize - writeOffset)
-				+ DEFAULT_MESSAGE_BUFFER_SIZE);
-	}
+	reserve(8*n);
 
 	/* do not swap byte if it is not necessary */
 	if (bufferHasMyEndianness) {
 		memcpy(buffer+writeOffset, data, 8*n);
-		writeOffset += 8*n;
 	} else {
-		for (i=0; i<n; ++i) {
-			a_deux32.ui64 = data[i];
-			an_uint32 = LIBHLA_UINT32_SWAP_BYTES(a_deux32.ui32[1]);
-			memcpy(buffer+writeOffset,&an_uint32,4);
-			writeOffset += 4;
-			an_uint32 = LIBHLA_UINT32_SWAP_BYTES(a_deux32.ui32[0]);
-			memcpy(buffer+writeOffset,&an_uint32,4);
-			writeOffset += 4;
-		}
+		swapBytes<8>(buffer+writeOffset, reinterpret_cast<const uint8_t*>(data), n);
 	}
+	writeOffset += 8*n;
 	return (writeOffset-8*n);
 } /* end of write_uint64s */
 
 int32_t MessageBuffer::read_uint64s(uint64_t* data, uint32_t n) {
-	uint32_t i;
-	union deux32 {
-			uint32_t    ui32[2];
-			uint64_t    ui64;
-	} a_deux32;
-	uint32_t an_uint32;
 	//std::cerr  << "read_uint64s(" << data << " = [" << (n ? data[0] : 0) <<" ...], " << n << ")" << std::endl;
 
 	if (8*n + readOffset > writeOffset) {
 		throw MessageBufferError(stringize()
-			<< "read_uint64s::invalid read of size <" << 4*n
+			<< "read_uint64s::invalid read of size <" << 8*n
 			<< "> inside a buffer of readable size <"
 			<< (int32_t)writeOffset-readOffset << "> (writeOffset="
 			<< writeOffset << ",readOffset="<<readOffset <<").");
@@ -374,20 +424,10 @@ int32_t MessageBuffer::read_uint64s(uint64_t* data, uint32_t n) {
 	/* do not swap byte if it is not necessary */
 	if (bufferHasMyEndianness) {
 		memcpy(data, buffer+readOffset, 8*n);
-		readOffset += 8*n;
 	} else {
-		for (i=0; i<n; ++i) {
-			memcpy(&an_uint32,buffer+readOffset,4);
-			a_deux32.ui32[1] = LIBHLA_UINT32_SWAP_BYTES(an_uint32);
-			readOffset += 4;
-
-			memcpy(&an_uint32,buffer+readOffset,4);
-			a_deux32.ui32[0] = LIBHLA_UINT32_SWAP_BYTES(an_uint32);
-			readOffset += 4;
-
-			data[i] = a_deux32.ui64;
-		}
+		swapBytes<8>(reinterpret_cast<uint8_t*>(data), buffer+readOffset, n);
 	}
+	readOffset += 8*n;
 	return (readOffset-8*n);
 }
 
@@ -40,6 +40,9 @@ namespace libhla {
  * One must read from the buffer in the exact order the write was done.
  * MessageBuffer is dynamically sized, however reallocation are
  * only done when needed.
+ * A buffer is written in the byte order of the writing host, which the
+ * first reserved byte tells, and the reader swaps bytes only if its own
+ * order differs: hosts of the same endianness never swap.
  */
 class HLA_EXPORT MessageBuffer
 {
@@ -159,6 +162,16 @@ public:
 	 */
 	void assumeSizeFromReservedBytes();
 
+	/**
+	 * The size of a message, reserved bytes included, read from
+	 * the reserved bytes at the given address, as
+	 * assumeSizeFromReservedBytes does.
+	 * This may be used to find where a message ends in a stream
+	 * before copying it into a buffer.
+	 * @param[in] reserved the reservedBytes first bytes of a message
+	 */
+	static uint32_t sizeFromReservedBytes(const void* reserved);
+
 #define DECLARE_SIGNED(type)				\
 	int32_t						\
 	write_##type##s(const type##_t* data, uint32_t n) {		\
@@ -332,6 +345,12 @@ private:
 	 */
 	void reallocate(uint32_t n);
 
+	/**
+	 * Make room for n more bytes after the write offset.
+	 * The buffer grows at least twofold when it must be reallocated.
+	 */
+	void reserve(uint32_t n);
+
 	/**
 	 * Update reserved bytes in order to indicate
 	 * the actual size of the buffer.
@@ -26,10 +26,12 @@ using std::endl;
 
 #include "config.h"
 #include "MessageBuffer.hh"
+#include "Clock.hh"
 #include <cassert>
 #include <string>
 #include <cstring>
 #include <cstdio>
+#include <vector>
 
 void messageBufferTests(libhla::MessageBuffer& MsgBuf) {
 	libhla::MessageBuffer MsgBuf2;
@@ -214,6 +216,126 @@ void messageBufferTests(libhla::MessageBuffer& MsgBuf) {
 	cout << "Testing MessageBuffer class END."<<endl;
 } /* end of messageBufferTests */
 
+/* Assume the buffer has the other endianness than the host one. */
+void assumeOtherEndianness(libhla::MessageBuffer& MsgBuf) {
+	if (libhla::MessageBuffer::HostIsBigEndian()) {
+		MsgBuf.assumeBufferIsLittleEndian();
+	} else {
+		MsgBuf.assumeBufferIsBigEndian();
+	}
+}
+
+/* True if the W bytes of each of the n values of a are those of b reversed. */
+bool isSwapped(const void* a, const void* b, uint32_t n, uint32_t W) {
+	const uint8_t* ua = static_cast<const uint8_t*>(a);
+	const uint8_t* ub = static_cast<const uint8_t*>(b);
+	for (uint32_t i=0; i<n*W; ++i) {
+		if (ua[i] != ub[(i/W)*W + W-1-i%W]) return false;
+	}
+	return true;
+}
+
+void messageBufferArrayTests() {
+	cout << "Testing MessageBuffer arrays BEGIN..."<<endl;
+	/* odd sizes so that both the vector and the scalar swaps are used */
+	const uint32_t sizes[] = { 0, 1, 3, 7, 8, 17, 33, 67, 1031 };
+	for (unsigned s=0; s<sizeof(sizes)/sizeof(sizes[0]); ++s) {
+		uint32_t n = sizes[s];
+		std::vector<uint16_t> u16(n+1), vu16(n+1);
+		std::vector<uint32_t> u32(n+1), vu32(n+1);
+		std::vector<uint64_t> u64(n+1), vu64(n+1);
+		std::vector<double>   d64(n+1), vd64(n+1);
+		for (uint32_t i=0; i<n; ++i) {
+			u16[i] = static_cast<uint16_t>(0x0102 + 0x1111*i);
+			u32[i] = 0x01020304U + 0x11111111U*i;
+			u64[i] = (static_cast<uint64_t>(u32[i]) << 32) | (0x05060708U + i);
+			d64[i] = 3.1415927*i - 2.7182818;
+		}
+		libhla::MessageBuffer MsgBuf;
+		/* one byte first, so that the values are not aligned */
+		MsgBuf.write_uint8(0xA5);
+		MsgBuf.write_uint16s(&u16[0],n);
+		MsgBuf.write_uint32s(&u32[0],n);
+		MsgBuf.write_uint64s(&u64[0],n);
+		MsgBuf.write_doubles(&d64[0],n);
+		/* reading with the host endianness gives the values back... */
+		assert(MsgBuf.read_uint8()==0xA5);
+		MsgBuf.read_uint16s(&vu16[0],n); assert(vu16==u16);
+		MsgBuf.read_uint32s(&vu32[0],n); assert(vu32==u32);
+		MsgBuf.read_uint64s(&vu64[0],n); assert(vu64==u64);
+		MsgBuf.read_doubles(&vd64[0],n); assert(vd64==d64);
+		/* ...reading with the other one gives their bytes reversed... */
+		MsgBuf.reset();
+		MsgBuf.write_uint8(0xA5);
+		MsgBuf.write_uint16s(&u16[0],n);
+		MsgBuf.write_uint32s(&u32[0],n);
+		MsgBuf.write_uint64s(&u64[0],n);
+		assumeOtherEndianness(MsgBuf);
+		assert(MsgBuf.read_uint8()==0xA5);
+		MsgBuf.read_uint16s(&vu16[0],n); assert(isSwapped(&vu16[0],&u16[0],n,2));
+		MsgBuf.read_uint32s(&vu32[0],n); assert(isSwapped(&vu32[0],&u32[0],n,4));
+		MsgBuf.read_uint64s(&vu64[0],n); assert(isSwapped(&vu64[0],&u64[0],n,8));
+		/* ...and so does writing with the other one */
+		MsgBuf.reset();
+		assumeOtherEndianness(MsgBuf);
+		MsgBuf.write_uint8(0xA5);
+		MsgBuf.write_uint16s(&u16[0],n);
+		MsgBuf.write_uint32s(&u32[0],n);
+		MsgBuf.write_uint64s(&u64[0],n);
+		MsgBuf.write_doubles(&d64[0],n);
+		assert(isSwapped(MsgBuf(MsgBuf.reservedBytes+1),&u16[0],n,2));
+		assert(isSwapped(MsgBuf(MsgBuf.reservedBytes+1+2*n),&u32[0],n,4));
+		assert(isSwapped(MsgBuf(MsgBuf.reservedBytes+1+6*n),&u64[0],n,8));
+		assert(MsgBuf.read_uint8()==0xA5);
+		MsgBuf.read_uint16s(&vu16[0],n); assert(vu16==u16);
+		MsgBuf.read_uint32s(&vu32[0],n); assert(vu32==u32);
+		MsgBuf.read_uint64s(&vu64[0],n); assert(vu64==u64);
+		MsgBuf.read_doubles(&vd64[0],n); assert(vd64==d64);
+	}
+	cout << "    All encoded/decoded arrays are equal." << endl;
+	cout << "Testing MessageBuffer arrays END."<<endl;
+} /* end of messageBufferArrayTests */
+
+/*
+ * Write then read large arrays of doubles and of 32 bits integers,
+ * in the host byte order and swapped, and show the throughput.
+ */
+void messageBufferBenchmark() {
+	const uint32_t n = 1 << 18;
+	const int rounds = 8;
+	libhla::clock::Clock* clk = libhla::clock::Clock::getBestClock();
+	std::vector<double>   d64(n, 2.7182818), vd64(n);
+	std::vector<uint32_t> u32(n, 0xFFAAEEBB), vu32(n);
+	libhla::MessageBuffer MsgBuf;
+
+	cout << "Benchmarking MessageBuffer arrays BEGIN..."<<endl;
+	for (int swapped=0; swapped<2; ++swapped) {
+		uint64_t start = clk->getCurrentTicksValue();
+		for (int r=0; r<rounds; ++r) {
+			MsgBuf.reset();
+			if (swapped) assumeOtherEndianness(MsgBuf);
+			MsgBuf.write_doubles(&d64[0],n);
+			MsgBuf.read_doubles(&vd64[0],n);
+		}
+		double doubles = clk->getDeltaNanoSecond(start);
+		start = clk->getCurrentTicksValue();
+		for (int r=0; r<rounds; ++r) {
+			MsgBuf.reset();
+			if (swapped) assumeOtherEndianness(MsgBuf);
+			MsgBuf.write_uint32s(&u32[0],n);
+			MsgBuf.read_uint32s(&vu32[0],n);
+		}
+		double uint32s = clk->getDeltaNanoSecond(start);
+		assert(vd64==d64 && vu32==u32);
+		printf("    %s: doubles %.1f MB/s, uint32s %.1f MB/s (written and read)\n",
+		       swapped ? "swapped" : "host order",
+		       2.0*rounds*n*sizeof(double)*1e3/doubles,
+		       2.0*rounds*n*sizeof(uint32_t)*1e3/uint32s);
+	}
+	delete clk;
+	cout << "Benchmarking MessageBuffer arrays END."<<endl;
+} /* end of messageBufferBenchmark */
+
 int
 main(int argc, char **argv)
 {
@@ -231,6 +353,8 @@ main(int argc, char **argv)
 	}
 	cout << endl;
 	messageBufferTests(MsgBuf);
+	messageBufferArrayTests();
+	messageBufferBenchmark();
 
 	cout << "LibHLA MessageBuffer Test->END." <<endl;
     /* getchar(); */
@@ -27,6 +27,9 @@
 #include "RTItypesImp.hh"
 #include "PrettyDebug.hh"
 #include "M_Classes.hh"
+#ifndef _WIN32
+#include "RTIAThread.hh"
+#endif
 #include <sstream>
 #include <iostream>
 #include <memory>
@@ -76,6 +79,7 @@ RTIambPrivateRefs::RTIambPrivateRefs()
 	handle_RTIA  = (HANDLE)-1;
 #else
 	pid_RTIA     = (pid_t)-1;
+	thread_RTIA  = NULL;
 #endif
 	is_reentrant = false;
 	_theRootObj  = NULL;
@@ -85,6 +89,10 @@ RTIambPrivateRefs::RTIambPrivateRefs()
 RTIambPrivateRefs::~RTIambPrivateRefs()
 {
 	delete socketUn ;
+#ifndef _WIN32
+	// The RTIA thread ends once its federate socket is closed.
+	delete thread_RTIA ;
+#endif
 }
 
 // ----------------------------------------------------------------------------
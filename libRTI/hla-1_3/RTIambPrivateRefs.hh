@@ -27,9 +27,12 @@
 #include "Message.hh"
 #include "RootObject.hh"
 #include "MessageBuffer.hh"
+#include "CallbackBatch.hh"
 
 using namespace certi ;
 
+namespace certi { namespace rtia { class RTIAThread ; } }
+
 class RTIambPrivateRefs
 {
 public:
@@ -46,6 +49,7 @@ public:
 	  HANDLE	handle_RTIA;
 #else
     pid_t pid_RTIA ; //!< pid associated with rtia fork (private).
+    certi::rtia::RTIAThread *thread_RTIA ; //!< RTIA running in this process, or NULL.
 #endif
 
     //! Federate Ambassador reference for module calls.
@@ -58,6 +62,9 @@ public:
 
     SocketUN *socketUn ;
     MessageBuffer msgBufSend,msgBufReceive ;
+    //! Callbacks read by tick() and not delivered yet, kept from one
+    //! tick() to the next when a callback throws.
+    CallbackBatch callbacks ;
 };
 
 // $Id: RTIambPrivateRefs.hh,v 1.1 2014/03/03 15:18:23 erk Exp $
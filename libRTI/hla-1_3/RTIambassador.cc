@@ -29,6 +29,12 @@
 
 #include "Message.hh"
 #include "M_Classes.hh"
+#include "CallbackBatch.hh"
+#include "MessagePool.hh"
+#include "EventTrace.hh"
+#ifndef _WIN32
+#include "RTIAThread.hh"
+#endif
 #include "PrettyDebug.hh"
 
 #include "config.h"
@@ -38,6 +44,7 @@
 #include <string.h>
 #else 
 #include <unistd.h>
+#include <fcntl.h>
 #endif
 #include <cstdlib>
 #include <iostream>
@@ -161,13 +168,31 @@ assignPHVPSToRequest(const std::vector<std::pair<RTI::ParameterHandle, Parameter
 /*! When a new RTIambassador is created in the application, a new process rtia
   is launched. This process is used for data exchange with rtig server.
   This process connects to rtia after one second delay (UNIX socket).
+  With CERTI_RTIA_THREAD, the RTIA runs on a thread of the federate instead.
  */
 
 RTI::RTIambassador::RTIambassador()
 throw (RTI::MemoryExhausted, RTI::RTIinternalError)
+{
+	startRTIA(RTIA_FROM_ENVIRONMENT);
+}
+
+// ----------------------------------------------------------------------------
+//! Start the RTIA at the given location, CERTI_RTIA_THREAD being ignored.
+RTI::RTIambassador::RTIambassador(RTIALocation rtia)
+throw (RTI::MemoryExhausted, RTI::RTIinternalError)
+{
+	startRTIA(rtia);
+}
+
+// ----------------------------------------------------------------------------
+void
+RTI::RTIambassador::startRTIA(RTIALocation rtia)
+throw (RTI::MemoryExhausted, RTI::RTIinternalError)
 {
 	G.Out(pdGendoc,"enter RTIambassador::RTIambassador");
 	PrettyDebug::setFederateName( "LibRTI::UnjoinedFederate" );
+	EventTrace::configure("federate");
 	std::stringstream msg;
 
 	privateRefs = new RTIambPrivateRefs();
@@ -200,6 +225,28 @@ throw (RTI::MemoryExhausted, RTI::RTIinternalError)
 	}
 #endif
 
+#if !defined(_WIN32) && !defined(RTIA_USE_TCP)
+	// RTIA_THREAD: no process, the RTIA runs on a thread of the
+	// federate and the link carries the messages themselves.
+	if (rtia == RTIA_THREAD
+	    || (rtia == RTIA_FROM_ENVIRONMENT && certi::rtia::RTIAThread::isRequested())) {
+		privateRefs->thread_RTIA = certi::rtia::RTIAThread::start(*privateRefs->socketUn, pipeFd);
+		if (privateRefs->thread_RTIA == NULL)
+			throw RTI::RTIinternalError("Cannot start the RTIA thread");
+	}
+
+	int shmFd = -1 ;
+	const char *shmLink = getenv("CERTI_SHM_LINK");
+	if (privateRefs->thread_RTIA == NULL && shmLink != NULL && atoi(shmLink) > 0) {
+		shmFd = privateRefs->socketUn->createSHMLink(atoi(shmLink) * 1024);
+		if (shmFd == -1)
+			D.Out( pdError, "Cannot create shared memory link to RTIA, using the socket alone." );
+	}
+#else
+	if (rtia == RTIA_THREAD)
+		throw RTI::RTIinternalError("The RTIA cannot run on a thread of this federate");
+#endif
+
 #ifdef _WIN32
 	STARTUPINFO si;
 	PROCESS_INFORMATION pi;
@@ -272,59 +319,77 @@ throw (RTI::MemoryExhausted, RTI::RTIinternalError)
 
 #else
 
-	sigset_t nset, oset;
-	// temporarily block termination signals
-	// note: this is to prevent child processes from receiving termination signals
-	sigemptyset(&nset);
-	sigaddset(&nset, SIGINT);
-	sigprocmask(SIG_BLOCK, &nset, &oset);
-
-	switch((privateRefs->pid_RTIA = fork())) {
-	case -1: // fork failed.
-	perror("fork");
-	// unbock the above blocked signals
-	sigprocmask(SIG_SETMASK, &oset, NULL);
+	if (privateRefs->thread_RTIA == NULL) {
+		sigset_t nset, oset;
+		// temporarily block termination signals
+		// note: this is to prevent child processes from receiving termination signals
+		sigemptyset(&nset);
+		sigaddset(&nset, SIGINT);
+		sigprocmask(SIG_BLOCK, &nset, &oset);
+
+		switch((privateRefs->pid_RTIA = fork())) {
+		case -1: // fork failed.
+		perror("fork");
+		// unbock the above blocked signals
+		sigprocmask(SIG_SETMASK, &oset, NULL);
 #if !defined(RTIA_USE_TCP)
-	close(pipeFd);
+		close(pipeFd);
+		if (shmFd != -1)
+			close(shmFd);
 #endif
-	throw RTI::RTIinternalError("fork failed in RTIambassador constructor");
-	break ;
+		throw RTI::RTIinternalError("fork failed in RTIambassador constructor");
+		break ;
 
-	case 0: // child process (RTIA).
-		// close all open filedescriptors except the pipe one
-		for (int fdmax = sysconf(_SC_OPEN_MAX), fd = 3; fd < fdmax; ++fd) {
+		case 0: // child process (RTIA).
+			// close all open filedescriptors except the pipe one
+			for (int fdmax = sysconf(_SC_OPEN_MAX), fd = 3; fd < fdmax; ++fd) {
 #if !defined(RTIA_USE_TCP)
-			if (fd == pipeFd)
-				continue;
+				if (fd == pipeFd)
+					continue;
+				if (fd == shmFd) {
+					// shm_open descriptors are closed on exec by default.
+					fcntl(fd, F_SETFD, 0);
+					continue;
+				}
 #endif
-			close(fd);
-		}
-		for (unsigned i = 0; i < rtiaList.size(); ++i)
-		{
-			std::stringstream stream;
+				close(fd);
+			}
+			for (unsigned i = 0; i < rtiaList.size(); ++i)
+			{
+				std::stringstream stream;
 #if defined(RTIA_USE_TCP)
-			stream << port;
-			execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-p", stream.str().c_str(), NULL);
+				stream << port;
+				execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-p", stream.str().c_str(), NULL);
 #else
-			stream << pipeFd;
-			execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), NULL);
+				stream << pipeFd;
+				if (shmFd != -1) {
+					std::stringstream shm;
+					shm << shmFd;
+					execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), "-s", shm.str().c_str(), NULL);
+				}
+				else {
+					execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), NULL);
+				}
 #endif
-		}
-		// unbock the above blocked signals
-		sigprocmask(SIG_SETMASK, &oset, NULL);
-		msg << "Could not launch RTIA process (execlp): "
-				<< strerror(errno)
-				<< endl
-				<< "Maybe RTIA is not in search PATH environment.";
-		throw RTI::RTIinternalError(msg.str().c_str());
-
-	default: // father process (Federe).
-		// unbock the above blocked signals
-		sigprocmask(SIG_SETMASK, &oset, NULL);
+			}
+			// unbock the above blocked signals
+			sigprocmask(SIG_SETMASK, &oset, NULL);
+			msg << "Could not launch RTIA process (execlp): "
+					<< strerror(errno)
+					<< endl
+					<< "Maybe RTIA is not in search PATH environment.";
+			throw RTI::RTIinternalError(msg.str().c_str());
+
+		default: // father process (Federe).
+			// unbock the above blocked signals
+			sigprocmask(SIG_SETMASK, &oset, NULL);
 #if !defined(RTIA_USE_TCP)
-		close(pipeFd);
+			close(pipeFd);
+			if (shmFd != -1)
+				close(shmFd);
 #endif
-		break ;
+			break ;
+		}
 	}
 #endif
 
@@ -406,6 +471,23 @@ throw (RTI::SpecifiedSaveLabelDoesNotExist,
     M_Tick_Request vers_RTI;
     std::auto_ptr<Message> vers_Fed(NULL);
 
+    EventTrace::record(TRACE_TICK_BEGIN, Message::TICK_REQUEST, 0, 0, 0, 0);
+
+    // The RTIA took the callbacks of a batch off its queues: those left
+    // behind by a callback which threw come before any new one.
+    while (privateRefs->callbacks.pending()) {
+        vers_Fed.reset(privateRefs->callbacks.receive(privateRefs->socketUn));
+        // the batch may end with the answer of the interrupted tick()
+        if (vers_Fed->getMessageType() == Message::TICK_REQUEST) {
+            MessagePool::release(vers_Fed.release());
+            break ;
+        }
+        privateRefs->callFederateAmbassador(vers_Fed.get());
+        MessagePool::release(vers_Fed.release());
+        if (!multiple)
+            return RTI_TRUE;
+    }
+
     // Request callback(s) from the local RTIA
     vers_RTI.setMultiple(multiple);
     vers_RTI.setMinTickTime(minimum);
@@ -424,7 +506,7 @@ throw (RTI::SpecifiedSaveLabelDoesNotExist,
     // Read response(s) from the local RTIA until Message::TICK_REQUEST is received.
     while (1) {
         try {
-            vers_Fed.reset(M_Factory::receive(privateRefs->socketUn));
+            vers_Fed.reset(privateRefs->callbacks.receive(privateRefs->socketUn));
         }
         catch (NetworkError &e) {
             std::stringstream msg;
@@ -434,6 +516,7 @@ throw (RTI::SpecifiedSaveLabelDoesNotExist,
 
         // If the type is TICK_REQUEST, the __tick_kernel() has terminated.
         if (vers_Fed->getMessageType() == Message::TICK_REQUEST) {
+            EventTrace::record(TRACE_TICK_END, Message::TICK_REQUEST, 0, 0, 0, 0);
             if (vers_Fed->getExceptionType() != e_NO_EXCEPTION) {
                 // tick() may only throw exceptions defined in the HLA standard
                 // the RTIA is responsible for sending 'allowed' exceptions only
@@ -442,6 +525,7 @@ throw (RTI::SpecifiedSaveLabelDoesNotExist,
             return RTI::Boolean(static_cast<M_Tick_Request*>(vers_Fed.get())->getMultiple());
         }
 
+        EventTrace::record(TRACE_TICK_CALLBACK, vers_Fed->getMessageType(), 0, 0, 0, 0);
         try {
             // Otherwise, the RTI calls a FederateAmbassador service.
             privateRefs->callFederateAmbassador(vers_Fed.get());
@@ -449,9 +533,16 @@ throw (RTI::SpecifiedSaveLabelDoesNotExist,
         catch (RTI::RTIinternalError&) {
             // RTIA awaits TICK_REQUEST_NEXT, terminate the tick() processing
             privateRefs->sendTickRequestStop();
-            // ignore the response and re-throw the original exception
+            // ignore the response and re-throw the original exception; the
+            // rest of the batch is delivered by the next tick()
             throw;
         }
+        // Its storage serves the next callback of the same type
+        MessagePool::release(vers_Fed.release());
+
+        // Deliver the whole batch before requesting the next callback(s)
+        if (privateRefs->callbacks.pending())
+            continue;
 
         try {
             // Request next callback from the RTIA
@@ -26,9 +26,15 @@
 #include "Message.hh"
 #include "RootObject.hh"
 #include "MessageBuffer.hh"
+#include "CallbackBatch.hh"
+#include "RTI1516fedTime.h"
+
+#include <vector>
 
 using namespace certi ;
 
+namespace certi { namespace rtia { class RTIAThread ; } }
+
 class RTI1516ambPrivateRefs
 {
 public:
@@ -45,6 +51,7 @@ public:
 	  HANDLE	handle_RTIA;
 #else
     pid_t pid_RTIA ; //!< pid associated with rtia fork (private).
+    certi::rtia::RTIAThread *thread_RTIA ; //!< RTIA running in this process, or NULL.
 #endif
 
     //! Federate Ambassador reference for module calls.
@@ -57,6 +64,18 @@ public:
 
     SocketUN *socketUn ;
     MessageBuffer msgBufSend,msgBufReceive ;
+    //! Callbacks read by tick() and not delivered yet, kept from one
+    //! tick() to the next when a callback throws.
+    CallbackBatch callbacks ;
+
+    /** Arguments of the reflect, receive and remove callbacks, kept between
+        callbacks not to allocate them each time. The values and the tag
+        point into the message delivered (see callFederateAmbassador). */
+    rti1516::AttributeHandleValueMap callbackAttributes ;
+    rti1516::ParameterHandleValueMap callbackParameters ;
+    std::vector<std::pair<certi::Handle, uint32_t> > callbackOrder ;
+    rti1516::VariableLengthData callbackTag ;
+    RTI1516fedTime callbackTime ;
 };
 
 // $Id: RTIambPrivateRefs.h,v 1.1 2014/03/03 16:41:48 erk Exp $
@@ -27,15 +27,20 @@
 #include <cstdlib>
 #include <cerrno>
 #include <cstring>
+#include <sstream>
 #ifndef _WIN32
 #include <csignal>
 #include <unistd.h>
+#include <fcntl.h>
 #endif
 
 #include "PrettyDebug.hh"
 #include "RTIambassadorImplementation.h"
 
 #include "M_Classes.hh"
+#ifndef _WIN32
+#include "RTIAThread.hh"
+#endif
 
 #include "config.h"
 
@@ -51,6 +56,26 @@ throw ()
 namespace {
 static PrettyDebug D1516("LIBRTI1516", __FILE__);
 static PrettyDebug G1516("GENDOC1516",__FILE__) ;
+
+/** Value N of a CERTI_RTIA_THREAD=N argument of the factory, -1 without one.
+ *  As the environment variable of the same name, which it overrides, a
+ *  positive N runs the RTIA on a thread of the federate. */
+int
+rtiaThreadArgument(const std::vector< std::wstring > &args)
+throw (rti1516::BadInitializationParameter)
+{
+    static const std::wstring key(L"CERTI_RTIA_THREAD=");
+    for (std::vector< std::wstring >::const_iterator it = args.begin(); it != args.end(); ++it) {
+        if (it->compare(0, key.size(), key) != 0)
+            continue ;
+        std::wistringstream value(it->substr(key.size()));
+        int n ;
+        if (!(value >> n) || !value.eof())
+            throw rti1516::BadInitializationParameter(*it);
+        return n > 0 ? n : 0 ;
+    }
+    return -1 ;
+}
 }
 
 std::auto_ptr< rti1516::RTIambassador >
@@ -58,6 +83,8 @@ rti1516::RTIambassadorFactory::createRTIambassador(std::vector< std::wstring > &
 throw (BadInitializationParameter,
         RTIinternalError)
         {
+    int rtiaThread = rtiaThreadArgument(args);
+
     certi::RTI1516ambassador* p_ambassador(new certi::RTI1516ambassador());
 
     std::auto_ptr< rti1516::RTIambassador > ap_ambassador(p_ambassador);
@@ -96,6 +123,27 @@ throw (BadInitializationParameter,
     }
 #endif
 
+#if !defined(_WIN32) && !defined(RTIA_USE_TCP)
+    // CERTI_RTIA_THREAD: no process, the RTIA runs on a thread of the
+    // federate and the link carries the messages themselves.
+    if (rtiaThread > 0 || (rtiaThread < 0 && certi::rtia::RTIAThread::isRequested())) {
+        p_ambassador->privateRefs->thread_RTIA = certi::rtia::RTIAThread::start(*p_ambassador->privateRefs->socketUn, pipeFd);
+        if (p_ambassador->privateRefs->thread_RTIA == NULL)
+            throw rti1516::RTIinternalError(L"Cannot start the RTIA thread");
+    }
+
+    int shmFd = -1 ;
+    const char *shmLink = getenv("CERTI_SHM_LINK");
+    if (p_ambassador->privateRefs->thread_RTIA == NULL && shmLink != NULL && atoi(shmLink) > 0) {
+        shmFd = p_ambassador->privateRefs->socketUn->createSHMLink(atoi(shmLink) * 1024);
+        if (shmFd == -1)
+            D1516.Out( pdError, "Cannot create shared memory link to RTIA, using the socket alone." );
+    }
+#else
+    if (rtiaThread > 0)
+        throw rti1516::RTIinternalError(L"The RTIA cannot run on a thread of this federate");
+#endif
+
 #ifdef _WIN32
     STARTUPINFO si;
     PROCESS_INFORMATION pi;
@@ -168,59 +216,77 @@ throw (BadInitializationParameter,
 
 #else
 
-    sigset_t nset, oset;
-    // temporarily block termination signals
-    // note: this is to prevent child processes from receiving termination signals
-    sigemptyset(&nset);
-    sigaddset(&nset, SIGINT);
-    sigprocmask(SIG_BLOCK, &nset, &oset);
-
-    switch((p_ambassador->privateRefs->pid_RTIA = fork())) {
-    case -1: // fork failed.
-        perror("fork");
-        // unbock the above blocked signals
-        sigprocmask(SIG_SETMASK, &oset, NULL);
+    if (p_ambassador->privateRefs->thread_RTIA == NULL) {
+        sigset_t nset, oset;
+        // temporarily block termination signals
+        // note: this is to prevent child processes from receiving termination signals
+        sigemptyset(&nset);
+        sigaddset(&nset, SIGINT);
+        sigprocmask(SIG_BLOCK, &nset, &oset);
+
+        switch((p_ambassador->privateRefs->pid_RTIA = fork())) {
+        case -1: // fork failed.
+            perror("fork");
+            // unbock the above blocked signals
+            sigprocmask(SIG_SETMASK, &oset, NULL);
 #if !defined(RTIA_USE_TCP)
-        close(pipeFd);
+            close(pipeFd);
+            if (shmFd != -1)
+                close(shmFd);
 #endif
-        throw rti1516::RTIinternalError(wstringize() << "fork failed in RTIambassador constructor");
-        break ;
+            throw rti1516::RTIinternalError(wstringize() << "fork failed in RTIambassador constructor");
+            break ;
 
-    case 0: // child process (RTIA).
-        // close all open filedescriptors except the pipe one
-        for (int fdmax = sysconf(_SC_OPEN_MAX), fd = 3; fd < fdmax; ++fd) {
+        case 0: // child process (RTIA).
+            // close all open filedescriptors except the pipe one
+            for (int fdmax = sysconf(_SC_OPEN_MAX), fd = 3; fd < fdmax; ++fd) {
 #if !defined(RTIA_USE_TCP)
-            if (fd == pipeFd)
-                continue;
+                if (fd == pipeFd)
+                    continue;
+                if (fd == shmFd) {
+                    // shm_open descriptors are closed on exec by default.
+                    fcntl(fd, F_SETFD, 0);
+                    continue;
+                }
 #endif
-            close(fd);
-        }
-        for (unsigned i = 0; i < rtiaList.size(); ++i)
-        {
-            std::stringstream stream;
+                close(fd);
+            }
+            for (unsigned i = 0; i < rtiaList.size(); ++i)
+            {
+                std::stringstream stream;
 #if defined(RTIA_USE_TCP)
-            stream << port;
-            execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-p", stream.str().c_str(), NULL);
+                stream << port;
+                execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-p", stream.str().c_str(), NULL);
 #else
-            stream << pipeFd;
-            execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), NULL);
+                stream << pipeFd;
+                if (shmFd != -1) {
+                    std::stringstream shm;
+                    shm << shmFd;
+                    execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), "-s", shm.str().c_str(), NULL);
+                }
+                else {
+                    execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), NULL);
+                }
 #endif
-        }
-        // unbock the above blocked signals
-        sigprocmask(SIG_SETMASK, &oset, NULL);
-        msg << "Could not launch RTIA process (execlp): "
-                << strerror(errno)
-                << std::endl
-                << "Maybe RTIA is not in search PATH environment.";
-        throw rti1516::RTIinternalError(msg.str().c_str());
-
-    default: // father process (Federe).
-        // unbock the above blocked signals
-        sigprocmask(SIG_SETMASK, &oset, NULL);
+            }
+            // unbock the above blocked signals
+            sigprocmask(SIG_SETMASK, &oset, NULL);
+            msg << "Could not launch RTIA process (execlp): "
+                    << strerror(errno)
+                    << std::endl
+                    << "Maybe RTIA is not in search PATH environment.";
+            throw rti1516::RTIinternalError(msg.str().c_str());
+
+        default: // father process (Federe).
+            // unbock the above blocked signals
+            sigprocmask(SIG_SETMASK, &oset, NULL);
 #if !defined(RTIA_USE_TCP)
-        close(pipeFd);
+            close(pipeFd);
+            if (shmFd != -1)
+                close(shmFd);
 #endif
-        break ;
+            break ;
+        }
     }
 #endif
 
@@ -35,6 +35,10 @@
 
 #include "PrettyDebug.hh"
 #include "M_Classes.hh"
+#ifndef _WIN32
+#include "RTIAThread.hh"
+#endif
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
@@ -75,36 +79,71 @@ getPHVPSFromRequest(T* request)
 	return result;
 }
 
-template<typename T>
-rti1516e::AttributeHandleValueMap *
-getAHVMFromRequest(T* request)
+/** Order of the values of a callback, by handle: see fillValueMap. */
+typedef std::vector<std::pair<certi::Handle, uint32_t> > ValueOrder ;
+
+struct SameHandle {
+	bool operator()(const ValueOrder::value_type &a, const ValueOrder::value_type &b) const {
+		return a.first == b.first ;
+	}
+};
+
+/**
+ * Point the values of a callback map into the buffers of the message, without
+ * copying them. The map and its handles are kept from one callback to the
+ * next, and only rebuilt when the message carries other handles than the
+ * previous one: a steady flow of updates does not allocate. The map is only
+ * valid until the message is deleted.
+ */
+template<typename Friend, typename Map, typename Value>
+void
+fillValueMap(Map &map, ValueOrder &order, const std::vector<Value> &values)
 {
-	uint32_t size = request->getAttributesSize();
-	rti1516e::AttributeHandleValueMap *result = new rti1516e::AttributeHandleValueMap();
-	
-	for (uint32_t i = 0 ; i < size ; ++i) {
-		rti1516e::AttributeHandle attribute = rti1516e::AttributeHandleFriend::createRTI1516Handle(request->getAttributes(i));
-		rti1516e::VariableLengthData varData(&(request->getValues(i)[0]), request->getValues(i).size());
-		result->insert(std::pair<rti1516e::AttributeHandle,rti1516e::VariableLengthData>(attribute, varData));
+	// Map order; the first value of a handle given twice is kept, as by insert.
+	std::sort(order.begin(), order.end());
+	order.erase(std::unique(order.begin(), order.end(), SameHandle()), order.end());
+
+	bool same = map.size() == order.size();
+	typename Map::iterator it = map.begin();
+	for (size_t i = 0 ; same && i < order.size() ; ++i, ++it)
+		same = Friend::toCertiHandle(it->first) == order[i].first ;
+
+	if (!same) {
+		map.clear();
+		for (size_t i = 0 ; i < order.size() ; ++i) {
+			const Value &value = values[order[i].second];
+			map.insert(map.end(), typename Map::value_type(Friend::createRTI1516Handle(order[i].first),
+					rti1516e::VariableLengthData(value.empty() ? NULL : &value[0], value.size())));
+		}
 	}
 
-	return result;
+	it = map.begin();
+	for (size_t i = 0 ; i < order.size() ; ++i, ++it) {
+		Value &value = const_cast<Value &>(values[order[i].second]);
+		it->second.setDataPointer(value.empty() ? NULL : &value[0], value.size());
+	}
 }
 
 template<typename T>
-rti1516e::ParameterHandleValueMap *
-getPHVMFromRequest(T* request)
+void
+fillAHVMFromRequest(rti1516e::AttributeHandleValueMap &map, ValueOrder &order, T* request)
 {
-	uint32_t size = request->getParametersSize();
-	rti1516e::ParameterHandleValueMap *result = new rti1516e::ParameterHandleValueMap();
-
-	for (uint32_t i = 0 ; i < size ; ++i) {
-		rti1516e::ParameterHandle parameter = rti1516e::ParameterHandleFriend::createRTI1516Handle(request->getParameters(i));
-		rti1516e::VariableLengthData varData(&(request->getValues(i)[0]), request->getValues(i).size());
-		result->insert(std::pair<rti1516e::ParameterHandle,rti1516e::VariableLengthData>(parameter, varData));
-	}
+	uint32_t size = request->getAttributesSize();
+	order.clear();
+	for (uint32_t i = 0 ; i < size ; ++i)
+		order.push_back(ValueOrder::value_type(request->getAttributes(i), i));
+	fillValueMap<rti1516e::AttributeHandleFriend>(map, order, request->getValues());
+}
 
-	return result;
+template<typename T>
+void
+fillPHVMFromRequest(rti1516e::ParameterHandleValueMap &map, ValueOrder &order, T* request)
+{
+	uint32_t size = request->getParametersSize();
+	order.clear();
+	for (uint32_t i = 0 ; i < size ; ++i)
+		order.push_back(ValueOrder::value_type(request->getParameters(i), i));
+	fillValueMap<rti1516e::ParameterHandleFriend>(map, order, request->getValues());
 }
 
 template<typename T>
@@ -139,12 +178,14 @@ throw ( rti1516e::RTIinternalError )
 } // End anonymous namespace
 
 RTI1516ambPrivateRefs::RTI1516ambPrivateRefs()
+	: callbackTime(0.0)
 {
 	fed_amb      = NULL;
 #ifdef _WIN32
 	handle_RTIA  = (HANDLE)-1;
 #else
 	pid_RTIA     = (pid_t)-1;
+	thread_RTIA  = NULL;
 #endif
 	is_reentrant = false;
 	_theRootObj  = NULL;
@@ -154,6 +195,10 @@ RTI1516ambPrivateRefs::RTI1516ambPrivateRefs()
 RTI1516ambPrivateRefs::~RTI1516ambPrivateRefs()
 {
 	delete socketUn ;
+#ifndef _WIN32
+	// The RTIA thread ends once its federate socket is closed.
+	delete thread_RTIA ;
+#endif
 }
 
 // ----------------------------------------------------------------------------
@@ -886,10 +931,9 @@ throw (rti1516e::RTIinternalError)
 
 			rti1516e::ObjectInstanceHandle instance = rti1516e::ObjectInstanceHandleFriend::createRTI1516Handle(RAV->getObject());
 
-			rti1516e::AttributeHandleValueMap *attributes = getAHVMFromRequest(RAV);
+			fillAHVMFromRequest(callbackAttributes, callbackOrder, RAV);
 
-			std::string tagString(msg->getTag());
-			rti1516e::VariableLengthData tagVarData(tagString.c_str(), tagString.length());
+			callbackTag.setDataPointer(const_cast<char *>(msg->getTag().data()), msg->getTag().size());
 			/* FIXME 1516-2010: Howto setup SRI properly ?? */
 			rti1516e::SupplementalReflectInfo sri;
 
@@ -898,28 +942,27 @@ throw (rti1516e::RTIinternalError)
 				certi::FederateHandle certiHandle = RAV->getEventRetraction().getSendingFederate();
 				rti1516e::MessageRetractionHandle event = rti1516e::MessageRetractionHandleFriend::createRTI1516Handle(certiHandle, sn);
 
-				std::auto_ptr < rti1516e::LogicalTime > fedTime (new RTI1516fedTime(msg->getDate().getTime()));
+				callbackTime = RTI1516fedTime(msg->getDate().getTime());
 
 
 				fed_amb->reflectAttributeValues(instance, //ObjectInstanceHandle
-						*attributes,							  //AttributeHandleValueMap &
-						tagVarData,								  //VariableLengthData &
+						callbackAttributes,							  //AttributeHandleValueMap &
+						callbackTag,								  //VariableLengthData &
 						rti1516e::TIMESTAMP,						  //OrderType (send)
 						rti1516e::RELIABLE,						  //TransportationType
-						*fedTime,								  //LogicalTime &
+						callbackTime,								  //LogicalTime &
 						rti1516e::RECEIVE,						  //OrderType (receive)
 						event,									  //MessageRetractionHandle
 						sri);
 			}
 			else {
 				fed_amb->reflectAttributeValues(instance,
-						*attributes,
-						tagVarData,
+						callbackAttributes,
+						callbackTag,
 						rti1516e::RECEIVE,
 						rti1516e::RELIABLE,
 						sri);
 			}
-			delete attributes ;
 		}
 		CATCH_FEDERATE_AMBASSADOR_EXCEPTIONS(L"reflectAttributeValues")
 		break ;
@@ -927,12 +970,11 @@ throw (rti1516e::RTIinternalError)
 	case Message::RECEIVE_INTERACTION:
 		try {
 			M_Receive_Interaction* RI = static_cast<M_Receive_Interaction *>(msg);
-			rti1516e::ParameterHandleValueMap *parameters = getPHVMFromRequest(RI);
+			fillPHVMFromRequest(callbackParameters, callbackOrder, RI);
 
 			rti1516e::InteractionClassHandle interactionHandle = rti1516e::InteractionClassHandleFriend::createRTI1516Handle(RI->getInteractionClass());
 
-			std::string tagString(msg->getTag());
-			rti1516e::VariableLengthData tagVarData(tagString.c_str(), tagString.length());
+			callbackTag.setDataPointer(const_cast<char *>(msg->getTag().data()), msg->getTag().size());
 			/* FIXME 1516-2010: Howto setup SRI properly ?? */
 			rti1516e::SupplementalReceiveInfo sri;
 
@@ -941,15 +983,15 @@ throw (rti1516e::RTIinternalError)
 				certi::FederateHandle certiHandle = RI->getEventRetraction().getSendingFederate();
 				rti1516e::MessageRetractionHandle event = rti1516e::MessageRetractionHandleFriend::createRTI1516Handle(certiHandle, sn);
 
-				std::auto_ptr < rti1516e::LogicalTime > fedTime (new RTI1516fedTime(msg->getDate().getTime()));
+				callbackTime = RTI1516fedTime(msg->getDate().getTime());
 
 				fed_amb->receiveInteraction(
 						interactionHandle,						// InteractionClassHandle
-						*parameters,							// ParameterHandleValueMap &
-						tagVarData,								// VariableLengthData &
+						callbackParameters,							// ParameterHandleValueMap &
+						callbackTag,								// VariableLengthData &
 						rti1516e::TIMESTAMP,						  //OrderType (send)
 						rti1516e::RELIABLE,						  //TransportationType
-						*fedTime,								  //LogicalTime &
+						callbackTime,								  //LogicalTime &
 						rti1516e::RECEIVE,						  //OrderType (receive)
 						event,									  //MessageRetractionHandle
 						sri);
@@ -957,13 +999,12 @@ throw (rti1516e::RTIinternalError)
 			else {
 				fed_amb->receiveInteraction(
 						interactionHandle,
-						*parameters,
-						tagVarData,
+						callbackParameters,
+						callbackTag,
 						rti1516e::RECEIVE,
 						rti1516e::RELIABLE,
 						sri);
 			}
-			delete parameters ;
 		}
 		CATCH_FEDERATE_AMBASSADOR_EXCEPTIONS(L"receiveInteraction")
 		break ;
@@ -974,8 +1015,7 @@ throw (rti1516e::RTIinternalError)
 
 			rti1516e::ObjectInstanceHandle instance = rti1516e::ObjectInstanceHandleFriend::createRTI1516Handle(ROI->getObject());
 
-			std::string tagString(msg->getTag());
-			rti1516e::VariableLengthData tagVarData(tagString.c_str(), tagString.length());
+			callbackTag.setDataPointer(const_cast<char *>(msg->getTag().data()), msg->getTag().size());
 			/* FIXME 1516-2010: Howto setup SRI properly ?? */
 			rti1516e::SupplementalRemoveInfo sri;
 
@@ -984,13 +1024,13 @@ throw (rti1516e::RTIinternalError)
 				certi::FederateHandle certiHandle = ROI->getEventRetraction().getSendingFederate();
 				rti1516e::MessageRetractionHandle event = rti1516e::MessageRetractionHandleFriend::createRTI1516Handle(certiHandle, sn);
 
-				std::auto_ptr < rti1516e::LogicalTime > fedTime (new RTI1516fedTime(msg->getDate().getTime()));
+				callbackTime = RTI1516fedTime(msg->getDate().getTime());
 
 				fed_amb->removeObjectInstance(
 						instance,
-						tagVarData,
+						callbackTag,
 						rti1516e::TIMESTAMP,
-						*fedTime,
+						callbackTime,
 						rti1516e::RECEIVE,
 						event,
 						sri);
@@ -998,7 +1038,7 @@ throw (rti1516e::RTIinternalError)
 			else {
 				fed_amb->removeObjectInstance(
 						instance,
-						tagVarData,
+						callbackTag,
 						rti1516e::RECEIVE,
 						sri);
 			}
@@ -30,12 +30,16 @@
 #ifndef _WIN32
 #include <csignal>
 #include <unistd.h>
+#include <fcntl.h>
 #endif
 
 #include "PrettyDebug.hh"
 #include "RTIambassadorImplementation.h"
 
 #include "M_Classes.hh"
+#ifndef _WIN32
+#include "RTIAThread.hh"
+#endif
 
 #include "config.h"
 
@@ -55,6 +59,13 @@ static PrettyDebug G1516("GENDOC1516e",__FILE__) ;
 
 std::auto_ptr< rti1516e::RTIambassador >
 rti1516e::RTIambassadorFactory::createRTIambassador()
+throw (rti1516e::RTIinternalError)
+{
+    return createRTIambassador(RTIA_FROM_ENVIRONMENT);
+}
+
+std::auto_ptr< rti1516e::RTIambassador >
+rti1516e::RTIambassadorFactory::createRTIambassador(RTIALocation rtia)
 throw (rti1516e::RTIinternalError)
         {
     certi::RTI1516ambassador* p_ambassador(new certi::RTI1516ambassador());
@@ -95,6 +106,28 @@ throw (rti1516e::RTIinternalError)
     }
 #endif
 
+#if !defined(_WIN32) && !defined(RTIA_USE_TCP)
+    // RTIA_THREAD: no process, the RTIA runs on a thread of the
+    // federate and the link carries the messages themselves.
+    if (rtia == RTIA_THREAD
+        || (rtia == RTIA_FROM_ENVIRONMENT && certi::rtia::RTIAThread::isRequested())) {
+        p_ambassador->privateRefs->thread_RTIA = certi::rtia::RTIAThread::start(*p_ambassador->privateRefs->socketUn, pipeFd);
+        if (p_ambassador->privateRefs->thread_RTIA == NULL)
+            throw rti1516e::RTIinternalError(L"Cannot start the RTIA thread");
+    }
+
+    int shmFd = -1 ;
+    const char *shmLink = getenv("CERTI_SHM_LINK");
+    if (p_ambassador->privateRefs->thread_RTIA == NULL && shmLink != NULL && atoi(shmLink) > 0) {
+        shmFd = p_ambassador->privateRefs->socketUn->createSHMLink(atoi(shmLink) * 1024);
+        if (shmFd == -1)
+            D1516.Out( pdError, "Cannot create shared memory link to RTIA, using the socket alone." );
+    }
+#else
+    if (rtia == RTIA_THREAD)
+        throw rti1516e::RTIinternalError(L"The RTIA cannot run on a thread of this federate");
+#endif
+
 #ifdef _WIN32
     STARTUPINFO si;
     PROCESS_INFORMATION pi;
@@ -167,59 +200,77 @@ throw (rti1516e::RTIinternalError)
 
 #else
 
-    sigset_t nset, oset;
-    // temporarily block termination signals
-    // note: this is to prevent child processes from receiving termination signals
-    sigemptyset(&nset);
-    sigaddset(&nset, SIGINT);
-    sigprocmask(SIG_BLOCK, &nset, &oset);
-
-    switch((p_ambassador->privateRefs->pid_RTIA = fork())) {
-    case -1: // fork failed.
-        perror("fork");
-        // unbock the above blocked signals
-        sigprocmask(SIG_SETMASK, &oset, NULL);
+    if (p_ambassador->privateRefs->thread_RTIA == NULL) {
+        sigset_t nset, oset;
+        // temporarily block termination signals
+        // note: this is to prevent child processes from receiving termination signals
+        sigemptyset(&nset);
+        sigaddset(&nset, SIGINT);
+        sigprocmask(SIG_BLOCK, &nset, &oset);
+
+        switch((p_ambassador->privateRefs->pid_RTIA = fork())) {
+        case -1: // fork failed.
+            perror("fork");
+            // unbock the above blocked signals
+            sigprocmask(SIG_SETMASK, &oset, NULL);
 #if !defined(RTIA_USE_TCP)
-        close(pipeFd);
+            close(pipeFd);
+            if (shmFd != -1)
+                close(shmFd);
 #endif
-        throw rti1516e::RTIinternalError(wstringize() << "fork failed in RTIambassador constructor");
-        break ;
+            throw rti1516e::RTIinternalError(wstringize() << "fork failed in RTIambassador constructor");
+            break ;
 
-    case 0: // child process (RTIA).
-        // close all open filedescriptors except the pipe one
-        for (int fdmax = sysconf(_SC_OPEN_MAX), fd = 3; fd < fdmax; ++fd) {
+        case 0: // child process (RTIA).
+            // close all open filedescriptors except the pipe one
+            for (int fdmax = sysconf(_SC_OPEN_MAX), fd = 3; fd < fdmax; ++fd) {
 #if !defined(RTIA_USE_TCP)
-            if (fd == pipeFd)
-                continue;
+                if (fd == pipeFd)
+                    continue;
+                if (fd == shmFd) {
+                    // shm_open descriptors are closed on exec by default.
+                    fcntl(fd, F_SETFD, 0);
+                    continue;
+                }
 #endif
-            close(fd);
-        }
-        for (unsigned i = 0; i < rtiaList.size(); ++i)
-        {
-            std::stringstream stream;
+                close(fd);
+            }
+            for (unsigned i = 0; i < rtiaList.size(); ++i)
+            {
+                std::stringstream stream;
 #if defined(RTIA_USE_TCP)
-            stream << port;
-            execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-p", stream.str().c_str(), NULL);
+                stream << port;
+                execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-p", stream.str().c_str(), NULL);
 #else
-            stream << pipeFd;
-            execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), NULL);
+                stream << pipeFd;
+                if (shmFd != -1) {
+                    std::stringstream shm;
+                    shm << shmFd;
+                    execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), "-s", shm.str().c_str(), NULL);
+                }
+                else {
+                    execlp(rtiaList[i].c_str(), rtiaList[i].c_str(), "-f", stream.str().c_str(), NULL);
+                }
 #endif
-        }
-        // unbock the above blocked signals
-        sigprocmask(SIG_SETMASK, &oset, NULL);
-        msg << "Could not launch RTIA process (execlp): "
-                << strerror(errno)
-                << std::endl
-                << "Maybe RTIA is not in search PATH environment.";
-        throw rti1516e::RTIinternalError(msg.str().c_str());
-
-    default: // father process (Federe).
-        // unbock the above blocked signals
-        sigprocmask(SIG_SETMASK, &oset, NULL);
+            }
+            // unbock the above blocked signals
+            sigprocmask(SIG_SETMASK, &oset, NULL);
+            msg << "Could not launch RTIA process (execlp): "
+                    << strerror(errno)
+                    << std::endl
+                    << "Maybe RTIA is not in search PATH environment.";
+            throw rti1516e::RTIinternalError(msg.str().c_str());
+
+        default: // father process (Federe).
+            // unbock the above blocked signals
+            sigprocmask(SIG_SETMASK, &oset, NULL);
 #if !defined(RTIA_USE_TCP)
-        close(pipeFd);
+            close(pipeFd);
+            if (shmFd != -1)
+                close(shmFd);
 #endif
-        break ;
+            break ;
+        }
     }
 #endif
 
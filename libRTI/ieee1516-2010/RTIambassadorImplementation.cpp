@@ -32,6 +32,8 @@
 #include "PrettyDebug.hh"
 
 #include "M_Classes.hh"
+#include "CallbackBatch.hh"
+#include "MessagePool.hh"
 #include "RTIHandleFactory.h"
 #include "RTI1516fedTime.h"
 
@@ -152,6 +154,21 @@ throw (rti1516e::SpecifiedSaveLabelDoesNotExist,
     M_Tick_Request vers_RTI;
     std::auto_ptr<Message> vers_Fed(NULL);
 
+    // The RTIA took the callbacks of a batch off its queues: those left
+    // behind by a callback which threw come before any new one.
+    while (privateRefs->callbacks.pending()) {
+        vers_Fed.reset(privateRefs->callbacks.receive(privateRefs->socketUn));
+        // the batch may end with the answer of the interrupted tick()
+        if (vers_Fed->getMessageType() == Message::TICK_REQUEST) {
+            MessagePool::release(vers_Fed.release());
+            break ;
+        }
+        privateRefs->callFederateAmbassador(vers_Fed.get());
+        MessagePool::release(vers_Fed.release());
+        if (!multiple)
+            return true;
+    }
+
     // Request callback(s) from the local RTIA
     vers_RTI.setMultiple(multiple);
     vers_RTI.setMinTickTime(minimum);
@@ -167,7 +184,7 @@ throw (rti1516e::SpecifiedSaveLabelDoesNotExist,
     // Read response(s) from the local RTIA until Message::TICK_REQUEST is received.
     while (1) {
         try {
-            vers_Fed.reset(M_Factory::receive(privateRefs->socketUn));
+            vers_Fed.reset(privateRefs->callbacks.receive(privateRefs->socketUn));
         }
         catch (NetworkError &e) {
             throw rti1516e::RTIinternalError(L"NetworkError in tick() while receiving response: " + e.wreason());
@@ -190,9 +207,16 @@ throw (rti1516e::SpecifiedSaveLabelDoesNotExist,
         catch (RTIinternalError&) {
             // RTIA awaits TICK_REQUEST_NEXT, terminate the tick() processing
             privateRefs->sendTickRequestStop();
-            // ignore the response and re-throw the original exception
+            // ignore the response and re-throw the original exception; the
+            // rest of the batch is delivered by the next tick()
             throw;
         }
+        // Its storage serves the next callback of the same type
+        MessagePool::release(vers_Fed.release());
+
+        // Deliver the whole batch before requesting the next callback(s)
+        if (privateRefs->callbacks.pending())
+            continue;
 
         try {
             // Request next callback from the RTIA
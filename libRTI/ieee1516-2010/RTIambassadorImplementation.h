@@ -35,7 +35,7 @@ namespace certi
 class RTI_EXPORT RTI1516ambassador : rti1516e::RTIambassador
 {
     friend std::auto_ptr< rti1516e::RTIambassador >
-    rti1516e::RTIambassadorFactory::createRTIambassador()
+    rti1516e::RTIambassadorFactory::createRTIambassador(rti1516e::RTIambassadorFactory::RTIALocation)
     throw (rti1516e::RTIinternalError);
 
 private:
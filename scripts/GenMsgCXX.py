@@ -105,6 +105,12 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
         self.serializeBufferType = 'libhla::MessageBuffer'
         self.messageTypeGetter = 'getType()'
         self.exception = ['std::string']
+        # root class of the messages which may go through an in-process
+        # link, which then get clone/copy methods and are not serialized
+        self.localLinkRoot = None
+        # header of the pool giving the received messages, which then
+        # come from its get method instead of the factory creator
+        self.messagePool = None
 
     def getTargetTypeName(self, name):
         if name in self.builtinTypeMap.keys():
@@ -117,6 +123,51 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
         else:
             return name
 
+    def getArenaFor(self, name):
+        # A native may give, with a 'language CXX [arena <class>]' line,
+        # the class holding a repeated field of that native as slices
+        # of a shared arena instead of a vector of values.
+        for native in self.AST.natives:
+            if name == native.name and native.hasLanguage('CXX'):
+                for line in native.getLanguageLines('CXX'):
+                    if line.statement.startswith('arena '):
+                        return line.statement.split()[1]
+        return None
+
+    def writeArenaGetterSetter(self, stream, field, arena):
+        targetTypeName = self.getTargetTypeName(field.typeid.name)
+        name = self.upperFirst(field.name)
+        stream.write(self.getIndent())
+        stream.write('uint32_t get' + name + 'Size() const')
+        stream.write(' {return ' + field.name + '.size();}\n')
+
+        stream.write(self.getIndent())
+        stream.write('void set' + name + 'Size(uint32_t num)')
+        stream.write(' {' + field.name + '.resize(num);}\n')
+
+        stream.write(self.getIndent())
+        stream.write('const ' + arena + '& get' + name + '() const')
+        stream.write(' {return ' + field.name + ';}\n')
+
+        stream.write(self.getIndent())
+        stream.write(arena + '& get' + name + '()')
+        stream.write(' {return ' + field.name + ';}\n')
+
+        stream.write(self.getIndent())
+        stream.write('void set' + name + '(const ' + arena + '& new'
+                     + name + ')')
+        stream.write(' {' + field.name + '=new' + name + ';}\n')
+
+        stream.write(self.getIndent())
+        stream.write('void set' + name + '(const ' + targetTypeName
+                     + '& new' + name + ', uint32_t rank)')
+        stream.write(' {' + field.name + '.set(rank, new' + name
+                     + ');}\n')
+
+        stream.write(self.getIndent())
+        stream.write('void remove' + name + '(uint32_t rank)')
+        stream.write(' {' + field.name + '.erase(rank);}\n')
+
     def openNamespaces(self, stream):
         if self.AST.hasPackage():
             self.writeComment(stream, self.AST.package)
@@ -144,6 +195,10 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
     def writeOneGetterSetter(self, stream, field):
 
         targetTypeName = self.getTargetTypeName(field.typeid.name)
+        arena = self.getArenaFor(field.typeid.name)
+        if field.qualifier == 'repeated' and arena:
+            self.writeArenaGetterSetter(stream, field, arena)
+            return
 
         if field.typeid.name == 'onoff':
             if field.qualifier == 'repeated':
@@ -270,7 +325,10 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
 
     def writeDeclarationFieldStatement(self, stream, field):
         stream.write(self.getIndent())
-        if field.qualifier == 'repeated':
+        arena = self.getArenaFor(field.typeid.name)
+        if field.qualifier == 'repeated' and arena:
+            stream.write('%s %s;' % (arena, field.name))
+        elif field.qualifier == 'repeated':
             stream.write('std::vector<%s> %s;'
                          % (self.getTargetTypeName(field.typeid.name),
                          field.name))
@@ -459,6 +517,16 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
                 stream.write(self.getIndent() + virtual + '~'
                              + msg.name + '();\n')
 
+                # the copy methods of the in-process link
+
+                if self.localLinkRoot is not None and msg.hasMerge():
+                    stream.write(self.getIndent()
+                                 + '%s* clone() const {return new %s(*this);}\n'
+                                 % (virtual + self.localLinkRoot, msg.name))
+                    stream.write(self.getIndent() + virtual
+                                 + 'void copy(const %s& other) {*this=static_cast<const %s&>(other);}\n'
+                                 % (self.localLinkRoot, msg.name))
+
                 # write virtual serialize and deserialize
                 # if we have some specific field
 
@@ -558,6 +626,15 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
                 for exception in self.exception[1:]:
                     stream.write(' ,%s' % exception)
                 stream.write('); \n')
+                stream.write(self.getIndent()
+                             + 'static %s* %s(%s stream, '
+                             % self.AST.factory.receiver)
+                stream.write('%s& msgBuffer) throw ('
+                             % self.serializeBufferType)
+                stream.write('%s' % self.exception[0])
+                for exception in self.exception[1:]:
+                    stream.write(' ,%s' % exception)
+                stream.write('); \n')
 
             self.unIndent()
 
@@ -611,6 +688,11 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
 
     def writeSerializeFieldStatement(self, stream, field):
         indexField = ''
+        if field.qualifier == 'repeated' \
+            and self.getArenaFor(field.typeid.name):
+            stream.write(self.getIndent())
+            stream.write(field.name + '.serialize(msgBuffer);\n')
+            return
         if field.qualifier == 'optional':
             stream.write(self.getIndent())
             stream.write('msgBuffer.write_bool(_has%s);\n'
@@ -685,6 +767,23 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
 
     def writeShowFieldStatement(self, stream, field):
         indexField = ''
+        if field.qualifier == 'repeated' \
+            and self.getArenaFor(field.typeid.name):
+            stream.write(self.getIndent())
+            stream.write('out << "    %s [] =" << std::endl;\n'
+                         % field.name)
+            stream.write(self.getIndent())
+            stream.write('for (uint32_t i = 0; i < get'
+                         + self.upperFirst(field.name)
+                         + 'Size(); ++i) {\n')
+            self.indent()
+            stream.write(self.getIndent())
+            stream.write('out << %s.length(i) << " bytes ";\n'
+                         % field.name)
+            self.unIndent()
+            stream.write(self.getIndent() + '}\n')
+            stream.write(self.getIndent() + 'out << std::endl;\n')
+            return
         if field.qualifier == 'optional':
             stream.write(self.getIndent())
             stream.write('out << "(opt) %s =" ' % field.name)
@@ -745,6 +844,11 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
 
     def writeDeSerializeFieldStatement(self, stream, field):
         indexField = ''
+        if field.qualifier == 'repeated' \
+            and self.getArenaFor(field.typeid.name):
+            stream.write(self.getIndent())
+            stream.write(field.name + '.deserialize(msgBuffer);\n')
+            return
         if field.qualifier == 'optional':
             stream.write(self.getIndent())
             stream.write('_has%s = msgBuffer.read_bool();\n'
@@ -902,9 +1006,33 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
 
         self.indent()
         stream.write(self.getIndent() + self.commentLineBeginWith
-                     + ' FIXME This is not thread safe\n')
+                     + ' FIXME This is not thread safe, concurrent callers\n')
+        stream.write(self.getIndent() + self.commentLineBeginWith
+                     + ' have to give their own buffer\n')
         stream.write(self.getIndent() + 'static %s msgBuffer;\n'
                      % self.serializeBufferType)
+        stream.write(self.getIndent() + 'return %s(stream,msgBuffer);\n'
+                     % receiver[2])
+        self.unIndent()
+        stream.write(self.getIndent() + '} /* end of %s::%s */ \n\n'
+                     % (receiver[1], receiver[2]))
+
+        stream.write(self.getIndent() + '%s* %s::%s(%s stream, '
+                     % receiver)
+        stream.write('%s& msgBuffer) throw (' % self.serializeBufferType)
+        stream.write('%s' % self.exception[0])
+        for exception in self.exception[1:]:
+            stream.write(' ,%s' % exception)
+        stream.write(') { \n')
+
+        self.indent()
+        if self.localLinkRoot is not None:
+            stream.write(self.getIndent() + self.commentLineBeginWith
+                         + ' messages of an in-process link are not serialized\n')
+            stream.write(self.getIndent() + 'if (stream->usesLocalLink())\n')
+            self.indent()
+            stream.write(self.getIndent() + 'return stream->receiveMessage();\n')
+            self.unIndent()
         stream.write(self.getIndent() + '%s  msgGen;\n' % receiver[0])
         stream.write(self.getIndent() + '''%s* msg;
 
@@ -917,9 +1045,13 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
                      + ' create specific message from type \n')
 
         stream.write(self.getIndent() + 'msg = ')
-        stream.write(self.AST.factory.name + '::'
-                     + self.AST.factory.creator[1] + '(msgGen.%s);\n'
-                     % self.messageTypeGetter)
+        if self.messagePool is not None:
+            stream.write('MessagePool::get(msgGen.%s);\n'
+                         % self.messageTypeGetter)
+        else:
+            stream.write(self.AST.factory.name + '::'
+                         + self.AST.factory.creator[1] + '(msgGen.%s);\n'
+                         % self.messageTypeGetter)
 
         stream.write(self.getIndent()
                      + 'msgBuffer.assumeSizeFromReservedBytes();\n')
@@ -960,6 +1092,8 @@ class CXXGenerator(GenMsgBase.CodeGenerator):
             supposedHeaderName = os.path.basename(supposedHeaderName)
             supposedHeaderName = os.path.splitext(supposedHeaderName)[0]
             stream.write('#include "' + supposedHeaderName + '.hh"\n')
+        if self.messagePool is not None:
+            stream.write('#include "' + self.messagePool + '"\n')
 
         # Generate namespace for specified package package
         # we may have nested namespace
@@ -1134,6 +1268,8 @@ class CXXCERTIMessageGenerator(CXXGenerator):
         self.serializeBufferType = 'libhla::MessageBuffer'
         self.messageTypeGetter = 'getMessageType()'
         self.exception = ['NetworkError', 'NetworkSignal']
+        self.localLinkRoot = 'Message'
+        self.messagePool = 'MessagePool.hh'
 
 
 class CXXCERTINetworkMessageGenerator(CXXGenerator):
@@ -1158,5 +1294,6 @@ class CXXCERTINetworkMessageGenerator(CXXGenerator):
         self.serializeBufferType = 'libhla::MessageBuffer'
         self.messageTypeGetter = 'getMessageType()'
         self.exception = ['NetworkError', 'NetworkSignal']
+        self.messagePool = 'MessagePool.hh'
 
 
@@ -0,0 +1,217 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// HLA 1.3 services of the benchmark federate.
+
+#include "BenchFederate.hh"
+#include "RTI.hh"
+#include "NullFederateAmbassador.hh"
+#include "fedtime.hh"
+
+#include <iostream>
+#include <sstream>
+
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+class HLA13Federate : public BenchFederate, public NullFederateAmbassador
+{
+public:
+    HLA13Federate(const BenchScenario &s)
+        : BenchFederate(s), regulating(false), constrained(false), subscription(NULL),
+          payload(s.size, 'x') {}
+    ~HLA13Federate() throw () {}
+
+    bool run() {
+        try {
+            return BenchFederate::run();
+        }
+        catch (RTI::Exception &e) {
+            cerr << scenario.name << ": " << e._name << " " << (e._reason ? e._reason : "") << endl ;
+            return false ;
+        }
+    }
+
+    // Federate ambassador
+    void discoverObjectInstance(RTI::ObjectHandle, RTI::ObjectClassHandle, const char *)
+        throw (RTI::CouldNotDiscover, RTI::ObjectClassNotKnown, RTI::FederateInternalError) {
+        discovered();
+    }
+
+    void reflectAttributeValues(RTI::ObjectHandle, const RTI::AttributeHandleValuePairSet &ahvps,
+                                const RTI::FedTime &, const char *, RTI::EventRetractionHandle)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::FederateOwnsAttributes,
+               RTI::InvalidFederationTime, RTI::FederateInternalError) {
+        reflect(ahvps);
+    }
+
+    void reflectAttributeValues(RTI::ObjectHandle, const RTI::AttributeHandleValuePairSet &ahvps,
+                                const char *)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::FederateOwnsAttributes,
+               RTI::FederateInternalError) {
+        reflect(ahvps);
+    }
+
+    void timeRegulationEnabled(const RTI::FedTime &)
+        throw (RTI::InvalidFederationTime, RTI::EnableTimeRegulationWasNotPending,
+               RTI::FederateInternalError) {
+        regulating = true ;
+    }
+
+    void timeConstrainedEnabled(const RTI::FedTime &)
+        throw (RTI::InvalidFederationTime, RTI::EnableTimeConstrainedWasNotPending,
+               RTI::FederateInternalError) {
+        constrained = true ;
+    }
+
+    void timeAdvanceGrant(const RTI::FedTime &time)
+        throw (RTI::InvalidFederationTime, RTI::TimeAdvanceWasNotInProgress,
+               RTI::FederateInternalError) {
+        granted(RTIfedTime(time).getTime());
+    }
+
+protected:
+    void join() {
+        rtiamb.reset(new RTI::RTIambassador());
+        try {
+            rtiamb->createFederationExecution(scenario.federation.c_str(), scenario.fom.c_str());
+        }
+        catch (RTI::FederationExecutionAlreadyExists &) {
+        }
+        rtiamb->joinFederationExecution(scenario.name.c_str(), scenario.federation.c_str(), this);
+
+        objectClass = rtiamb->getObjectClassHandle("BenchObject");
+        for (int i = 0 ; i < scenario.attributes ; ++i) {
+            std::ostringstream name ;
+            name << "Attr" << i ;
+            attributes.push_back(rtiamb->getAttributeHandle(name.str().c_str(), objectClass));
+        }
+    }
+
+    void enableTimeManagement() {
+        rtiamb->enableTimeRegulation(RTIfedTime(0.0), RTIfedTime(scenario.lookahead));
+        while (!regulating)
+            evoke(0.1, 1.0);
+        rtiamb->enableTimeConstrained();
+        while (!constrained)
+            evoke(0.1, 1.0);
+        rtiamb->enableAsynchronousDelivery();
+    }
+
+    void declare() {
+        std::auto_ptr<RTI::AttributeHandleSet> set(
+            RTI::AttributeHandleSetFactory::create(attributes.size()));
+        for (unsigned int i = 0 ; i < attributes.size(); ++i)
+            set->add(attributes[i]);
+        rtiamb->publishObjectClass(objectClass, *set);
+
+        if (scenario.ddm) {
+            // Neither the extents of region modifications nor the regions of
+            // registrations travel to the RTIG yet: the subscriptions use a
+            // region of default extent, the whole dimension, and every
+            // update goes through region matching to every subscriber.
+            RTI::SpaceHandle space = rtiamb->getRoutingSpaceHandle("Geo");
+            subscription = rtiamb->createRegion(space, 1);
+            rtiamb->subscribeObjectClassAttributesWithRegion(objectClass, *subscription, *set);
+        }
+        else {
+            rtiamb->subscribeObjectClassAttributes(objectClass, *set);
+        }
+
+        for (int o = 0 ; o < scenario.objects ; ++o)
+            objects.push_back(rtiamb->registerObjectInstance(objectClass));
+    }
+
+    void update(int object, const std::vector<char> &first, double time) {
+        std::auto_ptr<RTI::AttributeHandleValuePairSet> ahvps(
+            RTI::AttributeSetFactory::create(attributes.size()));
+        ahvps->add(attributes[0], &first[0], first.size());
+        for (unsigned int i = 1 ; i < attributes.size(); ++i)
+            ahvps->add(attributes[i], payload.data(), payload.size());
+        if (time < 0.0)
+            rtiamb->updateAttributeValues(objects[object], *ahvps, "");
+        else
+            rtiamb->updateAttributeValues(objects[object], *ahvps, RTIfedTime(time), "");
+    }
+
+    void timeAdvanceRequest(double time) {
+        rtiamb->timeAdvanceRequest(RTIfedTime(time));
+    }
+
+    void evoke(double wait, double max) {
+        rtiamb->tick(wait, max);
+    }
+
+    void resign() {
+        rtiamb->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+        try {
+            rtiamb->destroyFederationExecution(scenario.federation.c_str());
+        }
+        catch (RTI::FederatesCurrentlyJoined &) {
+        }
+        catch (RTI::FederationExecutionDoesNotExist &) {
+        }
+        rtiamb.reset();
+    }
+
+private:
+    void reflect(const RTI::AttributeHandleValuePairSet &ahvps) {
+        const char *first = NULL ;
+        RTI::ULong firstLength = 0 ;
+        uint64_t size = 0 ;
+        for (RTI::ULong i = 0 ; i < ahvps.size(); ++i) {
+            RTI::ULong length ;
+            char *value = ahvps.getValuePointer(i, length);
+            if (ahvps.getHandle(i) == attributes[0]) {
+                first = value ;
+                firstLength = length ;
+            }
+            size += length ;
+        }
+        reflected(first, firstLength, ahvps.size(), size);
+    }
+
+    std::auto_ptr<RTI::RTIambassador> rtiamb ;
+    bool regulating ;
+    bool constrained ;
+    RTI::ObjectClassHandle objectClass ;
+    std::vector<RTI::AttributeHandle> attributes ;
+    std::vector<RTI::ObjectHandle> objects ;
+    RTI::Region *subscription ;
+    std::string payload ;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+BenchFederate *
+BenchFederate::create(const BenchScenario &scenario)
+{
+    return new HLA13Federate(scenario);
+}
+
+// ----------------------------------------------------------------------------
+const char *
+BenchFederate::flavour()
+{
+    return "HLA13" ;
+}
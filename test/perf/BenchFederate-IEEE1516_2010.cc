@@ -0,0 +1,207 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// IEEE 1516-2010 services of the benchmark federate.
+
+#include "BenchFederate.hh"
+#include <RTI/RTIambassadorFactory.h>
+#include <RTI/RTIambassador.h>
+#include <RTI/NullFederateAmbassador.h>
+#include <RTI/RTI1516fedTime.h>
+
+#include <iostream>
+#include <sstream>
+
+using std::cerr ;
+using std::endl ;
+using namespace rti1516e ;
+
+namespace {
+
+std::wstring widen(const std::string &s)
+{
+    return std::wstring(s.begin(), s.end());
+}
+
+class IEEE1516_2010Federate : public BenchFederate, public NullFederateAmbassador
+{
+public:
+    IEEE1516_2010Federate(const BenchScenario &s)
+        : BenchFederate(s), regulating(false), constrained(false), tag("bench", 5) {}
+
+    bool run() {
+        try {
+            return BenchFederate::run();
+        }
+        catch (Exception &e) {
+            std::wcerr << widen(scenario.name) << L": " << e.what() << endl ;
+            return false ;
+        }
+    }
+
+    // Federate ambassador
+    void discoverObjectInstance(ObjectInstanceHandle, ObjectClassHandle, std::wstring const &)
+        throw (FederateInternalError) {
+        discovered();
+    }
+
+    void reflectAttributeValues(ObjectInstanceHandle, AttributeHandleValueMap const &values,
+                                VariableLengthData const &, OrderType, TransportationType,
+                                SupplementalReflectInfo)
+        throw (FederateInternalError) {
+        reflect(values);
+    }
+
+    void reflectAttributeValues(ObjectInstanceHandle, AttributeHandleValueMap const &values,
+                                VariableLengthData const &, OrderType, TransportationType,
+                                LogicalTime const &, OrderType, MessageRetractionHandle,
+                                SupplementalReflectInfo)
+        throw (FederateInternalError) {
+        reflect(values);
+    }
+
+    void timeRegulationEnabled(LogicalTime const &)
+        throw (FederateInternalError) {
+        regulating = true ;
+    }
+
+    void timeConstrainedEnabled(LogicalTime const &)
+        throw (FederateInternalError) {
+        constrained = true ;
+    }
+
+    void timeAdvanceGrant(LogicalTime const &time)
+        throw (FederateInternalError) {
+        granted(dynamic_cast<RTI1516fedTime const &>(time).getFedTime());
+    }
+
+protected:
+    void join() {
+        RTIambassadorFactory factory ;
+        rtiamb = factory.createRTIambassador();
+        rtiamb->connect(*this, HLA_EVOKED);
+        try {
+            rtiamb->createFederationExecution(widen(scenario.federation), widen(scenario.fom));
+        }
+        catch (FederationExecutionAlreadyExists &) {
+        }
+        rtiamb->joinFederationExecution(widen(scenario.name), widen(scenario.federation));
+
+        objectClass = rtiamb->getObjectClassHandle(L"BenchObject");
+        for (int i = 0 ; i < scenario.attributes ; ++i) {
+            std::wostringstream name ;
+            name << L"Attr" << i ;
+            attributes.push_back(rtiamb->getAttributeHandle(objectClass, name.str()));
+        }
+        std::string payload(scenario.size, 'x');
+        for (unsigned int i = 1 ; i < attributes.size(); ++i)
+            values[attributes[i]] = VariableLengthData(payload.data(), payload.size());
+    }
+
+    void enableTimeManagement() {
+        rtiamb->enableTimeRegulation(RTI1516fedTimeInterval(scenario.lookahead));
+        while (!regulating)
+            evoke(0.1, 1.0);
+        rtiamb->enableTimeConstrained();
+        while (!constrained)
+            evoke(0.1, 1.0);
+        rtiamb->enableAsynchronousDelivery();
+    }
+
+    void declare() {
+        AttributeHandleSet set(attributes.begin(), attributes.end());
+        rtiamb->publishObjectClassAttributes(objectClass, set);
+        rtiamb->subscribeObjectClassAttributes(objectClass, set);
+        for (int o = 0 ; o < scenario.objects ; ++o)
+            objects.push_back(rtiamb->registerObjectInstance(objectClass));
+    }
+
+    void update(int object, const std::vector<char> &first, double time) {
+        values[attributes[0]].setData(&first[0], first.size());
+        if (time < 0.0)
+            rtiamb->updateAttributeValues(objects[object], values, tag);
+        else
+            rtiamb->updateAttributeValues(objects[object], values, tag, RTI1516fedTime(time));
+    }
+
+    void timeAdvanceRequest(double time) {
+        rtiamb->timeAdvanceRequest(RTI1516fedTime(time));
+    }
+
+    void evoke(double wait, double max) {
+        rtiamb->evokeMultipleCallbacks(wait, max);
+    }
+
+    void resign() {
+        rtiamb->resignFederationExecution(DELETE_OBJECTS_THEN_DIVEST);
+        try {
+            rtiamb->destroyFederationExecution(widen(scenario.federation));
+        }
+        catch (FederatesCurrentlyJoined &) {
+        }
+        catch (FederationExecutionDoesNotExist &) {
+        }
+        rtiamb.reset();
+    }
+
+private:
+    void reflect(AttributeHandleValueMap const &map) {
+        const char *first = NULL ;
+        uint32_t firstLength = 0 ;
+        uint64_t size = 0 ;
+        for (AttributeHandleValueMap::const_iterator i = map.begin(); i != map.end(); ++i) {
+            if (i->first == attributes[0]) {
+                first = static_cast<const char *>(i->second.data());
+                firstLength = i->second.size();
+            }
+            size += i->second.size();
+        }
+        reflected(first, firstLength, map.size(), size);
+    }
+
+    std::auto_ptr<RTIambassador> rtiamb ;
+    bool regulating ;
+    bool constrained ;
+    ObjectClassHandle objectClass ;
+    std::vector<AttributeHandle> attributes ;
+    std::vector<ObjectInstanceHandle> objects ;
+    AttributeHandleValueMap values ;
+    VariableLengthData tag ;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+BenchFederate *
+BenchFederate::create(const BenchScenario &scenario)
+{
+    if (scenario.ddm) {
+        cerr << "The IEEE 1516-2010 libRTI does not implement regions." << endl ;
+        return NULL ;
+    }
+    return new IEEE1516_2010Federate(scenario);
+}
+
+// ----------------------------------------------------------------------------
+const char *
+BenchFederate::flavour()
+{
+    return "IEEE1516_2010" ;
+}
@@ -0,0 +1,359 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Headless benchmark federate.
+//
+// Every federate of the federation registers the same number of BenchObject
+// instances and subscribes to the class, then waits until it has discovered
+// the objects of all the others: they have all subscribed by then. The
+// senders update all their objects in turn, each update carrying the
+// attributes asked for. The first value starts with the number of the
+// sender and the time of the update, so that the UAV to reflect latency is
+// measured by the receivers of the same host.
+//
+// In receive order, the senders update for the given duration, at the given
+// rate if any, then send a last update marked as such; every federate
+// evokes callbacks until it has the last update of all the senders. In time
+// stamp order, every federate is regulating and constrained and advances
+// time step by step, the senders updating each object once per step with a
+// time stamp of the granted time plus the lookahead; the TAR to TAG latency
+// is measured for each step.
+//
+// The federate prints a comment line naming the columns and a line of
+// measures; CertiBench.sh starts a rtig and the federates of a scenario and
+// merges their lines.
+//
+// Usage: CertiBenchFederate-<flavour> [options]
+//   -n name        federate name (default bench-<index>)
+//   -x federation  federation execution name (default CertiBench)
+//   -f FOM         FOM file, found through CERTI_FOM_PATH
+//                  (default BenchFederation.fed)
+//   -i index       number of this federate, from 0 (default 0)
+//   -N federates   federates of the federation (default 1)
+//   -P senders     federates updating their objects (default federates)
+//   -R             this federate only receives
+//   -o objects     objects registered by each federate (default 4)
+//   -a attributes  attributes per update, 1 to 8 (default 2)
+//   -s size        bytes per attribute value (default 64)
+//   -r rate        updates per second, 0 for no limit (default 0)
+//   -t seconds     duration of the updates in receive order (default 3)
+//   -T             time stamp order
+//   -S steps       time steps with updates in time stamp order (default 1000)
+//   -l lookahead   lookahead in time stamp order, the step being 1 (default 1)
+//   -d             subscriptions with regions (DDM, HLA 1.3 only)
+//   -w prefix      write the UAV to reflect and TAR to TAG latencies, in us,
+//                  one per line, in prefix.uav and prefix.tag
+
+#include "config.h"
+#include "BenchFederate.hh"
+#ifdef HAVE_POSIX_CLOCK
+#include "PosixClock.hh"
+#endif
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+/** Start of the value of the first attribute of each update. */
+struct Header {
+    uint32_t sender ;
+    uint32_t flags ;
+    uint64_t sent ;     ///< clock ticks
+};
+
+/** Flag of the last update of a sender. */
+const uint32_t LAST_UPDATE = 1 ;
+/** Seconds a federate waits for the last updates after its own. */
+const double LAST_UPDATE_TIMEOUT = 30.0 ;
+
+/** Nearest rank percentile of sorted values, 0 if there are none. */
+double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0 ;
+    size_t rank = static_cast<size_t>(ceil(p * sorted.size()));
+    return sorted[rank > 0 ? rank - 1 : 0] ;
+}
+
+/** Write sorted latencies, one per line. */
+void writeSamples(const std::string &name, const std::vector<double> &samples)
+{
+    std::ofstream file(name.c_str());
+    for (size_t i = 0 ; i < samples.size(); ++i)
+        file << samples[i] << '\n' ;
+}
+
+/** CPU seconds (user and system) of the process or of its children. */
+double cpu(int who)
+{
+    struct rusage usage ;
+    if (getrusage(who, &usage) != 0)
+        return 0.0 ;
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+        + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+BenchScenario::BenchScenario()
+    : federation("CertiBench"), fom("BenchFederation.fed"), index(0), federates(1),
+      senders(-1), sender(true), objects(4), attributes(2), size(64), rate(0.0),
+      duration(3.0), steps(1000), lookahead(1.0), tso(false), ddm(false)
+{
+}
+
+// ----------------------------------------------------------------------------
+BenchFederate::BenchFederate(const BenchScenario &s)
+    : scenario(s), discoveries(0), advancing(false), grantedTime(0.0), updates(0),
+      reflections(0), values(0), bytes(0), measured(0.0), sending(0.0)
+{
+#ifdef HAVE_POSIX_CLOCK
+    // The latencies compare the clocks of several processes.
+    clk.reset(new libhla::clock::PosixClock(CLOCK_MONOTONIC));
+#else
+    clk.reset(libhla::clock::Clock::getBestClock());
+#endif
+}
+
+// ----------------------------------------------------------------------------
+void
+BenchFederate::reflected(const char *first, uint32_t length, uint32_t count, uint64_t size)
+{
+    ++reflections ;
+    values += count ;
+    bytes += size ;
+    if (first == NULL || length < sizeof(Header))
+        return ;
+
+    Header header ;
+    memcpy(&header, first, sizeof(header));
+    uint64_t current = clk->getCurrentTicksValue();
+    if (current >= header.sent)
+        latencies.push_back(clk->tick2NanoSecond(current - header.sent) * 1e-3);
+    if (header.flags & LAST_UPDATE)
+        finished.insert(header.sender);
+}
+
+// ----------------------------------------------------------------------------
+bool
+BenchFederate::run()
+{
+    join();
+    if (scenario.tso)
+        enableTimeManagement();
+    declare();
+
+    // Once the objects of the others are discovered, they have subscribed.
+    while (discoveries < (scenario.federates - 1) * scenario.objects)
+        evoke(0.1, 1.0);
+
+    bool complete = scenario.tso ? runTimeStampOrder() : runReceiveOrder();
+    resign();
+    report();
+    return complete ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+BenchFederate::runReceiveOrder()
+{
+    std::vector<char> first(std::max<size_t>(scenario.size, sizeof(Header)), 'x');
+    Header header = { scenario.index, 0, 0 };
+    double period = scenario.rate > 0.0 ? 1.0 / scenario.rate : 0.0 ;
+    double next = 0.0 ;
+    double elapsed = 0.0 ;
+    uint64_t start = clk->getCurrentTicksValue();
+
+    if (scenario.sender) {
+        while (elapsed < scenario.duration) {
+            if (elapsed < next) {
+                evoke(next - elapsed, next - elapsed);
+            }
+            else {
+                header.sent = clk->getCurrentTicksValue();
+                memcpy(&first[0], &header, sizeof(header));
+                update(updates % scenario.objects, first, -1.0);
+                ++updates ;
+                next += period ;
+                evoke(0.0, 0.001);
+            }
+            elapsed = clk->getDeltaNanoSecond(start) * 1e-9 ;
+        }
+        header.flags = LAST_UPDATE ;
+        header.sent = clk->getCurrentTicksValue();
+        memcpy(&first[0], &header, sizeof(header));
+        update(0, first, -1.0);
+    }
+    sending = elapsed ;
+
+    size_t expected = scenario.senders - (scenario.sender ? 1 : 0);
+    double deadline = std::max(elapsed, scenario.duration) + LAST_UPDATE_TIMEOUT ;
+    while (finished.size() < expected && elapsed < deadline) {
+        evoke(0.1, 1.0);
+        elapsed = clk->getDeltaNanoSecond(start) * 1e-9 ;
+    }
+
+    measured = elapsed ;
+    if (finished.size() < expected) {
+        cerr << scenario.name << ": no last update from " << expected - finished.size()
+             << " sender(s) after " << elapsed << " s." << endl ;
+        return false ;
+    }
+    return true ;
+}
+
+// ----------------------------------------------------------------------------
+bool
+BenchFederate::runTimeStampOrder()
+{
+    std::vector<char> first(std::max<size_t>(scenario.size, sizeof(Header)), 'x');
+    Header header = { scenario.index, 0, 0 };
+    // Steps without updates, so that the last ones are delivered everywhere.
+    int drain = static_cast<int>(ceil(scenario.lookahead)) + 1 ;
+    uint64_t start = clk->getCurrentTicksValue();
+
+    for (int step = 0 ; step < scenario.steps + drain ; ++step) {
+        if (scenario.sender && step < scenario.steps) {
+            for (int o = 0 ; o < scenario.objects ; ++o) {
+                header.sent = clk->getCurrentTicksValue();
+                memcpy(&first[0], &header, sizeof(header));
+                update(o, first, grantedTime + scenario.lookahead);
+                ++updates ;
+            }
+        }
+        uint64_t request = clk->getCurrentTicksValue();
+        advancing = true ;
+        timeAdvanceRequest(grantedTime + 1.0);
+        while (advancing)
+            evoke(0.1, 1.0);
+        grants.push_back(clk->getDeltaNanoSecond(request) * 1e-3);
+        if (step == scenario.steps - 1)
+            sending = clk->getDeltaNanoSecond(start) * 1e-9 ;
+    }
+
+    measured = clk->getDeltaNanoSecond(start) * 1e-9 ;
+    return true ;
+}
+
+// ----------------------------------------------------------------------------
+void
+BenchFederate::report()
+{
+    std::sort(latencies.begin(), latencies.end());
+    std::sort(grants.begin(), grants.end());
+
+    if (!scenario.samples.empty()) {
+        writeSamples(scenario.samples + ".uav", latencies);
+        writeSamples(scenario.samples + ".tag", grants);
+    }
+
+    std::ostringstream line ;
+    line << std::fixed << std::setprecision(1)
+         << flavour() << "  " << scenario.name << "  " << (scenario.tso ? "tso" : "ro")
+         << "  " << (scenario.ddm ? "ddm" : "-") << "  " << updates << "  "
+         << (sending > 0.0 ? updates / sending : 0.0) << "  " << reflections << "  "
+         << (measured > 0.0 ? reflections / measured : 0.0) << "  "
+         << (measured > 0.0 ? values / measured : 0.0) << "  "
+         << std::setprecision(3) << (measured > 0.0 ? bytes / measured / 1e6 : 0.0) << "  "
+         << measured << "  " << std::setprecision(1) ;
+    const double levels[] = { 0.5, 0.9, 0.99, 0.999, 1.0 };
+    for (unsigned int i = 0 ; i < sizeof(levels) / sizeof(levels[0]); ++i)
+        line << percentile(latencies, levels[i]) << "  " ;
+    for (unsigned int i = 0 ; i < sizeof(levels) / sizeof(levels[0]); ++i)
+        line << percentile(grants, levels[i]) << "  " ;
+
+    // The RTIA has ended with the resignation.
+    while (wait(NULL) > 0)
+        ;
+    line << std::setprecision(3) << cpu(RUSAGE_SELF) << "  " << cpu(RUSAGE_CHILDREN);
+
+    cout << "# flavour  federate  order  ddm  updates  updates/s  reflections"
+         << "  reflections/s  values/s  MB/s  seconds"
+         << "  uav-reflect-us p50 p90 p99 p99.9 max"
+         << "  tar-tag-us p50 p90 p99 p99.9 max  federate-cpu-s  rtia-cpu-s" << endl ;
+    cout << line.str() << endl ;
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    BenchScenario scenario ;
+    int option ;
+    while ((option = getopt(argc, argv, "n:x:f:i:N:P:Ro:a:s:r:t:TS:l:dw:")) != -1) {
+        switch (option) {
+          case 'n': scenario.name = optarg ; break ;
+          case 'x': scenario.federation = optarg ; break ;
+          case 'f': scenario.fom = optarg ; break ;
+          case 'i': scenario.index = atoi(optarg); break ;
+          case 'N': scenario.federates = atoi(optarg); break ;
+          case 'P': scenario.senders = atoi(optarg); break ;
+          case 'R': scenario.sender = false ; break ;
+          case 'o': scenario.objects = atoi(optarg); break ;
+          case 'a': scenario.attributes = atoi(optarg); break ;
+          case 's': scenario.size = atoi(optarg); break ;
+          case 'r': scenario.rate = atof(optarg); break ;
+          case 't': scenario.duration = atof(optarg); break ;
+          case 'T': scenario.tso = true ; break ;
+          case 'S': scenario.steps = atoi(optarg); break ;
+          case 'l': scenario.lookahead = atof(optarg); break ;
+          case 'd': scenario.ddm = true ; break ;
+          case 'w': scenario.samples = optarg ; break ;
+          default:
+            cerr << "Usage: " << argv[0] << " [-n name] [-x federation] [-f FOM] [-i index]"
+                 << " [-N federates] [-P senders] [-R] [-o objects] [-a attributes]"
+                 << " [-s size] [-r rate] [-t seconds] [-T] [-S steps] [-l lookahead] [-d]"
+                 << " [-w prefix]" << endl ;
+            return EXIT_FAILURE ;
+        }
+    }
+    if (scenario.name.empty()) {
+        std::ostringstream name ;
+        name << "bench-" << scenario.index ;
+        scenario.name = name.str();
+    }
+    if (scenario.senders < 0)
+        scenario.senders = scenario.federates ;
+    if (scenario.federates < 1 || scenario.objects < 1 || scenario.attributes < 1
+        || scenario.attributes > BenchFederate::MAX_ATTRIBUTES || scenario.lookahead <= 0.0) {
+        cerr << "At least one federate and one object, 1 to " << BenchFederate::MAX_ATTRIBUTES
+             << " attributes and a positive lookahead are needed." << endl ;
+        return EXIT_FAILURE ;
+    }
+
+    std::auto_ptr<BenchFederate> federate(BenchFederate::create(scenario));
+    if (federate.get() == NULL)
+        return EXIT_FAILURE ;
+    return federate->run() ? EXIT_SUCCESS : EXIT_FAILURE ;
+}
@@ -0,0 +1,131 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+#ifndef CERTI_BENCH_FEDERATE_HH
+#define CERTI_BENCH_FEDERATE_HH
+
+#include "Clock.hh"
+
+#include <stdint.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+/** The scenario run by a benchmark federate, from its command line. */
+struct BenchScenario
+{
+    BenchScenario();
+
+    std::string name ;          ///< federate name
+    std::string federation ;    ///< federation execution name
+    std::string fom ;           ///< FOM file, found through CERTI_FOM_PATH
+    uint32_t index ;            ///< number of this federate in the federation
+    int federates ;             ///< federates of the federation, this one included
+    int senders ;               ///< federates updating their objects
+    bool sender ;               ///< whether this federate updates its objects
+    int objects ;               ///< object instances registered by each federate
+    int attributes ;            ///< attributes per update
+    uint32_t size ;             ///< bytes per attribute value
+    double rate ;               ///< updates per second, 0 for no limit (receive order)
+    double duration ;           ///< seconds of updates (receive order)
+    int steps ;                 ///< time steps with updates (time stamp order)
+    double lookahead ;          ///< lookahead (time stamp order)
+    bool tso ;                  ///< time stamp order instead of receive order
+    bool ddm ;                  ///< subscriptions with regions
+    std::string samples ;       ///< prefix of the files receiving the latencies, if any
+};
+
+/**
+ * A federate running a benchmark scenario.
+ * The scenario, the measures and the report do not depend on the libRTI
+ * flavour: BenchFederate-HLA13.cc, BenchFederate-IEEE1516_2000.cc and
+ * BenchFederate-IEEE1516_2010.cc implement the RTI services for each of
+ * them, and call the reflected(), discovered() and granted() methods from
+ * their federate ambassador.
+ */
+class BenchFederate
+{
+public:
+    /** Attributes of the BenchObject class in BenchFederation.fed. */
+    static const int MAX_ATTRIBUTES = 8 ;
+
+    /** Build the federate of the flavour linked in. */
+    static BenchFederate *create(const BenchScenario &scenario);
+    /** Name of the libRTI flavour linked in. */
+    static const char *flavour();
+
+    virtual ~BenchFederate() {}
+
+    /** Run the scenario and print the measures, false if it failed. The
+     *  flavours catch the exceptions of their libRTI here. */
+    virtual bool run();
+
+protected:
+    BenchFederate(const BenchScenario &scenario);
+
+    /** Create the federation execution if needed, and join it. */
+    virtual void join() = 0 ;
+    /** Become time regulating and constrained, once both are granted,
+     *  with asynchronous delivery so that discoveries and other receive
+     *  order callbacks keep coming between time advances. */
+    virtual void enableTimeManagement() = 0 ;
+    /** Publish and subscribe the attributes, register the objects. */
+    virtual void declare() = 0 ;
+    /** Update the attributes of an object, with a time stamp if tso. */
+    virtual void update(int object, const std::vector<char> &first, double time) = 0 ;
+    /** Request a time advance, granted() being called back. */
+    virtual void timeAdvanceRequest(double time) = 0 ;
+    /** Deliver callbacks: wait up to wait seconds for one, then go on up to max. */
+    virtual void evoke(double wait, double max) = 0 ;
+    /** Resign, destroy the federation execution if it is the last one and
+     *  release the RTI ambassador, so that the RTIA ends. */
+    virtual void resign() = 0 ;
+
+    /** Called back when an object of another federate is discovered. */
+    void discovered() { ++discoveries ; }
+    /** Called back for a reflection, with the value of the first attribute. */
+    void reflected(const char *first, uint32_t length, uint32_t values, uint64_t bytes);
+    /** Called back when a time advance is granted. */
+    void granted(double time) { grantedTime = time ; advancing = false ; }
+
+    const BenchScenario &scenario ;
+
+private:
+    bool runReceiveOrder();
+    bool runTimeStampOrder();
+    void report();
+
+    std::auto_ptr<libhla::clock::Clock> clk ;
+    int discoveries ;
+    bool advancing ;
+    double grantedTime ;
+    uint64_t updates ;
+    uint64_t reflections ;
+    uint64_t values ;
+    uint64_t bytes ;
+    double measured ;           ///< seconds from the first update to the last reflection
+    double sending ;            ///< seconds from the first update to the last one
+    std::set<uint32_t> finished ;
+    std::vector<double> latencies ;
+    std::vector<double> grants ;
+};
+
+#endif // CERTI_BENCH_FEDERATE_HH
@@ -0,0 +1,144 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Best effort transportation benchmark.
+//
+// Two HLA 1.3 federates run in this process. The ping federate updates
+// the probe attribute (Attr1) of its object, the pong federate answers its
+// reflection with an update of its own, and the mean round trip of this
+// exchange is reported, lost probes excluded. Under load, the ping federate
+// first updates a bulk attribute (Attr2, reliable) of its object a given
+// number of times before each probe, which the pong federate reflects too.
+// This is done with the probe attributes reliable, then best effort through
+// changeAttributeTransportationType: the RTIG then sends the probe
+// reflections to the RTIAs over UDP, packed in datagrams. A probe not
+// answered within a second is counted as lost.
+//
+// Usage: CertiBenchBestEffort [round_trips [load [FED file]]]
+//   A rtig must be running (CERTI_HOST / CERTI_TCP_PORT) and the FED file
+//   (default testFederation.fed) must be found through CERTI_FOM_PATH.
+
+#include "PeerFederate.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchBestEffort" ;
+
+/** Measure the mean round trip in microseconds and count the lost probes. */
+void run(bool bestEffort, int roundTrips, int load, const char *fed,
+         libhla::clock::Clock &clk, double &roundTrip, int &lost)
+{
+    PeerFederate ping, pong ;
+    join(ping, FEDERATION_NAME, "ping", fed);
+    join(pong, FEDERATION_NAME, "pong", fed);
+
+    RTI::ObjectClassHandle dataClass = ping.rtiamb->getObjectClassHandle("Data");
+    RTI::AttributeHandle attr1 = ping.rtiamb->getAttributeHandle("Attr1", dataClass);
+    RTI::AttributeHandle attr2 = ping.rtiamb->getAttributeHandle("Attr2", dataClass);
+    std::auto_ptr<RTI::AttributeHandleSet> probes(RTI::AttributeHandleSetFactory::create(1));
+    probes->add(attr1);
+    std::auto_ptr<RTI::AttributeHandleSet> all(RTI::AttributeHandleSetFactory::create(2));
+    all->add(attr1);
+    all->add(attr2);
+
+    ping.rtiamb->publishObjectClass(dataClass, *all);
+    ping.rtiamb->subscribeObjectClassAttributes(dataClass, *probes);
+    pong.rtiamb->publishObjectClass(dataClass, *probes);
+    pong.rtiamb->subscribeObjectClassAttributes(dataClass, *all);
+    PeerFederate *federates[] = { &ping, &pong };
+    for (int i = 0 ; i < 2 ; ++i) {
+        federates[i]->amb.probe = attr1 ;
+        federates[i]->object = federates[i]->rtiamb->registerObjectInstance(dataClass);
+        if (bestEffort) {
+            RTI::TransportationHandle type =
+                federates[i]->rtiamb->getTransportationHandle("HLAbestEffort");
+            federates[i]->rtiamb->changeAttributeTransportationType(federates[i]->object,
+                                                                    *probes, type);
+        }
+    }
+    discover(ping, pong);
+
+    std::string value(1000, 'x');
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> bulk(RTI::AttributeSetFactory::create(1));
+    bulk->add(attr2, value.data(), value.size());
+
+    // Only the probe exchange is timed, not the sending of the load.
+    lost = 0 ;
+    uint64_t total = 0 ;
+    for (int i = 1 ; i <= roundTrips ; ++i) {
+        for (int j = 0 ; j < load ; ++j)
+            ping.rtiamb->updateAttributeValues(ping.object, *bulk, "");
+        uint64_t start = clk.getCurrentTicksValue();
+        probe(ping, i);
+        if (!await(pong, i, clk, 1.0)) {
+            ++lost ;
+            continue ;
+        }
+        probe(pong, i);
+        if (!await(ping, i, clk, 1.0)) {
+            ++lost ;
+            continue ;
+        }
+        total += clk.getDeltaNanoSecond(start);
+    }
+    roundTrip = roundTrips > lost ? total * 1e-3 / (roundTrips - lost) : 0 ;
+
+    resign(ping, pong, FEDERATION_NAME);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int roundTrips = argc > 1 ? atoi(argv[1]) : 1000 ;
+    int load = argc > 2 ? atoi(argv[2]) : 20 ;
+    const char *fed = argc > 3 ? argv[3] : "testFederation.fed" ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# transport  load  round trip (us)  lost" << endl ;
+        static const char *modes[] = { "reliable", "best_effort" };
+        const int loads[] = { 0, load };
+        for (int l = 0 ; l < 2 ; ++l) {
+            for (int mode = 0 ; mode < 2 ; ++mode) {
+                double roundTrip ;
+                int lost ;
+                run(mode != 0, roundTrips, loads[l], fed, *clk, roundTrip, lost);
+                cout << modes[mode] << "  " << loads[l] << "  " << roundTrip
+                     << "  " << lost << endl ;
+            }
+        }
+    }
+    catch (RTI::Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << (e._reason ? e._reason : "") << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
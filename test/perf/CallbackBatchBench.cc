@@ -0,0 +1,154 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Callback delivery benchmark.
+//
+// Two HLA 1.3 federates run in this process. The publisher sends a burst of
+// receive order updates, which the RTIA of the subscriber queues, then the
+// subscriber drains them with tick() and the reflection rate is reported.
+// This is done first with the default RTIA (one callback per
+// TICK_REQUEST_NEXT) and then with a subscriber RTIA started with
+// CERTI_TICK_BATCH set to the given batch size.
+//
+// Usage: CertiBenchCallbacks [count [batch [FED file]]]
+//   A rtig must be running (CERTI_HOST / CERTI_TCP_PORT) and the FED file
+//   (default testFederation.fed) must be found through CERTI_FOM_PATH.
+
+#include "RTI.hh"
+#include "NullFederateAmbassador.hh"
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchCallbacks" ;
+
+class Subscriber : public NullFederateAmbassador
+{
+public:
+    Subscriber() : discovered(false), reflections(0) {}
+
+    void discoverObjectInstance(RTI::ObjectHandle, RTI::ObjectClassHandle, const char *)
+        throw (RTI::CouldNotDiscover, RTI::ObjectClassNotKnown, RTI::FederateInternalError) {
+        discovered = true ;
+    }
+
+    void reflectAttributeValues(RTI::ObjectHandle, const RTI::AttributeHandleValuePairSet &, const char *)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::FederateOwnsAttributes,
+               RTI::FederateInternalError) {
+        ++reflections ;
+    }
+
+    bool discovered ;
+    int reflections ;
+};
+
+/** Join a new federate whose RTIA uses the given batch size, 0 meaning the default. */
+RTI::RTIambassador *join(const char *name, int batch, const char *fed,
+                         RTI::FederateAmbassador &fedamb)
+{
+    if (batch > 0) {
+        std::ostringstream value ;
+        value << batch ;
+        setenv("CERTI_TICK_BATCH", value.str().c_str(), 1);
+    }
+    else {
+        unsetenv("CERTI_TICK_BATCH");
+    }
+
+    RTI::RTIambassador *rtiamb = new RTI::RTIambassador();
+    try {
+        rtiamb->createFederationExecution(FEDERATION_NAME, fed);
+    }
+    catch (RTI::FederationExecutionAlreadyExists &) {
+    }
+    rtiamb->joinFederationExecution(name, FEDERATION_NAME, &fedamb);
+    return rtiamb ;
+}
+
+/** Return the reflection rate seen by a subscriber draining count updates. */
+double run(int count, int batch, const char *fed, libhla::clock::Clock &clk)
+{
+    NullFederateAmbassador publisherAmb ;
+    Subscriber subscriberAmb ;
+    std::auto_ptr<RTI::RTIambassador> publisher(join("publisher", 0, fed, publisherAmb));
+    std::auto_ptr<RTI::RTIambassador> subscriber(join("subscriber", batch, fed, subscriberAmb));
+
+    RTI::ObjectClassHandle dataClass = publisher->getObjectClassHandle("Data");
+    RTI::AttributeHandle attr1 = publisher->getAttributeHandle("Attr1", dataClass);
+    std::auto_ptr<RTI::AttributeHandleSet> attributes(RTI::AttributeHandleSetFactory::create(1));
+    attributes->add(attr1);
+    publisher->publishObjectClass(dataClass, *attributes);
+    subscriber->subscribeObjectClassAttributes(dataClass, *attributes);
+    RTI::ObjectHandle object = publisher->registerObjectInstance(dataClass);
+    while (!subscriberAmb.discovered)
+        subscriber->tick(0.1, 1.0);
+
+    std::string value(8, 'x');
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> ahvps(RTI::AttributeSetFactory::create(1));
+    ahvps->add(attr1, value.data(), value.size());
+    for (int i = 0 ; i < count ; ++i)
+        publisher->updateAttributeValues(object, *ahvps, "");
+
+    uint64_t start = clk.getCurrentTicksValue();
+    while (subscriberAmb.reflections < count)
+        subscriber->tick(0.1, 1.0);
+    double rate = count / (clk.getDeltaNanoSecond(start) * 1e-9);
+
+    subscriber->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    publisher->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    try {
+        publisher->destroyFederationExecution(FEDERATION_NAME);
+    }
+    catch (RTI::FederatesCurrentlyJoined &) {
+    }
+    return rate ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 10000 ;
+    int batch = argc > 2 ? atoi(argv[2]) : 256 ;
+    const char *fed = argc > 3 ? argv[3] : "testFederation.fed" ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# batch  updates  reflections/s" << endl ;
+        cout << "1  " << count << "  " << static_cast<uint64_t>(run(count, 0, fed, *clk)) << endl ;
+        cout << batch << "  " << count << "  " << static_cast<uint64_t>(run(count, batch, fed, *clk)) << endl ;
+    }
+    catch (RTI::Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << (e._reason ? e._reason : "") << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
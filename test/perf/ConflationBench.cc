@@ -0,0 +1,257 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+// Receive order conflation benchmark.
+//
+// Two HLA 1.3 federates run in this process. The publisher updates the two
+// attributes of a few objects again and again, each value carrying its
+// update number, while the subscriber does not tick. The subscriber then
+// ticks until it has the last value of every attribute, and the number of
+// reflections it got and the time it took are reported: first with the
+// default RTIA, which queues every update, then with a subscriber RTIA
+// started with CERTI_CONFLATE set to the given names (default Data), which
+// keeps only the latest values of the attributes they cover.
+//
+// A last run mixes receive order updates with a time stamped one, which
+// the subscriber receives in receive order as it is not constrained: the
+// later updates must not be conflated into the ones queued before it.
+//
+// Usage: CertiBenchConflation [updates [objects [names [FED file]]]]
+//   A rtig must be running (CERTI_HOST / CERTI_TCP_PORT) and the FED file
+//   (default testFederation.fed) must be found through CERTI_FOM_PATH.
+
+#include "RTI.hh"
+#include "fedtime.hh"
+#include "NullFederateAmbassador.hh"
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchConflation" ;
+
+class Subscriber : public NullFederateAmbassador
+{
+public:
+    Subscriber() : discovered(0), reflections(0), dated(0), values(0) {}
+
+    void discoverObjectInstance(RTI::ObjectHandle, RTI::ObjectClassHandle, const char *)
+        throw (RTI::CouldNotDiscover, RTI::ObjectClassNotKnown, RTI::FederateInternalError) {
+        ++discovered ;
+    }
+
+    void reflectAttributeValues(RTI::ObjectHandle object, const RTI::AttributeHandleValuePairSet &ahvps,
+                                const char *)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::FederateOwnsAttributes,
+               RTI::FederateInternalError) {
+        ++reflections ;
+        for (RTI::ULong i = 0 ; i < ahvps.size() ; ++i) {
+            RTI::ULong length ;
+            char *value = ahvps.getValuePointer(i, length);
+            uint32_t update = 0 ;
+            if (length >= sizeof(update))
+                memcpy(&update, value, sizeof(update));
+            latest[std::make_pair(object, ahvps.getHandle(i))] = update ;
+            ++values ;
+        }
+    }
+
+    void reflectAttributeValues(RTI::ObjectHandle object, const RTI::AttributeHandleValuePairSet &ahvps,
+                                const RTI::FedTime &, const char *tag, RTI::EventRetractionHandle)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::FederateOwnsAttributes,
+               RTI::InvalidFederationTime, RTI::FederateInternalError) {
+        ++dated ;
+        reflectAttributeValues(object, ahvps, tag);
+    }
+
+    int discovered ;
+    int reflections ;
+    int dated ;
+    int values ;
+    std::map<std::pair<RTI::ObjectHandle, RTI::AttributeHandle>, uint32_t> latest ;
+};
+
+RTI::RTIambassador *join(const char *name, const char *fed, RTI::FederateAmbassador &fedamb)
+{
+    RTI::RTIambassador *rtiamb = new RTI::RTIambassador();
+    try {
+        rtiamb->createFederationExecution(FEDERATION_NAME, fed);
+    }
+    catch (RTI::FederationExecutionAlreadyExists &) {
+    }
+    rtiamb->joinFederationExecution(name, FEDERATION_NAME, &fedamb);
+    return rtiamb ;
+}
+
+/** Drain the updates, conflated or not, and print the result line. */
+void run(int updates, int objects, const char *conflate, const char *fed,
+         libhla::clock::Clock &clk)
+{
+    NullFederateAmbassador publisherAmb ;
+    Subscriber subscriberAmb ;
+    unsetenv("CERTI_CONFLATE");
+    std::auto_ptr<RTI::RTIambassador> publisher(join("publisher", fed, publisherAmb));
+    if (conflate != NULL)
+        setenv("CERTI_CONFLATE", conflate, 1);
+    std::auto_ptr<RTI::RTIambassador> subscriber(join("subscriber", fed, subscriberAmb));
+    unsetenv("CERTI_CONFLATE");
+
+    RTI::ObjectClassHandle dataClass = publisher->getObjectClassHandle("Data");
+    RTI::AttributeHandle attr1 = publisher->getAttributeHandle("Attr1", dataClass);
+    RTI::AttributeHandle attr2 = publisher->getAttributeHandle("Attr2", dataClass);
+    std::auto_ptr<RTI::AttributeHandleSet> attributes(RTI::AttributeHandleSetFactory::create(2));
+    attributes->add(attr1);
+    attributes->add(attr2);
+    publisher->publishObjectClass(dataClass, *attributes);
+    subscriber->subscribeObjectClassAttributes(dataClass, *attributes);
+    std::vector<RTI::ObjectHandle> handles ;
+    for (int o = 0 ; o < objects ; ++o)
+        handles.push_back(publisher->registerObjectInstance(dataClass));
+    while (subscriberAmb.discovered < objects)
+        subscriber->tick(0.1, 1.0);
+
+    // Update i of object i % objects sets Attr1 to i and Attr2 to i + 1.
+    std::string value(64, 'x');
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> ahvps(RTI::AttributeSetFactory::create(2));
+    for (int i = 0 ; i < updates ; ++i) {
+        ahvps->empty();
+        uint32_t update = i ;
+        memcpy(&value[0], &update, sizeof(update));
+        ahvps->add(attr1, value.data(), value.size());
+        ++update ;
+        memcpy(&value[0], &update, sizeof(update));
+        ahvps->add(attr2, value.data(), value.size());
+        publisher->updateAttributeValues(handles[i % objects], *ahvps, "");
+    }
+
+    uint64_t start = clk.getCurrentTicksValue();
+    bool complete = false ;
+    while (!complete) {
+        subscriber->tick(0.1, 1.0);
+        complete = true ;
+        for (int o = 0 ; o < objects && complete ; ++o) {
+            uint32_t last = o + (updates - 1 - o) / objects * objects ;
+            complete = subscriberAmb.latest[std::make_pair(handles[o], attr1)] == last
+                && subscriberAmb.latest[std::make_pair(handles[o], attr2)] == last + 1 ;
+        }
+    }
+    double elapsed = clk.getDeltaNanoSecond(start) * 1e-6 ;
+
+    cout << (conflate != NULL ? "conflated" : "queued") << "  " << updates << "  "
+         << subscriberAmb.reflections << "  " << subscriberAmb.values << "  " << elapsed << endl ;
+
+    subscriber->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    publisher->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    try {
+        publisher->destroyFederationExecution(FEDERATION_NAME);
+    }
+    catch (RTI::FederatesCurrentlyJoined &) {
+    }
+}
+
+/**
+ * Update an attribute without time stamp, with one, then without again:
+ * the last value must be the one the subscriber ends with.
+ */
+bool checkDatedBarrier(const char *conflate, const char *fed)
+{
+    NullFederateAmbassador publisherAmb ;
+    Subscriber subscriberAmb ;
+    std::auto_ptr<RTI::RTIambassador> publisher(join("publisher", fed, publisherAmb));
+    setenv("CERTI_CONFLATE", conflate, 1);
+    std::auto_ptr<RTI::RTIambassador> subscriber(join("subscriber", fed, subscriberAmb));
+    unsetenv("CERTI_CONFLATE");
+
+    RTI::ObjectClassHandle dataClass = publisher->getObjectClassHandle("Data");
+    RTI::AttributeHandle attr1 = publisher->getAttributeHandle("Attr1", dataClass);
+    std::auto_ptr<RTI::AttributeHandleSet> attributes(RTI::AttributeHandleSetFactory::create(1));
+    attributes->add(attr1);
+    publisher->publishObjectClass(dataClass, *attributes);
+    subscriber->subscribeObjectClassAttributes(dataClass, *attributes);
+    RTI::ObjectHandle object = publisher->registerObjectInstance(dataClass);
+    while (subscriberAmb.discovered < 1)
+        subscriber->tick(0.1, 1.0);
+
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> ahvps(RTI::AttributeSetFactory::create(1));
+    for (uint32_t update = 1 ; update <= 3 ; ++update) {
+        ahvps->empty();
+        ahvps->add(attr1, reinterpret_cast<const char *>(&update), sizeof(update));
+        if (update == 2)
+            publisher->updateAttributeValues(object, *ahvps, RTIfedTime(10.0), "");
+        else
+            publisher->updateAttributeValues(object, *ahvps, "");
+    }
+
+    while (subscriberAmb.dated == 0)
+        subscriber->tick(0.1, 1.0);
+    for (int i = 0 ; i < 5 ; ++i)
+        subscriber->tick(0.1, 0.2);
+    bool ok = subscriberAmb.latest[std::make_pair(object, attr1)] == 3 ;
+    cout << "# dated barrier: " << subscriberAmb.reflections << " reflections, last value "
+         << subscriberAmb.latest[std::make_pair(object, attr1)] << (ok ? " ok" : " BROKEN") << endl ;
+
+    subscriber->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    publisher->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    try {
+        publisher->destroyFederationExecution(FEDERATION_NAME);
+    }
+    catch (RTI::FederatesCurrentlyJoined &) {
+    }
+    return ok ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int updates = argc > 1 ? atoi(argv[1]) : 10000 ;
+    int objects = argc > 2 ? atoi(argv[2]) : 4 ;
+    const char *names = argc > 3 ? argv[3] : "Data" ;
+    const char *fed = argc > 4 ? argv[4] : "testFederation.fed" ;
+    if (objects < 1 || updates < objects) {
+        cerr << "At least one update per object is needed." << endl ;
+        return EXIT_FAILURE ;
+    }
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# mode  updates  reflections  values  drain ms" << endl ;
+        run(updates, objects, NULL, fed, *clk);
+        run(updates, objects, names, fed, *clk);
+        if (!checkDatedBarrier(names, fed))
+            return EXIT_FAILURE ;
+    }
+    catch (RTI::Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << (e._reason ? e._reason : "") << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,172 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// DDM region matching benchmark.
+//
+// Creates, in a routing space of the given number of dimensions, regions
+// of one extent whose ranges cover 1/64 of each axis at random places, and
+// measures the rate of overlap queries of random update regions of the same
+// size: first by testing every region as Subscribable used to, then through
+// the RegionIndex of the space. The mean number of overlapping regions found
+// both ways must be the same. The rate of modifyRegion moving a region to a
+// random place is reported too, as the index is updated on each of them.
+//
+// Usage: CertiBenchDDM [max_regions [max_dimensions [queries]]]
+
+#include "config.h"
+#include "certi.hh"
+#include "RoutingSpace.hh"
+#include "RTIRegion.hh"
+#include "RegionIndex.hh"
+#include "Dimension.hh"
+#include "Clock.hh"
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const uint32_t RANGE = UINT_MAX / 64 ;
+
+std::vector<Extent> randomExtents(const RoutingSpace &space)
+{
+    std::vector<Extent> extents(1, space.createExtent());
+    for (DimensionHandle d = 1 ; d <= space.size() ; ++d) {
+        uint32_t lower = static_cast<uint32_t>(
+            (static_cast<uint64_t>(rand()) * (UINT_MAX - RANGE)) / RAND_MAX);
+        extents[0].setRangeLowerBound(d, lower);
+        extents[0].setRangeUpperBound(d, lower + RANGE);
+    }
+    return extents ;
+}
+
+struct Result {
+    double bruteRate ;
+    double indexRate ;
+    double bruteMatches ;
+    double indexMatches ;
+    double modifyRate ;
+};
+
+Result run(int count, int dimensions, int queries, libhla::clock::Clock &clk)
+{
+    RoutingSpace space ;
+    space.setHandle(1);
+    for (int d = 1 ; d <= dimensions ; ++d) {
+        Dimension dimension(d);
+        std::ostringstream name ;
+        name << "D" << d ;
+        dimension.setName(name.str());
+        space.addDimension(dimension);
+    }
+
+    std::vector<RTIRegion *> regions ;
+    for (int i = 0 ; i < count ; ++i) {
+        RTIRegion *region = new RTIRegion(i + 1, space, 1);
+        region->replaceExtents(randomExtents(space));
+        space.getRegionIndex().insert(region);
+        regions.push_back(region);
+    }
+
+    std::vector<RTIRegion *> updates ;
+    for (int i = 0 ; i < queries ; ++i) {
+        RTIRegion *region = new RTIRegion(count + i + 1, space, 1);
+        region->replaceExtents(randomExtents(space));
+        updates.push_back(region);
+    }
+
+    Result result ;
+    uint64_t matches = 0 ;
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < queries ; ++i) {
+        for (int r = 0 ; r < count ; ++r)
+            if (regions[r]->overlaps(*updates[i]))
+                ++matches ;
+    }
+    result.bruteRate = queries / (clk.getDeltaNanoSecond(start) * 1e-9);
+    result.bruteMatches = static_cast<double>(matches) / queries ;
+
+    matches = 0 ;
+    RegionIndex::RegionList overlapping ;
+    start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < queries ; ++i) {
+        space.getRegionIndex().overlapping(*updates[i], overlapping);
+        matches += overlapping.size();
+    }
+    result.indexRate = queries / (clk.getDeltaNanoSecond(start) * 1e-9);
+    result.indexMatches = static_cast<double>(matches) / queries ;
+
+    std::vector<std::vector<Extent> > moves ;
+    for (int i = 0 ; i < queries ; ++i)
+        moves.push_back(randomExtents(space));
+    start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < queries ; ++i)
+        space.getRegionIndex().update(regions[i % count], moves[i]);
+    result.modifyRate = queries / (clk.getDeltaNanoSecond(start) * 1e-9);
+
+    for (int i = 0 ; i < count ; ++i) {
+        space.getRegionIndex().remove(regions[i]);
+        delete regions[i] ;
+    }
+    for (int i = 0 ; i < queries ; ++i)
+        delete updates[i] ;
+    return result ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int maxRegions = argc > 1 ? atoi(argv[1]) : 16384 ;
+    int maxDimensions = argc > 2 ? atoi(argv[2]) : 3 ;
+    int queries = argc > 3 ? atoi(argv[3]) : 2000 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+    srand(1);
+
+    try {
+        cout << "# dimensions  regions  brute queries/s  index queries/s"
+             << "  brute matches  index matches  modify/s" << endl ;
+        for (int dimensions = 1 ; dimensions <= maxDimensions ; ++dimensions) {
+            for (int regions = 256 ; regions <= maxRegions ; regions *= 4) {
+                Result r = run(regions, dimensions, queries, *clk);
+                cout << dimensions << "  " << regions
+                     << "  " << static_cast<uint64_t>(r.bruteRate)
+                     << "  " << static_cast<uint64_t>(r.indexRate)
+                     << "  " << r.bruteMatches << "  " << r.indexMatches
+                     << "  " << static_cast<uint64_t>(r.modifyRate) << endl ;
+            }
+        }
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
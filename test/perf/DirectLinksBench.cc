@@ -0,0 +1,175 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Direct RTIA links benchmark.
+//
+// Two HLA 1.3 federates run in this process. The ping federate updates
+// the probe attribute (Attr1) of its object, the pong federate answers its
+// reflection with an update of its own, and the mean round trip of this
+// exchange is reported. Then the ping federate sends a burst of receive
+// order updates of a bulk attribute (Attr2), and the rate at which the
+// pong federate reflects them is reported. This is done with the updates
+// relayed by the RTIG, then with CERTI_DIRECT_LINKS set for both RTIAs,
+// which then send them to each other over their direct links. Last, a late
+// federate subscribes while the ping federate keeps updating: it must get
+// the discovery of the object before its reflections, whichever path comes
+// first. Then the ping federate deletes objects right after updating them:
+// the pong federate must get no reflection after a removal, although the
+// removal relayed by the RTIG may overtake the updates.
+//
+// Usage: CertiBenchDirectLinks [round_trips [burst [size [FED file]]]]
+//   A rtig must be running (CERTI_HOST / CERTI_TCP_PORT) and the FED file
+//   (default testFederation.fed) must be found through CERTI_FOM_PATH.
+
+#include "PeerFederate.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchDirectLinks" ;
+// Objects registered, updated and deleted at once, their updates and the
+// size of these, enough for the direct link to queue them.
+const int DELETED_OBJECTS = 100 ;
+const int DELETED_UPDATES = 10 ;
+const size_t DELETED_SIZE = 64 * 1024 ;
+
+/** Measure the mean round trip in microseconds and the burst rate in updates/s. */
+void run(bool direct, int roundTrips, int burst, int size, const char *fed,
+         libhla::clock::Clock &clk, double &roundTrip, double &rate)
+{
+    // The RTIAs read the variable when the RTIambassadors launch them.
+    if (direct)
+        setenv("CERTI_DIRECT_LINKS", "1", 1);
+    else
+        unsetenv("CERTI_DIRECT_LINKS");
+
+    PeerFederate ping, pong ;
+    join(ping, FEDERATION_NAME, "ping", fed);
+    join(pong, FEDERATION_NAME, "pong", fed);
+
+    RTI::ObjectClassHandle dataClass = ping.rtiamb->getObjectClassHandle("Data");
+    RTI::AttributeHandle attr1 = ping.rtiamb->getAttributeHandle("Attr1", dataClass);
+    RTI::AttributeHandle attr2 = ping.rtiamb->getAttributeHandle("Attr2", dataClass);
+    std::auto_ptr<RTI::AttributeHandleSet> probes(RTI::AttributeHandleSetFactory::create(1));
+    probes->add(attr1);
+    std::auto_ptr<RTI::AttributeHandleSet> all(RTI::AttributeHandleSetFactory::create(2));
+    all->add(attr1);
+    all->add(attr2);
+
+    ping.rtiamb->publishObjectClass(dataClass, *all);
+    ping.rtiamb->subscribeObjectClassAttributes(dataClass, *probes);
+    pong.rtiamb->publishObjectClass(dataClass, *probes);
+    pong.rtiamb->subscribeObjectClassAttributes(dataClass, *all);
+    PeerFederate *federates[] = { &ping, &pong };
+    for (int i = 0 ; i < 2 ; ++i) {
+        federates[i]->amb.probe = attr1 ;
+        federates[i]->object = federates[i]->rtiamb->registerObjectInstance(dataClass);
+    }
+    discover(ping, pong);
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 1 ; i <= roundTrips ; ++i) {
+        probe(ping, i);
+        await(pong, i, clk);
+        probe(pong, i);
+        await(ping, i, clk);
+    }
+    roundTrip = clk.getDeltaNanoSecond(start) * 1e-3 / roundTrips ;
+
+    std::string value(size, 'x');
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> bulk(RTI::AttributeSetFactory::create(1));
+    bulk->add(attr2, value.data(), value.size());
+
+    start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < burst ; ++i)
+        ping.rtiamb->updateAttributeValues(ping.object, *bulk, "");
+    while (pong.amb.bulk < burst)
+        pong.rtiamb->tick(0.01, 0.1);
+    rate = burst * 1e9 / clk.getDeltaNanoSecond(start);
+
+    if (direct) {
+        PeerFederate late ;
+        join(late, FEDERATION_NAME, "late", fed);
+        late.amb.probe = attr1 ;
+        late.rtiamb->subscribeObjectClassAttributes(dataClass, *probes);
+        // The routes to the late federate reach the ping RTIA meanwhile.
+        int sequence = roundTrips ;
+        while (late.amb.lastProbe <= roundTrips) {
+            probe(ping, ++sequence);
+            late.rtiamb->tick(0.0, 0.001);
+        }
+        cout << "# late subscriber reflecting after " << sequence - roundTrips
+             << " updates: " << (late.amb.undiscovered == 0 ? "ok" : "BROKEN") << endl ;
+        late.rtiamb->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+
+        std::string large(DELETED_SIZE, 'x');
+        std::auto_ptr<RTI::AttributeHandleValuePairSet> heavy(RTI::AttributeSetFactory::create(1));
+        heavy->add(attr2, large.data(), large.size());
+        for (int i = 0 ; i < DELETED_OBJECTS ; ++i) {
+            RTI::ObjectHandle object = ping.rtiamb->registerObjectInstance(dataClass);
+            for (int j = 0 ; j < DELETED_UPDATES ; ++j)
+                ping.rtiamb->updateAttributeValues(object, *heavy, "");
+            ping.rtiamb->deleteObjectInstance(object, "");
+        }
+        while (pong.amb.removals < DELETED_OBJECTS)
+            pong.rtiamb->tick(0.01, 0.1);
+        // The updates overtaken by the removals come meanwhile.
+        pong.rtiamb->tick(0.2, 0.2);
+        cout << "# objects deleted after " << DELETED_UPDATES << " updates: "
+             << (pong.amb.afterRemoval == 0 ? "ok" : "BROKEN") << endl ;
+    }
+
+    resign(ping, pong, FEDERATION_NAME);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int roundTrips = argc > 1 ? atoi(argv[1]) : 1000 ;
+    int burst = argc > 2 ? atoi(argv[2]) : 20000 ;
+    int size = argc > 3 ? atoi(argv[3]) : 100 ;
+    const char *fed = argc > 4 ? argv[4] : "testFederation.fed" ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# path  round trip (us)  burst (updates/s)" << endl ;
+        static const char *modes[] = { "rtig", "direct" };
+        for (int mode = 0 ; mode < 2 ; ++mode) {
+            double roundTrip, rate ;
+            run(mode != 0, roundTrips, burst, size, fed, *clk, roundTrip, rate);
+            cout << modes[mode] << "  " << roundTrip << "  " << rate << endl ;
+        }
+    }
+    catch (RTI::Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << (e._reason ? e._reason : "") << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,100 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Event tracing benchmark.
+//
+// Records the given number of events with EventTrace, first with tracing
+// disabled, then enabled as by CERTI_TRACE, from one thread then from
+// several threads at once, and reports the mean cost of an event (wall
+// time divided by the events of all the threads). The time
+// taken to dump the rings is reported too; the trace file written is
+// bench.<pid>.trace in the current directory.
+//
+// Usage: CertiBenchEventTrace [events [threads [ring_size]]]
+
+#include "config.h"
+#include "certi.hh"
+#include "EventTrace.hh"
+#include "Clock.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <pthread.h>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+void *record(void *events)
+{
+    int count = *static_cast<int *>(events);
+    for (int i = 0 ; i < count ; ++i)
+        EventTrace::record(TRACE_RTIG_RECEIVE, i & 0xff, 1, i & 0xf, i, 64);
+    return NULL ;
+}
+
+/** Mean cost of an event in nanoseconds, the threads recording at once. */
+double measure(int events, int threads, libhla::clock::Clock &clk)
+{
+    std::vector<pthread_t> ids(threads);
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int t = 0 ; t < threads ; ++t)
+        pthread_create(&ids[t], NULL, record, &events);
+    for (int t = 0 ; t < threads ; ++t)
+        pthread_join(ids[t], NULL);
+    return clk.getDeltaNanoSecond(start) / (double(events) * threads);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int events = argc > 1 ? atoi(argv[1]) : 10000000 ;
+    int threads = argc > 2 ? atoi(argv[2]) : 4 ;
+    const char *ringSize = argc > 3 ? argv[3] : "65536" ;
+    if (threads < 1)
+        threads = 1 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    cout << "# tracing  threads  event (ns)" << endl ;
+    cout << "disabled  1  " << measure(events, 1, *clk) << endl ;
+
+    setenv("CERTI_TRACE", ringSize, 1);
+    EventTrace::configure("bench");
+    if (!EventTrace::isEnabled()) {
+        cerr << "Tracing not available on this platform" << endl ;
+        return EXIT_FAILURE ;
+    }
+    cout << "enabled  1  " << measure(events, 1, *clk) << endl ;
+    cout << "enabled  " << threads << "  " << measure(events, threads, *clk) << endl ;
+
+    uint64_t start = clk->getCurrentTicksValue();
+    EventTrace::dump();
+    cout << "# dump of " << threads + 2 << " rings of " << ringSize << " events: "
+         << clk->getDeltaNanoSecond(start) * 1e-6 << " ms" << endl ;
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,204 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// RTIG fan-out benchmark.
+//
+// Synthetic RTIAs join a federation on a running rtig: a sender and
+// receivers subscribed to the Message interaction. The sender keeps a window
+// of small interactions waiting for the RTIG answer, each of them broadcast
+// to every receiver. The interactions sent and delivered per second are
+// reported, with the number of write system calls the rtig made per
+// delivered interaction (from /proc/<rtig>/io, when the rtig runs on the
+// same host): about one without write coalescing, much less with it.
+//
+// Usage: CertiBenchFanout [receivers [seconds [size [window]]]]
+//   The rtig is found with CERTI_HOST / CERTI_TCP_PORT, testFederation.fed
+//   with CERTI_FOM_PATH. Compare a rtig started with CERTI_NO_COALESCING set
+//   with one started without it.
+
+#include "config.h"
+#include "SyntheticRTIA.hh"
+#include "Clock.hh"
+
+#include <dirent.h>
+#include <poll.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchFanout" ;
+// Message interaction class and its Param1 parameter in testFederation.fed
+const InteractionClassHandle MESSAGE_CLASS = 3 ;
+const ParameterHandle PARAM1 = 1 ;
+
+/** Write system calls of the rtig so far, -1 if unknown. */
+long long writeCalls(const std::string &io)
+{
+    std::ifstream file(io.c_str());
+    std::string key ;
+    long long value ;
+    while (file >> key >> value) {
+        if (key == "syscw:")
+            return value ;
+    }
+    return -1 ;
+}
+
+/** The /proc/<pid>/io file of the local rtig, empty if there is none. */
+std::string findRTIG()
+{
+    DIR *proc = opendir("/proc");
+    if (proc == NULL)
+        return "" ;
+    std::string found ;
+    struct dirent *entry ;
+    while (found.empty() && (entry = readdir(proc)) != NULL) {
+        std::string dir = std::string("/proc/") + entry->d_name ;
+        std::ifstream stat((dir + "/stat").c_str());
+        std::string pid, name, state ;
+        // Not a rtig which has exited but is not reaped yet.
+        if (stat >> pid >> name >> state && name == "(rtig)" && state != "Z")
+            found = dir + "/io" ;
+    }
+    closedir(proc);
+    return found ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int receiverCount = argc > 1 ? atoi(argv[1]) : 8 ;
+    double seconds = argc > 2 ? atof(argv[2]) : 3.0 ;
+    uint32_t size = argc > 3 ? atoi(argv[3]) : 16 ;
+    int window = argc > 4 ? atoi(argv[4]) : 64 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+    std::string rtigIO = findRTIG();
+
+    try {
+        SocketTCP control ;
+        connectToRTIG(control);
+        createFederation(control, FEDERATION_NAME, "testFederation.fed");
+
+        SyntheticRTIA sender ;
+        connectToRTIG(sender.link);
+        join(sender, FEDERATION_NAME, "sender");
+        NM_Publish_Interaction_Class publish ;
+        request(sender, publish, MESSAGE_CLASS, NetworkMessage::PUBLISH_INTERACTION_CLASS,
+                "Publication");
+
+        std::vector<SyntheticRTIA *> receivers ;
+        for (int i = 0 ; i < receiverCount ; ++i) {
+            receivers.push_back(new SyntheticRTIA());
+            connectToRTIG(receivers.back()->link);
+            join(*receivers.back(), FEDERATION_NAME, stringize() << "receiver-" << i);
+            NM_Subscribe_Interaction_Class subscribe ;
+            request(*receivers.back(), subscribe, MESSAGE_CLASS,
+                    NetworkMessage::SUBSCRIBE_INTERACTION_CLASS, "Subscription");
+        }
+
+        std::vector<struct pollfd> fds(receivers.size() + 1);
+        fds[0].fd = sender.link.returnSocket();
+        for (unsigned int i = 0 ; i < receivers.size(); ++i)
+            fds[i + 1].fd = receivers[i]->link.returnSocket();
+        for (unsigned int i = 0 ; i < fds.size(); ++i)
+            fds[i].events = POLLIN ;
+
+        NM_Send_Interaction interaction ;
+        interaction.setFederation(sender.federation);
+        interaction.setFederate(sender.federate);
+        interaction.setInteractionClass(MESSAGE_CLASS);
+        interaction.setRegion(0);
+        interaction.setParametersSize(1);
+        interaction.setParameters(PARAM1, 0);
+        interaction.setValuesSize(1);
+        interaction.setValues(std::vector<char>(size, 'x'), 0);
+
+        cout << "# receivers " << receiverCount << ", interactions of " << size
+             << " bytes, window " << window << endl ;
+        cout << "# interactions/s  deliveries/s  rtig writes/delivery" << endl ;
+
+        int inFlight = 0 ;
+        uint64_t sent = 0, delivered = 0 ;
+        long long writesBefore = writeCalls(rtigIO);
+        uint64_t start = clk->getCurrentTicksValue();
+        double elapsed = 0.0 ;
+        while (elapsed < seconds) {
+            while (inFlight < window) {
+                interaction.send(&sender.link, sendBuffer);
+                ++inFlight ;
+                ++sent ;
+            }
+            if (poll(&fds[0], fds.size(), 100) < 0) {
+                perror("poll");
+                return EXIT_FAILURE ;
+            }
+            for (unsigned int i = 0 ; i < fds.size(); ++i) {
+                if (!(fds[i].revents & POLLIN))
+                    continue ;
+                SocketTCP &link = i == 0 ? sender.link : receivers[i - 1]->link ;
+                NetworkMessage *msg = NM_Factory::receive(&link, receiveBuffer);
+                if (i == 0 && msg->getMessageType() == NetworkMessage::SEND_INTERACTION)
+                    --inFlight ;
+                else if (i > 0 && msg->getMessageType() == NetworkMessage::RECEIVE_INTERACTION)
+                    ++delivered ;
+                delete msg ;
+            }
+            elapsed = clk->getDeltaNanoSecond(start) * 1e-9 ;
+        }
+        long long writesAfter = writeCalls(rtigIO);
+
+        cout << static_cast<uint64_t>(sent / elapsed) << "  "
+             << static_cast<uint64_t>(delivered / elapsed) << "  " ;
+        if (writesBefore < 0 || writesAfter < 0 || delivered == 0)
+            cout << "n/a" << endl ;
+        else
+            cout << double(writesAfter - writesBefore) / delivered << endl ;
+
+        // The interactions still on their way are read by the resignations.
+        resign(sender);
+        closeConnection(sender.link);
+        for (unsigned int i = 0 ; i < receivers.size(); ++i) {
+            resign(*receivers[i]);
+            closeConnection(receivers[i]->link);
+            delete receivers[i] ;
+        }
+
+        destroyFederation(control, FEDERATION_NAME);
+        closeConnection(control);
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,126 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Federate cleanup benchmark.
+//
+// Builds, in process and without RTIG links, an object class with a few
+// attributes and registers the given number of instances: half of them
+// are owned by a "large" federate, the others are spread over the other
+// federates. The times taken by RootObject::getAllObjectInstancesFromFederate
+// for a small federate and by RootObject::killFederate for a small, then
+// for the large federate, i.e. the crash cleanup of the RTIG, are reported.
+//
+// Usage: CertiBenchKillFederate [max_objects [federates]]
+
+#include "config.h"
+#include "certi.hh"
+#include "RootObject.hh"
+#include "ObjectClass.hh"
+#include "ObjectClassSet.hh"
+#include "ObjectClassAttribute.hh"
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const ObjectClassHandle CLASS = 1 ;
+const int ATTRIBUTES = 8 ;
+
+/** Report the cleanup times in microseconds for one population. */
+void run(int objects, FederateHandle federates, libhla::clock::Clock &clk,
+         double &lookup, double &killSmall, double &killLarge)
+{
+    RootObject root(NULL);
+
+    ObjectClass *oc = new ObjectClass("Data", CLASS);
+    root.addObjectClass(oc, NULL);
+    std::vector<AttributeHandle> attributes ;
+    for (AttributeHandle a = 1 ; a <= ATTRIBUTES ; ++a) {
+        std::ostringstream name ;
+        name << "Attr" << a ;
+        oc->addAttribute(new ObjectClassAttribute(name.str(), a));
+        attributes.push_back(a);
+    }
+    for (FederateHandle federate = 1 ; federate <= federates ; ++federate) {
+        root.ObjectClasses->publish(federate, CLASS, attributes, true);
+        root.ObjectClasses->subscribe(federate, CLASS, attributes);
+    }
+
+    // Federate 1 is the large one, the others share the second half.
+    for (int i = 0 ; i < objects ; ++i) {
+        FederateHandle owner = i % 2 ? 1 : 2 + (i / 2) % (federates - 1);
+        std::ostringstream name ;
+        name << "Object" << i ;
+        root.registerObjectInstance(owner, CLASS, i + 1, name.str());
+    }
+
+    std::vector<ObjectHandle> handles ;
+    uint64_t start = clk.getCurrentTicksValue();
+    root.getAllObjectInstancesFromFederate(2, handles);
+    lookup = clk.getDeltaNanoSecond(start) * 1e-3 ;
+
+    start = clk.getCurrentTicksValue();
+    root.killFederate(2);
+    killSmall = clk.getDeltaNanoSecond(start) * 1e-3 ;
+
+    start = clk.getCurrentTicksValue();
+    root.killFederate(1);
+    killLarge = clk.getDeltaNanoSecond(start) * 1e-3 ;
+
+    for (FederateHandle federate = 3 ; federate <= federates ; ++federate)
+        root.killFederate(federate);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int maxObjects = argc > 1 ? atoi(argv[1]) : 100000 ;
+    int federates = argc > 2 ? atoi(argv[2]) : 16 ;
+    if (federates < 2)
+        federates = 2 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# objects  federates  lookup small (us)  kill small (us)  kill large (us)" << endl ;
+        for (int objects = 1000 ; objects <= maxObjects ; objects *= 10) {
+            double lookup, killSmall, killLarge ;
+            run(objects, federates, *clk, lookup, killSmall, killLarge);
+            cout << objects << "  " << federates << "  " << lookup << "  " << killSmall
+                 << "  " << killLarge << endl ;
+        }
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
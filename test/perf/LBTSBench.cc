@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// LBTS benchmark.
+//
+// Inserts the given number of regulators in an LBTS, then applies a stream
+// of clock updates to random regulators, with an anonymous update (NULL
+// PRIME algorithm) every 16 updates. After each update the LBTS is checked
+// against a linear scan of the clocks, which is also what the former
+// LBTS::compute did and is timed on its own as the reference.
+//
+// Usage: CertiBenchLBTS [max_regulators [updates]]
+
+#include "config.h"
+#include "certi.hh"
+#include "LBTS.hh"
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::endl ;
+
+namespace {
+
+const FederateHandle ME = 1 ;
+
+struct Update {
+    FederateHandle federate ;
+    double time ;
+};
+
+/** Updates of federates 1..regulators, 0 being an anonymous update. */
+void createUpdates(std::vector<Update> &updates, int regulators, int count)
+{
+    srand(1);
+    double now = 0.0 ;
+    for (int i = 0 ; i < count ; ++i) {
+        Update u ;
+        now += 1.0 / regulators ;
+        u.federate = (i % 16 == 15) ? 0 : rand() % regulators + 1 ;
+        u.time = now + rand() % 4 ;
+        updates.push_back(u);
+    }
+}
+
+/** The former LBTS::update and LBTS::compute. */
+double scanUpdate(std::map<FederateHandle, double> &clocks, const Update &u)
+{
+    for (std::map<FederateHandle, double>::iterator i = clocks.begin(); i != clocks.end(); ++i)
+        if ((u.federate == 0 || i->first == u.federate) && i->second <= u.time)
+            i->second = u.time ;
+
+    double lbts = -1.0 ;
+    for (std::map<FederateHandle, double>::iterator i = clocks.begin(); i != clocks.end(); ++i)
+        if (i->first != ME && (lbts < 0.0 || i->second < lbts))
+            lbts = i->second ;
+    return lbts ;
+}
+
+void run(int regulators, int count, libhla::clock::Clock &clk)
+{
+    std::vector<Update> updates ;
+    createUpdates(updates, regulators, count);
+
+    LBTS lbts ;
+    lbts.setFederate(ME);
+    std::map<FederateHandle, double> clocks ;
+    for (FederateHandle f = 1 ; f <= static_cast<FederateHandle>(regulators) ; ++f) {
+        lbts.insert(f, 0.0);
+        clocks[f] = 0.0 ;
+    }
+
+    std::vector<double> expected(count);
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < count ; ++i)
+        expected[i] = scanUpdate(clocks, updates[i]);
+    double scanNs = clk.getDeltaNanoSecond(start);
+
+    std::vector<double> values(count);
+    start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < count ; ++i) {
+        lbts.update(updates[i].federate, updates[i].time);
+        values[i] = lbts.getLBTSValue().getTime();
+    }
+    double lbtsNs = clk.getDeltaNanoSecond(start);
+
+    bool correct = true ;
+    for (int i = 0 ; i < count ; ++i)
+        correct = correct && values[i] == expected[i] ;
+
+    cout << regulators
+         << "  " << static_cast<uint64_t>(count / (scanNs * 1e-9))
+         << "  " << static_cast<uint64_t>(count / (lbtsNs * 1e-9))
+         << "  " << (correct ? "ok" : "BROKEN") << endl ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int maxRegulators = argc > 1 ? atoi(argv[1]) : 1024 ;
+    int count = argc > 2 ? atoi(argv[2]) : 200000 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    cout << "# regulators  scan updates/s  lbts updates/s  lbts" << endl ;
+    for (int regulators = 4 ; regulators <= maxRegulators ; regulators *= 4)
+        run(regulators, count, *clk);
+    return EXIT_SUCCESS ;
+}
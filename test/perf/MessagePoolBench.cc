@@ -0,0 +1,214 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+// ----------------------------------------------------------------------------
+
+// Message receive allocations benchmark.
+//
+// Receives the same message over and over, as the RTIG (update), the RTIA
+// (reflection from the RTIG) and the federate (reflect callback) do, the
+// network messages over a loopback TCP link and the federate one over a
+// socketpair. Each received message is either deleted, as before the
+// message pools, or released to MessagePool. The global operator new is
+// counted to report the allocations per received message, which should be
+// zero once the pools are warm.
+//
+// Usage: CertiBenchMessagePool [messages [attributes [value bytes]]]
+
+#include "config.h"
+#include "certi.hh"
+#include "SocketTCP.hh"
+#include "SocketUN.hh"
+#include "NM_Classes.hh"
+#include "M_Classes.hh"
+#include "MessagePool.hh"
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+uint64_t allocations = 0 ;
+
+} // anonymous namespace
+
+#if __cplusplus >= 201103L
+void *operator new(size_t size)
+#else
+void *operator new(size_t size) throw (std::bad_alloc)
+#endif
+{
+    ++allocations ;
+    void *block = malloc(size == 0 ? 1 : size);
+    if (block == NULL)
+        throw std::bad_alloc();
+    return block ;
+}
+
+void operator delete(void *block) throw ()
+{
+    free(block);
+}
+
+namespace {
+
+struct Result {
+    double rate ;
+    double allocations ;
+};
+
+/** Receive count copies of wire, sent on out, from the receive function. */
+template<typename Link, typename Receive> Result
+run(Link &out, Receive receive, const libhla::MessageBuffer &wire, int count,
+    bool pooled, libhla::clock::Clock &clk)
+{
+    unsigned char *bytes = static_cast<unsigned char *>(const_cast<libhla::MessageBuffer &>(wire)(0));
+    // Warm the pools up first.
+    for (int n = 0 ; n < count ; ++n) {
+        out.send(bytes, wire.size());
+        receive.done(receive.get(), pooled);
+    }
+
+    Result result ;
+    uint64_t before = allocations ;
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int n = 0 ; n < count ; ++n) {
+        out.send(bytes, wire.size());
+        receive.done(receive.get(), pooled);
+    }
+    result.rate = count / (clk.getDeltaNanoSecond(start) * 1e-9);
+    result.allocations = double(allocations - before) / count ;
+    return result ;
+}
+
+struct NetworkReceive {
+    Socket *link ;
+    libhla::MessageBuffer *buffer ;
+    NetworkMessage *get() { return NM_Factory::receive(link, *buffer); }
+    void done(NetworkMessage *msg, bool pooled) {
+        if (pooled)
+            MessagePool::release(msg);
+        else
+            delete msg ;
+    }
+};
+
+struct FederateReceive {
+    SocketUN *link ;
+    libhla::MessageBuffer *buffer ;
+    Message *get() { return M_Factory::receive(link, *buffer); }
+    void done(Message *msg, bool pooled) {
+        if (pooled)
+            MessagePool::release(msg);
+        else
+            delete msg ;
+    }
+};
+
+template<typename Link, typename Receive> void
+report(const char *name, Link &out, Receive receive, const libhla::MessageBuffer &wire,
+       int count, libhla::clock::Clock &clk)
+{
+    Result deleted = run(out, receive, wire, count, false, clk);
+    Result pooled = run(out, receive, wire, count, true, clk);
+    cout << name << "  " << wire.size()
+         << "  " << static_cast<uint64_t>(deleted.rate) << "  " << deleted.allocations
+         << "  " << static_cast<uint64_t>(pooled.rate) << "  " << pooled.allocations << endl ;
+}
+
+template<typename T> void
+fillValues(T &msg, uint32_t attributes, uint32_t size)
+{
+    msg.setObject(1);
+    msg.setAttributesSize(attributes);
+    msg.setValuesSize(attributes);
+    for (uint32_t i = 0 ; i < attributes ; ++i) {
+        msg.setAttributes(i + 1, i);
+        msg.setValues(AttributeValue_t(size, 'x'), i);
+    }
+    msg.setTag("bench");
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 100000 ;
+    uint32_t attributes = argc > 2 ? atoi(argv[2]) : 10 ;
+    uint32_t size = argc > 3 ? atoi(argv[3]) : 64 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        // Loopback TCP link, as between an RTIA and the RTIG.
+        SocketTCP listener, client, server ;
+        listener.createServer(0, htonl(INADDR_LOOPBACK));
+        struct sockaddr_in address ;
+        socklen_t length = sizeof(address);
+        getsockname(listener.returnSocket(), reinterpret_cast<struct sockaddr *>(&address), &length);
+        client.createConnection("localhost", ntohs(address.sin_port));
+        server.accept(&listener);
+
+        // Socketpair, as between a federate and its RTIA.
+        SocketUN federate(stIgnoreSignal), rtia(stIgnoreSignal);
+        rtia.setSocketFD(federate.socketpair());
+
+        cout << "# message  bytes  deleted msg/s  allocations/msg  pooled msg/s  allocations/msg" << endl ;
+
+        libhla::MessageBuffer receiveBuffer ;
+        NetworkReceive fromClient = { &server, &receiveBuffer };
+        NetworkReceive fromServer = { &client, &receiveBuffer };
+        FederateReceive fromRTIA = { &federate, &receiveBuffer };
+
+        NM_Update_Attribute_Values update ;
+        update.setFederation(1);
+        update.setFederate(1);
+        fillValues(update, attributes, size);
+        libhla::MessageBuffer updateWire ;
+        update.encode(updateWire);
+        report("NM_Update_Attribute_Values", client, fromClient, updateWire, count, *clk);
+
+        NM_Reflect_Attribute_Values reflect ;
+        reflect.setFederation(1);
+        reflect.setFederate(1);
+        fillValues(reflect, attributes, size);
+        libhla::MessageBuffer reflectWire ;
+        reflect.encode(reflectWire);
+        report("NM_Reflect_Attribute_Values", server, fromServer, reflectWire, count, *clk);
+
+        M_Reflect_Attribute_Values callback ;
+        fillValues(callback, attributes, size);
+        libhla::MessageBuffer callbackWire ;
+        callback.send(&rtia, callbackWire);
+        delete M_Factory::receive(&federate, receiveBuffer);
+        report("M_Reflect_Attribute_Values", rtia, fromRTIA, callbackWire, count, *clk);
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
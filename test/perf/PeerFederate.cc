@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+
+#include "PeerFederate.hh"
+
+#include <cstring>
+
+// ----------------------------------------------------------------------------
+void
+PeerAmbassador::discoverObjectInstance(RTI::ObjectHandle, RTI::ObjectClassHandle, const char *)
+    throw (RTI::CouldNotDiscover, RTI::ObjectClassNotKnown, RTI::FederateInternalError)
+{
+    discovered = true ;
+}
+
+// ----------------------------------------------------------------------------
+void
+PeerAmbassador::reflectAttributeValues(RTI::ObjectHandle object,
+                                       const RTI::AttributeHandleValuePairSet &ahvps,
+                                       const char *)
+    throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::FederateOwnsAttributes,
+           RTI::FederateInternalError)
+{
+    ++reflections ;
+    if (!discovered)
+        ++undiscovered ;
+    if (removed.find(object) != removed.end())
+        ++afterRemoval ;
+    for (RTI::ULong i = 0 ; i < ahvps.size(); ++i) {
+        if (ahvps.getHandle(i) != probe) {
+            ++bulk ;
+            continue ;
+        }
+        RTI::ULong length ;
+        char *value = ahvps.getValuePointer(i, length);
+        if (length == sizeof(int))
+            memcpy(&lastProbe, value, sizeof(int));
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+PeerAmbassador::removeObjectInstance(RTI::ObjectHandle object, const char *)
+    throw (RTI::ObjectNotKnown, RTI::FederateInternalError)
+{
+    ++removals ;
+    removed.insert(object);
+}
+
+// ----------------------------------------------------------------------------
+void
+join(PeerFederate &federate, const char *federation, const char *name, const char *fed,
+     RTI::RTIambassador::RTIALocation rtia)
+{
+    federate.rtiamb.reset(new RTI::RTIambassador(rtia));
+    try {
+        federate.rtiamb->createFederationExecution(federation, fed);
+    }
+    catch (RTI::FederationExecutionAlreadyExists &) {
+    }
+    federate.rtiamb->joinFederationExecution(name, federation, &federate.amb);
+}
+
+// ----------------------------------------------------------------------------
+void
+discover(PeerFederate &first, PeerFederate &second)
+{
+    while (!first.amb.discovered || !second.amb.discovered) {
+        first.rtiamb->tick(0.01, 0.1);
+        second.rtiamb->tick(0.01, 0.1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+probe(PeerFederate &federate, int sequence)
+{
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> ahvps(RTI::AttributeSetFactory::create(1));
+    ahvps->add(federate.amb.probe, reinterpret_cast<const char *>(&sequence), sizeof(sequence));
+    federate.rtiamb->updateAttributeValues(federate.object, *ahvps, "");
+}
+
+// ----------------------------------------------------------------------------
+bool
+await(PeerFederate &federate, int sequence, libhla::clock::Clock &clk, double timeout)
+{
+    uint64_t start = clk.getCurrentTicksValue();
+    while (federate.amb.lastProbe < sequence) {
+        if (timeout > 0.0 && clk.getDeltaNanoSecond(start) > timeout * 1e9)
+            return false ;
+        federate.rtiamb->tick(0.01, 0.1);
+    }
+    return true ;
+}
+
+// ----------------------------------------------------------------------------
+void
+resign(PeerFederate &first, PeerFederate &second, const char *federation)
+{
+    second.rtiamb->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    first.rtiamb->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    try {
+        first.rtiamb->destroyFederationExecution(federation);
+    }
+    catch (RTI::FederatesCurrentlyJoined &) {
+    }
+}
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+
+#ifndef CERTI_PEER_FEDERATE_HH
+#define CERTI_PEER_FEDERATE_HH
+
+#include "RTI.hh"
+#include "NullFederateAmbassador.hh"
+#include "Clock.hh"
+
+#include <memory>
+#include <set>
+
+/**
+ * Federate ambassador of the HLA 1.3 federates exchanging updates in the
+ * process of a benchmark. A reflection of the probe attribute carries the
+ * sequence number of the probe, the other attributes are counted as bulk.
+ * The reflections of an object already removed are counted apart.
+ */
+class PeerAmbassador : public NullFederateAmbassador
+{
+public:
+    PeerAmbassador()
+        : discovered(false), probe(0), lastProbe(0), reflections(0), bulk(0), undiscovered(0),
+          removals(0), afterRemoval(0) {}
+
+    void discoverObjectInstance(RTI::ObjectHandle, RTI::ObjectClassHandle, const char *)
+        throw (RTI::CouldNotDiscover, RTI::ObjectClassNotKnown, RTI::FederateInternalError);
+
+    void reflectAttributeValues(RTI::ObjectHandle, const RTI::AttributeHandleValuePairSet &ahvps,
+                                const char *)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::FederateOwnsAttributes,
+               RTI::FederateInternalError);
+
+    void removeObjectInstance(RTI::ObjectHandle object, const char *)
+        throw (RTI::ObjectNotKnown, RTI::FederateInternalError);
+
+    bool discovered ;
+    RTI::AttributeHandle probe ;
+    int lastProbe ;             ///< sequence number of the last probe reflected
+    int reflections ;
+    int bulk ;
+    int undiscovered ;          ///< reflections before the discovery
+    int removals ;
+    int afterRemoval ;          ///< reflections of removed objects
+    std::set<RTI::ObjectHandle> removed ;
+};
+
+/** A federate of the process, with the object it updates. */
+struct PeerFederate
+{
+    PeerAmbassador amb ;
+    std::auto_ptr<RTI::RTIambassador> rtiamb ;
+    RTI::ObjectHandle object ;
+};
+
+/** Create the federation execution if needed, and join it. */
+void join(PeerFederate &federate, const char *federation, const char *name, const char *fed,
+          RTI::RTIambassador::RTIALocation rtia = RTI::RTIambassador::RTIA_FROM_ENVIRONMENT);
+/** Tick both federates until each one has discovered an object. */
+void discover(PeerFederate &first, PeerFederate &second);
+/** Update the probe attribute with a sequence number. */
+void probe(PeerFederate &federate, int sequence);
+/** Tick until the given probe is reflected, false after timeout seconds
+ *  unless it is 0. */
+bool await(PeerFederate &federate, int sequence, libhla::clock::Clock &clk, double timeout = 0.0);
+/** Resign both federates and destroy the federation execution. */
+void resign(PeerFederate &first, PeerFederate &second, const char *federation);
+
+#endif // CERTI_PEER_FEDERATE_HH
@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// In-process RTIA benchmark.
+//
+// Two HLA 1.3 federates run in this process, each publishing and
+// subscribing the attributes of one object. The ping federate updates its
+// object, the pong federate answers its reflection with an update of its
+// own, and the mean round trip of this exchange is reported. Then the ping
+// federate sends a burst of updates which the pong federate drains with
+// tick(), giving the reflection rate. This is done first with forked RTIA
+// processes and then with RTIAs running on threads of the federate
+// (RTIambassador::RTIA_THREAD), whose link carries the messages without
+// serializing them.
+//
+// Usage: CertiBenchRTIAThread [round_trips [count [FED file]]]
+//   A rtig must be running (CERTI_HOST / CERTI_TCP_PORT) and the FED file
+//   (default testFederation.fed) must be found through CERTI_FOM_PATH.
+
+#include "PeerFederate.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchRTIAThread" ;
+
+void update(PeerFederate &federate, const RTI::AttributeHandleValuePairSet &ahvps)
+{
+    federate.rtiamb->updateAttributeValues(federate.object, ahvps, "");
+}
+
+/** Tick until the federate got the given number of reflections. */
+void awaitReflections(PeerFederate &federate, int reflections)
+{
+    while (federate.amb.reflections < reflections)
+        federate.rtiamb->tick(0.1, 1.0);
+}
+
+/** Measure the mean round trip in microseconds and the reflection rate. */
+void run(bool thread, int roundTrips, int count, const char *fed,
+         libhla::clock::Clock &clk, double &roundTrip, double &rate)
+{
+    RTI::RTIambassador::RTIALocation rtia = thread ? RTI::RTIambassador::RTIA_THREAD
+                                                   : RTI::RTIambassador::RTIA_PROCESS ;
+    PeerFederate ping, pong ;
+    join(ping, FEDERATION_NAME, "ping", fed, rtia);
+    join(pong, FEDERATION_NAME, "pong", fed, rtia);
+
+    RTI::ObjectClassHandle dataClass = ping.rtiamb->getObjectClassHandle("Data");
+    RTI::AttributeHandle attr1 = ping.rtiamb->getAttributeHandle("Attr1", dataClass);
+    std::auto_ptr<RTI::AttributeHandleSet> attributes(RTI::AttributeHandleSetFactory::create(1));
+    attributes->add(attr1);
+    PeerFederate *federates[] = { &ping, &pong };
+    for (int i = 0 ; i < 2 ; ++i) {
+        federates[i]->rtiamb->publishObjectClass(dataClass, *attributes);
+        federates[i]->rtiamb->subscribeObjectClassAttributes(dataClass, *attributes);
+        federates[i]->object = federates[i]->rtiamb->registerObjectInstance(dataClass);
+    }
+    discover(ping, pong);
+
+    std::string value(8, 'x');
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> ahvps(RTI::AttributeSetFactory::create(1));
+    ahvps->add(attr1, value.data(), value.size());
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 1 ; i <= roundTrips ; ++i) {
+        update(ping, *ahvps);
+        awaitReflections(pong, i);
+        update(pong, *ahvps);
+        awaitReflections(ping, i);
+    }
+    roundTrip = clk.getDeltaNanoSecond(start) * 1e-3 / roundTrips ;
+
+    start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < count ; ++i)
+        update(ping, *ahvps);
+    awaitReflections(pong, roundTrips + count);
+    rate = count / (clk.getDeltaNanoSecond(start) * 1e-9);
+
+    resign(ping, pong, FEDERATION_NAME);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int roundTrips = argc > 1 ? atoi(argv[1]) : 2000 ;
+    int count = argc > 2 ? atoi(argv[2]) : 10000 ;
+    const char *fed = argc > 3 ? argv[3] : "testFederation.fed" ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# RTIA  round trip (us)  reflections/s" << endl ;
+        static const char *modes[] = { "process", "thread" };
+        for (int thread = 0 ; thread < 2 ; ++thread) {
+            double roundTrip, rate ;
+            run(thread != 0, roundTrips, count, fed, *clk, roundTrip, rate);
+            cout << modes[thread] << "  " << roundTrip
+                 << "  " << static_cast<uint64_t>(rate) << endl ;
+        }
+    }
+    catch (RTI::Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << (e._reason ? e._reason : "") << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,130 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// RTIG event loop benchmark.
+//
+// Connects a growing number of synthetic RTIAs to a running rtig, joins
+// them to a federation and makes each of them keep a window of
+// request/answer exchanges in flight (class relevance advisory switch
+// on/off, which the RTIG answers one by one). The aggregated number of
+// answers per second is reported for each federation size.
+//
+// Usage: CertiBenchRTIG [max_federates [seconds [window [FED file]]]]
+//   The RTIG is found with CERTI_HOST / CERTI_TCP_PORT as for any RTIA,
+//   the FED file (default testFederation.fed) with CERTI_FOM_PATH.
+//   Beyond ~1000 federates raise the descriptor limit (ulimit -n) of both
+//   processes; the select based RTIG poller cannot go past FD_SETSIZE.
+
+#include "config.h"
+#include "SyntheticRTIA.hh"
+#include "Clock.hh"
+
+#include <poll.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchRTIG" ;
+
+/** Keep every federate window full during the given time, return answers/s. */
+double run(std::vector<SyntheticRTIA *> &rtias, int window, double seconds,
+           libhla::clock::Clock &clk)
+{
+    std::vector<struct pollfd> fds(rtias.size());
+    for (unsigned int i = 0 ; i < rtias.size(); ++i) {
+        fds[i].fd = rtias[i]->link.returnSocket();
+        fds[i].events = POLLIN ;
+        while (rtias[i]->inFlight < window)
+            switchAdvisory(*rtias[i]);
+    }
+
+    uint64_t answers = 0 ;
+    uint64_t start = clk.getCurrentTicksValue();
+    double elapsed = 0.0 ;
+    while (elapsed < seconds * 1e9) {
+        if (poll(&fds[0], fds.size(), 1000) < 0) {
+            perror("poll");
+            exit(EXIT_FAILURE);
+        }
+        for (unsigned int i = 0 ; i < fds.size(); ++i) {
+            if (!(fds[i].revents & POLLIN))
+                continue ;
+            delete NM_Factory::receive(&rtias[i]->link);
+            --rtias[i]->inFlight ;
+            ++answers ;
+            switchAdvisory(*rtias[i]);
+        }
+        elapsed = clk.getDeltaNanoSecond(start);
+    }
+    return answers / (elapsed * 1e-9);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int maxFederates = argc > 1 ? atoi(argv[1]) : 256 ;
+    double seconds = argc > 2 ? atof(argv[2]) : 2.0 ;
+    int window = argc > 3 ? atoi(argv[3]) : 4 ;
+    const char *fed = argc > 4 ? argv[4] : "testFederation.fed" ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        SocketTCP control ;
+        connectToRTIG(control);
+        createFederation(control, FEDERATION_NAME, fed);
+
+        cout << "# federates  window  answers/s  answers/s/federate" << endl ;
+        std::vector<SyntheticRTIA *> rtias ;
+        for (int n = 1 ; n <= maxFederates ; n *= 2) {
+            while (static_cast<int>(rtias.size()) < n) {
+                rtias.push_back(new SyntheticRTIA());
+                connectToRTIG(rtias.back()->link);
+                join(*rtias.back(), FEDERATION_NAME, stringize() << "synthetic-" << rtias.size());
+            }
+            double rate = run(rtias, window, seconds, *clk);
+            cout << n << "  " << window << "  " << static_cast<uint64_t>(rate)
+                 << "  " << static_cast<uint64_t>(rate / n) << endl ;
+        }
+
+        for (unsigned int i = 0 ; i < rtias.size(); ++i) {
+            resign(*rtias[i]);
+            closeConnection(rtias[i]->link);
+            delete rtias[i] ;
+        }
+
+        destroyFederation(control, FEDERATION_NAME);
+        closeConnection(control);
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
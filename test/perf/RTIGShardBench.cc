@@ -0,0 +1,162 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// RTIG independent federations benchmark.
+//
+// Runs a growing number K of independent federations on a running rtig, with
+// the same number of synthetic RTIAs joined to each of them. Every RTIA keeps
+// a window of request/answer exchanges in flight (class relevance advisory
+// switch on/off, which the RTIG answers one by one). The aggregated number of
+// answers per second is reported for each K: it stays flat with a single
+// event loop and grows with the cores when the rtig runs with
+// CERTI_RTIG_SHARDS set. One more RTIA then joins every federation in turn,
+// resigning in between, its link moving from shard to shard.
+//
+// Usage: CertiBenchFederations [max_federations [federates [seconds [window [FED file]]]]]
+//   The RTIG is found with CERTI_HOST / CERTI_TCP_PORT as for any RTIA,
+//   the FED file (default testFederation.fed) with CERTI_FOM_PATH.
+
+#include "config.h"
+#include "SyntheticRTIA.hh"
+#include "Clock.hh"
+
+#include <poll.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+std::string federationName(int rank)
+{
+    return stringize() << "CertiBenchFederations-" << rank ;
+}
+
+/** Keep every federate window full during the given time, return answers/s. */
+double run(std::vector<SyntheticRTIA *> &rtias, int window, double seconds,
+           libhla::clock::Clock &clk)
+{
+    std::vector<struct pollfd> fds(rtias.size());
+    for (unsigned int i = 0 ; i < rtias.size(); ++i) {
+        fds[i].fd = rtias[i]->link.returnSocket();
+        fds[i].events = POLLIN ;
+        while (rtias[i]->inFlight < window)
+            switchAdvisory(*rtias[i]);
+    }
+
+    uint64_t answers = 0 ;
+    uint64_t start = clk.getCurrentTicksValue();
+    double elapsed = 0.0 ;
+    while (elapsed < seconds * 1e9) {
+        if (poll(&fds[0], fds.size(), 1000) < 0) {
+            perror("poll");
+            exit(EXIT_FAILURE);
+        }
+        for (unsigned int i = 0 ; i < fds.size(); ++i) {
+            if (!(fds[i].revents & POLLIN))
+                continue ;
+            delete NM_Factory::receive(&rtias[i]->link);
+            --rtias[i]->inFlight ;
+            ++answers ;
+            switchAdvisory(*rtias[i]);
+        }
+        elapsed = clk.getDeltaNanoSecond(start);
+    }
+    return answers / (elapsed * 1e-9);
+}
+
+/**
+ * One more RTIA joins each federation in turn, resigning in between, so
+ * that its link goes from shard to shard. Return false if a join fails.
+ */
+bool rejoin(int federations)
+{
+    SyntheticRTIA rtia ;
+    connectToRTIG(rtia.link);
+    for (int i = 0 ; i < federations ; ++i) {
+        if (!tryJoin(rtia, federationName(i), "synthetic-rejoin"))
+            return false ;
+        resign(rtia);
+    }
+    closeConnection(rtia.link);
+    return true ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int maxFederations = argc > 1 ? atoi(argv[1]) : 8 ;
+    int federates = argc > 2 ? atoi(argv[2]) : 4 ;
+    double seconds = argc > 3 ? atof(argv[3]) : 2.0 ;
+    int window = argc > 4 ? atoi(argv[4]) : 4 ;
+    const char *fed = argc > 5 ? argv[5] : "testFederation.fed" ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# federations  federates  window  answers/s  answers/s/federation" << endl ;
+        std::vector<SyntheticRTIA *> rtias ;
+        int federations = 0 ;
+        for (int k = 1 ; k <= maxFederations ; k *= 2) {
+            for ( ; federations < k ; ++federations) {
+                std::string name = federationName(federations);
+                for (int f = 0 ; f < federates ; ++f) {
+                    rtias.push_back(new SyntheticRTIA());
+                    connectToRTIG(rtias.back()->link);
+                    if (f == 0)
+                        createFederation(rtias.back()->link, name, fed);
+                    join(*rtias.back(), name, stringize() << "synthetic-" << f);
+                }
+            }
+            double rate = run(rtias, window, seconds, *clk);
+            cout << k << "  " << federates << "  " << window
+                 << "  " << static_cast<uint64_t>(rate)
+                 << "  " << static_cast<uint64_t>(rate / k) << endl ;
+        }
+
+        bool moved = rejoin(federations);
+        cout << "# one link joining the " << federations << " federations in turn: "
+             << (moved ? "ok" : "BROKEN") << endl ;
+
+        for (unsigned int i = 0 ; i < rtias.size(); ++i) {
+            resign(*rtias[i]);
+            // The last federate of a federation destroys it.
+            if ((i + 1) % federates == 0)
+                destroyFederation(rtias[i]->link, federationName(i / federates));
+            closeConnection(rtias[i]->link);
+            delete rtias[i] ;
+        }
+        if (!moved)
+            return EXIT_FAILURE ;
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// IEEE 1516-2010 callback delivery benchmark.
+//
+// Two federates run in this process. The sender sends a burst of updates of
+// the Attr1 attribute of its Data object, then a burst of Message
+// interactions, while the receiver does not evoke any callback. Once the
+// bursts are queued by the receiver RTIA, the rate at which the receiver
+// gets them through evokeMultipleCallbacks is reported: this is the cost of
+// the federate/RTIA link and of the conversion of the messages into the
+// callback arguments by libRTI, the RTIG being out of the measure.
+//
+// Usage: CertiBenchReflect1516e [burst [size [FOM file]]]
+//   A rtig must be running (CERTI_HOST / CERTI_TCP_PORT) and the FOM file
+//   (default testFederation.xml) must be found through CERTI_FOM_PATH.
+
+#include <RTI/RTIambassadorFactory.h>
+#include <RTI/RTIambassador.h>
+#include <RTI/NullFederateAmbassador.h>
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using std::cout ;
+using std::endl ;
+using namespace rti1516e ;
+
+namespace {
+
+const wchar_t *FEDERATION_NAME = L"CertiBenchReflect1516e" ;
+
+class Receiver : public NullFederateAmbassador
+{
+public:
+    Receiver() : discovered(false), reflections(0), interactions(0), bytes(0) {}
+
+    void discoverObjectInstance(ObjectInstanceHandle, ObjectClassHandle, std::wstring const &)
+        throw (FederateInternalError) {
+        discovered = true ;
+    }
+
+    void reflectAttributeValues(ObjectInstanceHandle, AttributeHandleValueMap const &values,
+                                VariableLengthData const &, OrderType, TransportationType,
+                                SupplementalReflectInfo)
+        throw (FederateInternalError) {
+        ++reflections ;
+        for (AttributeHandleValueMap::const_iterator i = values.begin(); i != values.end(); ++i)
+            bytes += i->second.size();
+    }
+
+    void receiveInteraction(InteractionClassHandle, ParameterHandleValueMap const &values,
+                            VariableLengthData const &, OrderType, TransportationType,
+                            SupplementalReceiveInfo)
+        throw (FederateInternalError) {
+        ++interactions ;
+        for (ParameterHandleValueMap::const_iterator i = values.begin(); i != values.end(); ++i)
+            bytes += i->second.size();
+    }
+
+    bool discovered ;
+    int reflections ;
+    int interactions ;
+    size_t bytes ;
+};
+
+struct Federate {
+    Receiver amb ;
+    std::auto_ptr<RTIambassador> rtiamb ;
+};
+
+void join(Federate &federate, const wchar_t *name, const std::wstring &fom)
+{
+    RTIambassadorFactory factory ;
+    federate.rtiamb = factory.createRTIambassador();
+    federate.rtiamb->connect(federate.amb, HLA_EVOKED);
+    try {
+        federate.rtiamb->createFederationExecution(FEDERATION_NAME, fom);
+    }
+    catch (FederationExecutionAlreadyExists &) {
+    }
+    federate.rtiamb->joinFederationExecution(name, FEDERATION_NAME);
+}
+
+/** Callbacks per second while the receiver drains the count given. */
+double drain(Federate &receiver, const int &received, int count, libhla::clock::Clock &clk)
+{
+    uint64_t start = clk.getCurrentTicksValue();
+    while (received < count)
+        receiver.rtiamb->evokeMultipleCallbacks(0.0, 0.1);
+    return count * 1e9 / clk.getDeltaNanoSecond(start);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int burst = argc > 1 ? atoi(argv[1]) : 20000 ;
+    int size = argc > 2 ? atoi(argv[2]) : 100 ;
+    std::string fomName = argc > 3 ? argv[3] : "testFederation.xml" ;
+    std::wstring fom(fomName.begin(), fomName.end());
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        Federate sender, receiver ;
+        join(sender, L"sender", fom);
+        join(receiver, L"receiver", fom);
+
+        ObjectClassHandle dataClass = sender.rtiamb->getObjectClassHandle(L"Data");
+        AttributeHandle attr1 = sender.rtiamb->getAttributeHandle(dataClass, L"Attr1");
+        InteractionClassHandle messageClass = sender.rtiamb->getInteractionClassHandle(L"Message");
+        ParameterHandle param1 = sender.rtiamb->getParameterHandle(messageClass, L"Param1");
+        ParameterHandle param2 = sender.rtiamb->getParameterHandle(messageClass, L"Param2");
+        AttributeHandleSet attributes ;
+        attributes.insert(attr1);
+
+        sender.rtiamb->publishObjectClassAttributes(dataClass, attributes);
+        sender.rtiamb->publishInteractionClass(messageClass);
+        receiver.rtiamb->subscribeObjectClassAttributes(dataClass, attributes);
+        receiver.rtiamb->subscribeInteractionClass(messageClass);
+        ObjectInstanceHandle object = sender.rtiamb->registerObjectInstance(dataClass);
+        while (!receiver.amb.discovered)
+            receiver.rtiamb->evokeMultipleCallbacks(0.01, 0.1);
+
+        std::string value(size, 'x');
+        VariableLengthData data(value.data(), value.size());
+        VariableLengthData tag("bench", 5);
+        AttributeHandleValueMap update ;
+        update[attr1] = data ;
+        ParameterHandleValueMap parameters ;
+        parameters[param1] = data ;
+        parameters[param2] = data ;
+
+        cout << "# callback  burst  size  callbacks/s" << endl ;
+
+        for (int i = 0 ; i < burst ; ++i)
+            sender.rtiamb->updateAttributeValues(object, update, tag);
+        // Let the receiver RTIA queue the whole burst.
+        sleep(1);
+        double rate = drain(receiver, receiver.amb.reflections, burst, *clk);
+        cout << "reflectAttributeValues  " << burst << "  " << size << "  " << rate << endl ;
+
+        for (int i = 0 ; i < burst ; ++i)
+            sender.rtiamb->sendInteraction(messageClass, parameters, tag);
+        sleep(1);
+        rate = drain(receiver, receiver.amb.interactions, burst, *clk);
+        cout << "receiveInteraction  " << burst << "  " << size << "  " << rate << endl ;
+
+        receiver.rtiamb->resignFederationExecution(NO_ACTION);
+        sender.rtiamb->resignFederationExecution(DELETE_OBJECTS_THEN_DIVEST);
+        try {
+            sender.rtiamb->destroyFederationExecution(FEDERATION_NAME);
+        }
+        catch (FederatesCurrentlyJoined &) {
+        }
+    }
+    catch (Exception &e) {
+        std::wcerr << L"Benchmark aborted: " << e.what() << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,189 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// RTIG reflection routing benchmark.
+//
+// Builds, in process, a chain of object classes of the given depth whose
+// subscribers are spread over every level, registers an instance of the
+// deepest class and measures the rate of ObjectClassSet::updateAttributeValues,
+// i.e. the routing and broadcast list work done by the RTIG for each update.
+// The federate links are closed once their references are set, so that
+// nothing is actually written. Two rates are reported:
+//   steady: the subscriptions do not change between updates,
+//   churn:  a federate subscribes again before each update, so the routes
+//           are rebuilt every time.
+//
+// Usage: CertiBenchRouting [max_depth [max_subscribers [updates]]]
+
+#include "config.h"
+#include "certi.hh"
+#include "RootObject.hh"
+#include "ObjectClass.hh"
+#include "ObjectClassSet.hh"
+#include "ObjectClassAttribute.hh"
+#include "SecurityServer.hh"
+#include "SocketServer.hh"
+#include "SocketTCP.hh"
+#include "SocketUDP.hh"
+#include "AuditFile.hh"
+#include "Clock.hh"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const Handle FEDERATION = 1 ;
+const int ATTRIBUTES_PER_CLASS = 4 ;
+const ObjectHandle OBJECT = 1 ;
+
+/** Give the server links of federates 1..count references, then close them. */
+void createFederates(SocketServer &sockets, SocketTCP &listener, int count)
+{
+    struct sockaddr_in address ;
+    socklen_t length = sizeof(address);
+    getsockname(listener.returnSocket(), reinterpret_cast<struct sockaddr *>(&address), &length);
+
+    for (int federate = 1 ; federate <= count ; ++federate) {
+        SocketTCP client ;
+        client.createConnection("localhost", ntohs(address.sin_port));
+        sockets.open();
+
+        // Make the accepted link the only one the poller reports.
+        const unsigned char byte = 0 ;
+        client.send(&byte, 1);
+        std::vector<SOCKET> ready ;
+        sockets.getPoller().wait(ready, -1);
+        sockets.setReferences(ready.front(), FEDERATION, federate, 0, 0);
+
+        Handle federation ;
+        FederateHandle handle ;
+        sockets.close(ready.front(), federation, handle);
+        client.close();
+    }
+}
+
+/** Return the update rate of one configuration. */
+double run(SecurityServer &server, int depth, int subscribers, int updates,
+           bool churn, libhla::clock::Clock &clk)
+{
+    RootObject root(&server);
+
+    // Class chain, each level adding its own attributes to the inherited ones.
+    std::vector<std::vector<AttributeHandle> > levels(depth);
+    ObjectClass *parent = NULL ;
+    AttributeHandle next = 1 ;
+    for (int d = 0 ; d < depth ; ++d) {
+        std::ostringstream name ;
+        name << "Level" << d ;
+        ObjectClass *oc = new ObjectClass(name.str(), d + 1);
+        root.addObjectClass(oc, parent);
+        for (int a = 0 ; a < ATTRIBUTES_PER_CLASS ; ++a, ++next) {
+            std::ostringstream attribute ;
+            attribute << "Attr" << next ;
+            oc->addAttribute(new ObjectClassAttribute(attribute.str(), next));
+            levels[d].push_back(next);
+        }
+        parent = oc ;
+    }
+    ObjectClassHandle deepest = depth ;
+
+    for (int federate = 1 ; federate <= subscribers ; ++federate) {
+        int level = federate % depth ;
+        root.ObjectClasses->subscribe(federate, level + 1, levels[level]);
+    }
+
+    FederateHandle publisher = subscribers + 1 ;
+    std::vector<AttributeHandle> attributes ;
+    for (int d = 0 ; d < depth ; ++d)
+        attributes.insert(attributes.end(), levels[d].begin(), levels[d].end());
+    root.ObjectClasses->publish(publisher, deepest, attributes, true);
+    root.registerObjectInstance(publisher, deepest, OBJECT, "bench");
+    Object *object = root.getObject(OBJECT);
+
+    ValueArena values ;
+    values.resize(attributes.size());
+    for (uint32_t i = 0 ; i < values.size() ; ++i)
+        values.set(i, AttributeValue_t(8, 'x'));
+    ObjectClass *resubscribed = root.getObjectClass(1 % depth + 1);
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < updates ; ++i) {
+        if (churn)
+            resubscribed->subscribe(1, levels[1 % depth], NULL);
+        root.ObjectClasses->updateAttributeValues(publisher, object, attributes, values, "");
+    }
+    double rate = updates / (clk.getDeltaNanoSecond(start) * 1e-9);
+
+    root.deleteObjectInstance(publisher, OBJECT, "");
+    for (FederateHandle federate = 1 ; federate <= publisher ; ++federate)
+        root.killFederate(federate);
+    return rate ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int maxDepth = argc > 1 ? atoi(argv[1]) : 16 ;
+    int maxSubscribers = argc > 2 ? atoi(argv[2]) : 256 ;
+    int updates = argc > 3 ? atoi(argv[3]) : 2000 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        SocketTCP listener ;
+        SocketUDP datagrams ;
+        listener.createServer(0, htonl(INADDR_LOOPBACK));
+        datagrams.createServer(0, htonl(INADDR_LOOPBACK));
+        SocketServer sockets(&listener, &datagrams);
+        AuditFile audit("/dev/null");
+        SecurityServer server(sockets, audit, FEDERATION);
+
+        // Subscribers plus the publisher.
+        createFederates(sockets, listener, maxSubscribers + 1);
+
+        cout << "# depth  subscribers  attributes  steady updates/s  churn updates/s" << endl ;
+        for (int depth = 1 ; depth <= maxDepth ; depth *= 4) {
+            for (int subscribers = 16 ; subscribers <= maxSubscribers ; subscribers *= 4) {
+                double steady = run(server, depth, subscribers, updates, false, *clk);
+                double churn = run(server, depth, subscribers, updates, true, *clk);
+                cout << depth << "  " << subscribers << "  " << depth * ATTRIBUTES_PER_CLASS
+                     << "  " << static_cast<uint64_t>(steady)
+                     << "  " << static_cast<uint64_t>(churn) << endl ;
+            }
+        }
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Federate/RTIA link benchmark.
+//
+// Forks a peer process connected the way a federate and its RTIA are, through
+// a socketpair alone or through a shared memory link (CERTI_SHM_LINK), and
+// measures for several message sizes:
+//   latency:    round trip of one message echoed by the peer,
+//   throughput: burst of messages read by the peer, which then acknowledges.
+//
+// Usage: CertiBenchSHMLink [count [ring_kbytes]]
+
+#include "config.h"
+#include "certi.hh"
+#include "SocketUN.hh"
+#include "Clock.hh"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const uint32_t LATENCY = 1 ;
+const uint32_t THROUGHPUT = 2 ;
+const uint32_t STOP = 3 ;
+
+struct Command {
+    uint32_t test ;
+    uint32_t size ;
+    uint32_t count ;
+};
+
+/** Peer side: run the commands of the parent until STOP. */
+void serve(SocketUN &link)
+{
+    std::vector<unsigned char> buffer ;
+    Command command ;
+    for (;;) {
+        link.receive(reinterpret_cast<unsigned char *>(&command), sizeof(command));
+        if (command.test == STOP)
+            return ;
+        buffer.resize(command.size);
+        for (uint32_t i = 0 ; i < command.count ; ++i) {
+            link.receive(&buffer[0], command.size);
+            if (command.test == LATENCY)
+                link.send(&buffer[0], command.size);
+        }
+        if (command.test == THROUGHPUT)
+            link.send(&buffer[0], 1);
+    }
+}
+
+/** Average round trip in microseconds. */
+double latency(SocketUN &link, uint32_t size, uint32_t count, libhla::clock::Clock &clk)
+{
+    std::vector<unsigned char> buffer(size, 'x');
+    Command command = { LATENCY, size, count };
+    link.send(reinterpret_cast<unsigned char *>(&command), sizeof(command));
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (uint32_t i = 0 ; i < count ; ++i) {
+        link.send(&buffer[0], size);
+        link.receive(&buffer[0], size);
+    }
+    return clk.getDeltaNanoSecond(start) * 1e-3 / count ;
+}
+
+/** Messages per second. */
+double throughput(SocketUN &link, uint32_t size, uint32_t count, libhla::clock::Clock &clk)
+{
+    std::vector<unsigned char> buffer(size, 'x');
+    Command command = { THROUGHPUT, size, count };
+    link.send(reinterpret_cast<unsigned char *>(&command), sizeof(command));
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (uint32_t i = 0 ; i < count ; ++i)
+        link.send(&buffer[0], size);
+    link.receive(&buffer[0], 1);
+    return count / (clk.getDeltaNanoSecond(start) * 1e-9);
+}
+
+/** Run every size on a link, with a shared memory ring of ringSize bytes if not 0. */
+int run(const char *name, uint32_t count, size_t ringSize, libhla::clock::Clock &clk)
+{
+    SocketUN link(stIgnoreSignal);
+    int peerFd = link.socketpair();
+    int shmFd = ringSize > 0 ? link.createSHMLink(ringSize) : -1 ;
+    if (peerFd == -1 || (ringSize > 0 && shmFd == -1)) {
+        cerr << "Cannot create the " << name << " link." << endl ;
+        return EXIT_FAILURE ;
+    }
+
+    pid_t peer = fork();
+    if (peer == 0) {
+        close(link.returnSocket());
+        SocketUN peerLink(stIgnoreSignal);
+        peerLink.setSocketFD(peerFd);
+        if (shmFd != -1 && !peerLink.setSHMLinkFD(shmFd))
+            _exit(EXIT_FAILURE);
+        serve(peerLink);
+        _exit(EXIT_SUCCESS);
+    }
+    close(peerFd);
+    if (shmFd != -1)
+        close(shmFd);
+
+    static const uint32_t sizes[] = { 64, 1024, 16384, 262144, 1048576 };
+    for (unsigned int i = 0 ; i < sizeof(sizes) / sizeof(sizes[0]) ; ++i) {
+        // Keep roughly the same amount of data for every size.
+        uint32_t n = std::max<uint32_t>(count / (1 + sizes[i] / 1024), 50);
+        double us = latency(link, sizes[i], n, clk);
+        double rate = throughput(link, sizes[i], n, clk);
+        cout << name << "  " << sizes[i] << "  " << us
+             << "  " << static_cast<uint64_t>(rate)
+             << "  " << static_cast<uint64_t>(rate * sizes[i] / (1024 * 1024)) << endl ;
+    }
+
+    Command stop = { STOP, 0, 0 };
+    link.send(reinterpret_cast<unsigned char *>(&stop), sizeof(stop));
+    int status ;
+    waitpid(peer, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    uint32_t count = argc > 1 ? atoi(argv[1]) : 20000 ;
+    size_t ringSize = (argc > 2 ? atoi(argv[2]) : 1024) * 1024 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# link  bytes  round trip us  messages/s  MiB/s" << endl ;
+        if (run("socket", count, 0, *clk) != EXIT_SUCCESS
+            || run("shm", count, ringSize, *clk) != EXIT_SUCCESS)
+            return EXIT_FAILURE ;
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,220 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// RTIG slow consumer benchmark.
+//
+// Synthetic RTIAs join a federation on a running rtig: a sender, healthy
+// receivers and one stalled receiver, all of them subscribed to the Message
+// interaction. The sender sends Message interactions at a steady rate, with
+// at most a window of them waiting for the RTIG answer, each one carrying
+// its send time. After one second the stalled receiver stops reading its
+// link. Every half second the number of interactions sent and received by
+// the healthy receivers, and their latency percentiles, are reported: with
+// the block policy the whole federation freezes once the output queue of the
+// stalled receiver is full, with the drop (best effort interactions) and
+// disconnect policies the healthy receivers should not notice.
+//
+// Usage: CertiBenchSlowConsumer [healthy [seconds [rate [size [transport]]]]]
+//   transport is "reliable" (default) or "best_effort". The rtig is found
+//   with CERTI_HOST / CERTI_TCP_PORT, testFederation.fed with CERTI_FOM_PATH.
+//   Run it against a rtig started with CERTI_SLOW_CONSUMER set to each
+//   policy, and a small CERTI_RTIG_OUTPUT_QUEUE to see the effect sooner.
+
+#include "config.h"
+#include "SyntheticRTIA.hh"
+#include "Clock.hh"
+
+#include <poll.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchSlowConsumer" ;
+// Message interaction class and its Param1 parameter in testFederation.fed
+const InteractionClassHandle MESSAGE_CLASS = 3 ;
+const ParameterHandle PARAM1 = 1 ;
+const int WINDOW = 16 ;
+// Stalled receiver socket buffer once stalled, so that the RTIG output queue
+// fills soon.
+const int STALLED_BUFFER = 4096 ;
+
+double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0 ;
+    return sorted[static_cast<size_t>(p * (sorted.size() - 1))] ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int healthy = argc > 1 ? atoi(argv[1]) : 4 ;
+    double seconds = argc > 2 ? atof(argv[2]) : 6.0 ;
+    double rate = argc > 3 ? atof(argv[3]) : 2000.0 ;
+    uint32_t size = argc > 4 ? atoi(argv[4]) : 1000 ;
+    bool bestEffort = argc > 5 && strcmp(argv[5], "best_effort") == 0 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        SocketTCP control ;
+        connectToRTIG(control);
+        createFederation(control, FEDERATION_NAME, "testFederation.fed");
+
+        SyntheticRTIA sender ;
+        connectToRTIG(sender.link);
+        join(sender, FEDERATION_NAME, "sender");
+        NM_Publish_Interaction_Class publish ;
+        request(sender, publish, MESSAGE_CLASS, NetworkMessage::PUBLISH_INTERACTION_CLASS,
+                "Publication");
+        if (bestEffort) {
+            NM_Change_Interaction_Transport_Type change ;
+            change.setTransport(BEST_EFFORT);
+            request(sender, change, MESSAGE_CLASS,
+                    NetworkMessage::CHANGE_INTERACTION_TRANSPORT_TYPE, "Transportation change");
+        }
+
+        // The stalled receiver is the last one.
+        std::vector<SyntheticRTIA *> receivers ;
+        for (int i = 0 ; i <= healthy ; ++i) {
+            receivers.push_back(new SyntheticRTIA());
+            connectToRTIG(receivers.back()->link);
+            join(*receivers.back(), FEDERATION_NAME, stringize() << "receiver-" << i);
+            NM_Subscribe_Interaction_Class subscribe ;
+            request(*receivers.back(), subscribe, MESSAGE_CLASS,
+                    NetworkMessage::SUBSCRIBE_INTERACTION_CLASS, "Subscription");
+        }
+        SyntheticRTIA &stalled = *receivers.back();
+
+        std::vector<struct pollfd> fds(receivers.size() + 1);
+        fds[0].fd = sender.link.returnSocket();
+        for (unsigned int i = 0 ; i < receivers.size(); ++i)
+            fds[i + 1].fd = receivers[i]->link.returnSocket();
+        for (unsigned int i = 0 ; i < fds.size(); ++i)
+            fds[i].events = POLLIN ;
+
+        NM_Send_Interaction interaction ;
+        interaction.setFederation(sender.federation);
+        interaction.setFederate(sender.federate);
+        interaction.setInteractionClass(MESSAGE_CLASS);
+        interaction.setRegion(0);
+        interaction.setParametersSize(1);
+        interaction.setParameters(PARAM1, 0);
+        interaction.setValuesSize(1);
+        std::vector<char> value(std::max<uint32_t>(size, sizeof(uint64_t)), 'x');
+
+        cout << "# healthy " << healthy << ", " << rate << " interactions/s of "
+             << value.size() << " bytes, " << (bestEffort ? "best effort" : "reliable") << endl ;
+        cout << "# time  stalled  sent  received/healthy  p50 us  p99 us  max us" << endl ;
+
+        int inFlight = 0 ;
+        uint64_t sent = 0, intervalSent = 0, intervalReceived = 0 ;
+        std::vector<double> latencies ;
+        uint64_t start = clk->getCurrentTicksValue();
+        double elapsed = 0.0, reported = 0.0 ;
+        bool stalling = false ;
+        while (elapsed < seconds) {
+            while (inFlight < WINDOW && sent < elapsed * rate) {
+                uint64_t now = clk->getCurrentTicksValue();
+                memcpy(&value[0], &now, sizeof(now));
+                interaction.setValues(value, 0);
+                interaction.send(&sender.link, sendBuffer);
+                ++inFlight ;
+                ++sent ;
+                ++intervalSent ;
+            }
+
+            if (!stalling && elapsed >= 1.0) {
+                stalling = true ;
+                fds.back().events = 0 ;
+                int buffer = STALLED_BUFFER ;
+                setsockopt(stalled.link.returnSocket(), SOL_SOCKET, SO_RCVBUF,
+                           &buffer, sizeof(buffer));
+            }
+            if (poll(&fds[0], fds.size(), 1) < 0) {
+                perror("poll");
+                return EXIT_FAILURE ;
+            }
+            for (unsigned int i = 0 ; i < fds.size(); ++i) {
+                if (!(fds[i].revents & POLLIN))
+                    continue ;
+                SocketTCP &link = i == 0 ? sender.link : receivers[i - 1]->link ;
+                NetworkMessage *msg = NM_Factory::receive(&link, receiveBuffer);
+                if (i == 0 && msg->getMessageType() == NetworkMessage::SEND_INTERACTION)
+                    --inFlight ;
+                else if (i > 0 && i < fds.size() - 1
+                         && msg->getMessageType() == NetworkMessage::RECEIVE_INTERACTION) {
+                    uint64_t stamp ;
+                    const ValueArena &values = static_cast<NM_Receive_Interaction *>(msg)->getValues();
+                    memcpy(&stamp, values.data(0), sizeof(stamp));
+                    latencies.push_back(clk->getDeltaNanoSecond(stamp) * 1e-3);
+                    ++intervalReceived ;
+                }
+                delete msg ;
+            }
+
+            elapsed = clk->getDeltaNanoSecond(start) * 1e-9 ;
+            if (elapsed - reported >= 0.5) {
+                std::sort(latencies.begin(), latencies.end());
+                cout << reported + 0.5 << "  " << (stalling ? "yes" : "no")
+                     << "  " << intervalSent << "  " << intervalReceived / healthy
+                     << "  " << static_cast<uint64_t>(percentile(latencies, 0.5))
+                     << "  " << static_cast<uint64_t>(percentile(latencies, 0.99))
+                     << "  " << static_cast<uint64_t>(percentile(latencies, 1.0)) << endl ;
+                latencies.clear();
+                intervalSent = intervalReceived = 0 ;
+                reported += 0.5 ;
+            }
+        }
+
+        // Closing the stalled link unblocks a rtig waiting for it, which
+        // then kills the stalled federate.
+        stalled.link.close();
+        receivers.pop_back();
+        delete &stalled ;
+        resign(sender);
+        closeConnection(sender.link);
+        for (unsigned int i = 0 ; i < receivers.size(); ++i) {
+            resign(*receivers[i]);
+            closeConnection(receivers[i]->link);
+            delete receivers[i] ;
+        }
+
+        destroyFederation(control, FEDERATION_NAME);
+        closeConnection(control);
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Federation snapshot benchmark.
+//
+// Builds, in process and without RTIG links, an object class with a few
+// attributes published and subscribed by some federates, and registers the
+// given number of instances spread over these federates. The state of this
+// RootObject is saved in a snapshot, then restored in another RootObject
+// built from the same FOM, as the RTIG does on a federation save and
+// restore. The save and restore times and the snapshot size are reported.
+// A truncated copy of the snapshot must then be rejected without changing
+// the restored federation.
+//
+// Usage: CertiBenchSnapshot [max_objects [federates [file]]]
+
+#include "config.h"
+#include "certi.hh"
+#include "RootObject.hh"
+#include "ObjectClass.hh"
+#include "ObjectClassSet.hh"
+#include "ObjectClassAttribute.hh"
+#include "ObjectSet.hh"
+#include "Snapshot.hh"
+#include "Clock.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const ObjectClassHandle CLASS = 1 ;
+const int ATTRIBUTES = 8 ;
+
+/** Build the FOM of the benchmark, declared by every federate. */
+void declare(RootObject &root, FederateHandle federates)
+{
+    ObjectClass *oc = new ObjectClass("Data", CLASS);
+    root.addObjectClass(oc, NULL);
+    std::vector<AttributeHandle> attributes ;
+    for (AttributeHandle a = 1 ; a <= ATTRIBUTES ; ++a) {
+        std::ostringstream name ;
+        name << "Attr" << a ;
+        oc->addAttribute(new ObjectClassAttribute(name.str(), a));
+        attributes.push_back(a);
+    }
+    for (FederateHandle federate = 1 ; federate <= federates ; ++federate) {
+        root.ObjectClasses->publish(federate, CLASS, attributes, true);
+        root.ObjectClasses->subscribe(federate, CLASS, attributes);
+    }
+}
+
+/** Report the save and restore times in milliseconds for one population. */
+void run(int objects, FederateHandle federates, const std::string &file, libhla::clock::Clock &clk,
+         double &save, double &restore, uint64_t &size)
+{
+    RootObject saved(NULL);
+    declare(saved, federates);
+    for (int i = 0 ; i < objects ; ++i) {
+        std::ostringstream name ;
+        name << "Object" << i ;
+        saved.registerObjectInstance(1 + i % federates, CLASS, i + 1, name.str());
+    }
+
+    SnapshotWriter writer ;
+    uint64_t start = clk.getCurrentTicksValue();
+    writer.open(file);
+    saved.saveSnapshot(writer);
+    writer.close();
+    save = clk.getDeltaNanoSecond(start) * 1e-6 ;
+    size = writer.getSize();
+
+    // The federation restored has the same FOM, not the same objects.
+    RootObject restored(NULL);
+    declare(restored, federates);
+
+    SnapshotReader reader ;
+    start = clk.getCurrentTicksValue();
+    reader.open(file);
+    restored.restoreSnapshot(reader);
+    restore = clk.getDeltaNanoSecond(start) * 1e-6 ;
+
+    if (!reader.atEnd() || restored.objects->size() != static_cast<size_t>(objects))
+        throw RTIinternalError("Snapshot not restored as saved");
+    reader.close();
+
+    // A truncated snapshot is rejected before anything is replaced.
+    std::ifstream in(file.c_str(), std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out(file.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size() - 1);
+    out.close();
+
+    SnapshotReader truncated ;
+    truncated.open(file);
+    bool rejected = false ;
+    try {
+        restored.restoreSnapshot(truncated);
+    }
+    catch (RTIinternalError &) {
+        rejected = true ;
+    }
+    if (!rejected || restored.objects->size() != static_cast<size_t>(objects))
+        throw RTIinternalError("Truncated snapshot not rejected as a whole");
+    truncated.close();
+    remove(file.c_str());
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int maxObjects = argc > 1 ? atoi(argv[1]) : 100000 ;
+    int federates = argc > 2 ? atoi(argv[2]) : 16 ;
+    std::string file = argc > 3 ? argv[3] : "CertiBenchSnapshot.snp" ;
+    if (federates < 1)
+        federates = 1 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# objects  federates  save (ms)  restore (ms)  size (bytes)" << endl ;
+        for (int objects = 1000 ; objects <= maxObjects ; objects *= 10) {
+            double save, restore ;
+            uint64_t size ;
+            run(objects, federates, file, *clk, save, restore, size);
+            cout << objects << "  " << federates << "  " << save << "  " << restore
+                 << "  " << static_cast<unsigned long>(size) << endl ;
+        }
+    }
+    catch (Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << e._reason << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,146 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+
+#include "config.h"
+#include "SyntheticRTIA.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+using namespace certi ;
+using std::cerr ;
+using std::endl ;
+
+MessageBuffer sendBuffer ;
+MessageBuffer receiveBuffer ;
+
+// ----------------------------------------------------------------------------
+void connectToRTIG(SocketTCP &link)
+{
+    const char *host = getenv("CERTI_HOST");
+    const char *port = getenv("CERTI_TCP_PORT");
+    link.createConnection(host ? host : "localhost", atoi(port ? port : PORT_TCP_RTIG));
+}
+
+// ----------------------------------------------------------------------------
+NetworkMessage *waitFor(SocketTCP &link, NetworkMessage::Type type)
+{
+    for (;;) {
+        NetworkMessage *msg = NM_Factory::receive(&link, receiveBuffer);
+        if (msg->getMessageType() == type)
+            return msg ;
+        delete msg ;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void check(NetworkMessage *rep, const char *what)
+{
+    std::auto_ptr<NetworkMessage> owner(rep);
+    if (rep->getException() != e_NO_EXCEPTION) {
+        cerr << what << " failed: " << rep->getExceptionReason() << endl ;
+        exit(EXIT_FAILURE);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void createFederation(SocketTCP &link, const std::string &federation, const char *fed)
+{
+    NM_Create_Federation_Execution req ;
+    req.setFederationName(federation);
+    req.setFEDid(fed);
+    req.send(&link, sendBuffer);
+    check(waitFor(link, NetworkMessage::CREATE_FEDERATION_EXECUTION), "Federation creation");
+}
+
+// ----------------------------------------------------------------------------
+void destroyFederation(SocketTCP &link, const std::string &federation)
+{
+    NM_Destroy_Federation_Execution req ;
+    req.setFederationName(federation);
+    req.send(&link, sendBuffer);
+    delete waitFor(link, NetworkMessage::DESTROY_FEDERATION_EXECUTION);
+}
+
+// ----------------------------------------------------------------------------
+void closeConnection(SocketTCP &link)
+{
+    NM_Close_Connexion close ;
+    close.send(&link, sendBuffer);
+    link.close();
+}
+
+// ----------------------------------------------------------------------------
+bool tryJoin(SyntheticRTIA &rtia, const std::string &federation, const std::string &name)
+{
+    NM_Join_Federation_Execution req ;
+    req.setFederationName(federation);
+    req.setFederateName(name);
+    req.setBestEffortAddress(0);
+    req.setBestEffortPeer(0);
+    req.send(&rtia.link, sendBuffer);
+
+    std::auto_ptr<NetworkMessage> rep(waitFor(rtia.link, NetworkMessage::JOIN_FEDERATION_EXECUTION));
+    if (rep->getException() != e_NO_EXCEPTION) {
+        cerr << "Join of " << federation << " failed: " << rep->getExceptionReason() << endl ;
+        return false ;
+    }
+    rtia.federation = rep->getFederation();
+    rtia.federate = rep->getFederate();
+    return true ;
+}
+
+// ----------------------------------------------------------------------------
+void join(SyntheticRTIA &rtia, const std::string &federation, const std::string &name)
+{
+    if (!tryJoin(rtia, federation, name))
+        exit(EXIT_FAILURE);
+}
+
+// ----------------------------------------------------------------------------
+void resign(SyntheticRTIA &rtia)
+{
+    while (rtia.inFlight > 0) {
+        delete NM_Factory::receive(&rtia.link, receiveBuffer);
+        --rtia.inFlight ;
+    }
+    NM_Resign_Federation_Execution req ;
+    req.setFederation(rtia.federation);
+    req.setFederate(rtia.federate);
+    req.send(&rtia.link, sendBuffer);
+    delete waitFor(rtia.link, NetworkMessage::RESIGN_FEDERATION_EXECUTION);
+}
+
+// ----------------------------------------------------------------------------
+void switchAdvisory(SyntheticRTIA &rtia)
+{
+    NM_Set_Class_Relevance_Advisory_Switch req ;
+    req.setFederation(rtia.federation);
+    req.setFederate(rtia.federate);
+    rtia.craOn = !rtia.craOn ;
+    if (rtia.craOn)
+        req.classRelevanceAdvisorySwitchOn();
+    else
+        req.classRelevanceAdvisorySwitchOff();
+    req.send(&rtia.link, sendBuffer);
+    ++rtia.inFlight ;
+}
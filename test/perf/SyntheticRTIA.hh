@@ -0,0 +1,90 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+
+#ifndef CERTI_SYNTHETIC_RTIA_HH
+#define CERTI_SYNTHETIC_RTIA_HH
+
+#include "certi.hh"
+#include "SocketTCP.hh"
+#include "NM_Classes.hh"
+
+#include <string>
+
+/**
+ * A federate of the RTIG benchmarks, talking to the rtig in place of a
+ * RTIA: the benchmark sends the network messages of its choice on the link
+ * and reads the answers itself. The rtig is found with CERTI_HOST /
+ * CERTI_TCP_PORT as for any RTIA.
+ */
+struct SyntheticRTIA
+{
+    SyntheticRTIA() : federation(0), federate(0), craOn(false), inFlight(0) {}
+
+    certi::SocketTCP link ;
+    certi::Handle federation ;
+    certi::FederateHandle federate ;
+    bool craOn ;                ///< class relevance advisory switch state
+    int inFlight ;              ///< requests sent and not answered yet
+};
+
+/** Buffers of the messages sent and received by the synthetic RTIAs. */
+extern MessageBuffer sendBuffer ;
+extern MessageBuffer receiveBuffer ;
+
+/** Connect a link to the rtig. */
+void connectToRTIG(certi::SocketTCP &link);
+/** Read the link until a message of the given type, the others are deleted. */
+certi::NetworkMessage *waitFor(certi::SocketTCP &link, certi::NetworkMessage::Type type);
+/** Delete an answer, exit if it carries an exception. */
+void check(certi::NetworkMessage *rep, const char *what);
+
+/** Create a federation execution, exit if it fails. */
+void createFederation(certi::SocketTCP &link, const std::string &federation, const char *fed);
+/** Destroy a federation execution, once its last federate has resigned. */
+void destroyFederation(certi::SocketTCP &link, const std::string &federation);
+/** Tell the rtig that the link closes, and close it. */
+void closeConnection(certi::SocketTCP &link);
+
+/** Join a federation through a connected link, false if the rtig refuses.
+ *  No UDP link is given: the best effort messages come over TCP as well. */
+bool tryJoin(SyntheticRTIA &rtia, const std::string &federation, const std::string &name);
+/** Join a federation through a connected link, exit if it fails. */
+void join(SyntheticRTIA &rtia, const std::string &federation, const std::string &name);
+/** Read the answers still in flight and resign, the link staying open. */
+void resign(SyntheticRTIA &rtia);
+
+/** Switch the class relevance advisory on or off, which the rtig answers:
+ *  one more request in flight. */
+void switchAdvisory(SyntheticRTIA &rtia);
+
+/** Send a request about an interaction class and check its answer. */
+template<typename T> void
+request(SyntheticRTIA &rtia, T &req, certi::InteractionClassHandle interaction,
+        certi::NetworkMessage::Type type, const char *what)
+{
+    req.setFederation(rtia.federation);
+    req.setFederate(rtia.federate);
+    req.setInteractionClass(interaction);
+    req.send(&rtia.link, sendBuffer);
+    check(waitFor(rtia.link, type), what);
+}
+
+#endif // CERTI_SYNTHETIC_RTIA_HH
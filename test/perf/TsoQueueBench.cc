@@ -0,0 +1,178 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// RTIA TSO queue benchmark.
+//
+// Feeds the RTIA Queues with a burst of randomly timestamped reflections
+// (many of them sharing a timestamp), then drains them the way
+// TimeManagement does, advancing the logical time by steps of 1. Delivery
+// order (timestamp, then receive order) is checked. The same burst is also
+// fed to the former sorted list insertion, on a smaller count since it is
+// quadratic.
+//
+// Usage: CertiBenchTSO [count [list_count]]
+
+#include "config.h"
+#include "certi.hh"
+#include "Files.hh"
+#include "NM_Classes.hh"
+#include "Clock.hh"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+/** Messages dated in [0, count/10), numbered in their receive order. Half
+ *  of the dates are one rounding error above the integer: these chains of
+ *  nearly equal dates must still come out in date order. */
+void createBurst(std::vector<NetworkMessage *> &burst, int count)
+{
+    srand(1);
+    for (int i = 0 ; i < count ; ++i) {
+        NetworkMessage *msg = new NM_Reflect_Attribute_Values();
+        msg->setFederate(i);
+        double date = static_cast<double>(rand() % (count / 10 + 1));
+        if (rand() % 2)
+            date = nextafter(date, 1e300);
+        msg->setDate(date);
+        burst.push_back(msg);
+    }
+}
+
+void deleteBurst(std::vector<NetworkMessage *> &burst)
+{
+    for (unsigned int i = 0 ; i < burst.size(); ++i)
+        delete burst[i] ;
+    burst.clear();
+}
+
+/** Former Queues::insertTsoMessage, on the raw dates as the heap. */
+void insertSorted(std::list<NetworkMessage *> &tsos, NetworkMessage *msg)
+{
+    std::list<NetworkMessage *>::iterator i ;
+    for (i = tsos.begin(); i != tsos.end(); i++) {
+        if ((*i)->getDate().getTime() > msg->getDate().getTime()) {
+            tsos.insert(i, msg);
+            return ;
+        }
+    }
+    tsos.push_back(msg);
+}
+
+bool inOrder(const NetworkMessage *previous, const NetworkMessage *msg)
+{
+    if (previous == NULL)
+        return true ;
+    double before = previous->getDate().getTime();
+    double date = msg->getDate().getTime();
+    return before < date || (before == date && previous->getFederate() < msg->getFederate());
+}
+
+void report(const char *queue, int count, double insertNs, double giveNs, bool ordered)
+{
+    cout << queue << "  " << count
+         << "  " << static_cast<uint64_t>(count / (insertNs * 1e-9))
+         << "  " << static_cast<uint64_t>(count / (giveNs * 1e-9))
+         << "  " << (ordered ? "ok" : "BROKEN") << endl ;
+}
+
+void runQueues(int count, libhla::clock::Clock &clk)
+{
+    std::vector<NetworkMessage *> burst ;
+    createBurst(burst, count);
+    rtia::Queues queues ;
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < count ; ++i)
+        queues.insertTsoMessage(burst[i]);
+    double insertNs = clk.getDeltaNanoSecond(start);
+
+    bool ordered = true ;
+    int given = 0 ;
+    const NetworkMessage *previous = NULL ;
+    start = clk.getCurrentTicksValue();
+    for (FederationTime now = 0.0 ; given < count ; now += 1.0) {
+        bool msg_donne = true ;
+        bool msg_restant ;
+        while (msg_donne) {
+            NetworkMessage *msg = queues.giveTsoMessage(now, msg_donne, msg_restant);
+            if (msg_donne) {
+                ordered = ordered && inOrder(previous, msg);
+                previous = msg ;
+                ++given ;
+            }
+        }
+    }
+    double giveNs = clk.getDeltaNanoSecond(start);
+
+    report("heap", count, insertNs, giveNs, ordered);
+    deleteBurst(burst);
+}
+
+void runList(int count, libhla::clock::Clock &clk)
+{
+    std::vector<NetworkMessage *> burst ;
+    createBurst(burst, count);
+    std::list<NetworkMessage *> tsos ;
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < count ; ++i)
+        insertSorted(tsos, burst[i]);
+    double insertNs = clk.getDeltaNanoSecond(start);
+
+    bool ordered = true ;
+    const NetworkMessage *previous = NULL ;
+    start = clk.getCurrentTicksValue();
+    while (!tsos.empty()) {
+        ordered = ordered && inOrder(previous, tsos.front());
+        previous = tsos.front();
+        tsos.pop_front();
+    }
+    double giveNs = clk.getDeltaNanoSecond(start);
+
+    report("list", count, insertNs, giveNs, ordered);
+    deleteBurst(burst);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 1000000 ;
+    int listCount = argc > 2 ? atoi(argv[2]) : 20000 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    cout << "# queue  messages  inserts/s  gives/s  order" << endl ;
+    runList(listCount, *clk);
+    runQueues(listCount, *clk);
+    runQueues(count, *clk);
+    return EXIT_SUCCESS ;
+}
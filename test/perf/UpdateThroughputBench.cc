@@ -0,0 +1,146 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// updateAttributeValues / sendInteraction throughput benchmark.
+//
+// A single HLA 1.3 federate registers one object and sends a burst of
+// receive order updates, then a burst of interactions, first with the
+// default synchronous RTIA and then with a new RTIA started with
+// CERTI_ASYNC_UPDATES set to the given window. The rate of both bursts is
+// reported for each mode.
+//
+// Usage: CertiBenchUpdates [count [payload [window [FED file]]]]
+//   A rtig must be running (CERTI_HOST / CERTI_TCP_PORT) and the FED file
+//   (default testFederation.fed) must be found through CERTI_FOM_PATH.
+
+#include "RTI.hh"
+#include "NullFederateAmbassador.hh"
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *FEDERATION_NAME = "CertiBenchUpdates" ;
+
+struct Result {
+    double updates ;
+    double interactions ;
+};
+
+/** Run both bursts with a fresh RTIA, window 0 meaning synchronous mode. */
+Result run(int count, int payload, int window, const char *fed,
+           libhla::clock::Clock &clk)
+{
+    if (window > 0) {
+        std::ostringstream value ;
+        value << window ;
+        setenv("CERTI_ASYNC_UPDATES", value.str().c_str(), 1);
+    }
+    else {
+        unsetenv("CERTI_ASYNC_UPDATES");
+    }
+
+    std::auto_ptr<RTI::RTIambassador> rtiamb(new RTI::RTIambassador());
+    NullFederateAmbassador fedamb ;
+
+    try {
+        rtiamb->createFederationExecution(FEDERATION_NAME, fed);
+    }
+    catch (RTI::FederationExecutionAlreadyExists &) {
+    }
+    rtiamb->joinFederationExecution("bench", FEDERATION_NAME, &fedamb);
+
+    RTI::ObjectClassHandle dataClass = rtiamb->getObjectClassHandle("Data");
+    RTI::AttributeHandle attr1 = rtiamb->getAttributeHandle("Attr1", dataClass);
+    RTI::AttributeHandle attr2 = rtiamb->getAttributeHandle("Attr2", dataClass);
+    RTI::InteractionClassHandle messageClass = rtiamb->getInteractionClassHandle("Message");
+    RTI::ParameterHandle param1 = rtiamb->getParameterHandle("Param1", messageClass);
+    RTI::ParameterHandle param2 = rtiamb->getParameterHandle("Param2", messageClass);
+
+    std::auto_ptr<RTI::AttributeHandleSet> attributes(RTI::AttributeHandleSetFactory::create(2));
+    attributes->add(attr1);
+    attributes->add(attr2);
+    rtiamb->publishObjectClass(dataClass, *attributes);
+    rtiamb->publishInteractionClass(messageClass);
+    RTI::ObjectHandle object = rtiamb->registerObjectInstance(dataClass);
+
+    std::string value(payload, 'x');
+    std::auto_ptr<RTI::AttributeHandleValuePairSet> ahvps(RTI::AttributeSetFactory::create(2));
+    ahvps->add(attr1, value.data(), value.size());
+    ahvps->add(attr2, value.data(), value.size());
+    std::auto_ptr<RTI::ParameterHandleValuePairSet> phvps(RTI::ParameterSetFactory::create(2));
+    phvps->add(param1, value.data(), value.size());
+    phvps->add(param2, value.data(), value.size());
+
+    Result result ;
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < count ; ++i)
+        rtiamb->updateAttributeValues(object, *ahvps, "");
+    result.updates = count / (clk.getDeltaNanoSecond(start) * 1e-9);
+
+    start = clk.getCurrentTicksValue();
+    for (int i = 0 ; i < count ; ++i)
+        rtiamb->sendInteraction(messageClass, *phvps, "");
+    result.interactions = count / (clk.getDeltaNanoSecond(start) * 1e-9);
+
+    rtiamb->resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
+    try {
+        rtiamb->destroyFederationExecution(FEDERATION_NAME);
+    }
+    catch (RTI::FederatesCurrentlyJoined &) {
+    }
+    return result ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 20000 ;
+    int payload = argc > 2 ? atoi(argv[2]) : 64 ;
+    int window = argc > 3 ? atoi(argv[3]) : 64 ;
+    const char *fed = argc > 4 ? argv[4] : "testFederation.fed" ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    try {
+        cout << "# mode  window  payload  updates/s  interactions/s" << endl ;
+        Result sync = run(count, payload, 0, fed, *clk);
+        cout << "sync  0  " << payload << "  " << static_cast<uint64_t>(sync.updates)
+             << "  " << static_cast<uint64_t>(sync.interactions) << endl ;
+        Result async = run(count, payload, window, fed, *clk);
+        cout << "async  " << window << "  " << payload << "  " << static_cast<uint64_t>(async.updates)
+             << "  " << static_cast<uint64_t>(async.interactions) << endl ;
+    }
+    catch (RTI::Exception &e) {
+        cerr << "Benchmark aborted: " << e._name << " " << (e._reason ? e._reason : "") << endl ;
+        return EXIT_FAILURE ;
+    }
+    return EXIT_SUCCESS ;
+}
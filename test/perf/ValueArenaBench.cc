@@ -0,0 +1,140 @@
+// ----------------------------------------------------------------------------
+// CERTI - HLA RunTime Infrastructure
+// Copyright (C) 2002-2005  ONERA
+//
+// This program is free software ; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation ; either version 2 of
+// the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY ; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this program ; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+// ----------------------------------------------------------------------------
+
+// Attribute values benchmark.
+//
+// Follows the values of an update through the RTIG: the update is decoded
+// from a receive buffer, its values are given to the reflect message, then
+// to a reduced reflect message holding every other attribute, and both are
+// encoded. The values are shared slices of the arena of the update; the
+// reference copies every value at each step instead, as the former
+// vector<vector<char>> representation did.
+//
+// Usage: CertiBenchValues [updates]
+
+#include "config.h"
+#include "certi.hh"
+#include "NM_Classes.hh"
+#include "Clock.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::endl ;
+
+namespace {
+
+void copyHeader(const NM_Update_Attribute_Values &update, NM_Reflect_Attribute_Values &reflect)
+{
+    reflect.setFederation(update.getFederation());
+    reflect.setFederate(update.getFederate());
+    reflect.setObject(update.getObject());
+    reflect.setAttributesSize(update.getAttributesSize());
+    for (uint32_t i = 0 ; i < update.getAttributesSize() ; ++i)
+        reflect.setAttributes(update.getAttributes(i), i);
+}
+
+/** Updates per second, values being shared or copied. */
+double run(libhla::MessageBuffer &wire, const std::vector<uint32_t> &ranks,
+           int updates, bool share, libhla::clock::Clock &clk)
+{
+    libhla::MessageBuffer out ;
+    std::vector<AttributeValue_t> copies ;
+
+    uint64_t start = clk.getCurrentTicksValue();
+    for (int n = 0 ; n < updates ; ++n) {
+        wire.assumeSizeFromReservedBytes();
+        NM_Update_Attribute_Values update ;
+        update.deserialize(wire);
+        const ValueArena &values = update.getValues();
+
+        NM_Reflect_Attribute_Values reflect ;
+        copyHeader(update, reflect);
+        NM_Reflect_Attribute_Values reduced ;
+        copyHeader(update, reduced);
+        if (share) {
+            reflect.setValues(values);
+            reduced.setValues(ValueArena(values, ranks));
+        }
+        else {
+            // Decoding, then the reflect and the reduced messages.
+            copies.resize(values.size());
+            for (uint32_t i = 0 ; i < values.size() ; ++i)
+                copies[i] = values.get(i);
+            std::vector<AttributeValue_t> reflectValues(copies);
+            std::vector<AttributeValue_t> reducedValues ;
+            for (uint32_t i = 0 ; i < ranks.size() ; ++i)
+                reducedValues.push_back(reflectValues[ranks[i]]);
+            reflect.setValuesSize(reflectValues.size());
+            for (uint32_t i = 0 ; i < reflectValues.size() ; ++i)
+                reflect.setValues(reflectValues[i], i);
+            reduced.setValuesSize(reducedValues.size());
+            for (uint32_t i = 0 ; i < reducedValues.size() ; ++i)
+                reduced.setValues(reducedValues[i], i);
+        }
+        reflect.encode(out);
+        reduced.encode(out);
+    }
+    return updates / (clk.getDeltaNanoSecond(start) * 1e-9);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    int updates = argc > 1 ? atoi(argv[1]) : 50000 ;
+
+    std::auto_ptr<libhla::clock::Clock> clk(libhla::clock::Clock::getBestClock());
+
+    cout << "# attributes  value bytes  shared updates/s  copied updates/s" << endl ;
+    static const uint32_t counts[] = { 4, 20, 100 };
+    static const uint32_t sizes[] = { 8, 256 };
+    for (unsigned int c = 0 ; c < sizeof(counts) / sizeof(counts[0]) ; ++c) {
+        for (unsigned int s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; ++s) {
+            NM_Update_Attribute_Values update ;
+            update.setFederation(1);
+            update.setFederate(1);
+            update.setObject(1);
+            update.setAttributesSize(counts[c]);
+            update.setValuesSize(counts[c]);
+            std::vector<uint32_t> ranks ;
+            for (uint32_t i = 0 ; i < counts[c] ; ++i) {
+                update.setAttributes(i + 1, i);
+                update.setValues(AttributeValue_t(sizes[s], 'x'), i);
+                if (i % 2 == 0)
+                    ranks.push_back(i);
+            }
+            libhla::MessageBuffer wire ;
+            update.encode(wire);
+
+            int n = updates / (1 + counts[c] * sizes[s] / 1024);
+            double shared = run(wire, ranks, n, true, *clk);
+            double copied = run(wire, ranks, n, false, *clk);
+            cout << counts[c] << "  " << sizes[s]
+                 << "  " << static_cast<uint64_t>(shared)
+                 << "  " << static_cast<uint64_t>(copied) << endl ;
+        }
+    }
+    return EXIT_SUCCESS ;
+}
@@ -0,0 +1,167 @@
+/* ----------------------------------------------------------------------------
+ * CERTI - HLA RunTime Infrastructure
+ * Copyright (C) 2002-2011  ONERA
+ *
+ * This program is free software ; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation ; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY ; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program ; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ * USA
+ */
+
+// Decoder of the trace files written by EventTrace (see CERTI_TRACE).
+//
+// The events of every thread of the given files are printed in time order,
+// one per line, the time being in microseconds since the start of the
+// earliest process. The processes of a host share the monotonic clock, so
+// the traces of an RTIG, its RTIAs and their federates can be merged.
+//
+// Usage: CertiTraceDump file.trace [file.trace ...]
+
+#include "EventTrace.hh"
+#include "NM_Classes.hh"
+#include "M_Classes.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace certi ;
+using std::cout ;
+using std::cerr ;
+using std::endl ;
+
+namespace {
+
+const char *POINTS[] = {
+    "?", "rtig-receive", "rtig-dispatch", "rtig-broadcast", "network-send",
+    "rtia-receive", "rtia-request", "rtia-callback",
+    "tick-begin", "tick-callback", "tick-end"
+};
+
+struct DecodedEvent {
+    double nanoseconds ;
+    uint32_t pid ;
+    TraceEvent event ;
+    bool operator<(const DecodedEvent &other) const {
+        return nanoseconds < other.nanoseconds ;
+    }
+};
+
+/** Name of a message type, Message::Type between a federate and its RTIA. */
+std::string messageName(const TraceEvent &event)
+{
+    static std::map<uint32_t, std::string> networkNames, federateNames ;
+    bool federateSide = event.point >= TRACE_RTIA_REQUEST ;
+    std::map<uint32_t, std::string> &names = federateSide ? federateNames : networkNames ;
+    std::map<uint32_t, std::string>::const_iterator i = names.find(event.type);
+    if (i != names.end())
+        return i->second ;
+
+    std::string name = "?" ;
+    try {
+        if (federateSide) {
+            std::auto_ptr<Message> msg(M_Factory::create(static_cast<Message::Type>(event.type)));
+            name = msg->getMessageName();
+        }
+        else {
+            std::auto_ptr<NetworkMessage> msg(NM_Factory::create(static_cast<NetworkMessage::Type>(event.type)));
+            name = msg->getMessageName();
+        }
+    }
+    catch (Exception &e) {
+    }
+    names[event.type] = name ;
+    return name ;
+}
+
+bool readFile(const char *filename, std::vector<DecodedEvent> &events)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        cerr << "Cannot open " << filename << endl ;
+        return false ;
+    }
+    TraceFileHeader header ;
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, "CERTITRC", sizeof(header.magic)) != 0
+        || header.version != EventTrace::FORMAT_VERSION
+        || header.eventSize != sizeof(TraceEvent)) {
+        cerr << filename << " is not a CERTI trace of this version" << endl ;
+        fclose(file);
+        return false ;
+    }
+
+    // The ticks are converted through the clock readings of the header.
+    double nanosecondsPerTick = 1.0 ;
+    if (header.dumpTicks > header.startTicks)
+        nanosecondsPerTick = double(header.dumpNanoseconds - header.startNanoseconds)
+            / double(header.dumpTicks - header.startTicks);
+
+    for (uint32_t r = 0 ; r < header.rings ; ++r) {
+        TraceRingHeader ring ;
+        if (fread(&ring, sizeof(ring), 1, file) != 1)
+            break ;
+        uint64_t kept = std::min<uint64_t>(ring.written, ring.capacity);
+        for (uint64_t e = 0 ; e < kept ; ++e) {
+            DecodedEvent decoded ;
+            if (fread(&decoded.event, sizeof(TraceEvent), 1, file) != 1)
+                break ;
+            decoded.pid = header.pid ;
+            decoded.nanoseconds = header.startNanoseconds
+                + (double(decoded.event.time) - double(header.startTicks)) * nanosecondsPerTick ;
+            events.push_back(decoded);
+        }
+        if (ring.written > ring.capacity)
+            cerr << filename << ": " << (ring.written - ring.capacity)
+                 << " oldest events of thread " << ring.thread << " overwritten" << endl ;
+    }
+    fclose(file);
+    return true ;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " file.trace [file.trace ...]" << endl ;
+        return EXIT_FAILURE ;
+    }
+
+    std::vector<DecodedEvent> events ;
+    for (int i = 1 ; i < argc ; ++i)
+        if (!readFile(argv[i], events))
+            return EXIT_FAILURE ;
+    if (events.empty())
+        return EXIT_SUCCESS ;
+    std::stable_sort(events.begin(), events.end());
+
+    double origin = events.front().nanoseconds ;
+    cout << "# time (us)  pid  thread  point  message  federation  federate  handle  size" << endl ;
+    cout << std::fixed << std::setprecision(3);
+    for (std::vector<DecodedEvent>::const_iterator i = events.begin(); i != events.end(); ++i) {
+        const TraceEvent &event = i->event ;
+        const char *point = event.point < sizeof(POINTS) / sizeof(POINTS[0]) ? POINTS[event.point] : "?" ;
+        cout << (i->nanoseconds - origin) * 1e-3 << "  " << i->pid << "  " << event.thread
+             << "  " << point << "  " << messageName(event) << "  " << event.federation
+             << "  " << event.federate << "  " << event.handle << "  " << event.size << endl ;
+    }
+    return EXIT_SUCCESS ;
+}